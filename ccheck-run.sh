@@ -47,6 +47,11 @@ while [ -z "$doneopt" ]; do
 		shift 1
 		opt="$opt -d $check"
 		;;
+	(.-j)
+		shift 1
+		opt="$opt -j $1"
+		shift 1
+		;;
 	(*)
 		doneopt=y
 		;;
@@ -66,37 +71,4 @@ if [ $rc != 0 ]; then
 	exit 1
 fi
 
-srepcnt=0
-snorepcnt=0
-fcnt=0
-
-find "$@" -type f -regex '^.*\.[ch]$' | (
-while read fname; do
-	outfile="$(mktemp)"
-	$ccheck $opt $fname >"$outfile" 2>&1
-	rc=$?
-	if [ .$rc == .0 ]; then
-		if [ -s "$outfile" ] ; then
-			srepcnt=$((srepcnt + 1))
-			cat "$outfile"
-		else
-			snorepcnt=$((snorepcnt + 1))
-		fi
-	else
-		fcnt=$((fcnt + 1))
-		cat "$outfile"
-	fi
-
-	rm -f "$outfile"
-done
-
-if [ $srepcnt == 0 -a $fcnt == 0 ] ; then
-	echo "Ccheck passed."
-else
-	echo "Ccheck failed."
-	echo "Checked files with issues: $srepcnt"
-	echo "Checked files without issues: $snorepcnt"
-	echo "Files with parse errors: $fcnt"
-	exit 1
-fi
-)
+exec $ccheck $opt "$@"
@@ -0,0 +1,392 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Allocation tracker
+ *
+ * The lexer, parser, AST and checker allocate memory through these
+ * functions. Normally they just call the C library. Once tracking is
+ * enabled, each block is prefixed with a header recording its size and
+ * the subsystem and tracker it is charged to, so that the number of
+ * allocations, bytes in use and peak use can be counted per subsystem
+ * and leaks can be detected without an external tool.
+ *
+ * Each thread charges its allocations to its own tracker (if any).
+ * A tracker must not be used by more than one thread at a time.
+ */
+
+#include <alloc.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** @c true iff tracking is enabled */
+static bool alloc_enabled;
+/** Key of per-thread tracker */
+static pthread_key_t alloc_track_key;
+/** Makes sure alloc_track_key is only created once */
+static pthread_once_t alloc_track_once = PTHREAD_ONCE_INIT;
+
+/** Subsystem names */
+static const char *alloc_subsys_names[as_limit] = {
+	[as_lexer] = "lexer",
+	[as_parser] = "parser",
+	[as_ast] = "ast",
+	[as_checker] = "checker"
+};
+
+/** Create key of per-thread tracker. */
+static void alloc_track_key_create(void)
+{
+	(void) pthread_key_create(&alloc_track_key, NULL);
+}
+
+/** Enable allocation tracking.
+ *
+ * Must be called before any memory is allocated by the tracked
+ * subsystems and before any other threads are started. Tracking
+ * cannot be disabled again.
+ */
+void alloc_track_enable(void)
+{
+	(void) pthread_once(&alloc_track_once, alloc_track_key_create);
+	alloc_enabled = true;
+}
+
+/** Determine if allocation tracking is enabled.
+ *
+ * @return @c true iff alloc_track_enable() has been called
+ */
+bool alloc_track_enabled(void)
+{
+	return alloc_enabled;
+}
+
+/** Initialize allocation tracker.
+ *
+ * @param track Allocation tracker
+ */
+void alloc_track_init(alloc_track_t *track)
+{
+	memset(track, 0, sizeof(alloc_track_t));
+}
+
+/** Set tracker charged with allocations by the calling thread.
+ *
+ * @param track Allocation tracker or @c NULL to stop charging
+ */
+void alloc_track_set(alloc_track_t *track)
+{
+	if (!alloc_enabled)
+		return;
+
+	(void) pthread_setspecific(alloc_track_key, track);
+}
+
+/** Get tracker charged with allocations by the calling thread.
+ *
+ * @return Allocation tracker or @c NULL
+ */
+static alloc_track_t *alloc_track_get(void)
+{
+	if (!alloc_enabled)
+		return NULL;
+
+	return pthread_getspecific(alloc_track_key);
+}
+
+/** Record the number of blocks currently allocated.
+ *
+ * @param mark Place to store mark
+ */
+void alloc_track_mark(alloc_mark_t *mark)
+{
+	unsigned i;
+
+	memset(mark, 0, sizeof(alloc_mark_t));
+	mark->track = alloc_track_get();
+	if (mark->track == NULL)
+		return;
+
+	for (i = 0; i < as_limit; i++)
+		mark->nblocks[i] = mark->track->ss[i].nblocks;
+}
+
+/** Check for blocks leaked since a mark was taken.
+ *
+ * Any blocks allocated since @a mark and not freed yet are counted
+ * as leaked in the tracker statistics.
+ *
+ * @param mark Mark taken by alloc_track_mark()
+ * @return Number of leaked blocks
+ */
+size_t alloc_track_check(alloc_mark_t *mark)
+{
+	alloc_stats_t *stats;
+	size_t nleaked = 0;
+	unsigned i;
+
+	if (mark->track == NULL)
+		return 0;
+
+	for (i = 0; i < as_limit; i++) {
+		stats = &mark->track->ss[i];
+		if (stats->nblocks > mark->nblocks[i]) {
+			stats->nleaked += stats->nblocks - mark->nblocks[i];
+			nleaked += stats->nblocks - mark->nblocks[i];
+		}
+	}
+
+	return nleaked;
+}
+
+/** Start measuring peak memory use of the calling thread.
+ *
+ * The peak is reset to the number of bytes currently charged to
+ * the tracker of the calling thread (if any).
+ */
+void alloc_track_reset_peak(void)
+{
+	alloc_track_t *track = alloc_track_get();
+
+	if (track != NULL)
+		track->rpeak = track->cbytes;
+}
+
+/** Get peak memory use of the calling thread.
+ *
+ * @return Peak number of bytes charged to the tracker of the calling
+ *         thread since alloc_track_reset_peak() or zero if there is
+ *         no tracker
+ */
+size_t alloc_track_peak(void)
+{
+	alloc_track_t *track = alloc_track_get();
+
+	return track != NULL ? track->rpeak : 0;
+}
+
+/** Get number of blocks allocated by a subsystem.
+ *
+ * @param ss Subsystem
+ * @return Number of blocks charged to the tracker of the calling thread
+ *         so far or zero if the calling thread has no tracker
+ */
+size_t alloc_track_nallocs(alloc_subsys_t ss)
+{
+	alloc_track_t *track = alloc_track_get();
+
+	return track != NULL ? track->ss[ss].nallocs : 0;
+}
+
+/** Charge change of block size to tracker.
+ *
+ * @param hdr Block header
+ * @param osize Old size of block
+ */
+static void alloc_charge(alloc_hdr_t *hdr, size_t osize)
+{
+	alloc_track_t *track = hdr->h.track;
+	alloc_stats_t *stats;
+
+	if (track == NULL)
+		return;
+
+	stats = &track->ss[hdr->h.ss];
+	stats->cbytes = stats->cbytes - osize + hdr->h.size;
+	track->cbytes = track->cbytes - osize + hdr->h.size;
+
+	if (hdr->h.size > osize)
+		stats->nbytes += hdr->h.size - osize;
+	if (stats->cbytes > stats->peak)
+		stats->peak = stats->cbytes;
+	if (track->cbytes > track->peak)
+		track->peak = track->cbytes;
+	if (track->cbytes > track->rpeak)
+		track->rpeak = track->cbytes;
+}
+
+/** Allocate tracked block.
+ *
+ * @param ss Subsystem to charge
+ * @param size Size of block
+ * @param zero @c true to fill the block with zeroes
+ * @return Pointer to block or @c NULL if out of memory
+ */
+static void *alloc_tracked(alloc_subsys_t ss, size_t size, bool zero)
+{
+	alloc_hdr_t *hdr;
+
+	if (size > SIZE_MAX - sizeof(alloc_hdr_t))
+		return NULL;
+
+	if (zero)
+		hdr = calloc(1, sizeof(alloc_hdr_t) + size);
+	else
+		hdr = malloc(sizeof(alloc_hdr_t) + size);
+	if (hdr == NULL)
+		return NULL;
+
+	hdr->h.track = alloc_track_get();
+	hdr->h.size = size;
+	hdr->h.ss = ss;
+
+	if (hdr->h.track != NULL) {
+		++hdr->h.track->ss[ss].nallocs;
+		++hdr->h.track->ss[ss].nblocks;
+	}
+
+	alloc_charge(hdr, 0);
+	return hdr + 1;
+}
+
+/** Allocate memory.
+ *
+ * @param ss Subsystem to charge
+ * @param size Size of block
+ * @return Pointer to block or @c NULL if out of memory
+ */
+void *alloc_malloc(alloc_subsys_t ss, size_t size)
+{
+	if (!alloc_enabled)
+		return malloc(size);
+
+	return alloc_tracked(ss, size, false);
+}
+
+/** Allocate zero-filled memory.
+ *
+ * @param ss Subsystem to charge
+ * @param nmemb Number of elements
+ * @param size Size of element
+ * @return Pointer to block or @c NULL if out of memory
+ */
+void *alloc_calloc(alloc_subsys_t ss, size_t nmemb, size_t size)
+{
+	if (!alloc_enabled)
+		return calloc(nmemb, size);
+
+	if (size != 0 && nmemb > SIZE_MAX / size)
+		return NULL;
+
+	return alloc_tracked(ss, nmemb * size, true);
+}
+
+/** Change size of memory block.
+ *
+ * @param ss Subsystem to charge if @a ptr is @c NULL
+ * @param ptr Block allocated by alloc_malloc(), alloc_calloc(),
+ *            alloc_realloc() or alloc_strdup() or @c NULL
+ * @param size New size of block
+ * @return Pointer to resized block or @c NULL if out of memory
+ *         (@a ptr is left untouched)
+ */
+void *alloc_realloc(alloc_subsys_t ss, void *ptr, size_t size)
+{
+	alloc_hdr_t *hdr;
+	alloc_hdr_t *nhdr;
+	size_t osize;
+
+	if (!alloc_enabled)
+		return realloc(ptr, size);
+
+	if (ptr == NULL)
+		return alloc_tracked(ss, size, false);
+
+	if (size > SIZE_MAX - sizeof(alloc_hdr_t))
+		return NULL;
+
+	hdr = (alloc_hdr_t *) ptr - 1;
+	osize = hdr->h.size;
+
+	nhdr = realloc(hdr, sizeof(alloc_hdr_t) + size);
+	if (nhdr == NULL)
+		return NULL;
+
+	nhdr->h.size = size;
+	alloc_charge(nhdr, osize);
+	return nhdr + 1;
+}
+
+/** Duplicate string.
+ *
+ * @param ss Subsystem to charge
+ * @param s String
+ * @return Pointer to new string or @c NULL if out of memory
+ */
+char *alloc_strdup(alloc_subsys_t ss, const char *s)
+{
+	size_t size;
+	char *d;
+
+	if (!alloc_enabled)
+		return strdup(s);
+
+	size = strlen(s) + 1;
+	d = alloc_tracked(ss, size, false);
+	if (d == NULL)
+		return NULL;
+
+	memcpy(d, s, size);
+	return d;
+}
+
+/** Free memory.
+ *
+ * @param ptr Block allocated by alloc_malloc(), alloc_calloc(),
+ *            alloc_realloc() or alloc_strdup() or @c NULL
+ */
+void alloc_free(void *ptr)
+{
+	alloc_hdr_t *hdr;
+	alloc_track_t *track;
+
+	if (!alloc_enabled) {
+		free(ptr);
+		return;
+	}
+
+	if (ptr == NULL)
+		return;
+
+	hdr = (alloc_hdr_t *) ptr - 1;
+	track = hdr->h.track;
+	if (track != NULL) {
+		--track->ss[hdr->h.ss].nblocks;
+		track->ss[hdr->h.ss].cbytes -= hdr->h.size;
+		track->cbytes -= hdr->h.size;
+	}
+
+	free(hdr);
+}
+
+/** Get subsystem name.
+ *
+ * @param ss Subsystem
+ * @return Name
+ */
+const char *alloc_subsys_name(alloc_subsys_t ss)
+{
+	return alloc_subsys_names[ss];
+}
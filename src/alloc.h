@@ -0,0 +1,50 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Allocation tracker
+ */
+
+#ifndef ALLOC_H
+#define ALLOC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <types/alloc.h>
+
+extern void alloc_track_enable(void);
+extern bool alloc_track_enabled(void);
+extern void alloc_track_init(alloc_track_t *);
+extern void alloc_track_set(alloc_track_t *);
+extern void alloc_track_mark(alloc_mark_t *);
+extern size_t alloc_track_check(alloc_mark_t *);
+extern void alloc_track_reset_peak(void);
+extern size_t alloc_track_peak(void);
+extern size_t alloc_track_nallocs(alloc_subsys_t);
+extern void *alloc_malloc(alloc_subsys_t, size_t);
+extern void *alloc_calloc(alloc_subsys_t, size_t, size_t);
+extern void *alloc_realloc(alloc_subsys_t, void *, size_t);
+extern char *alloc_strdup(alloc_subsys_t, const char *);
+extern void alloc_free(void *);
+extern const char *alloc_subsys_name(alloc_subsys_t);
+
+#endif
@@ -25,6 +25,7 @@
  */
 
 #include <adt/list.h>
+#include <alloc.h>
 #include <assert.h>
 #include <ast.h>
 #include <merrno.h>
@@ -59,6 +60,16 @@ static void ast_block_destroy(ast_block_t *);
 static void ast_sqlist_destroy(ast_sqlist_t *);
 static void ast_dlist_destroy(ast_dlist_t *);
 
+/** Allocate zero-filled AST node.
+ *
+ * @param size Node size
+ * @return Pointer to new node or @c NULL if out of memory
+ */
+static void *ast_alloc(size_t size)
+{
+	return alloc_calloc(as_ast, 1, size);
+}
+
 /** Create AST module.
  *
  * @param rmodule Place to store pointer to new module
@@ -68,7 +79,7 @@ int ast_module_create(ast_module_t **rmodule)
 {
 	ast_module_t *module;
 
-	module = calloc(1, sizeof(ast_module_t));
+	module = ast_alloc(sizeof(ast_module_t));
 	if (module == NULL)
 		return ENOMEM;
 
@@ -90,6 +101,36 @@ void ast_module_append(ast_module_t *module, ast_node_t *decl)
 	decl->lnode = &module->node;
 }
 
+/** Insert declaration into module before another declaration.
+ *
+ * @param module Module
+ * @param decl Declaration to insert
+ * @param before Declaration to insert before or @c NULL to append
+ */
+void ast_module_insert_before(ast_module_t *module, ast_node_t *decl,
+    ast_node_t *before)
+{
+	if (before == NULL) {
+		ast_module_append(module, decl);
+		return;
+	}
+
+	assert(before->lnode == &module->node);
+	list_insert_before(&decl->llist, &before->llist);
+	decl->lnode = &module->node;
+}
+
+/** Remove declaration from module.
+ *
+ * @param decl Declaration
+ */
+void ast_module_remove(ast_node_t *decl)
+{
+	assert(decl->lnode->ntype == ant_module);
+	list_remove(&decl->llist);
+	decl->lnode = NULL;
+}
+
 /** Return first declaration in module.
  *
  * @param module Module
@@ -202,7 +243,7 @@ static void ast_module_destroy(ast_module_t *module)
 		decl = ast_module_first(module);
 	}
 
-	free(module);
+	alloc_free(module);
 }
 
 /** Get first token of AST module.
@@ -249,7 +290,7 @@ int ast_sclass_create(ast_sclass_type_t sctype,
 {
 	ast_sclass_t *sclass;
 
-	sclass = calloc(1, sizeof(ast_sclass_t));
+	sclass = ast_alloc(sizeof(ast_sclass_t));
 	if (sclass == NULL)
 		return ENOMEM;
 
@@ -309,7 +350,7 @@ static int ast_sclass_print(ast_sclass_t *sclass, FILE *f)
  */
 static void ast_sclass_destroy(ast_sclass_t *sclass)
 {
-	free(sclass);
+	alloc_free(sclass);
 }
 
 /** Get first token of AST storage-class specifier.
@@ -347,7 +388,7 @@ int ast_gdecln_create(ast_dspecs_t *dspecs, ast_idlist_t *idlist,
 {
 	ast_gdecln_t *gdecln;
 
-	gdecln = calloc(1, sizeof(ast_gdecln_t));
+	gdecln = ast_alloc(sizeof(ast_gdecln_t));
 	if (gdecln == NULL)
 		return ENOMEM;
 
@@ -413,7 +454,7 @@ static void ast_gdecln_destroy(ast_gdecln_t *gdecln)
 	ast_malist_destroy(gdecln->malist);
 	ast_block_destroy(gdecln->body);
 
-	free(gdecln);
+	alloc_free(gdecln);
 }
 
 /** Get first token of AST global declaration.
@@ -449,7 +490,7 @@ int ast_mdecln_create(ast_mdecln_t **rmdecln)
 {
 	ast_mdecln_t *mdecln;
 
-	mdecln = calloc(1, sizeof(ast_mdecln_t));
+	mdecln = ast_alloc(sizeof(ast_mdecln_t));
 	if (mdecln == NULL)
 		return ENOMEM;
 
@@ -473,7 +514,7 @@ int ast_mdecln_append(ast_mdecln_t *mdecln, ast_node_t *expr, void *dcomma)
 {
 	ast_mdecln_arg_t *arg;
 
-	arg = calloc(1, sizeof(ast_mdecln_arg_t));
+	arg = ast_alloc(sizeof(ast_mdecln_arg_t));
 	if (arg == NULL)
 		return ENOMEM;
 
@@ -558,13 +599,13 @@ static void ast_mdecln_destroy(ast_mdecln_t *mdecln)
 	while (arg != NULL) {
 		list_remove(&arg->lmdecln);
 		ast_tree_destroy(arg->expr);
-		free(arg);
+		alloc_free(arg);
 
 		arg = ast_mdecln_first(mdecln);
 	}
 
 	ast_dspecs_destroy(mdecln->dspecs);
-	free(mdecln);
+	alloc_free(mdecln);
 }
 
 /** Get first token of AST macro-based declaration.
@@ -600,7 +641,7 @@ int ast_gmdecln_create(ast_gmdecln_t **rgmdecln)
 {
 	ast_gmdecln_t *gmdecln;
 
-	gmdecln = calloc(1, sizeof(ast_gmdecln_t));
+	gmdecln = ast_alloc(sizeof(ast_gmdecln_t));
 	if (gmdecln == NULL)
 		return ENOMEM;
 
@@ -653,7 +694,7 @@ static void ast_gmdecln_destroy(ast_gmdecln_t *gmdecln)
 {
 	ast_mdecln_destroy(gmdecln->mdecln);
 	ast_block_destroy(gmdecln->body);
-	free(gmdecln);
+	alloc_free(gmdecln);
 }
 
 /** Get first token of AST global macro-based declaration.
@@ -673,7 +714,12 @@ static ast_tok_t *ast_gmdecln_first_tok(ast_gmdecln_t *gmdecln)
  */
 static ast_tok_t *ast_gmdecln_last_tok(ast_gmdecln_t *gmdecln)
 {
-	return &gmdecln->tscolon;
+	if (gmdecln->have_scolon)
+		return &gmdecln->tscolon;
+	else if (gmdecln->body != NULL)
+		return ast_block_last_tok(gmdecln->body);
+	else
+		return ast_mdecln_last_tok(gmdecln->mdecln);
 }
 
 /** Create AST null declaration.
@@ -686,7 +732,7 @@ int ast_nulldecln_create(ast_nulldecln_t **rnulldecln)
 {
 	ast_nulldecln_t *anulldecln;
 
-	anulldecln = calloc(1, sizeof(ast_nulldecln_t));
+	anulldecln = ast_alloc(sizeof(ast_nulldecln_t));
 	if (anulldecln == NULL)
 		return ENOMEM;
 
@@ -719,7 +765,7 @@ static int ast_nulldecln_print(ast_nulldecln_t *anulldecln, FILE *f)
  */
 static void ast_nulldecln_destroy(ast_nulldecln_t *anulldecln)
 {
-	free(anulldecln);
+	alloc_free(anulldecln);
 }
 
 /** Get first token of AST null declaration.
@@ -752,7 +798,7 @@ int ast_externc_create(ast_externc_t **rexternc)
 {
 	ast_externc_t *externc;
 
-	externc = calloc(1, sizeof(ast_externc_t));
+	externc = ast_alloc(sizeof(ast_externc_t));
 	if (externc == NULL)
 		return ENOMEM;
 
@@ -887,7 +933,7 @@ static void ast_externc_destroy(ast_externc_t *externc)
 		decl = ast_externc_first(externc);
 	}
 
-	free(externc);
+	alloc_free(externc);
 }
 
 /** Get first token of AST extern "C" declaration.
@@ -921,7 +967,7 @@ int ast_block_create(ast_braces_t braces, ast_block_t **rblock)
 {
 	ast_block_t *block;
 
-	block = calloc(1, sizeof(ast_block_t));
+	block = ast_alloc(sizeof(ast_block_t));
 	if (block == NULL)
 		return ENOMEM;
 
@@ -1064,7 +1110,7 @@ static void ast_block_destroy(ast_block_t *block)
 		stmt = ast_block_first(block);
 	}
 
-	free(block);
+	alloc_free(block);
 }
 
 /** Get first token of AST block.
@@ -1116,7 +1162,7 @@ int ast_tqual_create(ast_qtype_t qtype, ast_tqual_t **rtqual)
 {
 	ast_tqual_t *tqual;
 
-	tqual = calloc(1, sizeof(ast_tqual_t));
+	tqual = ast_alloc(sizeof(ast_tqual_t));
 	if (tqual == NULL)
 		return ENOMEM;
 
@@ -1166,7 +1212,7 @@ static int ast_tqual_print(ast_tqual_t *tqual, FILE *f)
  */
 static void ast_tqual_destroy(ast_tqual_t *tqual)
 {
-	free(tqual);
+	alloc_free(tqual);
 }
 
 /** Get first token of AST type qualifier.
@@ -1199,7 +1245,7 @@ int ast_tsbasic_create(ast_tsbasic_t **rtsbasic)
 {
 	ast_tsbasic_t *tsbasic;
 
-	tsbasic = calloc(1, sizeof(ast_tsbasic_t));
+	tsbasic = ast_alloc(sizeof(ast_tsbasic_t));
 	if (tsbasic == NULL)
 		return ENOMEM;
 
@@ -1233,7 +1279,7 @@ static int ast_tsbasic_print(ast_tsbasic_t *tsbasic, FILE *f)
  */
 static void ast_tsbasic_destroy(ast_tsbasic_t *tsbasic)
 {
-	free(tsbasic);
+	alloc_free(tsbasic);
 }
 
 /** Get first token of AST basic type specifier.
@@ -1266,7 +1312,7 @@ int ast_tsident_create(ast_tsident_t **rtsident)
 {
 	ast_tsident_t *atsident;
 
-	atsident = calloc(1, sizeof(ast_tsident_t));
+	atsident = ast_alloc(sizeof(ast_tsident_t));
 	if (atsident == NULL)
 		return ENOMEM;
 
@@ -1300,7 +1346,7 @@ static int ast_tsident_print(ast_tsident_t *atsident, FILE *f)
  */
 static void ast_tsident_destroy(ast_tsident_t *atsident)
 {
-	free(atsident);
+	alloc_free(atsident);
 }
 
 /** Get first token of AST identifier type specifier.
@@ -1333,7 +1379,7 @@ int ast_tsatomic_create(ast_tsatomic_t **rtsatomic)
 {
 	ast_tsatomic_t *tsatomic;
 
-	tsatomic = calloc(1, sizeof(ast_tsatomic_t));
+	tsatomic = ast_alloc(sizeof(ast_tsatomic_t));
 	if (tsatomic == NULL)
 		return ENOMEM;
 
@@ -1375,7 +1421,7 @@ static int ast_tsatomic_print(ast_tsatomic_t *tsatomic, FILE *f)
 static void ast_tsatomic_destroy(ast_tsatomic_t *tsatomic)
 {
 	ast_typename_destroy(tsatomic->atypename);
-	free(tsatomic);
+	alloc_free(tsatomic);
 }
 
 /** Get first token of AST atomic type specifier.
@@ -1409,7 +1455,7 @@ int ast_tsrecord_create(ast_rtype_t rtype, ast_tsrecord_t **rtsrecord)
 {
 	ast_tsrecord_t *tsrecord;
 
-	tsrecord = calloc(1, sizeof(ast_tsrecord_t));
+	tsrecord = ast_alloc(sizeof(ast_tsrecord_t));
 	if (tsrecord == NULL)
 		return ENOMEM;
 
@@ -1436,7 +1482,7 @@ int ast_tsrecord_append(ast_tsrecord_t *tsrecord, ast_sqlist_t *sqlist,
 {
 	ast_tsrecord_elem_t *elem;
 
-	elem = calloc(1, sizeof(ast_tsrecord_elem_t));
+	elem = ast_alloc(sizeof(ast_tsrecord_elem_t));
 	if (elem == NULL)
 		return ENOMEM;
 
@@ -1461,7 +1507,7 @@ int ast_tsrecord_append_mdecln(ast_tsrecord_t *tsrecord, ast_mdecln_t *mdecln,
 {
 	ast_tsrecord_elem_t *elem;
 
-	elem = calloc(1, sizeof(ast_tsrecord_elem_t));
+	elem = ast_alloc(sizeof(ast_tsrecord_elem_t));
 	if (elem == NULL)
 		return ENOMEM;
 
@@ -1483,7 +1529,7 @@ int ast_tsrecord_append_null(ast_tsrecord_t *tsrecord, void *dscolon)
 {
 	ast_tsrecord_elem_t *elem;
 
-	elem = calloc(1, sizeof(ast_tsrecord_elem_t));
+	elem = ast_alloc(sizeof(ast_tsrecord_elem_t));
 	if (elem == NULL)
 		return ENOMEM;
 
@@ -1599,12 +1645,12 @@ static void ast_tsrecord_destroy(ast_tsrecord_t *tsrecord)
 		ast_sqlist_destroy(elem->sqlist);
 		ast_dlist_destroy(elem->dlist);
 		ast_mdecln_destroy(elem->mdecln);
-		free(elem);
+		alloc_free(elem);
 		elem = ast_tsrecord_first(tsrecord);
 	}
 
 	ast_aslist_destroy(tsrecord->aslist2);
-	free(tsrecord);
+	alloc_free(tsrecord);
 }
 
 /** Get first token of AST record type specifier.
@@ -1642,7 +1688,7 @@ int ast_tsenum_create(ast_tsenum_t **rtsenum)
 {
 	ast_tsenum_t *tsenum;
 
-	tsenum = calloc(1, sizeof(ast_tsenum_t));
+	tsenum = ast_alloc(sizeof(ast_tsenum_t));
 	if (tsenum == NULL)
 		return ENOMEM;
 
@@ -1669,7 +1715,7 @@ int ast_tsenum_append(ast_tsenum_t *tsenum, void *dident, void *dequals,
 {
 	ast_tsenum_elem_t *elem;
 
-	elem = calloc(1, sizeof(ast_tsenum_elem_t));
+	elem = ast_alloc(sizeof(ast_tsenum_elem_t));
 	if (elem == NULL)
 		return ENOMEM;
 
@@ -1760,11 +1806,11 @@ static void ast_tsenum_destroy(ast_tsenum_t *tsenum)
 	while (elem != NULL) {
 		list_remove(&elem->ltsenum);
 		ast_tree_destroy(elem->init);
-		free(elem);
+		alloc_free(elem);
 		elem = ast_tsenum_first(tsenum);
 	}
 
-	free(tsenum);
+	alloc_free(tsenum);
 }
 
 /** Get first token of AST enum type specifier.
@@ -1802,7 +1848,7 @@ int ast_fspec_create(ast_fspec_t **rfspec)
 {
 	ast_fspec_t *fspec;
 
-	fspec = calloc(1, sizeof(ast_fspec_t));
+	fspec = ast_alloc(sizeof(ast_fspec_t));
 	if (fspec == NULL)
 		return ENOMEM;
 
@@ -1834,7 +1880,7 @@ static int ast_fspec_print(ast_fspec_t *fspec, FILE *f)
  */
 static void ast_fspec_destroy(ast_fspec_t *fspec)
 {
-	free(fspec);
+	alloc_free(fspec);
 }
 
 /** Get first token of AST function specifier.
@@ -1867,7 +1913,7 @@ int ast_regassign_create(ast_regassign_t **rregassign)
 {
 	ast_regassign_t *regassign;
 
-	regassign = calloc(1, sizeof(ast_regassign_t));
+	regassign = ast_alloc(sizeof(ast_regassign_t));
 	if (regassign == NULL)
 		return ENOMEM;
 
@@ -1901,7 +1947,7 @@ static int ast_regassign_print(ast_regassign_t *regassign, FILE *f)
  */
 static void ast_regassign_destroy(ast_regassign_t *regassign)
 {
-	free(regassign);
+	alloc_free(regassign);
 }
 
 /** Get first token of AST register assignment.
@@ -1934,7 +1980,7 @@ int ast_aslist_create(ast_aslist_t **raslist)
 {
 	ast_aslist_t *aslist;
 
-	aslist = calloc(1, sizeof(ast_aslist_t));
+	aslist = ast_alloc(sizeof(ast_aslist_t));
 	if (aslist == NULL)
 		return ENOMEM;
 
@@ -2085,7 +2131,7 @@ static void ast_aslist_destroy(ast_aslist_t *aslist)
 		aspec = ast_aslist_first(aslist);
 	}
 
-	free(aslist);
+	alloc_free(aslist);
 }
 
 /** Get first token of AST attribute specifier list.
@@ -2130,7 +2176,7 @@ int ast_aspec_create(ast_aspec_t **raspec)
 {
 	ast_aspec_t *aspec;
 
-	aspec = calloc(1, sizeof(ast_aspec_t));
+	aspec = ast_alloc(sizeof(ast_aspec_t));
 	if (aspec == NULL)
 		return ENOMEM;
 
@@ -2291,7 +2337,7 @@ static void ast_aspec_destroy(ast_aspec_t *aspec)
 		attr = ast_aspec_first(aspec);
 	}
 
-	free(aspec);
+	alloc_free(aspec);
 }
 
 /** Get first token of AST attribute specifier.
@@ -2323,7 +2369,7 @@ int ast_aspec_attr_create(ast_aspec_attr_t **rattr)
 {
 	ast_aspec_attr_t *attr;
 
-	attr = calloc(1, sizeof(ast_aspec_attr_t));
+	attr = ast_alloc(sizeof(ast_aspec_attr_t));
 	if (attr == NULL)
 		return ENOMEM;
 
@@ -2349,11 +2395,11 @@ void ast_aspec_attr_destroy(ast_aspec_attr_t *attr)
 	while (param != NULL) {
 		list_remove(&param->lattr);
 		ast_tree_destroy(param->expr);
-		free(param);
+		alloc_free(param);
 		param = ast_aspec_attr_first(attr);
 	}
 
-	free(attr);
+	alloc_free(attr);
 }
 
 /** Append parameter to attribute.
@@ -2369,7 +2415,7 @@ int ast_aspec_attr_append(ast_aspec_attr_t *attr, ast_node_t *expr,
 {
 	ast_aspec_param_t *param;
 
-	param = calloc(1, sizeof(ast_aspec_param_t));
+	param = ast_alloc(sizeof(ast_aspec_param_t));
 	if (param == NULL)
 		return ENOMEM;
 
@@ -2456,7 +2502,7 @@ int ast_malist_create(ast_malist_t **rmalist)
 {
 	ast_malist_t *malist;
 
-	malist = calloc(1, sizeof(ast_malist_t));
+	malist = ast_alloc(sizeof(ast_malist_t));
 	if (malist == NULL)
 		return ENOMEM;
 
@@ -2607,7 +2653,7 @@ static void ast_malist_destroy(ast_malist_t *malist)
 		mattr = ast_malist_first(malist);
 	}
 
-	free(malist);
+	alloc_free(malist);
 }
 
 /** Get first token of AST macro attribute list.
@@ -2652,7 +2698,7 @@ int ast_mattr_create(ast_mattr_t **rmattr)
 {
 	ast_mattr_t *mattr;
 
-	mattr = calloc(1, sizeof(ast_mattr_t));
+	mattr = ast_alloc(sizeof(ast_mattr_t));
 	if (mattr == NULL)
 		return ENOMEM;
 
@@ -2675,7 +2721,7 @@ int ast_mattr_append(ast_mattr_t *mattr, ast_node_t *expr, void *dcomma)
 {
 	ast_mattr_param_t *param;
 
-	param = calloc(1, sizeof(ast_mattr_param_t));
+	param = ast_alloc(sizeof(ast_mattr_param_t));
 	if (param == NULL)
 		return ENOMEM;
 
@@ -2803,12 +2849,12 @@ static void ast_mattr_destroy(ast_mattr_t *mattr)
 	while (param != NULL) {
 		list_remove(&param->lparams);
 		ast_tree_destroy(param->expr);
-		free(param);
+		alloc_free(param);
 
 		param = ast_mattr_first(mattr);
 	}
 
-	free(mattr);
+	alloc_free(mattr);
 }
 
 /** Get first token of AST macro attribute.
@@ -2841,7 +2887,7 @@ int ast_sqlist_create(ast_sqlist_t **rsqlist)
 {
 	ast_sqlist_t *sqlist;
 
-	sqlist = calloc(1, sizeof(ast_sqlist_t));
+	sqlist = ast_alloc(sizeof(ast_sqlist_t));
 	if (sqlist == NULL)
 		return ENOMEM;
 
@@ -2985,7 +3031,7 @@ static void ast_sqlist_destroy(ast_sqlist_t *sqlist)
 		elem = ast_sqlist_first(sqlist);
 	}
 
-	free(sqlist);
+	alloc_free(sqlist);
 }
 
 /** Get first token of AST specifier-qualifier list.
@@ -3038,7 +3084,7 @@ int ast_tqlist_create(ast_tqlist_t **rtqlist)
 {
 	ast_tqlist_t *tqlist;
 
-	tqlist = calloc(1, sizeof(ast_tqlist_t));
+	tqlist = ast_alloc(sizeof(ast_tqlist_t));
 	if (tqlist == NULL)
 		return ENOMEM;
 
@@ -3182,7 +3228,7 @@ static void ast_tqlist_destroy(ast_tqlist_t *tqlist)
 		elem = ast_tqlist_first(tqlist);
 	}
 
-	free(tqlist);
+	alloc_free(tqlist);
 }
 
 /** Get first token of AST type qualifier list.
@@ -3215,7 +3261,7 @@ int ast_dspecs_create(ast_dspecs_t **rdspecs)
 {
 	ast_dspecs_t *dspecs;
 
-	dspecs = calloc(1, sizeof(ast_dspecs_t));
+	dspecs = ast_alloc(sizeof(ast_dspecs_t));
 	if (dspecs == NULL)
 		return ENOMEM;
 
@@ -3382,7 +3428,7 @@ static void ast_dspecs_destroy(ast_dspecs_t *dspecs)
 		elem = ast_dspecs_first(dspecs);
 	}
 
-	free(dspecs);
+	alloc_free(dspecs);
 }
 
 /** Get first token of AST declaration specifiers.
@@ -3415,7 +3461,7 @@ int ast_dident_create(ast_dident_t **rdident)
 {
 	ast_dident_t *adident;
 
-	adident = calloc(1, sizeof(ast_dident_t));
+	adident = ast_alloc(sizeof(ast_dident_t));
 	if (adident == NULL)
 		return ENOMEM;
 
@@ -3449,7 +3495,7 @@ static int ast_dident_print(ast_dident_t *adident, FILE *f)
  */
 static void ast_dident_destroy(ast_dident_t *adident)
 {
-	free(adident);
+	alloc_free(adident);
 }
 
 /** Get first token of AST identifier declarator.
@@ -3482,7 +3528,7 @@ int ast_dnoident_create(ast_dnoident_t **rdnoident)
 {
 	ast_dnoident_t *adnoident;
 
-	adnoident = calloc(1, sizeof(ast_dnoident_t));
+	adnoident = ast_alloc(sizeof(ast_dnoident_t));
 	if (adnoident == NULL)
 		return ENOMEM;
 
@@ -3516,7 +3562,7 @@ static int ast_dnoident_print(ast_dnoident_t *adnoident, FILE *f)
  */
 static void ast_dnoident_destroy(ast_dnoident_t *adnoident)
 {
-	free(adnoident);
+	alloc_free(adnoident);
 }
 
 /** Get first token of AST no-identifier declarator.
@@ -3551,7 +3597,7 @@ int ast_dparen_create(ast_dparen_t **rdparen)
 {
 	ast_dparen_t *adparen;
 
-	adparen = calloc(1, sizeof(ast_dparen_t));
+	adparen = ast_alloc(sizeof(ast_dparen_t));
 	if (adparen == NULL)
 		return ENOMEM;
 
@@ -3590,7 +3636,7 @@ static int ast_dparen_print(ast_dparen_t *adparen, FILE *f)
 static void ast_dparen_destroy(ast_dparen_t *adparen)
 {
 	ast_tree_destroy(adparen->bdecl);
-	free(adparen);
+	alloc_free(adparen);
 }
 
 /** Get first token of AST parenthesized declarator.
@@ -3623,7 +3669,7 @@ int ast_dptr_create(ast_dptr_t **rdptr)
 {
 	ast_dptr_t *adptr;
 
-	adptr = calloc(1, sizeof(ast_dptr_t));
+	adptr = ast_alloc(sizeof(ast_dptr_t));
 	if (adptr == NULL)
 		return ENOMEM;
 
@@ -3668,7 +3714,7 @@ static void ast_dptr_destroy(ast_dptr_t *adptr)
 {
 	ast_tqlist_destroy(adptr->tqlist);
 	ast_tree_destroy(adptr->bdecl);
-	free(adptr);
+	alloc_free(adptr);
 }
 
 /** Get first token of AST pointer declarator.
@@ -3707,7 +3753,7 @@ int ast_dfun_create(ast_dfun_t **rdfun)
 {
 	ast_dfun_t *dfun;
 
-	dfun = calloc(1, sizeof(ast_dfun_t));
+	dfun = ast_alloc(sizeof(ast_dfun_t));
 	if (dfun == NULL)
 		return ENOMEM;
 
@@ -3734,7 +3780,7 @@ int ast_dfun_append(ast_dfun_t *dfun, ast_dspecs_t *dspecs, ast_node_t *decl,
 {
 	ast_dfun_arg_t *arg;
 
-	arg = calloc(1, sizeof(ast_dfun_arg_t));
+	arg = ast_alloc(sizeof(ast_dfun_arg_t));
 	if (arg == NULL)
 		return ENOMEM;
 
@@ -3847,12 +3893,12 @@ static void ast_dfun_destroy(ast_dfun_t *dfun)
 		ast_dspecs_destroy(arg->dspecs);
 		ast_aslist_destroy(arg->aslist);
 		ast_tree_destroy(arg->decl);
-		free(arg);
+		alloc_free(arg);
 
 		arg = ast_dfun_first(dfun);
 	}
 
-	free(dfun);
+	alloc_free(dfun);
 }
 
 /** Get first token of AST function declarator.
@@ -3891,7 +3937,7 @@ int ast_darray_create(ast_darray_t **rdarray)
 {
 	ast_darray_t *darray;
 
-	darray = calloc(1, sizeof(ast_darray_t));
+	darray = ast_alloc(sizeof(ast_darray_t));
 	if (darray == NULL)
 		return ENOMEM;
 
@@ -3934,7 +3980,7 @@ static void ast_darray_destroy(ast_darray_t *darray)
 {
 	ast_tree_destroy(darray->bdecl);
 	ast_tree_destroy(darray->asize);
-	free(darray);
+	alloc_free(darray);
 }
 
 /** Get first token of AST array declarator.
@@ -3973,7 +4019,7 @@ int ast_dlist_create(ast_dlist_t **rdlist)
 {
 	ast_dlist_t *dlist;
 
-	dlist = calloc(1, sizeof(ast_dlist_t));
+	dlist = ast_alloc(sizeof(ast_dlist_t));
 	if (dlist == NULL)
 		return ENOMEM;
 
@@ -4001,7 +4047,7 @@ int ast_dlist_append(ast_dlist_t *dlist, void *dcomma, ast_node_t *decl,
 {
 	ast_dlist_entry_t *entry;
 
-	entry = calloc(1, sizeof(ast_dlist_entry_t));
+	entry = ast_alloc(sizeof(ast_dlist_entry_t));
 	if (entry == NULL)
 		return ENOMEM;
 
@@ -4131,12 +4177,12 @@ static void ast_dlist_destroy(ast_dlist_t *dlist)
 		list_remove(&entry->ldlist);
 		ast_tree_destroy(entry->decl);
 		ast_tree_destroy(entry->bitwidth);
-		free(entry);
+		alloc_free(entry);
 
 		entry = ast_dlist_first(dlist);
 	}
 
-	free(dlist);
+	alloc_free(dlist);
 }
 
 /** Get first token of AST declarator list.
@@ -4198,7 +4244,7 @@ int ast_idlist_create(ast_idlist_t **ridlist)
 {
 	ast_idlist_t *idlist;
 
-	idlist = calloc(1, sizeof(ast_idlist_t));
+	idlist = ast_alloc(sizeof(ast_idlist_t));
 	if (idlist == NULL)
 		return ENOMEM;
 
@@ -4229,7 +4275,7 @@ int ast_idlist_append(ast_idlist_t *idlist, void *dcomma, ast_node_t *decl,
 {
 	ast_idlist_entry_t *entry;
 
-	entry = calloc(1, sizeof(ast_idlist_entry_t));
+	entry = ast_alloc(sizeof(ast_idlist_entry_t));
 	if (entry == NULL)
 		return ENOMEM;
 
@@ -4381,12 +4427,12 @@ static void ast_idlist_destroy(ast_idlist_t *idlist)
 		ast_regassign_destroy(entry->regassign);
 		ast_aslist_destroy(entry->aslist);
 		ast_tree_destroy(entry->init);
-		free(entry);
+		alloc_free(entry);
 
 		entry = ast_idlist_first(idlist);
 	}
 
-	free(idlist);
+	alloc_free(idlist);
 }
 
 /** Get first token of AST init-declarator list.
@@ -4448,7 +4494,7 @@ int ast_typename_create(ast_typename_t **rtypename)
 {
 	ast_typename_t *atypename;
 
-	atypename = calloc(1, sizeof(ast_typename_t));
+	atypename = ast_alloc(sizeof(ast_typename_t));
 	if (atypename == NULL)
 		return ENOMEM;
 
@@ -4499,7 +4545,7 @@ static void ast_typename_destroy(ast_typename_t *atypename)
 
 	ast_dspecs_destroy(atypename->dspecs);
 	ast_tree_destroy(atypename->decl);
-	free(atypename);
+	alloc_free(atypename);
 }
 
 /** Get first token of AST type name.
@@ -4629,7 +4675,7 @@ int ast_eint_create(ast_eint_t **reint)
 {
 	ast_eint_t *eint;
 
-	eint = calloc(1, sizeof(ast_eint_t));
+	eint = ast_alloc(sizeof(ast_eint_t));
 	if (eint == NULL)
 		return ENOMEM;
 
@@ -4664,7 +4710,7 @@ static int ast_eint_print(ast_eint_t *eint, FILE *f)
  */
 static void ast_eint_destroy(ast_eint_t *eint)
 {
-	free(eint);
+	alloc_free(eint);
 }
 
 /** Get first token of AST integer literal expression.
@@ -4697,7 +4743,7 @@ int ast_echar_create(ast_echar_t **rechar)
 {
 	ast_echar_t *echar;
 
-	echar = calloc(1, sizeof(ast_echar_t));
+	echar = ast_alloc(sizeof(ast_echar_t));
 	if (echar == NULL)
 		return ENOMEM;
 
@@ -4732,7 +4778,7 @@ static int ast_echar_print(ast_echar_t *echar, FILE *f)
  */
 static void ast_echar_destroy(ast_echar_t *echar)
 {
-	free(echar);
+	alloc_free(echar);
 }
 
 /** Get first token of AST character literal expression.
@@ -4765,7 +4811,7 @@ int ast_estring_create(ast_estring_t **restring)
 {
 	ast_estring_t *estring;
 
-	estring = calloc(1, sizeof(ast_estring_t));
+	estring = ast_alloc(sizeof(ast_estring_t));
 	if (estring == NULL)
 		return ENOMEM;
 
@@ -4787,7 +4833,7 @@ int ast_estring_append(ast_estring_t *estring, void *dlit)
 {
 	ast_estring_lit_t *lit;
 
-	lit = calloc(1, sizeof(ast_estring_lit_t));
+	lit = ast_alloc(sizeof(ast_estring_lit_t));
 	if (lit == NULL)
 		return ENOMEM;
 
@@ -4890,11 +4936,11 @@ static void ast_estring_destroy(ast_estring_t *estring)
 	lit = ast_estring_first(estring);
 	while (lit != NULL) {
 		list_remove(&lit->lstring);
-		free(lit);
+		alloc_free(lit);
 		lit = ast_estring_first(estring);
 	}
 
-	free(estring);
+	alloc_free(estring);
 }
 
 /** Get first token of AST string literal expression.
@@ -4933,7 +4979,7 @@ int ast_eident_create(ast_eident_t **reident)
 {
 	ast_eident_t *eident;
 
-	eident = calloc(1, sizeof(ast_eident_t));
+	eident = ast_alloc(sizeof(ast_eident_t));
 	if (eident == NULL)
 		return ENOMEM;
 
@@ -4967,7 +5013,7 @@ static int ast_eident_print(ast_eident_t *eident, FILE *f)
  */
 static void ast_eident_destroy(ast_eident_t *eident)
 {
-	free(eident);
+	alloc_free(eident);
 }
 
 /** Get first token of AST identifier expression.
@@ -5000,7 +5046,7 @@ int ast_eparen_create(ast_eparen_t **reparen)
 {
 	ast_eparen_t *eparen;
 
-	eparen = calloc(1, sizeof(ast_eparen_t));
+	eparen = ast_alloc(sizeof(ast_eparen_t));
 	if (eparen == NULL)
 		return ENOMEM;
 
@@ -5043,7 +5089,7 @@ static int ast_eparen_print(ast_eparen_t *eparen, FILE *f)
 static void ast_eparen_destroy(ast_eparen_t *eparen)
 {
 	ast_tree_destroy(eparen->bexpr);
-	free(eparen);
+	alloc_free(eparen);
 }
 
 /** Get first token of AST parenthesized expression.
@@ -5076,7 +5122,7 @@ int ast_econcat_create(ast_econcat_t **reconcat)
 {
 	ast_econcat_t *econcat;
 
-	econcat = calloc(1, sizeof(ast_econcat_t));
+	econcat = ast_alloc(sizeof(ast_econcat_t));
 	if (econcat == NULL)
 		return ENOMEM;
 
@@ -5098,7 +5144,7 @@ int ast_econcat_append(ast_econcat_t *econcat, ast_node_t *bexpr)
 {
 	ast_econcat_elem_t *elem;
 
-	elem = calloc(1, sizeof(ast_econcat_elem_t));
+	elem = ast_alloc(sizeof(ast_econcat_elem_t));
 	if (elem == NULL)
 		return ENOMEM;
 
@@ -5202,11 +5248,11 @@ static void ast_econcat_destroy(ast_econcat_t *econcat)
 	while (elem != NULL) {
 		list_remove(&elem->lelems);
 		ast_tree_destroy(elem->bexpr);
-		free(elem);
+		alloc_free(elem);
 		elem = ast_econcat_first(econcat);
 	}
 
-	free(econcat);
+	alloc_free(econcat);
 }
 
 /** Get first token of AST concatenation expression.
@@ -5245,7 +5291,7 @@ int ast_ebinop_create(ast_ebinop_t **rebinop)
 {
 	ast_ebinop_t *ebinop;
 
-	ebinop = calloc(1, sizeof(ast_ebinop_t));
+	ebinop = ast_alloc(sizeof(ast_ebinop_t));
 	if (ebinop == NULL)
 		return ENOMEM;
 
@@ -5296,7 +5342,7 @@ static void ast_ebinop_destroy(ast_ebinop_t *ebinop)
 {
 	ast_tree_destroy(ebinop->larg);
 	ast_tree_destroy(ebinop->rarg);
-	free(ebinop);
+	alloc_free(ebinop);
 }
 
 /** Get first token of AST binary operator expression.
@@ -5329,7 +5375,7 @@ int ast_etcond_create(ast_etcond_t **retcond)
 {
 	ast_etcond_t *etcond;
 
-	etcond = calloc(1, sizeof(ast_etcond_t));
+	etcond = ast_alloc(sizeof(ast_etcond_t));
 	if (etcond == NULL)
 		return ENOMEM;
 
@@ -5389,7 +5435,7 @@ static void ast_etcond_destroy(ast_etcond_t *etcond)
 	ast_tree_destroy(etcond->cond);
 	ast_tree_destroy(etcond->targ);
 	ast_tree_destroy(etcond->farg);
-	free(etcond);
+	alloc_free(etcond);
 }
 
 /** Get first token of AST ternary conditional expression.
@@ -5422,7 +5468,7 @@ int ast_ecomma_create(ast_ecomma_t **recomma)
 {
 	ast_ecomma_t *ecomma;
 
-	ecomma = calloc(1, sizeof(ast_ecomma_t));
+	ecomma = ast_alloc(sizeof(ast_ecomma_t));
 	if (ecomma == NULL)
 		return ENOMEM;
 
@@ -5473,7 +5519,7 @@ static void ast_ecomma_destroy(ast_ecomma_t *ecomma)
 {
 	ast_tree_destroy(ecomma->larg);
 	ast_tree_destroy(ecomma->rarg);
-	free(ecomma);
+	alloc_free(ecomma);
 }
 
 /** Get first token of AST comma expression.
@@ -5506,7 +5552,7 @@ int ast_ecall_create(ast_ecall_t **recall)
 {
 	ast_ecall_t *ecall;
 
-	ecall = calloc(1, sizeof(ast_ecall_t));
+	ecall = ast_alloc(sizeof(ast_ecall_t));
 	if (ecall == NULL)
 		return ENOMEM;
 
@@ -5529,7 +5575,7 @@ int ast_ecall_append(ast_ecall_t *ecall, void *dcomma, ast_node_t *arg)
 {
 	ast_ecall_arg_t *earg;
 
-	earg = calloc(1, sizeof(ast_ecall_arg_t));
+	earg = ast_alloc(sizeof(ast_ecall_arg_t));
 	if (earg == NULL)
 		return ENOMEM;
 
@@ -5626,12 +5672,12 @@ static void ast_ecall_destroy(ast_ecall_t *ecall)
 	while (arg != NULL) {
 		list_remove(&arg->lcall);
 		ast_tree_destroy(arg->arg);
-		free(arg);
+		alloc_free(arg);
 
 		arg = ast_ecall_first(ecall);
 	}
 
-	free(ecall);
+	alloc_free(ecall);
 }
 
 /** Get first token of AST call expression.
@@ -5664,7 +5710,7 @@ int ast_eindex_create(ast_eindex_t **reindex)
 {
 	ast_eindex_t *eindex;
 
-	eindex = calloc(1, sizeof(ast_eindex_t));
+	eindex = ast_alloc(sizeof(ast_eindex_t));
 	if (eindex == NULL)
 		return ENOMEM;
 
@@ -5715,7 +5761,7 @@ static void ast_eindex_destroy(ast_eindex_t *eindex)
 {
 	ast_tree_destroy(eindex->bexpr);
 	ast_tree_destroy(eindex->iexpr);
-	free(eindex);
+	alloc_free(eindex);
 }
 
 /** Get first token of AST index expression.
@@ -5748,7 +5794,7 @@ int ast_ederef_create(ast_ederef_t **rederef)
 {
 	ast_ederef_t *ederef;
 
-	ederef = calloc(1, sizeof(ast_ederef_t));
+	ederef = ast_alloc(sizeof(ast_ederef_t));
 	if (ederef == NULL)
 		return ENOMEM;
 
@@ -5791,7 +5837,7 @@ static int ast_ederef_print(ast_ederef_t *ederef, FILE *f)
 static void ast_ederef_destroy(ast_ederef_t *ederef)
 {
 	ast_tree_destroy(ederef->bexpr);
-	free(ederef);
+	alloc_free(ederef);
 }
 
 /** Get first token of AST dereference expression.
@@ -5824,7 +5870,7 @@ int ast_eaddr_create(ast_eaddr_t **readdr)
 {
 	ast_eaddr_t *eaddr;
 
-	eaddr = calloc(1, sizeof(ast_eaddr_t));
+	eaddr = ast_alloc(sizeof(ast_eaddr_t));
 	if (eaddr == NULL)
 		return ENOMEM;
 
@@ -5867,7 +5913,7 @@ static int ast_eaddr_print(ast_eaddr_t *eaddr, FILE *f)
 static void ast_eaddr_destroy(ast_eaddr_t *eaddr)
 {
 	ast_tree_destroy(eaddr->bexpr);
-	free(eaddr);
+	alloc_free(eaddr);
 }
 
 /** Get first token of AST address expression.
@@ -5900,7 +5946,7 @@ int ast_esizeof_create(ast_esizeof_t **resizeof)
 {
 	ast_esizeof_t *esizeof;
 
-	esizeof = calloc(1, sizeof(ast_esizeof_t));
+	esizeof = ast_alloc(sizeof(ast_esizeof_t));
 	if (esizeof == NULL)
 		return ENOMEM;
 
@@ -5952,7 +5998,7 @@ static void ast_esizeof_destroy(ast_esizeof_t *esizeof)
 {
 	ast_tree_destroy(esizeof->bexpr);
 	ast_typename_destroy(esizeof->atypename);
-	free(esizeof);
+	alloc_free(esizeof);
 }
 
 /** Get first token of AST sizeof expression.
@@ -5985,7 +6031,7 @@ int ast_ecast_create(ast_ecast_t **recast)
 {
 	ast_ecast_t *ecast;
 
-	ecast = calloc(1, sizeof(ast_ecast_t));
+	ecast = ast_alloc(sizeof(ast_ecast_t));
 	if (ecast == NULL)
 		return ENOMEM;
 
@@ -6030,7 +6076,7 @@ static void ast_ecast_destroy(ast_ecast_t *ecast)
 	ast_dspecs_destroy(ecast->dspecs);
 	ast_tree_destroy(ecast->decl);
 	ast_tree_destroy(ecast->bexpr);
-	free(ecast);
+	alloc_free(ecast);
 }
 
 /** Get first token of AST cast expression.
@@ -6063,7 +6109,7 @@ int ast_ecliteral_create(ast_ecliteral_t **recliteral)
 {
 	ast_ecliteral_t *ecliteral;
 
-	ecliteral = calloc(1, sizeof(ast_ecliteral_t));
+	ecliteral = ast_alloc(sizeof(ast_ecliteral_t));
 	if (ecliteral == NULL)
 		return ENOMEM;
 
@@ -6108,7 +6154,7 @@ static void ast_ecliteral_destroy(ast_ecliteral_t *ecliteral)
 	ast_dspecs_destroy(ecliteral->dspecs);
 	ast_tree_destroy(ecliteral->decl);
 	ast_cinit_destroy(ecliteral->cinit);
-	free(ecliteral);
+	alloc_free(ecliteral);
 }
 
 /** Get first token of AST compound literal expression.
@@ -6141,7 +6187,7 @@ int ast_emember_create(ast_emember_t **remember)
 {
 	ast_emember_t *emember;
 
-	emember = calloc(1, sizeof(ast_emember_t));
+	emember = ast_alloc(sizeof(ast_emember_t));
 	if (emember == NULL)
 		return ENOMEM;
 
@@ -6184,7 +6230,7 @@ static int ast_emember_print(ast_emember_t *emember, FILE *f)
 static void ast_emember_destroy(ast_emember_t *emember)
 {
 	ast_tree_destroy(emember->bexpr);
-	free(emember);
+	alloc_free(emember);
 }
 
 /** Get first token of AST member expression.
@@ -6217,7 +6263,7 @@ int ast_eindmember_create(ast_eindmember_t **reindmember)
 {
 	ast_eindmember_t *eindmember;
 
-	eindmember = calloc(1, sizeof(ast_eindmember_t));
+	eindmember = ast_alloc(sizeof(ast_eindmember_t));
 	if (eindmember == NULL)
 		return ENOMEM;
 
@@ -6260,7 +6306,7 @@ static int ast_eindmember_print(ast_eindmember_t *eindmember, FILE *f)
 static void ast_eindmember_destroy(ast_eindmember_t *eindmember)
 {
 	ast_tree_destroy(eindmember->bexpr);
-	free(eindmember);
+	alloc_free(eindmember);
 }
 
 /** Get first token of AST indirect member expression.
@@ -6293,7 +6339,7 @@ int ast_eusign_create(ast_eusign_t **reusign)
 {
 	ast_eusign_t *eusign;
 
-	eusign = calloc(1, sizeof(ast_eusign_t));
+	eusign = ast_alloc(sizeof(ast_eusign_t));
 	if (eusign == NULL)
 		return ENOMEM;
 
@@ -6336,7 +6382,7 @@ static int ast_eusign_print(ast_eusign_t *eusign, FILE *f)
 static void ast_eusign_destroy(ast_eusign_t *eusign)
 {
 	ast_tree_destroy(eusign->bexpr);
-	free(eusign);
+	alloc_free(eusign);
 }
 
 /** Get first token of AST unary sign expression.
@@ -6369,7 +6415,7 @@ int ast_elnot_create(ast_elnot_t **relnot)
 {
 	ast_elnot_t *elnot;
 
-	elnot = calloc(1, sizeof(ast_elnot_t));
+	elnot = ast_alloc(sizeof(ast_elnot_t));
 	if (elnot == NULL)
 		return ENOMEM;
 
@@ -6413,7 +6459,7 @@ static void ast_elnot_destroy(ast_elnot_t *elnot)
 {
 	if (elnot != NULL)
 		ast_tree_destroy(elnot->bexpr);
-	free(elnot);
+	alloc_free(elnot);
 }
 
 /** Get first token of AST logical not expression.
@@ -6446,7 +6492,7 @@ int ast_ebnot_create(ast_ebnot_t **rebnot)
 {
 	ast_ebnot_t *ebnot;
 
-	ebnot = calloc(1, sizeof(ast_ebnot_t));
+	ebnot = ast_alloc(sizeof(ast_ebnot_t));
 	if (ebnot == NULL)
 		return ENOMEM;
 
@@ -6489,7 +6535,7 @@ static int ast_ebnot_print(ast_ebnot_t *ebnot, FILE *f)
 static void ast_ebnot_destroy(ast_ebnot_t *ebnot)
 {
 	ast_tree_destroy(ebnot->bexpr);
-	free(ebnot);
+	alloc_free(ebnot);
 }
 
 /** Get first token of AST bitwise not expression.
@@ -6522,7 +6568,7 @@ int ast_epreadj_create(ast_epreadj_t **repreadj)
 {
 	ast_epreadj_t *epreadj;
 
-	epreadj = calloc(1, sizeof(ast_epreadj_t));
+	epreadj = ast_alloc(sizeof(ast_epreadj_t));
 	if (epreadj == NULL)
 		return ENOMEM;
 
@@ -6565,7 +6611,7 @@ static int ast_epreadj_print(ast_epreadj_t *epreadj, FILE *f)
 static void ast_epreadj_destroy(ast_epreadj_t *epreadj)
 {
 	ast_tree_destroy(epreadj->bexpr);
-	free(epreadj);
+	alloc_free(epreadj);
 }
 
 /** Get first token of AST pre-adjustment expression.
@@ -6598,7 +6644,7 @@ int ast_epostadj_create(ast_epostadj_t **repostadj)
 {
 	ast_epostadj_t *epostadj;
 
-	epostadj = calloc(1, sizeof(ast_epostadj_t));
+	epostadj = ast_alloc(sizeof(ast_epostadj_t));
 	if (epostadj == NULL)
 		return ENOMEM;
 
@@ -6641,7 +6687,7 @@ static int ast_epostadj_print(ast_epostadj_t *epostadj, FILE *f)
 static void ast_epostadj_destroy(ast_epostadj_t *epostadj)
 {
 	ast_tree_destroy(epostadj->bexpr);
-	free(epostadj);
+	alloc_free(epostadj);
 }
 
 /** Get first token of AST pre-adjustment expression.
@@ -6674,7 +6720,7 @@ int ast_cinit_create(ast_cinit_t **rcinit)
 {
 	ast_cinit_t *cinit;
 
-	cinit = calloc(1, sizeof(ast_cinit_t));
+	cinit = ast_alloc(sizeof(ast_cinit_t));
 	if (cinit == NULL)
 		return ENOMEM;
 
@@ -6740,7 +6786,7 @@ int ast_cinit_elem_create(ast_cinit_elem_t **relem)
 {
 	ast_cinit_elem_t *elem;
 
-	elem = calloc(1, sizeof(ast_cinit_elem_t));
+	elem = ast_alloc(sizeof(ast_cinit_elem_t));
 	if (elem == NULL)
 		return ENOMEM;
 
@@ -6766,12 +6812,12 @@ void ast_cinit_elem_destroy(ast_cinit_elem_t *elem)
 		if (acc->atype == aca_index)
 			ast_tree_destroy(acc->index);
 		list_remove(&acc->laccs);
-		free(acc);
+		alloc_free(acc);
 		acc = ast_cinit_elem_first(elem);
 	}
 
 	ast_tree_destroy(elem->init);
-	free(elem);
+	alloc_free(elem);
 }
 
 /** Append index accessor to compound initializer element.
@@ -6788,7 +6834,7 @@ int ast_cinit_elem_append_index(ast_cinit_elem_t *elem, void *dlbracket,
 {
 	ast_cinit_acc_t *acc;
 
-	acc = calloc(1, sizeof(ast_cinit_acc_t));
+	acc = ast_alloc(sizeof(ast_cinit_acc_t));
 	if (acc == NULL)
 		return ENOMEM;
 
@@ -6815,7 +6861,7 @@ int ast_cinit_elem_append_member(ast_cinit_elem_t *elem, void *dperiod,
 {
 	ast_cinit_acc_t *acc;
 
-	acc = calloc(1, sizeof(ast_cinit_acc_t));
+	acc = ast_alloc(sizeof(ast_cinit_acc_t));
 	if (acc == NULL)
 		return ENOMEM;
 
@@ -6924,7 +6970,7 @@ static void ast_cinit_destroy(ast_cinit_t *cinit)
 		elem = ast_cinit_first(cinit);
 	}
 
-	free(cinit);
+	alloc_free(cinit);
 }
 
 /** Get first token of AST compound initializer.
@@ -6957,7 +7003,7 @@ int ast_asm_create(ast_asm_t **rasm)
 {
 	ast_asm_t *aasm;
 
-	aasm = calloc(1, sizeof(ast_asm_t));
+	aasm = ast_alloc(sizeof(ast_asm_t));
 	if (aasm == NULL)
 		return ENOMEM;
 
@@ -6993,7 +7039,7 @@ int ast_asm_append_out_op(ast_asm_t *aasm, bool have_symname, void *dlbracket,
 {
 	ast_asm_op_t *aop;
 
-	aop = calloc(1, sizeof(ast_asm_op_t));
+	aop = ast_alloc(sizeof(ast_asm_op_t));
 	if (aop == NULL)
 		return ENOMEM;
 
@@ -7035,7 +7081,7 @@ int ast_asm_append_in_op(ast_asm_t *aasm, bool have_symname, void *dlbracket,
 {
 	ast_asm_op_t *aop;
 
-	aop = calloc(1, sizeof(ast_asm_op_t));
+	aop = ast_alloc(sizeof(ast_asm_op_t));
 	if (aop == NULL)
 		return ENOMEM;
 
@@ -7068,7 +7114,7 @@ int ast_asm_append_clobber(ast_asm_t *aasm, void *dclobber, void *dcomma)
 {
 	ast_asm_clobber_t *aclobber;
 
-	aclobber = calloc(1, sizeof(ast_asm_clobber_t));
+	aclobber = ast_alloc(sizeof(ast_asm_clobber_t));
 	if (aclobber == NULL)
 		return ENOMEM;
 
@@ -7091,7 +7137,7 @@ int ast_asm_append_label(ast_asm_t *aasm, void *dlabel, void *dcomma)
 {
 	ast_asm_label_t *alabel;
 
-	alabel = calloc(1, sizeof(ast_asm_label_t));
+	alabel = ast_alloc(sizeof(ast_asm_label_t));
 	if (alabel == NULL)
 		return ENOMEM;
 
@@ -7338,7 +7384,7 @@ static void ast_asm_destroy(ast_asm_t *aasm)
 	while (out_op != NULL) {
 		list_remove(&out_op->lasm);
 		ast_tree_destroy(out_op->expr);
-		free(out_op);
+		alloc_free(out_op);
 		out_op = ast_asm_first_out_op(aasm);
 	}
 
@@ -7346,25 +7392,25 @@ static void ast_asm_destroy(ast_asm_t *aasm)
 	while (in_op != NULL) {
 		list_remove(&in_op->lasm);
 		ast_tree_destroy(in_op->expr);
-		free(in_op);
+		alloc_free(in_op);
 		in_op = ast_asm_first_in_op(aasm);
 	}
 
 	clobber = ast_asm_first_clobber(aasm);
 	while (clobber != NULL) {
 		list_remove(&clobber->lasm);
-		free(clobber);
+		alloc_free(clobber);
 		clobber = ast_asm_first_clobber(aasm);
 	}
 
 	label = ast_asm_first_label(aasm);
 	while (label != NULL) {
 		list_remove(&label->lasm);
-		free(label);
+		alloc_free(label);
 		label = ast_asm_first_label(aasm);
 	}
 
-	free(aasm);
+	alloc_free(aasm);
 }
 
 /** Get first token of AST enum type specifier.
@@ -7397,7 +7443,7 @@ int ast_break_create(ast_break_t **rbreak)
 {
 	ast_break_t *abreak;
 
-	abreak = calloc(1, sizeof(ast_break_t));
+	abreak = ast_alloc(sizeof(ast_break_t));
 	if (abreak == NULL)
 		return ENOMEM;
 
@@ -7431,7 +7477,7 @@ static int ast_break_print(ast_break_t *abreak, FILE *f)
  */
 static void ast_break_destroy(ast_break_t *abreak)
 {
-	free(abreak);
+	alloc_free(abreak);
 }
 
 /** Get first token of AST break.
@@ -7464,7 +7510,7 @@ int ast_continue_create(ast_continue_t **rcontinue)
 {
 	ast_continue_t *acontinue;
 
-	acontinue = calloc(1, sizeof(ast_continue_t));
+	acontinue = ast_alloc(sizeof(ast_continue_t));
 	if (acontinue == NULL)
 		return ENOMEM;
 
@@ -7498,7 +7544,7 @@ static int ast_continue_print(ast_continue_t *acontinue, FILE *f)
  */
 static void ast_continue_destroy(ast_continue_t *acontinue)
 {
-	free(acontinue);
+	alloc_free(acontinue);
 }
 
 /** Get first token of AST continue.
@@ -7531,7 +7577,7 @@ int ast_goto_create(ast_goto_t **rgoto)
 {
 	ast_goto_t *agoto;
 
-	agoto = calloc(1, sizeof(ast_goto_t));
+	agoto = ast_alloc(sizeof(ast_goto_t));
 	if (agoto == NULL)
 		return ENOMEM;
 
@@ -7565,7 +7611,7 @@ static int ast_goto_print(ast_goto_t *agoto, FILE *f)
  */
 static void ast_goto_destroy(ast_goto_t *agoto)
 {
-	free(agoto);
+	alloc_free(agoto);
 }
 
 /** Get first token of AST goto.
@@ -7598,7 +7644,7 @@ int ast_return_create(ast_return_t **rreturn)
 {
 	ast_return_t *areturn;
 
-	areturn = calloc(1, sizeof(ast_return_t));
+	areturn = ast_alloc(sizeof(ast_return_t));
 	if (areturn == NULL)
 		return ENOMEM;
 
@@ -7642,7 +7688,7 @@ static int ast_return_print(ast_return_t *areturn, FILE *f)
 static void ast_return_destroy(ast_return_t *areturn)
 {
 	ast_tree_destroy(areturn->arg);
-	free(areturn);
+	alloc_free(areturn);
 }
 
 /** Get first token of AST return.
@@ -7675,7 +7721,7 @@ int ast_if_create(ast_if_t **rif)
 {
 	ast_if_t *aif;
 
-	aif = calloc(1, sizeof(ast_if_t));
+	aif = ast_alloc(sizeof(ast_if_t));
 	if (aif == NULL)
 		return ENOMEM;
 
@@ -7702,7 +7748,7 @@ int ast_if_append(ast_if_t *aif, void *delse, void *dif, void *dlparen,
 {
 	ast_elseif_t *elseif;
 
-	elseif = calloc(1, sizeof(ast_elseif_t));
+	elseif = ast_alloc(sizeof(ast_elseif_t));
 	if (elseif == NULL)
 		return ENOMEM;
 
@@ -7801,12 +7847,12 @@ static void ast_if_destroy(ast_if_t *aif)
 		ast_tree_destroy(elseif->cond);
 		ast_block_destroy(elseif->ebranch);
 		list_remove(&elseif->lif);
-		free(elseif);
+		alloc_free(elseif);
 		elseif = ast_if_first(aif);
 	}
 
 	ast_block_destroy(aif->fbranch);
-	free(aif);
+	alloc_free(aif);
 }
 
 /** Get first token of AST if statement.
@@ -7842,7 +7888,7 @@ int ast_while_create(ast_while_t **rwhile)
 {
 	ast_while_t *awhile;
 
-	awhile = calloc(1, sizeof(ast_while_t));
+	awhile = ast_alloc(sizeof(ast_while_t));
 	if (awhile == NULL)
 		return ENOMEM;
 
@@ -7887,7 +7933,7 @@ static void ast_while_destroy(ast_while_t *awhile)
 {
 	ast_tree_destroy(awhile->cond);
 	ast_block_destroy(awhile->body);
-	free(awhile);
+	alloc_free(awhile);
 }
 
 /** Get first token of AST while loop statement.
@@ -7920,7 +7966,7 @@ int ast_do_create(ast_do_t **rdo)
 {
 	ast_do_t *ado;
 
-	ado = calloc(1, sizeof(ast_do_t));
+	ado = ast_alloc(sizeof(ast_do_t));
 	if (ado == NULL)
 		return ENOMEM;
 
@@ -7969,7 +8015,7 @@ static void ast_do_destroy(ast_do_t *ado)
 {
 	ast_block_destroy(ado->body);
 	ast_tree_destroy(ado->cond);
-	free(ado);
+	alloc_free(ado);
 }
 
 /** Get first token of AST do loop statement.
@@ -8002,7 +8048,7 @@ int ast_for_create(ast_for_t **rfor)
 {
 	ast_for_t *afor;
 
-	afor = calloc(1, sizeof(ast_for_t));
+	afor = ast_alloc(sizeof(ast_for_t));
 	if (afor == NULL)
 		return ENOMEM;
 
@@ -8073,7 +8119,7 @@ static void ast_for_destroy(ast_for_t *afor)
 	ast_tree_destroy(afor->lcond);
 	ast_tree_destroy(afor->lnext);
 	ast_block_destroy(afor->body);
-	free(afor);
+	alloc_free(afor);
 }
 
 /** Get first token of AST for statement.
@@ -8106,7 +8152,7 @@ int ast_switch_create(ast_switch_t **rswitch)
 {
 	ast_switch_t *aswitch;
 
-	aswitch = calloc(1, sizeof(ast_switch_t));
+	aswitch = ast_alloc(sizeof(ast_switch_t));
 	if (aswitch == NULL)
 		return ENOMEM;
 
@@ -8156,7 +8202,7 @@ static void ast_switch_destroy(ast_switch_t *aswitch)
 {
 	ast_tree_destroy(aswitch->sexpr);
 	ast_block_destroy(aswitch->body);
-	free(aswitch);
+	alloc_free(aswitch);
 }
 
 /** Get first token of AST switch statement.
@@ -8189,7 +8235,7 @@ int ast_clabel_create(ast_clabel_t **rclabel)
 {
 	ast_clabel_t *clabel;
 
-	clabel = calloc(1, sizeof(ast_clabel_t));
+	clabel = ast_alloc(sizeof(ast_clabel_t));
 	if (clabel == NULL)
 		return ENOMEM;
 
@@ -8224,7 +8270,7 @@ static int ast_clabel_print(ast_clabel_t *clabel, FILE *f)
 static void ast_clabel_destroy(ast_clabel_t *clabel)
 {
 	ast_tree_destroy(clabel->cexpr);
-	free(clabel);
+	alloc_free(clabel);
 }
 
 /** Get first token of AST case label.
@@ -8257,7 +8303,7 @@ int ast_glabel_create(ast_glabel_t **rglabel)
 {
 	ast_glabel_t *glabel;
 
-	glabel = calloc(1, sizeof(ast_glabel_t));
+	glabel = ast_alloc(sizeof(ast_glabel_t));
 	if (glabel == NULL)
 		return ENOMEM;
 
@@ -8291,7 +8337,7 @@ static int ast_glabel_print(ast_glabel_t *glabel, FILE *f)
  */
 static void ast_glabel_destroy(ast_glabel_t *glabel)
 {
-	free(glabel);
+	alloc_free(glabel);
 }
 
 /** Get first token of AST goto label.
@@ -8324,7 +8370,7 @@ int ast_stexpr_create(ast_stexpr_t **rstexpr)
 {
 	ast_stexpr_t *astexpr;
 
-	astexpr = calloc(1, sizeof(ast_stexpr_t));
+	astexpr = ast_alloc(sizeof(ast_stexpr_t));
 	if (astexpr == NULL)
 		return ENOMEM;
 
@@ -8363,7 +8409,7 @@ static int ast_stexpr_print(ast_stexpr_t *astexpr, FILE *f)
 static void ast_stexpr_destroy(ast_stexpr_t *astexpr)
 {
 	ast_tree_destroy(astexpr->expr);
-	free(astexpr);
+	alloc_free(astexpr);
 }
 
 /** Get first token of AST expression statement.
@@ -8396,7 +8442,7 @@ int ast_stdecln_create(ast_stdecln_t **rstdecln)
 {
 	ast_stdecln_t *stdecln;
 
-	stdecln = calloc(1, sizeof(ast_stdecln_t));
+	stdecln = ast_alloc(sizeof(ast_stdecln_t));
 	if (stdecln == NULL)
 		return ENOMEM;
 
@@ -8447,7 +8493,7 @@ static void ast_stdecln_destroy(ast_stdecln_t *stdecln)
 	ast_dspecs_destroy(stdecln->dspecs);
 	ast_idlist_destroy(stdecln->idlist);
 
-	free(stdecln);
+	alloc_free(stdecln);
 }
 
 /** Get first token of AST declaration statement.
@@ -8480,7 +8526,7 @@ int ast_stnull_create(ast_stnull_t **rstnull)
 {
 	ast_stnull_t *astnull;
 
-	astnull = calloc(1, sizeof(ast_stnull_t));
+	astnull = ast_alloc(sizeof(ast_stnull_t));
 	if (astnull == NULL)
 		return ENOMEM;
 
@@ -8513,7 +8559,7 @@ static int ast_stnull_print(ast_stnull_t *astnull, FILE *f)
  */
 static void ast_stnull_destroy(ast_stnull_t *astnull)
 {
-	free(astnull);
+	alloc_free(astnull);
 }
 
 /** Get first token of AST null statement.
@@ -8546,7 +8592,7 @@ int ast_lmacro_create(ast_lmacro_t **rlmacro)
 {
 	ast_lmacro_t *lmacro;
 
-	lmacro = calloc(1, sizeof(ast_lmacro_t));
+	lmacro = ast_alloc(sizeof(ast_lmacro_t));
 	if (lmacro == NULL)
 		return ENOMEM;
 
@@ -8597,7 +8643,7 @@ static void ast_lmacro_destroy(ast_lmacro_t *lmacro)
 	ast_tree_destroy(lmacro->expr);
 	ast_block_destroy(lmacro->body);
 
-	free(lmacro);
+	alloc_free(lmacro);
 }
 
 /** Get first token of AST loop macro invocation.
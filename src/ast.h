@@ -33,6 +33,9 @@
 
 extern int ast_module_create(ast_module_t **);
 extern void ast_module_append(ast_module_t *, ast_node_t *);
+extern void ast_module_insert_before(ast_module_t *, ast_node_t *,
+    ast_node_t *);
+extern void ast_module_remove(ast_node_t *);
 extern ast_node_t *ast_module_first(ast_module_t *);
 extern ast_node_t *ast_module_next(ast_node_t *);
 extern ast_node_t *ast_module_last(ast_module_t *);
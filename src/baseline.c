@@ -0,0 +1,495 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Baseline of known issues
+ *
+ * A baseline records a fingerprint of each issue found in a source tree
+ * so that later checks can report new issues only. The fingerprint
+ * computed by the checker does not depend on the position of the issue.
+ * It is combined with the file name and the number of preceding issues
+ * in the same file with the same fingerprint (so that adding another
+ * copy of an existing issue is still reported).
+ *
+ * The baseline file is a hash table with open addressing (linear
+ * probing) which is mapped into memory, so that it need not be parsed
+ * and each lookup takes constant time. It consists of a header (magic
+ * 'CCKB', 32-bit format version, 64-bit number of slots, 64-bit number
+ * of fingerprints, 64 reserved bits) followed by the slots. Each slot
+ * holds a 64-bit fingerprint or zero if it is empty. All integers are
+ * little-endian. At most half of the slots are used.
+ */
+
+#include <baseline.h>
+#include <diag.h>
+#include <fcntl.h>
+#include <hash.h>
+#include <merrno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum {
+	/** Baseline file format version */
+	baseline_version = 1,
+	/** Size of baseline file header */
+	baseline_hdr_size = 32,
+	/** Minimum number of slots */
+	baseline_min_slots = 16,
+	/** Initial number of entries allocated in a baseline writer */
+	baseline_wr_init_alloc = 1024
+};
+
+/** Baseline file magic */
+static const char baseline_magic[4] = { 'C', 'C', 'K', 'B' };
+
+/** Decode little-endian unsigned integer.
+ *
+ * @param bp Pointer to encoded integer
+ * @param nbytes Number of bytes
+ * @return Decoded integer
+ */
+static uint64_t baseline_get_uint(const uint8_t *bp, unsigned nbytes)
+{
+	uint64_t val = 0;
+	unsigned i;
+
+	for (i = 0; i < nbytes; i++)
+		val |= (uint64_t) bp[i] << (8 * i);
+
+	return val;
+}
+
+/** Encode little-endian unsigned integer.
+ *
+ * @param bp Pointer to buffer
+ * @param val Integer
+ * @param nbytes Number of bytes
+ */
+static void baseline_put_uint(uint8_t *bp, uint64_t val, unsigned nbytes)
+{
+	unsigned i;
+
+	for (i = 0; i < nbytes; i++)
+		bp[i] = (uint8_t) (val >> (8 * i));
+}
+
+/** Compute baseline fingerprints of a file's issues.
+ *
+ * @param list Diagnostic list (sorted by position)
+ * @param fps Array of @c list->ndiags entries to store fingerprints in
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int baseline_diag_fps(diag_list_t *list, uint64_t *fps)
+{
+	uint64_t *key;
+	size_t *count;
+	size_t nslots;
+	size_t i, j;
+	const char *fname;
+	uint64_t occ;
+	uint64_t hash;
+
+	if (list->ndiags == 0)
+		return EOK;
+
+	nslots = baseline_min_slots;
+	while (nslots < 2 * list->ndiags)
+		nslots *= 2;
+
+	key = calloc(nslots, sizeof(uint64_t));
+	count = calloc(nslots, sizeof(size_t));
+	if (key == NULL || count == NULL) {
+		free(key);
+		free(count);
+		return ENOMEM;
+	}
+
+	fname = list->fname;
+	while (fname[0] == '.' && fname[1] == '/')
+		fname += 2;
+
+	for (i = 0; i < list->ndiags; i++) {
+		/* Count preceding issues with the same fingerprint */
+		j = list->diag[i].fp & (nslots - 1);
+		while (count[j] != 0 && key[j] != list->diag[i].fp)
+			j = (j + 1) & (nslots - 1);
+
+		key[j] = list->diag[i].fp;
+		occ = count[j]++;
+
+		hash = hash_fnv(HASH_FNV_BASIS, &list->diag[i].fp,
+		    sizeof(uint64_t));
+		hash = hash_fnv(hash, fname, strlen(fname) + 1);
+		hash = hash_fnv(hash, &occ, sizeof(occ));
+
+		/* Zero marks an empty slot */
+		fps[i] = hash != 0 ? hash : 1;
+	}
+
+	free(key);
+	free(count);
+	return EOK;
+}
+
+/** Open baseline file.
+ *
+ * @param path Path to baseline file
+ * @param rbaseline Place to store pointer to new baseline
+ * @return EOK on success, ENOENT if the file does not exist, EINVAL
+ *         if it is not a valid baseline file, EIO on I/O error,
+ *         ENOMEM if out of memory
+ */
+int baseline_open(const char *path, baseline_t **rbaseline)
+{
+	baseline_t *baseline;
+	struct stat st;
+	const uint8_t *hdr;
+	int fd;
+	int rc;
+
+	baseline = calloc(1, sizeof(baseline_t));
+	if (baseline == NULL)
+		return ENOMEM;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		rc = errno == ENOENT ? ENOENT : EIO;
+		goto error;
+	}
+
+	if (fstat(fd, &st) < 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	if (st.st_size < baseline_hdr_size) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	baseline->map_size = st.st_size;
+	baseline->map = mmap(NULL, baseline->map_size, PROT_READ, MAP_PRIVATE,
+	    fd, 0);
+	if (baseline->map == MAP_FAILED) {
+		baseline->map = NULL;
+		rc = EIO;
+		goto error;
+	}
+
+	close(fd);
+	fd = -1;
+
+	hdr = (const uint8_t *) baseline->map;
+	baseline->nslots = baseline_get_uint(hdr + 8, 8);
+	baseline->nentries = baseline_get_uint(hdr + 16, 8);
+	baseline->slots = hdr + baseline_hdr_size;
+
+	if (memcmp(hdr, baseline_magic, 4) != 0 ||
+	    baseline_get_uint(hdr + 4, 4) != baseline_version ||
+	    baseline->nslots < baseline_min_slots ||
+	    (baseline->nslots & (baseline->nslots - 1)) != 0 ||
+	    baseline->nslots > (SIZE_MAX - baseline_hdr_size) / 8 ||
+	    baseline->map_size != baseline_hdr_size + baseline->nslots * 8 ||
+	    baseline->nentries > baseline->nslots / 2) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	*rbaseline = baseline;
+	return EOK;
+error:
+	if (fd >= 0)
+		close(fd);
+	baseline_close(baseline);
+	return rc;
+}
+
+/** Close baseline.
+ *
+ * @param baseline Baseline or @c NULL
+ */
+void baseline_close(baseline_t *baseline)
+{
+	if (baseline == NULL)
+		return;
+
+	if (baseline->map != NULL)
+		munmap(baseline->map, baseline->map_size);
+	free(baseline);
+}
+
+/** Determine if baseline contains fingerprint.
+ *
+ * @param baseline Baseline
+ * @param fp Fingerprint (non-zero)
+ * @return @c true iff @a fp is in the baseline
+ */
+bool baseline_contains(baseline_t *baseline, uint64_t fp)
+{
+	uint64_t mask = baseline->nslots - 1;
+	uint64_t i;
+	uint64_t n;
+	uint64_t val;
+
+	/* A corrupted file need not have any empty slot */
+	i = fp & mask;
+	for (n = 0; n < baseline->nslots; n++) {
+		val = baseline_get_uint(baseline->slots + 8 * i, 8);
+		if (val == fp)
+			return true;
+		if (val == 0)
+			return false;
+		i = (i + 1) & mask;
+	}
+
+	return false;
+}
+
+/** Remove issues contained in baseline from a diagnostic list.
+ *
+ * @param baseline Baseline
+ * @param list Diagnostic list (sorted by position)
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int baseline_filter(baseline_t *baseline, diag_list_t *list)
+{
+	uint64_t *fps;
+	size_t i, n;
+	int rc;
+
+	if (list->ndiags == 0)
+		return EOK;
+
+	fps = calloc(list->ndiags, sizeof(uint64_t));
+	if (fps == NULL)
+		return ENOMEM;
+
+	rc = baseline_diag_fps(list, fps);
+	if (rc != EOK) {
+		free(fps);
+		return rc;
+	}
+
+	n = 0;
+	for (i = 0; i < list->ndiags; i++) {
+		if (baseline_contains(baseline, fps[i]))
+			diag_free_strs(&list->diag[i]);
+		else
+			list->diag[n++] = list->diag[i];
+	}
+
+	list->ndiags = n;
+	free(fps);
+	return EOK;
+}
+
+/** Create baseline writer.
+ *
+ * @param rwr Place to store pointer to new baseline writer
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int baseline_wr_create(baseline_wr_t **rwr)
+{
+	baseline_wr_t *wr;
+
+	wr = calloc(1, sizeof(baseline_wr_t));
+	if (wr == NULL)
+		return ENOMEM;
+
+	pthread_mutex_init(&wr->lock, NULL);
+	*rwr = wr;
+	return EOK;
+}
+
+/** Destroy baseline writer.
+ *
+ * @param wr Baseline writer or @c NULL
+ */
+void baseline_wr_destroy(baseline_wr_t *wr)
+{
+	if (wr == NULL)
+		return;
+
+	pthread_mutex_destroy(&wr->lock);
+	free(wr->fp);
+	free(wr);
+}
+
+/** Add issues to baseline writer.
+ *
+ * This can be called from multiple threads simultaneously.
+ *
+ * @param wr Baseline writer
+ * @param list Diagnostic list (sorted by position)
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int baseline_wr_add(baseline_wr_t *wr, diag_list_t *list)
+{
+	uint64_t *fps;
+	uint64_t *nfp;
+	size_t nalloc;
+	int rc;
+
+	if (list->ndiags == 0)
+		return EOK;
+
+	fps = calloc(list->ndiags, sizeof(uint64_t));
+	if (fps == NULL)
+		return ENOMEM;
+
+	rc = baseline_diag_fps(list, fps);
+	if (rc != EOK)
+		goto out;
+
+	pthread_mutex_lock(&wr->lock);
+
+	if (wr->nfps + list->ndiags > wr->alloc) {
+		nalloc = wr->alloc != 0 ? wr->alloc : baseline_wr_init_alloc;
+		while (nalloc < wr->nfps + list->ndiags)
+			nalloc *= 2;
+
+		nfp = realloc(wr->fp, nalloc * sizeof(uint64_t));
+		if (nfp == NULL) {
+			pthread_mutex_unlock(&wr->lock);
+			rc = ENOMEM;
+			goto out;
+		}
+
+		wr->fp = nfp;
+		wr->alloc = nalloc;
+	}
+
+	memcpy(wr->fp + wr->nfps, fps, list->ndiags * sizeof(uint64_t));
+	wr->nfps += list->ndiags;
+
+	pthread_mutex_unlock(&wr->lock);
+	rc = EOK;
+out:
+	free(fps);
+	return rc;
+}
+
+/** Write baseline file.
+ *
+ * The file is written under a temporary name first and then renamed,
+ * so that a baseline being used by another check is never truncated.
+ *
+ * @param wr Baseline writer
+ * @param path Path to baseline file
+ * @return EOK on success, EIO on I/O error, ENOMEM if out of memory
+ */
+int baseline_wr_write(baseline_wr_t *wr, const char *path)
+{
+	uint8_t *buf = NULL;
+	uint8_t *slots;
+	size_t size;
+	uint64_t nslots;
+	uint64_t mask;
+	uint64_t nentries;
+	uint64_t val;
+	uint64_t i;
+	size_t j;
+	char *tmp_path = NULL;
+	FILE *f = NULL;
+	int rc;
+
+	nslots = baseline_min_slots;
+	while (nslots < 2 * (uint64_t) wr->nfps)
+		nslots *= 2;
+	mask = nslots - 1;
+
+	size = baseline_hdr_size + nslots * 8;
+	buf = calloc(1, size);
+	if (buf == NULL)
+		return ENOMEM;
+
+	memcpy(buf, baseline_magic, 4);
+	baseline_put_uint(buf + 4, baseline_version, 4);
+	baseline_put_uint(buf + 8, nslots, 8);
+	slots = buf + baseline_hdr_size;
+
+	nentries = 0;
+	for (j = 0; j < wr->nfps; j++) {
+		i = wr->fp[j] & mask;
+		while (true) {
+			val = baseline_get_uint(slots + 8 * i, 8);
+			if (val == wr->fp[j])
+				break;
+
+			if (val == 0) {
+				baseline_put_uint(slots + 8 * i, wr->fp[j], 8);
+				++nentries;
+				break;
+			}
+
+			i = (i + 1) & mask;
+		}
+	}
+
+	baseline_put_uint(buf + 16, nentries, 8);
+
+	if (asprintf(&tmp_path, "%s.tmp-%d", path, (int) getpid()) < 0) {
+		tmp_path = NULL;
+		rc = ENOMEM;
+		goto error;
+	}
+
+	f = fopen(tmp_path, "wb");
+	if (f == NULL) {
+		rc = EIO;
+		goto error;
+	}
+
+	if (fwrite(buf, 1, size, f) != size) {
+		rc = EIO;
+		goto error;
+	}
+
+	if (fclose(f) != 0) {
+		f = NULL;
+		rc = EIO;
+		goto error;
+	}
+
+	f = NULL;
+
+	if (rename(tmp_path, path) < 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	free(tmp_path);
+	free(buf);
+	return EOK;
+error:
+	if (f != NULL)
+		fclose(f);
+	if (tmp_path != NULL)
+		(void) unlink(tmp_path);
+	free(tmp_path);
+	free(buf);
+	return rc;
+}
@@ -0,0 +1,424 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Synthetic benchmark corpus
+ *
+ * Generates C source files that stress particular parts of the checker
+ * (comment handling, deep nesting, large initializers, macros, long lines).
+ * The output only depends on the corpus kind and the requested size,
+ * so results can be compared between builds.
+ */
+
+#include <bcorpus.h>
+#include <merrno.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+enum {
+	/** Maximum nesting depth of generated control flow */
+	bcorpus_max_depth = 12,
+	/** Number of values per line in generated tables */
+	bcorpus_table_cols = 8,
+	/** Maximum length of a generated long line */
+	bcorpus_max_line = 2000
+};
+
+/** Words used to fill comments */
+static const char *bcorpus_words[] = {
+	"the", "checker", "token", "value", "returns", "pointer", "to",
+	"buffer", "list", "entry", "is", "not", "a", "of", "and", "input",
+	"output", "size", "in", "bytes", "number", "element", "first",
+	"next", "function", "argument", "structure", "must", "be", "valid"
+};
+
+/** File names of corpus kinds */
+static const char *bcorpus_fnames[bck_limit] = {
+	[bck_comments] = "comments.h",
+	[bck_nested] = "nested.c",
+	[bck_tables] = "tables.c",
+	[bck_macros] = "macros.c",
+	[bck_longlines] = "longlines.c"
+};
+
+/** Get file name for corpus kind.
+ *
+ * @param kind Corpus kind
+ * @return File name (also indicates whether it is a header)
+ */
+const char *bcorpus_fname(bcorpus_kind_t kind)
+{
+	return bcorpus_fnames[kind];
+}
+
+/** Get next pseudo-random number.
+ *
+ * @param bc Corpus generator
+ * @param n Upper bound (exclusive), must be non-zero
+ * @return Number between 0 and @a n - 1
+ */
+static unsigned bcorpus_rand(bcorpus_t *bc, unsigned n)
+{
+	bc->seed = bc->seed * 1103515245 + 12345;
+	return (bc->seed >> 16) % n;
+}
+
+/** Write indentation.
+ *
+ * @param bc Corpus generator
+ * @param depth Number of tabs
+ */
+static void bcorpus_indent(bcorpus_t *bc, unsigned depth)
+{
+	unsigned i;
+
+	for (i = 0; i < depth; i++)
+		fputc('\t', bc->f);
+}
+
+/** Write a number of random words.
+ *
+ * @param bc Corpus generator
+ * @param nwords Number of words
+ */
+static void bcorpus_words_gen(bcorpus_t *bc, unsigned nwords)
+{
+	unsigned nw = sizeof(bcorpus_words) / sizeof(bcorpus_words[0]);
+	unsigned i;
+
+	for (i = 0; i < nwords; i++) {
+		fprintf(bc->f, "%s%s", i > 0 ? " " : "",
+		    bcorpus_words[bcorpus_rand(bc, nw)]);
+	}
+}
+
+/** Generate documented function prototype or structure.
+ *
+ * @param bc Corpus generator
+ */
+static void bcorpus_comments_item(bcorpus_t *bc)
+{
+	unsigned nlines;
+	unsigned i;
+
+	if (bcorpus_rand(bc, 4) == 0) {
+		fprintf(bc->f, "/** Structure %u */\ntypedef struct {\n",
+		    bc->nitems);
+		nlines = 2 + bcorpus_rand(bc, 6);
+		for (i = 0; i < nlines; i++) {
+			fprintf(bc->f, "\t/** ");
+			bcorpus_words_gen(bc, 3 + bcorpus_rand(bc, 6));
+			fprintf(bc->f, " */\n\tint m%u;\n", i);
+		}
+
+		fprintf(bc->f, "} bench_s%u_t;\n", bc->nitems);
+		return;
+	}
+
+	fprintf(bc->f, "/** Function %u.\n *\n", bc->nitems);
+	nlines = 2 + bcorpus_rand(bc, 8);
+	for (i = 0; i < nlines; i++) {
+		fprintf(bc->f, " * ");
+		bcorpus_words_gen(bc, 4 + bcorpus_rand(bc, 7));
+		fprintf(bc->f, "\n");
+	}
+
+	fprintf(bc->f, " *\n * @param a First argument\n"
+	    " * @param b Second argument\n * @return Result\n */\n"
+	    "extern int bench_fun%u(int, const char *);\n", bc->nitems);
+
+	if (bcorpus_rand(bc, 8) == 0) {
+		fprintf(bc->f, "\n/*\n * ");
+		bcorpus_words_gen(bc, 5 + bcorpus_rand(bc, 5));
+		fprintf(bc->f, "\n */\n");
+	}
+}
+
+/** Generate nested statement.
+ *
+ * @param bc Corpus generator
+ * @param depth Current depth
+ * @param maxd Depth at which to stop nesting
+ */
+static void bcorpus_nested_stmt(bcorpus_t *bc, unsigned depth, unsigned maxd)
+{
+	if (depth >= maxd) {
+		bcorpus_indent(bc, depth);
+		fprintf(bc->f, "s += a * %u - b;\n", bcorpus_rand(bc, 100));
+		return;
+	}
+
+	bcorpus_indent(bc, depth);
+	switch (bcorpus_rand(bc, 5)) {
+	case 0:
+		fprintf(bc->f, "if (a > %u) {\n", bcorpus_rand(bc, 100));
+		break;
+	case 1:
+		fprintf(bc->f, "while (b < %u) {\n", bcorpus_rand(bc, 100));
+		break;
+	case 2:
+		fprintf(bc->f, "for (i%u = 0; i%u < a; i%u++) {\n", depth,
+		    depth, depth);
+		break;
+	case 3:
+		fprintf(bc->f, "do {\n");
+		bcorpus_nested_stmt(bc, depth + 1, maxd);
+		bcorpus_indent(bc, depth);
+		fprintf(bc->f, "} while (s < %u);\n", bcorpus_rand(bc, 100));
+		return;
+	default:
+		fprintf(bc->f, "switch (a) {\n");
+		bcorpus_indent(bc, depth);
+		fprintf(bc->f, "case %u:\n", bcorpus_rand(bc, 100));
+		bcorpus_nested_stmt(bc, depth + 1, maxd);
+		bcorpus_indent(bc, depth + 1);
+		fprintf(bc->f, "break;\n");
+		bcorpus_indent(bc, depth);
+		fprintf(bc->f, "default:\n");
+		bcorpus_indent(bc, depth + 1);
+		fprintf(bc->f, "s = 0;\n");
+		bcorpus_indent(bc, depth);
+		fprintf(bc->f, "}\n");
+		return;
+	}
+
+	bcorpus_nested_stmt(bc, depth + 1, maxd);
+	if (bcorpus_rand(bc, 3) == 0)
+		bcorpus_nested_stmt(bc, depth + 1, maxd);
+
+	bcorpus_indent(bc, depth);
+	fprintf(bc->f, "}\n");
+}
+
+/** Generate function with deeply nested control flow.
+ *
+ * @param bc Corpus generator
+ */
+static void bcorpus_nested_item(bcorpus_t *bc)
+{
+	unsigned maxd;
+	unsigned i;
+
+	maxd = bcorpus_max_depth / 2 + bcorpus_rand(bc,
+	    bcorpus_max_depth / 2 + 1);
+
+	fprintf(bc->f, "int bench_nested%u(int a, int b)\n{\n", bc->nitems);
+	for (i = 1; i <= maxd; i++)
+		fprintf(bc->f, "\tint i%u;\n", i);
+	fprintf(bc->f, "\tint s = 0;\n\n");
+
+	bcorpus_nested_stmt(bc, 1, maxd);
+
+	fprintf(bc->f, "\treturn s;\n}\n");
+}
+
+/** Generate initializer tables.
+ *
+ * @param bc Corpus generator
+ */
+static void bcorpus_tables_item(bcorpus_t *bc)
+{
+	unsigned nlines;
+	unsigned i, j;
+
+	nlines = 50 + bcorpus_rand(bc, 200);
+
+	if (bcorpus_rand(bc, 2) == 0) {
+		fprintf(bc->f, "static const int bench_table%u[] = {\n",
+		    bc->nitems);
+		for (i = 0; i < nlines; i++) {
+			fprintf(bc->f, "\t");
+			for (j = 0; j < bcorpus_table_cols; j++) {
+				fprintf(bc->f, "%s%u,", j > 0 ? " " : "",
+				    bcorpus_rand(bc, 100000));
+			}
+			fprintf(bc->f, "\n");
+		}
+	} else {
+		fprintf(bc->f, "static const bench_ent_t bench_ents%u[] = {\n",
+		    bc->nitems);
+		for (i = 0; i < nlines; i++) {
+			fprintf(bc->f, "\t{ .name = \"e%u\", .a = %u, "
+			    ".b = { %u, %u } },\n", i, bcorpus_rand(bc, 1000),
+			    bcorpus_rand(bc, 1000), bcorpus_rand(bc, 1000));
+		}
+	}
+
+	fprintf(bc->f, "};\n");
+}
+
+/** Generate macro definitions and code using them.
+ *
+ * @param bc Corpus generator
+ */
+static void bcorpus_macros_item(bcorpus_t *bc)
+{
+	unsigned n = bc->nitems;
+	unsigned nstmts;
+	unsigned i;
+
+	fprintf(bc->f, "#define BENCH_MAX%u(a, b) ((a) > (b) ? (a) : (b))\n"
+	    "#define BENCH_FOREACH%u(i, n) \\\n"
+	    "\tfor ((i) = 0; (i) < (n); (i)++)\n"
+	    "#define BENCH_NAME%u \"name%u\"\n", n, n, n, n);
+
+	fprintf(bc->f, "\nint bench_macros%u(int a, int b)\n{\n"
+	    "\tint i;\n\tint s = 0;\n\n", n);
+
+	nstmts = 4 + bcorpus_rand(bc, 12);
+	for (i = 0; i < nstmts; i++) {
+		switch (bcorpus_rand(bc, 4)) {
+		case 0:
+			fprintf(bc->f, "\ts = BENCH_MAX%u(s, a + %u);\n", n,
+			    bcorpus_rand(bc, 100));
+			break;
+		case 1:
+			fprintf(bc->f, "\tBENCH_FOREACH%u(i, b) {\n"
+			    "\t\ts += BENCH_MAX%u(i, a);\n\t}\n", n, n);
+			break;
+		case 2:
+			fprintf(bc->f, "#ifdef BENCH_OPT%u\n\ts += %u;\n"
+			    "#else\n\ts -= %u;\n#endif\n", i,
+			    bcorpus_rand(bc, 100), bcorpus_rand(bc, 100));
+			break;
+		default:
+			fprintf(bc->f, "\tputs(\"prefix \" BENCH_NAME%u "
+			    "\" suffix\");\n", n);
+			break;
+		}
+	}
+
+	fprintf(bc->f, "\treturn s;\n}\n");
+}
+
+/** Generate function with long lines.
+ *
+ * @param bc Corpus generator
+ */
+static void bcorpus_longlines_item(bcorpus_t *bc)
+{
+	unsigned len;
+	unsigned col;
+	unsigned nw = sizeof(bcorpus_words) / sizeof(bcorpus_words[0]);
+
+	fprintf(bc->f, "int bench_long%u(int a, int b, int c)\n{\n"
+	    "\tputs(\"", bc->nitems);
+
+	len = 100 + bcorpus_rand(bc, bcorpus_max_line - 100);
+	col = 0;
+	while (col < len) {
+		col += fprintf(bc->f, "%s ",
+		    bcorpus_words[bcorpus_rand(bc, nw)]);
+	}
+
+	fprintf(bc->f, "\");\n\treturn a");
+
+	len = 100 + bcorpus_rand(bc, bcorpus_max_line - 100);
+	col = 0;
+	while (col < len) {
+		col += fprintf(bc->f, " %c %c", "+-*"[bcorpus_rand(bc, 3)],
+		    "abc"[bcorpus_rand(bc, 3)]);
+	}
+
+	fprintf(bc->f, ";\n}\n");
+}
+
+/** Generate synthetic source file.
+ *
+ * Generation stops at the end of the first top-level item that reaches
+ * @a size bytes.
+ *
+ * @param kind Corpus kind
+ * @param size Approximate size of generated source in bytes
+ * @param rtext Place to store pointer to newly allocated source text
+ * @param rsize Place to store size of source text
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int bcorpus_gen(bcorpus_kind_t kind, size_t size, char **rtext,
+    size_t *rsize)
+{
+	bcorpus_t bc;
+	char *text;
+	size_t tsize;
+
+	bc.f = open_memstream(&text, &tsize);
+	if (bc.f == NULL)
+		return ENOMEM;
+
+	bc.seed = 1 + kind;
+	bc.nitems = 0;
+
+	fprintf(bc.f, "/*\n * Synthetic benchmark source (%s)\n */\n",
+	    bcorpus_fnames[kind]);
+
+	switch (kind) {
+	case bck_comments:
+		fprintf(bc.f, "\n#ifndef BENCH_COMMENTS_H\n"
+		    "#define BENCH_COMMENTS_H\n");
+		break;
+	case bck_tables:
+		fprintf(bc.f, "\ntypedef struct {\n\tconst char *name;\n"
+		    "\tint a;\n\tint b[2];\n} bench_ent_t;\n");
+		break;
+	case bck_macros:
+		fprintf(bc.f, "\n#include <stdio.h>\n");
+		break;
+	default:
+		break;
+	}
+
+	while ((size_t)ftell(bc.f) < size) {
+		fprintf(bc.f, "\n");
+		switch (kind) {
+		case bck_comments:
+			bcorpus_comments_item(&bc);
+			break;
+		case bck_nested:
+			bcorpus_nested_item(&bc);
+			break;
+		case bck_tables:
+			bcorpus_tables_item(&bc);
+			break;
+		case bck_macros:
+			bcorpus_macros_item(&bc);
+			break;
+		case bck_longlines:
+		default:
+			bcorpus_longlines_item(&bc);
+			break;
+		}
+
+		++bc.nitems;
+	}
+
+	if (kind == bck_comments)
+		fprintf(bc.f, "\n#endif\n");
+
+	if (fclose(bc.f) != 0) {
+		free(text);
+		return ENOMEM;
+	}
+
+	*rtext = text;
+	*rsize = tsize;
+	return EOK;
+}
@@ -0,0 +1,987 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Benchmarks
+ *
+ * Edit latency benchmark simulates a user typing into a source file
+ * and compares the time needed to re-check the file incrementally
+ * after each keystroke with the time needed to check it from scratch.
+ *
+ * Throughput benchmark checks synthetic source files (see bcorpus.c)
+ * and reports throughput of the lexer, the parser, the rest of
+ * checker_run() and printing of fixed source separately. The results
+ * can be saved and later compared to detect performance regressions.
+ */
+
+#include <bcorpus.h>
+#include <bench.h>
+#include <buf_input.h>
+#include <checker.h>
+#include <diag.h>
+#include <inttypes.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+enum {
+	/** Number of simulated keystrokes (each typed and then erased) */
+	bench_edit_nkeys = 100,
+	/** Number of full checks to average */
+	bench_edit_nfull = 5,
+	/** Size of each synthetic source file in bytes */
+	bench_corpus_size = 512 * 1024,
+	/** Number of runs of the throughput benchmark (median is taken) */
+	bench_nruns = 5,
+	/** Number of runs when comparing with baseline */
+	bench_max_nruns = 9,
+	/** Regression must exceed this many standard errors */
+	bench_cmp_nse = 3,
+	/** Maximum length of a string value in benchmark results */
+	bench_json_str_size = 32
+};
+
+/** Get current time in nanoseconds.
+ *
+ * @return Monotonic time in nanoseconds
+ */
+static uint64_t bench_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/** Compare two times for sorting.
+ *
+ * @param a Pointer to first time (uint64_t *)
+ * @param b Pointer to second time (uint64_t *)
+ * @return Less than, equal to or greater than zero
+ */
+static int bench_time_cmp(const void *a, const void *b)
+{
+	uint64_t ta = *(const uint64_t *)a;
+	uint64_t tb = *(const uint64_t *)b;
+
+	if (ta < tb)
+		return -1;
+	if (ta > tb)
+		return 1;
+	return 0;
+}
+
+/** Read file into memory.
+ *
+ * @param fname File name
+ * @param rbuf Place to store pointer to newly allocated buffer
+ * @param rsize Place to store file size
+ * @return EOK on success, ENOENT if file cannot be opened, ENOMEM
+ *         if out of memory, EIO on I/O error
+ */
+static int bench_read_file(const char *fname, char **rbuf, size_t *rsize)
+{
+	FILE *f;
+	char *buf = NULL;
+	char *nbuf;
+	size_t size = 0;
+	size_t alloc = 0;
+	size_t nread;
+
+	f = fopen(fname, "r");
+	if (f == NULL)
+		return ENOENT;
+
+	do {
+		if (size + 1 >= alloc) {
+			alloc = alloc != 0 ? 2 * alloc : 65536;
+			nbuf = realloc(buf, alloc);
+			if (nbuf == NULL) {
+				free(buf);
+				fclose(f);
+				return ENOMEM;
+			}
+
+			buf = nbuf;
+		}
+
+		nread = fread(buf + size, 1, alloc - size - 1, f);
+		size += nread;
+	} while (nread > 0);
+
+	if (ferror(f)) {
+		free(buf);
+		fclose(f);
+		return EIO;
+	}
+
+	fclose(f);
+	*rbuf = buf;
+	*rsize = size;
+	return EOK;
+}
+
+/** Create checker for source text in memory.
+ *
+ * @param fname File name
+ * @param text Source text
+ * @param size Size of source text
+ * @param cfg Checker configuration
+ * @param binput Buffer input to initialize
+ * @param rchecker Place to store new checker
+ * @return EOK on success or error code
+ */
+static int bench_checker_create(const char *fname, char *text, size_t size,
+    checker_cfg_t *cfg, buf_input_t *binput, checker_t **rchecker)
+{
+	checker_mtype_t mtype;
+	size_t len;
+
+	len = strlen(fname);
+	mtype = len >= 2 && strcmp(fname + len - 2, ".h") == 0 ?
+	    cmod_header : cmod_c;
+
+	buf_input_init(binput, text, size, fname);
+	return checker_create(&lexer_buf_input, binput, mtype, cfg, rchecker);
+}
+
+/** Run a full check of source text in memory.
+ *
+ * @param fname File name
+ * @param text Source text
+ * @param size Size of source text
+ * @param cfg Checker configuration
+ * @param rtime Place to store time taken in nanoseconds
+ * @return EOK on success or error code
+ */
+static int bench_full_check(const char *fname, char *text, size_t size,
+    checker_cfg_t *cfg, uint64_t *rtime)
+{
+	checker_t *checker;
+	buf_input_t binput;
+	uint64_t t0;
+	int rc;
+
+	t0 = bench_now();
+
+	rc = bench_checker_create(fname, text, size, cfg, &binput, &checker);
+	if (rc != EOK)
+		return rc;
+
+	rc = checker_run(checker, false);
+	checker_destroy(checker);
+
+	*rtime = bench_now() - t0;
+	return rc;
+}
+
+/** Apply edit to source text, re-check it incrementally and time it.
+ *
+ * @param checker Incremental checker
+ * @param text Source text buffer (must have room for one more character)
+ * @param size Size of source text, updated
+ * @param pos Position of the edit
+ * @param c Character to insert or '\0' to delete the character at @a pos
+ * @param rtime Place to store time taken in nanoseconds
+ * @return EOK on success or error code
+ */
+static int bench_keystroke(checker_t *checker, char *text, size_t *size,
+    size_t pos, char c, uint64_t *rtime)
+{
+	checker_edit_t edit;
+	uint64_t t0;
+	int rc;
+
+	edit.pos = pos;
+	if (c != '\0') {
+		memmove(text + pos + 1, text + pos, *size - pos);
+		text[pos] = c;
+		++*size;
+		edit.old_size = 0;
+		edit.new_size = 1;
+	} else {
+		memmove(text + pos, text + pos + 1, *size - pos - 1);
+		--*size;
+		edit.old_size = 1;
+		edit.new_size = 0;
+	}
+
+	t0 = bench_now();
+
+	rc = checker_update(checker, text, *size, &edit, 1);
+	if (rc != EOK)
+		return rc;
+
+	diag_list_clear(&checker->diags);
+	rc = checker_run(checker, false);
+
+	*rtime = bench_now() - t0;
+	return rc;
+}
+
+/** Benchmark incremental re-check latency after single-keystroke edits.
+ *
+ * A space is typed at the beginning of lines evenly spaced throughout
+ * the file and then erased again. Each keystroke is followed by an incremental
+ * re-check. The latency is compared with a full check of the file.
+ *
+ * @param fname Source file name
+ * @param f Output file for the report
+ * @return EOK on success or error code
+ */
+int bench_edit(const char *fname, FILE *f)
+{
+	checker_cfg_t cfg;
+	checker_t *checker = NULL;
+	buf_input_t binput;
+	char *text = NULL;
+	char *orig = NULL;
+	size_t size;
+	size_t pos;
+	size_t ndiags;
+	uint64_t full[bench_edit_nfull];
+	uint64_t incr[2 * bench_edit_nkeys];
+	uint64_t tfull;
+	uint64_t tsum;
+	size_t i;
+	int rc;
+
+	rc = bench_read_file(fname, &orig, &size);
+	if (rc != EOK) {
+		fprintf(stderr, "Error reading '%s'.\n", fname);
+		return rc;
+	}
+
+	if (size == 0) {
+		fprintf(stderr, "File '%s' is empty.\n", fname);
+		rc = EINVAL;
+		goto error;
+	}
+
+	checker_cfg_init(&cfg);
+
+	for (i = 0; i < bench_edit_nfull; i++) {
+		rc = bench_full_check(fname, orig, size, &cfg, &full[i]);
+		if (rc != EOK)
+			goto error;
+	}
+
+	qsort(full, bench_edit_nfull, sizeof(uint64_t), bench_time_cmp);
+	tfull = full[bench_edit_nfull / 2];
+
+	/* The original text is only read until the first update */
+	text = malloc(size + 1);
+	if (text == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	memcpy(text, orig, size);
+
+	rc = bench_checker_create(fname, orig, size, &cfg, &binput, &checker);
+	if (rc != EOK)
+		goto error;
+
+	checker_set_incr(checker);
+	checker_set_errf(checker, stderr);
+
+	rc = checker_run(checker, false);
+	if (rc != EOK)
+		goto error;
+
+	ndiags = checker->diags.ndiags;
+
+	for (i = 0; i < bench_edit_nkeys; i++) {
+		/*
+		 * Indent the beginning of a line, which keeps the source
+		 * parseable, but changes the diagnostics
+		 */
+		pos = (size_t)((uint64_t)i * size / bench_edit_nkeys);
+		while (pos > 0 && text[pos - 1] != '\n')
+			--pos;
+
+		rc = bench_keystroke(checker, text, &size, pos, ' ',
+		    &incr[2 * i]);
+		if (rc != EOK)
+			goto error;
+
+		rc = bench_keystroke(checker, text, &size, pos, '\0',
+		    &incr[2 * i + 1]);
+		if (rc != EOK)
+			goto error;
+	}
+
+	/* After erasing all typed characters, results must be the same */
+	if (checker->diags.ndiags != ndiags) {
+		fprintf(stderr, "Incremental re-check result differs "
+		    "(%zu != %zu issues).\n", checker->diags.ndiags, ndiags);
+		rc = EINVAL;
+		goto error;
+	}
+
+	tsum = 0;
+	for (i = 0; i < 2 * bench_edit_nkeys; i++)
+		tsum += incr[i];
+
+	qsort(incr, 2 * bench_edit_nkeys, sizeof(uint64_t), bench_time_cmp);
+
+	fprintf(f, "File: %s (%zu bytes)\n", fname, size);
+	fprintf(f, "Full check: %.3f ms\n", tfull / 1e6);
+	fprintf(f, "Incremental re-check (%d keystrokes): mean %.3f ms, "
+	    "median %.3f ms, max %.3f ms\n", 2 * bench_edit_nkeys,
+	    tsum / 1e6 / (2 * bench_edit_nkeys),
+	    incr[bench_edit_nkeys] / 1e6,
+	    incr[2 * bench_edit_nkeys - 1] / 1e6);
+	fprintf(f, "Speedup (median): %.1fx\n",
+	    (double)tfull / incr[bench_edit_nkeys]);
+
+	checker_destroy(checker);
+	free(text);
+	free(orig);
+	return EOK;
+error:
+	if (checker != NULL)
+		checker_destroy(checker);
+	free(text);
+	free(orig);
+	return rc;
+}
+
+/** Get benchmark phase name.
+ *
+ * @param phase Benchmark phase
+ * @return Phase name
+ */
+const char *bench_phase_str(bench_phase_t phase)
+{
+	switch (phase) {
+	case bph_lex:
+		return "lex";
+	case bph_parse:
+		return "parse";
+	case bph_check:
+		return "check";
+	case bph_fix_print:
+		return "fix-print";
+	default:
+		return "?";
+	}
+}
+
+/** Write synthetic source files to a directory.
+ *
+ * @param dir Directory (must exist)
+ * @return EOK on success or error code
+ */
+int bench_gen(const char *dir)
+{
+	bcorpus_kind_t kind;
+	char *text;
+	size_t size;
+	char *path;
+	FILE *f;
+	int rc;
+
+	for (kind = 0; kind < bck_limit; kind++) {
+		rc = bcorpus_gen(kind, bench_corpus_size, &text, &size);
+		if (rc != EOK)
+			return rc;
+
+		if (asprintf(&path, "%s/%s", dir, bcorpus_fname(kind)) < 0) {
+			free(text);
+			return ENOMEM;
+		}
+
+		f = fopen(path, "w");
+		if (f == NULL) {
+			fprintf(stderr, "Cannot open '%s'.\n", path);
+			free(path);
+			free(text);
+			return EIO;
+		}
+
+		rc = EOK;
+		if (fwrite(text, 1, size, f) != size)
+			rc = EIO;
+		if (fclose(f) != 0)
+			rc = EIO;
+		if (rc != EOK)
+			fprintf(stderr, "Error writing '%s'.\n", path);
+
+		free(path);
+		free(text);
+		if (rc != EOK)
+			return rc;
+	}
+
+	return EOK;
+}
+
+/** Run throughput benchmark once on source text in memory.
+ *
+ * @param fname File name
+ * @param text Source text
+ * @param size Size of source text
+ * @param cfg Checker configuration
+ * @param nullf Output stream that discards output
+ * @param time Place to store time spent in each phase in nanoseconds
+ * @param rntoks Place to store number of tokens
+ * @return EOK on success or error code
+ */
+static int bench_run_once(const char *fname, char *text, size_t size,
+    checker_cfg_t *cfg, FILE *nullf, uint64_t *time, size_t *rntoks)
+{
+	checker_t *checker;
+	checker_stats_t stats;
+	buf_input_t binput;
+	uint64_t t0;
+	uint64_t trun;
+	int rc;
+
+	memset(&stats, 0, sizeof(stats));
+
+	rc = bench_checker_create(fname, text, size, cfg, &binput, &checker);
+	if (rc != EOK)
+		return rc;
+
+	checker_set_stats(checker, &stats);
+
+	t0 = bench_now();
+	rc = checker_run(checker, false);
+	trun = bench_now() - t0;
+	checker_destroy(checker);
+	if (rc != EOK)
+		return rc;
+
+	time[bph_lex] = stats.wall[cph_lex];
+	time[bph_parse] = stats.wall[cph_parse];
+	time[bph_check] = trun - stats.wall[cph_lex] - stats.wall[cph_parse];
+	*rntoks = stats.ntoks;
+
+	rc = bench_checker_create(fname, text, size, cfg, &binput, &checker);
+	if (rc != EOK)
+		return rc;
+
+	rc = checker_run(checker, true);
+	if (rc != EOK) {
+		checker_destroy(checker);
+		return rc;
+	}
+
+	t0 = bench_now();
+	rc = checker_print(checker, nullf);
+	time[bph_fix_print] = bench_now() - t0;
+	checker_destroy(checker);
+	return rc;
+}
+
+/** Compute median and median absolute deviation of times.
+ *
+ * @param t Array of times (sorted in place)
+ * @param n Number of times (non-zero, at most @c bench_max_nruns)
+ * @param rmed Place to store median
+ * @param rmad Place to store median absolute deviation
+ */
+static void bench_median_mad(uint64_t *t, unsigned n, uint64_t *rmed,
+    uint64_t *rmad)
+{
+	uint64_t dev[bench_max_nruns];
+	uint64_t med;
+	unsigned i;
+
+	qsort(t, n, sizeof(uint64_t), bench_time_cmp);
+	med = t[n / 2];
+
+	for (i = 0; i < n; i++)
+		dev[i] = t[i] > med ? t[i] - med : med - t[i];
+
+	qsort(dev, n, sizeof(uint64_t), bench_time_cmp);
+
+	*rmed = med;
+	*rmad = dev[n / 2];
+}
+
+/** Run throughput benchmark on one synthetic source file.
+ *
+ * @param kind Corpus kind
+ * @param nruns Number of runs (at most @c bench_max_nruns)
+ * @param cfg Checker configuration
+ * @param nullf Output stream that discards output
+ * @param res Place to store result
+ * @return EOK on success or error code
+ */
+static int bench_run_corpus(bcorpus_kind_t kind, unsigned nruns,
+    checker_cfg_t *cfg, FILE *nullf, bench_res_t *res)
+{
+	uint64_t time[bph_limit][bench_max_nruns];
+	uint64_t rtime[bph_limit];
+	char *text;
+	size_t size;
+	unsigned phase;
+	unsigned i;
+	int rc;
+
+	rc = bcorpus_gen(kind, bench_corpus_size, &text, &size);
+	if (rc != EOK)
+		return rc;
+
+	res->fname = bcorpus_fname(kind);
+	res->nbytes = size;
+
+	for (i = 0; i < nruns; i++) {
+		rc = bench_run_once(res->fname, text, size, cfg, nullf, rtime,
+		    &res->ntoks);
+		if (rc != EOK) {
+			fprintf(stderr, "Error checking '%s'.\n", res->fname);
+			free(text);
+			return rc;
+		}
+
+		for (phase = 0; phase < bph_limit; phase++)
+			time[phase][i] = rtime[phase];
+	}
+
+	for (phase = 0; phase < bph_limit; phase++) {
+		bench_median_mad(time[phase], nruns, &res->time[phase],
+		    &res->mad[phase]);
+	}
+
+	free(text);
+	return EOK;
+}
+
+/** Run throughput benchmark on all synthetic source files.
+ *
+ * @param nruns Number of runs (at most @c bench_max_nruns)
+ * @param res Array of @c bck_limit results to fill in
+ * @return EOK on success or error code
+ */
+static int bench_measure(unsigned nruns, bench_res_t *res)
+{
+	checker_cfg_t cfg;
+	bcorpus_kind_t kind;
+	FILE *nullf;
+	int rc;
+
+	nullf = fopen("/dev/null", "w");
+	if (nullf == NULL)
+		return EIO;
+
+	checker_cfg_init(&cfg);
+
+	for (kind = 0; kind < bck_limit; kind++) {
+		rc = bench_run_corpus(kind, nruns, &cfg, nullf, &res[kind]);
+		if (rc != EOK) {
+			fclose(nullf);
+			return rc;
+		}
+	}
+
+	fclose(nullf);
+	return EOK;
+}
+
+/** Compute throughput in units per second.
+ *
+ * @param n Number of units (bytes, tokens)
+ * @param time Time in nanoseconds
+ * @return Units per second
+ */
+static double bench_per_sec(size_t n, uint64_t time)
+{
+	return time != 0 ? n * 1e9 / time : 0.0;
+}
+
+/** Write throughput benchmark results as JSON.
+ *
+ * One result (source file and phase) is written per line.
+ *
+ * @param res Results
+ * @param nres Number of results
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+static int bench_write_json(bench_res_t *res, size_t nres, FILE *f)
+{
+	size_t i;
+	unsigned phase;
+
+	fprintf(f, "{\n\"corpus_size\": %d,\n\"runs\": %d,\n"
+	    "\"results\": [\n", (int)bench_corpus_size, (int)bench_nruns);
+
+	for (i = 0; i < nres; i++) {
+		for (phase = 0; phase < bph_limit; phase++) {
+			fprintf(f, "{\"file\": \"%s\", \"phase\": \"%s\", "
+			    "\"bytes\": %zu, \"tokens\": %zu, "
+			    "\"ns\": %" PRIu64 ", \"mad_ns\": %" PRIu64 ", "
+			    "\"mb_s\": %.3f, \"tok_s\": %.0f}%s\n",
+			    res[i].fname, bench_phase_str(phase),
+			    res[i].nbytes, res[i].ntoks, res[i].time[phase],
+			    res[i].mad[phase],
+			    bench_per_sec(res[i].nbytes, res[i].time[phase]) /
+			    1e6, bench_per_sec(res[i].ntoks,
+			    res[i].time[phase]), i + 1 < nres ||
+			    phase + 1 < bph_limit ? "," : "");
+		}
+	}
+
+	fprintf(f, "]\n}\n");
+	return ferror(f) ? EIO : EOK;
+}
+
+/** Find value of a key in a line of JSON.
+ *
+ * @param line Line containing a single-level JSON object
+ * @param key Key
+ * @return Pointer to the value or @c NULL if the key is not present
+ */
+static const char *bench_json_find(const char *line, const char *key)
+{
+	const char *p = line;
+	size_t len = strlen(key);
+
+	while ((p = strchr(p, '"')) != NULL) {
+		++p;
+		if (strncmp(p, key, len) == 0 && p[len] == '"' &&
+		    p[len + 1] == ':') {
+			p += len + 2;
+			while (*p == ' ')
+				++p;
+			return p;
+		}
+	}
+
+	return NULL;
+}
+
+/** Get string value of a key in a line of JSON.
+ *
+ * @param line Line containing a single-level JSON object
+ * @param key Key
+ * @param buf Buffer to store the value to
+ * @param bsize Buffer size
+ * @return EOK on success, ENOENT if the key is not present or the value
+ *         is not a string, EINVAL if the value does not fit
+ */
+static int bench_json_str(const char *line, const char *key, char *buf,
+    size_t bsize)
+{
+	const char *p;
+	size_t i;
+
+	p = bench_json_find(line, key);
+	if (p == NULL || *p != '"')
+		return ENOENT;
+
+	++p;
+	for (i = 0; p[i] != '"'; i++) {
+		if (p[i] == '\0' || i + 1 >= bsize)
+			return EINVAL;
+		buf[i] = p[i];
+	}
+
+	buf[i] = '\0';
+	return EOK;
+}
+
+/** Get unsigned integer value of a key in a line of JSON.
+ *
+ * @param line Line containing a single-level JSON object
+ * @param key Key
+ * @param rval Place to store the value
+ * @return EOK on success, ENOENT if the key is not present or the value
+ *         is not an unsigned integer
+ */
+static int bench_json_u64(const char *line, const char *key, uint64_t *rval)
+{
+	const char *p;
+
+	p = bench_json_find(line, key);
+	if (p == NULL || *p < '0' || *p > '9')
+		return ENOENT;
+
+	*rval = strtoull(p, NULL, 10);
+	return EOK;
+}
+
+/** Load benchmark results from JSON file written by bench_run().
+ *
+ * @param fname File name
+ * @param res Array of @c bck_limit results to fill in
+ * @param have Array of flags, set for each file and phase found
+ * @param rnruns Place to store number of runs
+ * @return EOK on success, ENOENT if file cannot be opened, EIO on
+ *         I/O error
+ */
+static int bench_load_json(const char *fname, bench_res_t *res,
+    bool have[bck_limit][bph_limit], unsigned *rnruns)
+{
+	FILE *f;
+	char *line = NULL;
+	size_t lsize = 0;
+	char file[bench_json_str_size];
+	char phase[bench_json_str_size];
+	uint64_t val;
+	bcorpus_kind_t kind;
+	unsigned ph;
+	int rc;
+
+	memset(have, 0, bck_limit * sizeof(have[0]));
+	*rnruns = bench_nruns;
+
+	f = fopen(fname, "r");
+	if (f == NULL)
+		return ENOENT;
+
+	while (getline(&line, &lsize, f) >= 0) {
+		if (bench_json_u64(line, "runs", &val) == EOK && val > 0 &&
+		    val <= bench_max_nruns)
+			*rnruns = val;
+
+		if (bench_json_str(line, "file", file, sizeof(file)) != EOK ||
+		    bench_json_str(line, "phase", phase,
+		    sizeof(phase)) != EOK)
+			continue;
+
+		for (kind = 0; kind < bck_limit; kind++) {
+			if (strcmp(file, bcorpus_fname(kind)) == 0)
+				break;
+		}
+
+		for (ph = 0; ph < bph_limit; ph++) {
+			if (strcmp(phase, bench_phase_str(ph)) == 0)
+				break;
+		}
+
+		/* Skip results for files or phases we do not know */
+		if (kind >= bck_limit || ph >= bph_limit)
+			continue;
+
+		res[kind].fname = bcorpus_fname(kind);
+
+		rc = bench_json_u64(line, "bytes", &val);
+		if (rc != EOK)
+			continue;
+		res[kind].nbytes = val;
+
+		rc = bench_json_u64(line, "ns", &res[kind].time[ph]);
+		if (rc != EOK)
+			continue;
+
+		/* Older results may lack MAD */
+		if (bench_json_u64(line, "mad_ns", &res[kind].mad[ph]) != EOK)
+			res[kind].mad[ph] = 0;
+
+		have[kind][ph] = true;
+	}
+
+	rc = ferror(f) ? EIO : EOK;
+	free(line);
+	fclose(f);
+	return rc;
+}
+
+/** Run throughput benchmark on synthetic source files.
+ *
+ * @param jfname Name of JSON file to write results to or @c NULL
+ * @param f Output file for the report
+ * @return EOK on success or error code
+ */
+int bench_run(const char *jfname, FILE *f)
+{
+	bench_res_t res[bck_limit];
+	bcorpus_kind_t kind;
+	unsigned phase;
+	FILE *jf;
+	int rc;
+
+	rc = bench_measure(bench_nruns, res);
+	if (rc != EOK)
+		return rc;
+
+	fprintf(f, "%-12s %-10s %10s %10s %12s\n", "File", "Phase",
+	    "Time [ms]", "MB/s", "Mtokens/s");
+
+	for (kind = 0; kind < bck_limit; kind++) {
+		for (phase = 0; phase < bph_limit; phase++) {
+			fprintf(f, "%-12s %-10s %10.3f %10.2f %12.3f\n",
+			    res[kind].fname, bench_phase_str(phase),
+			    res[kind].time[phase] / 1e6,
+			    bench_per_sec(res[kind].nbytes,
+			    res[kind].time[phase]) / 1e6,
+			    bench_per_sec(res[kind].ntoks,
+			    res[kind].time[phase]) / 1e6);
+		}
+	}
+
+	if (jfname == NULL)
+		return EOK;
+
+	jf = fopen(jfname, "w");
+	if (jf == NULL) {
+		fprintf(stderr, "Cannot open '%s'.\n", jfname);
+		return EIO;
+	}
+
+	rc = bench_write_json(res, bck_limit, jf);
+	if (fclose(jf) != 0)
+		rc = EIO;
+	if (rc != EOK) {
+		fprintf(stderr, "Error writing '%s'.\n", jfname);
+		return rc;
+	}
+
+	fprintf(f, "Results written to '%s'.\n", jfname);
+	return EOK;
+}
+
+/** Determine if a phase regressed compared to baseline.
+ *
+ * The increase of the median must exceed both @a threshold percent
+ * of the baseline median and @c bench_cmp_nse times the standard error
+ * of the difference of the medians, so that noisy phases are not
+ * reported. The standard error of a median of @c n runs is estimated
+ * from the median absolute deviation as 1.4826 * 1.2533 * MAD / sqrt(n)
+ * (assuming normally distributed noise).
+ *
+ * @param base Baseline median
+ * @param bmad Baseline median absolute deviation
+ * @param bnruns Number of baseline runs
+ * @param cur Current median
+ * @param cmad Current median absolute deviation
+ * @param cnruns Number of current runs
+ * @param threshold Threshold in percent
+ * @return @c true iff the phase regressed
+ */
+static bool bench_regressed(uint64_t base, uint64_t bmad, unsigned bnruns,
+    uint64_t cur, uint64_t cmad, unsigned cnruns, unsigned threshold)
+{
+	double delta;
+	double var;
+
+	if (cur <= base)
+		return false;
+
+	delta = (double)(cur - base);
+	var = 3.453 * ((double)bmad * bmad / bnruns +
+	    (double)cmad * cmad / cnruns);
+
+	return delta * 100 > (double)base * threshold &&
+	    delta * delta > bench_cmp_nse * bench_cmp_nse * var;
+}
+
+/** Compare throughput with baseline results.
+ *
+ * Benchmarks are run @c bench_max_nruns times and the medians are
+ * compared with the baseline saved by bench_run().
+ *
+ * @param bfname Name of JSON file with baseline results
+ * @param threshold Maximum allowed slowdown of any phase in percent
+ * @param f Output file for the report
+ * @return EOK if no phase regressed, EINVAL if any phase regressed,
+ *         other error code on failure
+ */
+int bench_compare(const char *bfname, unsigned threshold, FILE *f)
+{
+	bench_res_t base[bck_limit];
+	bench_res_t res[bck_limit];
+	bool have[bck_limit][bph_limit];
+	bcorpus_kind_t kind;
+	unsigned bnruns;
+	unsigned phase;
+	unsigned nregr;
+	unsigned nskip;
+	const char *status;
+	int rc;
+
+	memset(base, 0, sizeof(base));
+
+	rc = bench_load_json(bfname, base, have, &bnruns);
+	if (rc != EOK) {
+		fprintf(stderr, "Error reading '%s'.\n", bfname);
+		return rc;
+	}
+
+	rc = bench_measure(bench_max_nruns, res);
+	if (rc != EOK)
+		return rc;
+
+	fprintf(f, "%-12s %-10s %19s %19s %8s\n", "File", "Phase",
+	    "Baseline [ms]", "Current [ms]", "Change");
+
+	nregr = 0;
+	nskip = 0;
+	for (kind = 0; kind < bck_limit; kind++) {
+		for (phase = 0; phase < bph_limit; phase++) {
+			fprintf(f, "%-12s %-10s ", res[kind].fname,
+			    bench_phase_str(phase));
+
+			/* Source generated differently, cannot compare */
+			if (!have[kind][phase] || base[kind].time[phase] == 0 ||
+			    base[kind].nbytes != res[kind].nbytes) {
+				fprintf(f, "%19s %10.3f\n", "n/a",
+				    res[kind].time[phase] / 1e6);
+				++nskip;
+				continue;
+			}
+
+			if (bench_regressed(base[kind].time[phase],
+			    base[kind].mad[phase], bnruns,
+			    res[kind].time[phase], res[kind].mad[phase],
+			    bench_max_nruns, threshold)) {
+				status = "  REGRESSED";
+				++nregr;
+			} else {
+				status = "";
+			}
+
+			fprintf(f, "%10.3f (%6.3f) %10.3f (%6.3f) %+7.1f%%%s\n",
+			    base[kind].time[phase] / 1e6,
+			    base[kind].mad[phase] / 1e6,
+			    res[kind].time[phase] / 1e6,
+			    res[kind].mad[phase] / 1e6,
+			    100.0 * ((double)res[kind].time[phase] /
+			    base[kind].time[phase] - 1.0), status);
+		}
+	}
+
+	fprintf(f, "Times are medians of %d runs (median absolute deviation "
+	    "in parentheses).\n", (int)bench_max_nruns);
+	if (nskip > 0) {
+		fprintf(f, "%u phases not compared (missing in baseline or "
+		    "source generated differently).\n", nskip);
+	}
+
+	if (nregr > 0) {
+		fprintf(f, "Benchmark failed: %u phases slower by more "
+		    "than %u%%.\n", nregr, threshold);
+		return EINVAL;
+	}
+
+	fprintf(f, "Benchmark passed: no phase slower by more than %u%%.\n",
+	    threshold);
+	return EOK;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Lexer input from memory buffer
+ *
+ * Used to check text that is already in memory (e.g. an unsaved editor
+ * buffer) without going through a file. The buffer is not required
+ * to be null-terminated and can contain null characters. The lexer
+ * scans the buffer in place.
+ */
+
+#include <buf_input.h>
+#include <merrno.h>
+#include <src_pos.h>
+#include <string.h>
+
+static int buf_lexer_read(void *, char *, size_t, size_t *, src_pos_t *);
+static int buf_lexer_map(void *, const char **, size_t *, src_pos_t *);
+
+lexer_input_ops_t lexer_buf_input = {
+	.read = buf_lexer_read,
+	.map = buf_lexer_map
+};
+
+/** Lexer input from memory buffer.
+ *
+ * @param arg Buffer input (buf_input_t *)
+ * @param buf Buffer to read to
+ * @param bsize Buffer size
+ * @param nread Place to store number of bytes read
+ * @param bpos Place to store source position of first byte read
+ * @return EOK on success
+ */
+static int buf_lexer_read(void *arg, char *buf, size_t bsize, size_t *nread,
+    src_pos_t *bpos)
+{
+	buf_input_t *binput = (buf_input_t *)arg;
+	size_t nr;
+	size_t i;
+
+	nr = binput->size - binput->pos;
+	if (nr > bsize)
+		nr = bsize;
+
+	memcpy(buf, binput->buf + binput->pos, nr);
+	binput->pos += nr;
+
+	*nread = nr;
+	*bpos = binput->cpos;
+
+	/* Advance source position */
+	for (i = 0; i < nr; i++)
+		src_pos_fwd_char(&binput->cpos, buf[i]);
+
+	return EOK;
+}
+
+/** Map memory buffer to lexer.
+ *
+ * The rest of the buffer is handed to the lexer to scan in place.
+ *
+ * @param arg Buffer input (buf_input_t *)
+ * @param rbuf Place to store pointer to remaining characters
+ * @param rsize Place to store number of remaining characters
+ * @param bpos Place to store source position of first character
+ * @return EOK on success
+ */
+static int buf_lexer_map(void *arg, const char **rbuf, size_t *rsize,
+    src_pos_t *bpos)
+{
+	buf_input_t *binput = (buf_input_t *)arg;
+
+	*rbuf = binput->buf + binput->pos;
+	*rsize = binput->size - binput->pos;
+	*bpos = binput->cpos;
+
+	/* The lexer tracks the source position from here on */
+	binput->pos = binput->size;
+	return EOK;
+}
+
+/** Initialize lexer input from memory buffer.
+ *
+ * The buffer must stay valid while the input is in use.
+ *
+ * @param binput Buffer input
+ * @param buf Buffer
+ * @param size Buffer size
+ * @param fname File name used in source positions
+ */
+void buf_input_init(buf_input_t *binput, const char *buf, size_t size,
+    const char *fname)
+{
+	binput->buf = buf;
+	binput->size = size;
+	binput->pos = 0;
+
+	src_pos_set(&binput->cpos, fname, 1, 1);
+}
@@ -25,15 +25,29 @@
  */
 
 #include <adt/list.h>
+#include <alloc.h>
 #include <assert.h>
 #include <ast.h>
+#include <buf_input.h>
 #include <checker.h>
+#include <diag.h>
+#include <hash.h>
 #include <lexer.h>
 #include <merrno.h>
 #include <parser.h>
+#include <src_pos.h>
 #include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
+#include <time.h>
+#include <trace.h>
+
+enum {
+	/** Number of unchanged lines shown around changes in a diff */
+	checker_diff_ctx = 3
+};
 
 static void checker_parser_read_tok(void *, void *, unsigned, bool,
     lexer_tok_t *);
@@ -58,9 +72,11 @@ static int checker_check_init(checker_scope_t *, ast_node_t *);
 static int checker_check_mdecln(checker_scope_t *, ast_mdecln_t *);
 static int checker_check_global_decln(checker_scope_t *, ast_node_t *);
 static checker_tok_t *checker_module_first_tok(checker_module_t *);
-static void checker_remove_token(checker_tok_t *);
+static void checker_tok_destroy(checker_tok_t *);
 static checker_cfg_t *checker_scfg(checker_scope_t *);
 static checker_mtype_t checker_smtype(checker_scope_t *);
+static void checker_decl_destroy(checker_decl_t *);
+static uint64_t checker_diag_fp(checker_tok_t *, diag_msg_t);
 
 static parser_input_ops_t checker_parser_input = {
 	.read_tok = checker_parser_read_tok,
@@ -69,12 +85,12 @@ static parser_input_ops_t checker_parser_input = {
 };
 
 enum {
-	/** Maximum number of characters on a line */
-	line_length_limit = 80,
 	/** Number of spaces used to indent a continuation line */
 	cont_indent_spaces = 4,
 	/** Number of spaces used to indent a secondary continuation line */
-	seccont_indent_spaces = 6
+	seccont_indent_spaces = 6,
+	/** Initial number of entries allocated for suppression changes */
+	supp_ev_init_alloc = 16
 };
 
 /** Create checker module.
@@ -89,11 +105,12 @@ static int checker_module_create(checker_t *checker,
 {
 	checker_module_t *module = NULL;
 
-	module = calloc(1, sizeof(checker_module_t));
+	module = alloc_calloc(as_checker, 1, sizeof(checker_module_t));
 	if (module == NULL)
 		return ENOMEM;
 
 	list_initialize(&module->toks);
+	list_initialize(&module->decls);
 	module->checker = checker;
 
 	*rmodule = module;
@@ -107,17 +124,25 @@ static int checker_module_create(checker_t *checker,
 static void checker_module_destroy(checker_module_t *module)
 {
 	checker_tok_t *tok;
+	link_t *link;
+
+	while ((link = list_first(&module->decls)) != NULL) {
+		checker_decl_destroy(list_get_instance(link, checker_decl_t,
+		    ldecls));
+	}
 
 	if (module->ast != NULL)
 		ast_tree_destroy(&module->ast->node);
 
 	tok = checker_module_first_tok(module);
 	while (tok != NULL) {
-		checker_remove_token(tok);
+		checker_tok_destroy(tok);
 		tok = checker_module_first_tok(module);
 	}
 
-	free(module);
+	alloc_free(module->lfixed);
+	alloc_free(module->supp);
+	alloc_free(module);
 }
 
 /** Create a checker token.
@@ -131,7 +156,7 @@ static int checker_tok_new(lexer_tok_t *tok, checker_tok_t **rctok)
 {
 	checker_tok_t *ctok;
 
-	ctok = calloc(1, sizeof(checker_tok_t));
+	ctok = alloc_calloc(as_checker, 1, sizeof(checker_tok_t));
 	if (ctok == NULL)
 		return ENOMEM;
 
@@ -161,6 +186,11 @@ static int checker_module_append(checker_module_t *module, lexer_tok_t *tok)
 	ctok->mod = module;
 	list_append(&ctok->ltoks, &module->toks);
 
+	if (tok->sdir != lsd_none) {
+		++module->nsdirs;
+		module->supp_valid = false;
+	}
+
 	return EOK;
 }
 
@@ -179,9 +209,12 @@ int checker_create(lexer_input_ops_t *input_ops, void *input_arg,
 {
 	checker_t *checker = NULL;
 	lexer_t *lexer = NULL;
+	alloc_mark_t amark;
 	int rc;
 
-	checker = calloc(1, sizeof(checker_t));
+	alloc_track_mark(&amark);
+
+	checker = alloc_calloc(as_checker, 1, sizeof(checker_t));
 	if (checker == NULL) {
 		rc = ENOMEM;
 		goto error;
@@ -196,25 +229,369 @@ int checker_create(lexer_input_ops_t *input_ops, void *input_arg,
 	checker->lexer = lexer;
 	checker->mtype = mtype;
 	checker->cfg = cfg;
+	diag_list_init(&checker->diags);
+	checker->sink_ops = &diag_list_sink;
+	checker->sink_arg = &checker->diags;
+	checker->errf = stderr;
+	checker->amark = amark;
 	*rchecker = checker;
 	return EOK;
 error:
 	if (lexer != NULL)
 		lexer_destroy(lexer);
 	if (checker != NULL)
-		free(checker);
+		alloc_free(checker);
 	return rc;
 }
 
 /** Destroy checker.
+ *
+ * If allocations are being tracked, any lexer, parser, AST or checker
+ * memory allocated since the checker was created and not freed now
+ * is counted as leaked.
  *
  * @param checker Checker
  */
 void checker_destroy(checker_t *checker)
 {
-	checker_module_destroy(checker->mod);
+	alloc_mark_t amark = checker->amark;
+
+	if (checker->mod != NULL)
+		checker_module_destroy(checker->mod);
 	lexer_destroy(checker->lexer);
-	free(checker);
+	diag_list_fini(&checker->diags);
+	alloc_free(checker->lrange);
+	alloc_free(checker->dext);
+	alloc_free(checker);
+
+	(void) alloc_track_check(&amark);
+}
+
+/** Compare two line ranges for sorting.
+ *
+ * @param a Pointer to first range (checker_lrange_t *)
+ * @param b Pointer to second range (checker_lrange_t *)
+ * @return Less than, equal to or greater than zero
+ */
+static int checker_lrange_cmp(const void *a, const void *b)
+{
+	const checker_lrange_t *ra = (const checker_lrange_t *) a;
+	const checker_lrange_t *rb = (const checker_lrange_t *) b;
+
+	if (ra->bline != rb->bline)
+		return ra->bline < rb->bline ? -1 : 1;
+
+	return 0;
+}
+
+/** Restrict checking to ranges of lines.
+ *
+ * Issues are only reported (or fixed) on lines within one of the ranges.
+ * Global declarations that do not intersect any of the ranges are not
+ * checked at all.
+ *
+ * @param checker Checker
+ * @param ranges Line ranges (in any order, possibly overlapping)
+ * @param nranges Number of ranges (zero means nothing is checked)
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int checker_set_lines(checker_t *checker, checker_lrange_t *ranges,
+    size_t nranges)
+{
+	checker_lrange_t *lrange;
+	size_t i, n;
+
+	lrange = alloc_calloc(as_checker, nranges + 1,
+	    sizeof(checker_lrange_t));
+	if (lrange == NULL)
+		return ENOMEM;
+
+	if (nranges > 0) {
+		memcpy(lrange, ranges, nranges * sizeof(checker_lrange_t));
+		qsort(lrange, nranges, sizeof(checker_lrange_t),
+		    checker_lrange_cmp);
+	}
+
+	/* Merge overlapping and adjacent ranges */
+	n = 0;
+	for (i = 0; i < nranges; i++) {
+		if (n > 0 && lrange[i].bline <= lrange[n - 1].eline + 1) {
+			if (lrange[i].eline > lrange[n - 1].eline)
+				lrange[n - 1].eline = lrange[i].eline;
+		} else {
+			lrange[n++] = lrange[i];
+		}
+	}
+
+	alloc_free(checker->lrange);
+	checker->lrange = lrange;
+	checker->nlranges = n;
+	checker->lfilter = true;
+	return EOK;
+}
+
+/** Determine if lines intersect the checked line ranges.
+ *
+ * @param checker Checker
+ * @param bline First line
+ * @param eline Last line
+ * @return @c true iff any of the lines is to be checked
+ */
+static bool checker_lines_checked(checker_t *checker, size_t bline,
+    size_t eline)
+{
+	size_t lo, hi, mid;
+
+	if (!checker->lfilter)
+		return true;
+
+	/* Find first range that does not end before @a bline */
+	lo = 0;
+	hi = checker->nlranges;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (checker->lrange[mid].eline < bline)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo < checker->nlranges && checker->lrange[lo].bline <= eline;
+}
+
+/** Determine if a check is suppressed at a line.
+ *
+ * @param mod Checker module
+ * @param line Line number
+ * @param msg Message ID
+ * @return @c true iff the check group of @a msg is suppressed
+ *         at @a line by an annotation
+ */
+static bool checker_line_suppressed(checker_module_t *mod, size_t line,
+    diag_msg_t msg)
+{
+	size_t lo, hi, mid;
+
+	if (mod->nsupp == 0)
+		return false;
+
+	/* Find first entry starting after @a line */
+	lo = 0;
+	hi = mod->nsupp;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (mod->supp[mid].bline <= line)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo == 0)
+		return false;
+
+	return (mod->supp[lo - 1].mask & (1u << diag_msg_group(msg))) != 0;
+}
+
+/** Determine if issue with a token should be fixed.
+ *
+ * Issues outside of the checked line ranges or suppressed by
+ * an annotation are neither fixed nor reported.
+ *
+ * @param tok Token the issue is reported at
+ * @param msg Message ID of the issue
+ * @param fix @c true if fixing issues is enabled
+ * @return @c true iff the issue should be fixed
+ */
+static bool checker_fix_tok(checker_tok_t *tok, diag_msg_t msg, bool fix)
+{
+	return fix && checker_lines_checked(tok->mod->checker,
+	    tok->tok.bpos.line, tok->tok.bpos.line) &&
+	    !checker_line_suppressed(tok->mod, tok->tok.bpos.line, msg);
+}
+
+/** Set checker diagnostic sink.
+ *
+ * By default diagnostics are collected in the checker's diagnostic list
+ * and can be printed using checker_print_diags().
+ *
+ * @param checker Checker
+ * @param ops Diagnostic sink ops
+ * @param arg Argument to @a ops
+ */
+void checker_set_sink(checker_t *checker, diag_sink_ops_t *ops, void *arg)
+{
+	checker->sink_ops = ops;
+	checker->sink_arg = arg;
+}
+
+/** Set checker parse error output stream.
+ *
+ * Parse errors are written to @c stderr unless a different stream is set.
+ *
+ * @param checker Checker
+ * @param errf Error output stream
+ */
+void checker_set_errf(checker_t *checker, FILE *errf)
+{
+	checker->errf = errf;
+}
+
+/** Enable incremental mode.
+ *
+ * In incremental mode the checker remembers diagnostics reported for
+ * each global declaration so that the module can be updated after
+ * the source is edited using checker_update() and only the affected
+ * declarations need to be checked again. Only reporting mode is
+ * supported (not fixing).
+ *
+ * @param checker Checker
+ */
+void checker_set_incr(checker_t *checker)
+{
+	checker->incr = true;
+}
+
+/** Compute fingerprints of reported diagnostics.
+ *
+ * Fingerprints are only needed to match issues against a baseline.
+ * Without this, the @c fp field of reported diagnostics is zero.
+ *
+ * @param checker Checker
+ */
+void checker_set_fps(checker_t *checker)
+{
+	checker->fps = true;
+}
+
+/** Collect statistics while checking.
+ *
+ * Time spent in each phase and token and AST node counts are added
+ * to @a stats. If allocations are tracked, the peak memory use in each
+ * phase is taken from the allocation tracker of the calling thread.
+ *
+ * @param checker Checker
+ * @param stats Statistics to update (zero-initialized by caller) or
+ *              @c NULL to stop collecting statistics
+ */
+void checker_set_stats(checker_t *checker, checker_stats_t *stats)
+{
+	checker->stats = stats;
+}
+
+/** Write spans to event trace while checking.
+ *
+ * A span is written for each phase and for checking each global
+ * declaration.
+ *
+ * @param checker Checker
+ * @param trace Trace or @c NULL to stop tracing
+ */
+void checker_set_trace(checker_t *checker, trace_t *trace)
+{
+	checker->trace = trace;
+}
+
+/** Stop checking after a number of issues have been found.
+ *
+ * Once @a max issues have been reported, checking stops as soon as
+ * possible: no more declarations or statements are checked and the
+ * remaining passes over the module are skipped. Issues are thus found
+ * in checking order, not in source order. This is only useful in
+ * reporting mode (not fixing) and is ignored in incremental mode.
+ *
+ * @param checker Checker
+ * @param max Maximum number of issues or zero for no limit
+ */
+void checker_set_max_issues(checker_t *checker, unsigned max)
+{
+	checker->max_issues = max;
+}
+
+/** Get phase name.
+ *
+ * @param phase Checker phase
+ * @return Phase name
+ */
+const char *checker_phase_str(checker_phase_t phase)
+{
+	switch (phase) {
+	case cph_lex:
+		return "lex";
+	case cph_parse:
+		return "parse";
+	case cph_check:
+		return "check";
+	case cph_comments:
+		return "comments";
+	case cph_lines:
+		return "lines";
+	case cph_vspacing:
+		return "vspacing";
+	default:
+		assert(false);
+		return "unknown";
+	}
+}
+
+/** Read clock.
+ *
+ * @param clk Clock ID
+ * @return Clock time in nanoseconds
+ */
+static uint64_t checker_clock(clockid_t clk)
+{
+	struct timespec ts;
+
+	if (clock_gettime(clk, &ts) != 0)
+		return 0;
+
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/** Begin measuring checker phase.
+ *
+ * @param checker Checker
+ * @param mark Place to store start of phase
+ */
+static void checker_phase_begin(checker_t *checker,
+    checker_stats_mark_t *mark)
+{
+	if (checker->stats == NULL && checker->trace == NULL)
+		return;
+
+	mark->wall = checker_clock(CLOCK_MONOTONIC);
+	if (checker->stats != NULL) {
+		mark->cpu = checker_clock(CLOCK_THREAD_CPUTIME_ID);
+		alloc_track_reset_peak();
+	}
+}
+
+/** End measuring checker phase.
+ *
+ * @param checker Checker
+ * @param phase Checker phase
+ * @param mark Start of phase filled in by checker_phase_begin()
+ */
+static void checker_phase_end(checker_t *checker, checker_phase_t phase,
+    checker_stats_mark_t *mark)
+{
+	checker_stats_t *stats = checker->stats;
+	size_t peak;
+
+	if (checker->trace != NULL) {
+		trace_span(checker->trace, "phase", checker_phase_str(phase),
+		    mark->wall, 0);
+	}
+
+	if (stats == NULL)
+		return;
+
+	stats->wall[phase] += checker_clock(CLOCK_MONOTONIC) - mark->wall;
+	stats->cpu[phase] += checker_clock(CLOCK_THREAD_CPUTIME_ID) - mark->cpu;
+
+	peak = alloc_track_peak();
+	if (peak > stats->peak[phase])
+		stats->peak[phase] = peak;
 }
 
 /** Lex a module.
@@ -242,6 +619,11 @@ static int checker_module_lex(checker_t *checker, checker_module_t **rmodule)
 		if (rc != EOK)
 			return rc;
 
+		if (checker->stats != NULL) {
+			++checker->stats->ntoks;
+			checker->stats->nbytes += tok.text_size;
+		}
+
 		rc = checker_module_append(module, &tok);
 		if (rc != EOK) {
 			lexer_free_tok(&tok);
@@ -302,6 +684,7 @@ static checker_tok_t *checker_next_tok(checker_tok_t *tok)
 	if (tok == NULL)
 		return NULL;
 
+	++tok->mod->nvisits;
 	link = list_next(&tok->ltoks, &tok->mod->toks);
 	if (link == NULL)
 		return NULL;
@@ -321,6 +704,7 @@ static checker_tok_t *checker_prev_tok(checker_tok_t *tok)
 	if (tok == NULL)
 		return NULL;
 
+	++tok->mod->nvisits;
 	link = list_prev(&tok->ltoks, &tok->mod->toks);
 	if (link == NULL)
 		return NULL;
@@ -328,6 +712,169 @@ static checker_tok_t *checker_prev_tok(checker_tok_t *tok)
 	return list_get_instance(link, checker_tok_t, ltoks);
 }
 
+/** Fill in diagnostic referring to a token.
+ *
+ * @param diag Diagnostic to fill in
+ * @param tok Token
+ * @param bpos Beginning of the range the diagnostic points to
+ * @param epos End of the range the diagnostic points to
+ * @param msg Message ID
+ */
+static void checker_diag_init(diag_t *diag, checker_tok_t *tok,
+    src_pos_t *bpos, src_pos_t *epos, diag_msg_t msg)
+{
+	memset(diag, 0, sizeof(diag_t));
+	diag->file = bpos->file;
+	diag->bline = bpos->line;
+	diag->bcol = bpos->col;
+	diag->eline = epos->line;
+	diag->ecol = epos->col;
+	diag->ttype = tok->tok.ttype;
+
+	switch (tok->tok.ttype) {
+	case ltt_ident:
+	case ltt_number:
+	case ltt_invalid:
+		diag->ttext = tok->tok.text;
+		break;
+	default:
+		diag->ttext = NULL;
+		break;
+	}
+
+	diag->group = diag_msg_group(msg);
+	diag->msg = msg;
+}
+
+/** Report diagnostic to the checker's diagnostic sink.
+ *
+ * If the sink fails, the error is remembered and returned by checker_run().
+ * No further diagnostics are reported after that, nor after the issue
+ * limit is reached.
+ *
+ * @param checker Checker
+ * @param diag Diagnostic
+ */
+static void checker_report(checker_t *checker, diag_t *diag)
+{
+	int rc;
+
+	if (checker->sink_rc != EOK || checker->stop)
+		return;
+
+	if (!checker_lines_checked(checker, diag->bline, diag->bline))
+		return;
+
+	rc = checker->sink_ops->report(checker->sink_arg, diag);
+	if (rc != EOK)
+		checker->sink_rc = rc;
+
+	if (checker->max_issues != 0 && !checker->incr &&
+	    ++checker->nissues >= checker->max_issues)
+		checker->stop = true;
+}
+
+/** Determine if issue with a token is going to be reported.
+ *
+ * This is checked before the diagnostic is filled in, so issues outside
+ * of the checked lines, suppressed issues and issues past the issue limit
+ * cost next to nothing.
+ *
+ * @param tok Token
+ * @param line Line the issue is reported at
+ * @param msg Message ID
+ * @return @c true iff the issue should be reported
+ */
+static bool checker_diag_wanted(checker_tok_t *tok, size_t line,
+    diag_msg_t msg)
+{
+	checker_t *checker = tok->mod->checker;
+
+	return checker->sink_rc == EOK && !checker->stop &&
+	    checker_lines_checked(checker, line, line) &&
+	    !checker_line_suppressed(tok->mod, line, msg);
+}
+
+/** Report diagnostic referring to a token.
+ *
+ * The fingerprint is only computed if enabled.
+ *
+ * @param tok Token the diagnostic refers to
+ * @param diag Diagnostic
+ */
+static void checker_report_tok(checker_tok_t *tok, diag_t *diag)
+{
+	checker_t *checker = tok->mod->checker;
+
+	if (checker->fps)
+		diag->fp = checker_diag_fp(tok, diag->msg);
+
+	checker_report(checker, diag);
+}
+
+/** Report issue with a token.
+ *
+ * @param tok Token
+ * @param msg Message ID
+ * @param text Message text argument (static string) or @c NULL
+ */
+static void checker_diag(checker_tok_t *tok, diag_msg_t msg, const char *text)
+{
+	diag_t diag;
+
+	if (!checker_diag_wanted(tok, tok->tok.bpos.line, msg))
+		return;
+
+	checker_diag_init(&diag, tok, &tok->tok.bpos, &tok->tok.epos, msg);
+	diag.text = text;
+	checker_report_tok(tok, &diag);
+}
+
+/** Report issue with a token with numeric arguments.
+ *
+ * @param tok Token
+ * @param msg Message ID
+ * @param n1 First numeric argument
+ * @param n2 Second numeric argument
+ */
+static void checker_diag_num(checker_tok_t *tok, diag_msg_t msg,
+    unsigned n1, unsigned n2)
+{
+	diag_t diag;
+
+	if (!checker_diag_wanted(tok, tok->tok.bpos.line, msg))
+		return;
+
+	checker_diag_init(&diag, tok, &tok->tok.bpos, &tok->tok.epos, msg);
+	diag.num[0] = n1;
+	diag.num[1] = n2;
+	checker_report_tok(tok, &diag);
+}
+
+/** Report issue with a particular character of a token.
+ *
+ * @param tok Token
+ * @param offs Offset of the offending character in token text
+ * @param msg Message ID
+ */
+static void checker_diag_chr(checker_tok_t *tok, size_t offs, diag_msg_t msg)
+{
+	diag_t diag;
+	src_pos_t pos;
+	size_t i;
+
+	pos = tok->tok.bpos;
+	for (i = 0; i < offs; i++)
+		src_pos_fwd_char(&pos, tok->tok.text[i]);
+
+	if (!checker_diag_wanted(tok, pos.line, msg))
+		return;
+
+	checker_diag_init(&diag, tok, &pos, &pos, msg);
+	diag.chr = tok->tok.text[offs];
+	checker_report_tok(tok, &diag);
+}
+
 /** Check a token that does not itself have whitespace requirements.
  *
  * @param scope Checker scope
@@ -382,6 +929,24 @@ static checker_tok_t *checker_prev_newline(checker_tok_t *tok)
 	return NULL;
 }
 
+/** Mark source lines as changed by a fix.
+ *
+ * @param mod Checker module
+ * @param bline First changed line
+ * @param eline Last changed line
+ */
+static void checker_mark_fixed(checker_module_t *mod, size_t bline,
+    size_t eline)
+{
+	size_t l;
+
+	if (mod->lfixed == NULL)
+		return;
+
+	for (l = bline; l <= eline && l < mod->nlines; l++)
+		mod->lfixed[l] = true;
+}
+
 /** Prepend a new token before a token in the source code.
  *
  * @param tok Token before which to prepend
@@ -396,18 +961,21 @@ static int checker_prepend_tok(checker_tok_t *tok, lexer_toktype_t ltt,
 	char *dtext;
 	int rc;
 
-	dtext = strdup(text);
+	dtext = alloc_strdup(as_checker, text);
 	if (dtext == NULL)
 		return ENOMEM;
 
+	t.bpos = tok->tok.bpos;
+	t.epos = tok->tok.bpos;
 	t.ttype = ltt;
+	t.sdir = lsd_none;
 	t.text = dtext;
 	t.text_size = strlen(dtext);
 	t.udata = NULL;
 
 	rc = checker_tok_new(&t, &ctok);
 	if (rc != EOK) {
-		free(dtext);
+		alloc_free(dtext);
 		return ENOMEM;
 	}
 
@@ -415,6 +983,7 @@ static int checker_prepend_tok(checker_tok_t *tok, lexer_toktype_t ltt,
 	ctok->pindlvl = tok->pindlvl;
 	ctok->pseccont = tok->pseccont;
 	list_insert_before(&ctok->ltoks, &tok->ltoks);
+	checker_mark_fixed(tok->mod, t.bpos.line, t.bpos.line);
 
 	return EOK;
 }
@@ -433,18 +1002,21 @@ static int checker_append_tok(checker_tok_t *tok, lexer_toktype_t ltt,
 	char *dtext;
 	int rc;
 
-	dtext = strdup(text);
+	dtext = alloc_strdup(as_checker, text);
 	if (dtext == NULL)
 		return ENOMEM;
 
+	t.bpos = tok->tok.epos;
+	t.epos = tok->tok.epos;
 	t.ttype = ltt;
+	t.sdir = lsd_none;
 	t.text = dtext;
 	t.text_size = strlen(dtext);
 	t.udata = NULL;
 
 	rc = checker_tok_new(&t, &ctok);
 	if (rc != EOK) {
-		free(dtext);
+		alloc_free(dtext);
 		return ENOMEM;
 	}
 
@@ -452,6 +1024,7 @@ static int checker_append_tok(checker_tok_t *tok, lexer_toktype_t ltt,
 	ctok->pindlvl = tok->pindlvl;
 	ctok->pseccont = tok->pseccont;
 	list_insert_after(&ctok->ltoks, &tok->ltoks);
+	checker_mark_fixed(tok->mod, t.bpos.line, t.bpos.line);
 
 	return EOK;
 }
@@ -459,18 +1032,21 @@ static int checker_append_tok(checker_tok_t *tok, lexer_toktype_t ltt,
 /** Change token text.
  *
  * @param tok Token to change
- * @param text Nex text for the token
+ * @param text New text for the token
+ * @return EOK on success or error code
  */
 static int checker_set_tok_text(checker_tok_t *tok, const char *text)
 {
 	char *dtext;
 
-	dtext = strdup(text);
+	dtext = alloc_strdup(as_checker, text);
 	if (dtext == NULL)
 		return ENOMEM;
 
-	free(tok->tok.text);
+	alloc_free(tok->tok.text);
 	tok->tok.text = dtext;
+	tok->tok.text_size = strlen(dtext);
+	checker_mark_fixed(tok->mod, tok->tok.bpos.line, tok->tok.epos.line);
 	return EOK;
 }
 
@@ -481,21 +1057,43 @@ static int checker_set_tok_text(checker_tok_t *tok, const char *text)
  */
 static int checker_tok_strip_char1(checker_tok_t *tok)
 {
-	if (strlen(tok->tok.text) < 2)
+	if (tok->tok.text_size < 2)
 		return EINVAL;
 
 	return checker_set_tok_text(tok, tok->tok.text + 1);
 }
 
+/** Destroy a checker token.
+ *
+ * @param tok Token to destroy
+ */
+static void checker_tok_destroy(checker_tok_t *tok)
+{
+	if (tok->tok.sdir != lsd_none) {
+		--tok->mod->nsdirs;
+		tok->mod->supp_valid = false;
+	}
+
+	list_remove(&tok->ltoks);
+	lexer_free_tok(&tok->tok);
+	alloc_free(tok);
+}
+
 /** Remove a token from the source code.
  *
  * @param tok Token to remove
  */
 static void checker_remove_token(checker_tok_t *tok)
 {
-	list_remove(&tok->ltoks);
-	lexer_free_tok(&tok->tok);
-	free(tok);
+	size_t eline;
+
+	/* Removing a newline joins the following line */
+	eline = tok->tok.epos.line;
+	if (tok->tok.ttype == ltt_newline)
+		++eline;
+
+	checker_mark_fixed(tok->mod, tok->tok.bpos.line, eline);
+	checker_tok_destroy(tok);
 }
 
 /** Remove whitespace before token.
@@ -655,7 +1253,7 @@ static int checker_check_lbegin(checker_scope_t *scope, checker_tok_t *tok,
 	}
 
 	if (!checker_is_tok_lbegin(tok) && checker_scfg(scope)->fmt) {
-		if (scope->fix) {
+		if (checker_fix_tok(tok, dm_lbegin, scope->fix)) {
 			checker_remove_ws_before(tok);
 
 			rc = checker_prepend_tok(tok, ltt_newline, "\n");
@@ -669,8 +1267,7 @@ static int checker_check_lbegin(checker_scope_t *scope, checker_tok_t *tok,
 					return rc;
 			}
 		} else {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": %s\n", msg);
+			checker_diag(tok, dm_lbegin, msg);
 		}
 	}
 
@@ -696,11 +1293,10 @@ static void checker_check_nows_before(checker_scope_t *scope,
 	assert(p != NULL);
 
 	if (lexer_is_wspace(p->tok.ttype) && checker_scfg(scope)->fmt) {
-		if (scope->fix) {
+		if (checker_fix_tok(p, dm_nows_before, scope->fix)) {
 			checker_remove_ws_before(tok);
 		} else {
-			lexer_dprint_tok(&p->tok, stdout);
-			printf(": %s\n", msg);
+			checker_diag(p, dm_nows_before, msg);
 		}
 	}
 }
@@ -721,11 +1317,10 @@ static void checker_check_nows_after(checker_scope_t *scope,
 	assert(p != NULL);
 
 	if (lexer_is_wspace(p->tok.ttype) && checker_scfg(scope)->fmt) {
-		if (scope->fix) {
+		if (checker_fix_tok(p, dm_nows_after, scope->fix)) {
 			checker_remove_ws_after(tok);
 		} else {
-			lexer_dprint_tok(&p->tok, stdout);
-			printf(": %s\n", msg);
+			checker_diag(p, dm_nows_after, msg);
 		}
 	}
 }
@@ -748,11 +1343,10 @@ static void checker_check_nsbrk_before(checker_scope_t *scope,
 	if (lexer_is_wspace(p->tok.ttype) && !checker_is_tok_lbegin(tok) &&
 	    checker_scfg(scope)->fmt) {
 
-		if (scope->fix) {
+		if (checker_fix_tok(p, dm_nsbrk_before, scope->fix)) {
 			checker_remove_ws_before(tok);
 		} else {
-			lexer_dprint_tok(&p->tok, stdout);
-			printf(": %s\n", msg);
+			checker_diag(p, dm_nsbrk_before, msg);
 		}
 	}
 }
@@ -789,11 +1383,10 @@ static void checker_check_nsbrk_after(checker_scope_t *scope,
 
 	if (lexer_is_wspace(p->tok.ttype) && p->tok.ttype != ltt_newline &&
 	    checker_scfg(scope)->fmt) {
-		if (scope->fix) {
+		if (checker_fix_tok(p, dm_nsbrk_after, scope->fix)) {
 			checker_remove_ws_after(tok);
 		} else {
-			lexer_dprint_tok(&p->tok, stdout);
-			printf(": %s\n", msg);
+			checker_diag(p, dm_nsbrk_after, msg);
 		}
 	}
 }
@@ -816,13 +1409,12 @@ static int checker_check_brkspace_before(checker_scope_t *scope,
 	assert(p != NULL);
 
 	if (!lexer_is_wspace(p->tok.ttype) && checker_scfg(scope)->fmt) {
-		if (scope->fix) {
+		if (checker_fix_tok(p, dm_brkspace_before, scope->fix)) {
 			rc = checker_prepend_tok(tok, ltt_space, " ");
 			if (rc != EOK)
 				return rc;
 		} else {
-			lexer_dprint_tok(&p->tok, stdout);
-			printf(": %s\n", msg);
+			checker_diag(p, dm_brkspace_before, msg);
 		}
 	}
 
@@ -869,13 +1461,12 @@ static int checker_check_brkspace_after(checker_scope_t *scope,
 	assert(p != NULL);
 
 	if (!lexer_is_wspace(p->tok.ttype) && checker_scfg(scope)->fmt) {
-		if (scope->fix) {
+		if (checker_fix_tok(p, dm_brkspace_after, scope->fix)) {
 			rc = checker_append_tok(tok, ltt_space, " ");
 			if (rc != EOK)
 				return rc;
 		} else {
-			lexer_dprint_tok(&p->tok, stdout);
-			printf(": %s\n", msg);
+			checker_diag(p, dm_brkspace_after, msg);
 		}
 	}
 
@@ -906,15 +1497,14 @@ static int checker_check_nbspace_before(checker_scope_t *scope,
 
 	if ((!lexer_is_wspace(p->tok.ttype) || checker_is_tok_lbegin(tok)) &&
 	    checker_scfg(scope)->fmt) {
-		if (scope->fix) {
+		if (checker_fix_tok(p, dm_nbspace_before, scope->fix)) {
 			checker_remove_ws_before(tok);
 
 			rc = checker_prepend_tok(tok, ltt_space, " ");
 			if (rc != EOK)
 				return rc;
 		} else {
-			lexer_dprint_tok(&p->tok, stdout);
-			printf(": %s\n", msg);
+			checker_diag(p, dm_nbspace_before, msg);
 		}
 	}
 
@@ -940,7 +1530,7 @@ static int checker_check_binop_not_lbegin(checker_scope_t *scope,
 	checker_check_any(scope, tok);
 
 	if (checker_is_tok_lbegin(tok) && checker_scfg(scope)->fmt) {
-		if (scope->fix) {
+		if (checker_fix_tok(tok, dm_binop_lbegin, scope->fix)) {
 			p = checker_prev_newline(tok);
 			assert(p != NULL);
 
@@ -950,14 +1540,15 @@ static int checker_check_binop_not_lbegin(checker_scope_t *scope,
 			/* Move operator before the preceding line break */
 			list_remove(&tok->ltoks);
 			list_insert_before(&tok->ltoks, &p->ltoks);
+			checker_mark_fixed(tok->mod, p->tok.bpos.line,
+			    tok->tok.bpos.line);
 
 			/* Prepend a single space */
 			rc = checker_prepend_tok(tok, ltt_space, " ");
 			if (rc != EOK)
 				return rc;
 		} else {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": %s\n", msg);
+			checker_diag(tok, dm_binop_lbegin, msg);
 		}
 	}
 
@@ -975,7 +1566,7 @@ static checker_scope_t *checker_scope_toplvl(checker_module_t *mod,
 {
 	checker_scope_t *tscope;
 
-	tscope = calloc(1, sizeof(checker_scope_t));
+	tscope = alloc_calloc(as_checker, 1, sizeof(checker_scope_t));
 	if (tscope == NULL)
 		return NULL;
 
@@ -995,7 +1586,7 @@ static checker_scope_t *checker_scope_nested(checker_scope_t *scope)
 {
 	checker_scope_t *nscope;
 
-	nscope = calloc(1, sizeof(checker_scope_t));
+	nscope = alloc_calloc(as_checker, 1, sizeof(checker_scope_t));
 	if (nscope == NULL)
 		return NULL;
 
@@ -1015,7 +1606,7 @@ static checker_scope_t *checker_scope_secindent(checker_scope_t *scope)
 {
 	checker_scope_t *nscope;
 
-	nscope = calloc(1, sizeof(checker_scope_t));
+	nscope = alloc_calloc(as_checker, 1, sizeof(checker_scope_t));
 	if (nscope == NULL)
 		return NULL;
 
@@ -1033,41 +1624,437 @@ static checker_scope_t *checker_scope_secindent(checker_scope_t *scope)
  */
 static void checker_scope_destroy(checker_scope_t *scope)
 {
-	free(scope);
+	alloc_free(scope);
 }
 
-/** Parse a module.
+/** Determine if checking should stop (the issue limit was reached).
+ *
+ * @param scope Checker scope
+ * @return @c true iff no more issues are wanted
+ */
+static bool checker_scope_stopped(checker_scope_t *scope)
+{
+	return scope->mod->checker->stop;
+}
+
+/** Create checker declaration.
  *
  * @param mod Checker module
- * @return EOK on success or error code
+ * @param decl Declaration AST
+ * @param before Declaration to insert before or @c NULL to append
+ * @return EOK on success, ENOMEM if out of memory
  */
-static int checker_module_parse(checker_module_t *mod)
+static int checker_decl_create(checker_module_t *mod, ast_node_t *decl,
+    checker_decl_t *before)
 {
-	ast_module_t *amod;
-	parser_t *parser;
-	checker_parser_input_t pinput;
-	int rc;
+	checker_decl_t *cdecl;
 
-	rc = parser_create(&checker_parser_input, &pinput,
-	    checker_module_first_tok(mod), 0, false, &parser);
-	if (rc != EOK)
-		return rc;
+	cdecl = alloc_calloc(as_checker, 1, sizeof(checker_decl_t));
+	if (cdecl == NULL)
+		return ENOMEM;
 
-	rc = parser_process_module(parser, &amod);
-	if (rc != EOK)
-		goto error;
+	cdecl->decl = decl;
+	diag_list_init(&cdecl->diags);
+
+	if (before != NULL)
+		list_insert_before(&cdecl->ldecls, &before->ldecls);
+	else
+		list_append(&cdecl->ldecls, &mod->decls);
+
+	return EOK;
+}
+
+/** Destroy checker declaration.
+ *
+ * The declaration AST is not destroyed.
+ *
+ * @param cdecl Checker declaration
+ */
+static void checker_decl_destroy(checker_decl_t *cdecl)
+{
+	list_remove(&cdecl->ldecls);
+	diag_list_fini(&cdecl->diags);
+	alloc_free(cdecl);
+}
+
+/** Get first declaration in a checker module.
+ *
+ * @param mod Checker module
+ * @return First declaration or @c NULL
+ */
+static checker_decl_t *checker_module_first_decl(checker_module_t *mod)
+{
+	link_t *link;
+
+	link = list_first(&mod->decls);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, checker_decl_t, ldecls);
+}
+
+/** Get next declaration in a checker module.
+ *
+ * @param mod Checker module
+ * @param cdecl Current declaration
+ * @return Next declaration or @c NULL
+ */
+static checker_decl_t *checker_next_decl(checker_module_t *mod,
+    checker_decl_t *cdecl)
+{
+	link_t *link;
+
+	link = list_next(&cdecl->ldecls, &mod->decls);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, checker_decl_t, ldecls);
+}
+
+/** Get first token of a checker declaration.
+ *
+ * @param cdecl Checker declaration
+ * @return First token
+ */
+static checker_tok_t *checker_decl_first_tok(checker_decl_t *cdecl)
+{
+	return (checker_tok_t *) ast_tree_first_tok(cdecl->decl)->data;
+}
+
+/** Get last token of a checker declaration.
+ *
+ * @param cdecl Checker declaration
+ * @return Last token
+ */
+static checker_tok_t *checker_decl_last_tok(checker_decl_t *cdecl)
+{
+	return (checker_tok_t *) ast_tree_last_tok(cdecl->decl)->data;
+}
+
+/** Get name token of a global declaration.
+ *
+ * This is the identifier of the first declarator or, if there is none
+ * (e.g. a struct definition or a macro-based declaration), the first
+ * identifier in the declaration.
+ *
+ * @param decl Global declaration
+ * @return Name token or @c NULL if the declaration has no identifier
+ */
+static checker_tok_t *checker_decl_name(ast_node_t *decl)
+{
+	ast_gdecln_t *gdecln;
+	ast_idlist_entry_t *entry;
+	ast_tok_t *aident;
+	checker_tok_t *tok;
+	checker_tok_t *ltok;
+
+	if (decl->ntype == ant_gdecln) {
+		gdecln = (ast_gdecln_t *) decl->ext;
+		entry = ast_idlist_first(gdecln->idlist);
+		while (entry != NULL) {
+			aident = ast_decl_get_ident(entry->decl);
+			if (aident != NULL)
+				return (checker_tok_t *) aident->data;
+			entry = ast_idlist_next(entry);
+		}
+	}
+
+	tok = (checker_tok_t *) ast_tree_first_tok(decl)->data;
+	ltok = (checker_tok_t *) ast_tree_last_tok(decl)->data;
+	while (tok != NULL) {
+		if (tok->tok.ttype == ltt_ident)
+			return tok;
+		if (tok == ltok)
+			break;
+		tok = checker_next_tok(tok);
+	}
+
+	return NULL;
+}
+
+/** Append extent of a global declaration.
+ *
+ * @param checker Checker
+ * @param decl Global declaration
+ * @param alloc Number of allocated entries
+ */
+static void checker_dextent_add(checker_t *checker, ast_node_t *decl,
+    size_t alloc)
+{
+	checker_dextent_t *dext;
+
+	if (checker->ndext >= alloc)
+		return;
+
+	dext = &checker->dext[checker->ndext++];
+	dext->bpos = ((checker_tok_t *) ast_tree_first_tok(decl)->data)->
+	    tok.bpos;
+	dext->epos = ((checker_tok_t *) ast_tree_last_tok(decl)->data)->
+	    tok.epos;
+	dext->name = checker_decl_name(decl);
+}
+
+/** Build extents of global declarations of a module.
+ *
+ * @param mod Checker module
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int checker_dextent_build(checker_module_t *mod)
+{
+	checker_t *checker = mod->checker;
+	checker_decl_t *cdecl;
+	ast_node_t *decl;
+	size_t n;
+
+	if (checker->incr)
+		n = list_count(&mod->decls);
+	else
+		n = list_count(&mod->ast->decls);
+
+	alloc_free(checker->dext);
+	checker->ndext = 0;
+	checker->dext = alloc_calloc(as_checker, n + 1,
+	    sizeof(checker_dextent_t));
+	if (checker->dext == NULL)
+		return ENOMEM;
+
+	if (checker->incr) {
+		cdecl = checker_module_first_decl(mod);
+		while (cdecl != NULL) {
+			checker_dextent_add(checker, cdecl->decl, n);
+			cdecl = checker_next_decl(mod, cdecl);
+		}
+	} else {
+		decl = ast_module_first(mod->ast);
+		while (decl != NULL) {
+			checker_dextent_add(checker, decl, n);
+			decl = ast_module_next(decl);
+		}
+	}
+
+	checker->dext_valid = true;
+	return EOK;
+}
+
+/** Determine if source position precedes another source position.
+ *
+ * @param a First position
+ * @param b Second position
+ * @return @c true iff @a a is located before @a b
+ */
+static bool checker_pos_before(src_pos_t *a, src_pos_t *b)
+{
+	if (a->line != b->line)
+		return a->line < b->line;
+
+	return a->col < b->col;
+}
+
+/** Find global declaration a token belongs to.
+ *
+ * A token between global declarations (e.g. a comment) belongs to
+ * the following declaration.
+ *
+ * @param tok Token
+ * @param rinside Place to store @c true iff @a tok is within
+ *                the declaration
+ * @return Declaration extent or @c NULL if there is no such declaration
+ */
+static checker_dextent_t *checker_tok_dextent(checker_tok_t *tok,
+    bool *rinside)
+{
+	checker_t *checker = tok->mod->checker;
+	src_pos_t *pos = &tok->tok.bpos;
+	size_t lo, hi, mid;
+
+	*rinside = false;
+
+	if (!checker->dext_valid) {
+		if (tok->mod->ast == NULL ||
+		    checker_dextent_build(tok->mod) != EOK)
+			return NULL;
+	}
+
+	/* Find first declaration starting after @a pos */
+	lo = 0;
+	hi = checker->ndext;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (checker_pos_before(pos, &checker->dext[mid].bpos))
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+
+	if (lo > 0 && !checker_pos_before(&checker->dext[lo - 1].epos, pos)) {
+		*rinside = true;
+		return &checker->dext[lo - 1];
+	}
+
+	return lo < checker->ndext ? &checker->dext[lo] : NULL;
+}
+
+/** Hash token for diagnostic fingerprint.
+ *
+ * Whitespace is only represented by its type, as its text is often
+ * what the issue is about.
+ *
+ * @param hash Hash of preceding data
+ * @param tok Token or @c NULL
+ * @return Hash of preceding data followed by token
+ */
+static uint64_t checker_hash_tok(uint64_t hash, checker_tok_t *tok)
+{
+	uint8_t ttype;
+
+	if (tok == NULL)
+		return hash_fnv(hash, "", 1);
+
+	ttype = (uint8_t) tok->tok.ttype;
+	hash = hash_fnv(hash, &ttype, 1);
+	if (!lexer_is_wspace(tok->tok.ttype))
+		hash = hash_fnv(hash, tok->tok.text, tok->tok.text_size);
+
+	return hash_fnv(hash, "", 1);
+}
+
+/** Determine if token is significant for diagnostic fingerprints.
+ *
+ * @param tok Token
+ * @return @c true iff @a tok is neither whitespace nor a comment
+ */
+static bool checker_tok_fp_signif(checker_tok_t *tok)
+{
+	return !lexer_is_wspace(tok->tok.ttype) &&
+	    !lexer_is_comment(tok->tok.ttype);
+}
+
+/** Find nearest significant token for diagnostic fingerprint.
+ *
+ * This does not count as visiting tokens, since computing fingerprints
+ * is not part of checking.
+ *
+ * @param tok Token
+ * @param next @c true to search forward, @c false to search backward
+ * @return Nearest significant token before/after @a tok or @c NULL
+ */
+static checker_tok_t *checker_fp_adj_tok(checker_tok_t *tok, bool next)
+{
+	list_t *toks = &tok->mod->toks;
+	link_t *link = &tok->ltoks;
+
+	do {
+		link = next ? list_next(link, toks) : list_prev(link, toks);
+		if (link == NULL)
+			return NULL;
+
+		tok = list_get_instance(link, checker_tok_t, ltoks);
+	} while (!checker_tok_fp_signif(tok));
+
+	return tok;
+}
+
+/** Compute diagnostic fingerprint.
+ *
+ * The fingerprint is a hash of the message ID, the token, the nearest
+ * preceding and following tokens that are neither whitespace nor comments,
+ * and the name of the global declaration the token belongs to. The
+ * surrounding tokens are only taken from that declaration (only the
+ * following token for a token between declarations). Therefore the
+ * fingerprint does not change when other declarations are added, removed
+ * or moved around.
+ *
+ * @param tok Token the issue is reported at
+ * @param msg Message ID
+ * @return Fingerprint
+ */
+static uint64_t checker_diag_fp(checker_tok_t *tok, diag_msg_t msg)
+{
+	checker_dextent_t *dext;
+	checker_tok_t *ptok;
+	checker_tok_t *ntok;
+	uint16_t mid = (uint16_t) msg;
+	uint64_t hash;
+	bool inside;
+
+	dext = checker_tok_dextent(tok, &inside);
+
+	ptok = NULL;
+	if (inside) {
+		ptok = checker_fp_adj_tok(tok, false);
+		if (ptok != NULL && checker_pos_before(&ptok->tok.bpos,
+		    &dext->bpos))
+			ptok = NULL;
+	}
+
+	ntok = checker_fp_adj_tok(tok, true);
+	if (ntok != NULL && (dext == NULL ||
+	    checker_pos_before(&dext->epos, &ntok->tok.bpos)))
+		ntok = NULL;
+
+	hash = hash_fnv(HASH_FNV_BASIS, &mid, sizeof(mid));
+	hash = checker_hash_tok(hash, dext != NULL ? dext->name : NULL);
+	hash = checker_hash_tok(hash, ptok);
+	hash = checker_hash_tok(hash, tok);
+	return checker_hash_tok(hash, ntok);
+}
+
+/** Create checker declarations for all declarations in module AST.
+ *
+ * @param mod Checker module
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int checker_module_decls_create(checker_module_t *mod)
+{
+	ast_node_t *decl;
+	int rc;
 
-	if (0) {
-		putchar('\n');
-		rc = ast_tree_print(&amod->node, stdout);
+	decl = ast_module_first(mod->ast);
+	while (decl != NULL) {
+		rc = checker_decl_create(mod, decl, NULL);
 		if (rc != EOK)
-			goto error;
-		putchar('\n');
+			return rc;
+
+		decl = ast_module_next(decl);
 	}
 
+	return EOK;
+}
+
+/** Parse a module.
+ *
+ * @param mod Checker module
+ * @return EOK on success or error code
+ */
+static int checker_module_parse(checker_module_t *mod)
+{
+	ast_module_t *amod;
+	parser_t *parser;
+	checker_parser_input_t pinput;
+	int rc;
+
+	rc = parser_create(&checker_parser_input, &pinput,
+	    checker_module_first_tok(mod), 0, false, &parser);
+	if (rc != EOK)
+		return rc;
+
+	parser_set_errf(parser, mod->checker->errf);
+	if (mod->checker->stats != NULL)
+		parser_set_nread(parser, &mod->checker->stats->nptoks);
+
+	rc = parser_process_module(parser, &amod);
+	if (rc != EOK)
+		goto error;
+
 	mod->ast = amod;
 	parser_destroy(parser);
 
+	if (mod->checker->incr) {
+		rc = checker_module_decls_create(mod);
+		if (rc != EOK)
+			return rc;
+	}
+
 	return EOK;
 error:
 	parser_destroy(parser);
@@ -1642,8 +2629,7 @@ static int checker_check_do(checker_scope_t *scope, ast_do_t *ado)
 
 	if (ado->body->braces != ast_braces &&
 	    checker_scfg(scope)->loop) {
-		lexer_dprint_tok(&tdo->tok, stdout);
-		printf(": Body of 'do' loop should always have braces.\n");
+		checker_diag(tdo, dm_do_braces, NULL);
 	}
 
 	if (ado->body->braces) {
@@ -1773,11 +2759,8 @@ static int checker_check_for(checker_scope_t *scope, ast_for_t *afor)
 	} else {
 		checker_check_any(scope, trparen);
 
-		if (checker_scfg(scope)->loop) {
-			lexer_dprint_tok(&trparen->tok, stdout);
-			printf(": For loop with empty next expression. "
-			    "Use while instead.\n");
-		}
+		if (checker_scfg(scope)->loop)
+			checker_diag(trparen, dm_for_empty_next, NULL);
 	}
 
 	rc = checker_check_block(scope, afor->body, cns_disallow);
@@ -2009,10 +2992,8 @@ static int checker_check_stnull(checker_scope_t *scope, ast_stnull_t *stnull,
 	if (rc != EOK)
 		return rc;
 
-	if (nsallow != cns_allow && checker_scfg(scope)->estmt) {
-		lexer_dprint_tok(&tscolon->tok, stdout);
-		printf(": Unexpected null statement.\n");
-	}
+	if (nsallow != cns_allow && checker_scfg(scope)->estmt)
+		checker_diag(tscolon, dm_null_stmt, NULL);
 
 	return EOK;
 }
@@ -2064,10 +3045,8 @@ static int checker_check_stblock(checker_scope_t *scope, ast_block_t *block)
 	assert(block->braces);
 	tlbrace = (checker_tok_t *)block->topen.data;
 
-	if (checker_scfg(scope)->nblock) {
-		lexer_dprint_tok(&tlbrace->tok, stdout);
-		printf(": Gratuitous nested block.\n");
-	}
+	if (checker_scfg(scope)->nblock)
+		checker_diag(tlbrace, dm_nested_block, NULL);
 
 	rc = checker_check_lbegin(scope, tlbrace,
 	    "Nested block must begin on a new line.");
@@ -3068,11 +4047,8 @@ static int checker_check_tsrecord(checker_scope_t *scope,
 			if (rc != EOK)
 				goto error;
 
-			if (checker_scfg(escope)->estmt) {
-				lexer_dprint_tok(&tscolon->tok, stdout);
-				printf(": Empty struct or union "
-				    "member declaration.\n");
-			}
+			if (checker_scfg(escope)->estmt)
+				checker_diag(tscolon, dm_empty_member, NULL);
 		}
 
 		elem = ast_tsrecord_next(elem);
@@ -3361,7 +4337,7 @@ static int checker_check_block(checker_scope_t *scope, ast_block_t *block,
 
 	stmt = ast_block_first(block);
 	if (block->braces) {
-		while (stmt != NULL) {
+		while (stmt != NULL && !checker_scope_stopped(bscope)) {
 			/* Null statement not allowed in braced block */
 			rc = checker_check_stmt(bscope, stmt, cns_disallow);
 			if (rc != EOK)
@@ -3419,7 +4395,6 @@ static int checker_check_estring_lit(checker_scope_t *scope,
 {
 	checker_tok_t *tlit;
 	size_t invpos;
-	char invchar;
 
 	tlit = (checker_tok_t *) lit->tlit.data;
 	checker_check_any(scope, tlit);
@@ -3427,12 +4402,9 @@ static int checker_check_estring_lit(checker_scope_t *scope,
 	if (tlit->tok.ttype == ltt_strlit) {
 		invpos = 0;
 		while (!lexer_tok_valid_chars(&tlit->tok, invpos, &invpos)) {
-			invchar = tlit->tok.text[invpos];
 			if (checker_scfg(scope)->invchar) {
-				lexer_dprint_tok_chr(&tlit->tok, invpos, stdout);
-				printf(": Invalid character '");
-				lexer_dprint_char(invchar, stdout);
-				printf("' inside string literal.\n");
+				checker_diag_chr(tlit, invpos,
+				    dm_invchar_strlit);
 			}
 			++invpos;
 		}
@@ -3491,20 +4463,14 @@ static int checker_check_echar(checker_scope_t *scope, ast_echar_t *echar)
 {
 	checker_tok_t *tlit;
 	size_t invpos;
-	char invchar;
 
 	tlit = (checker_tok_t *) echar->tlit.data;
 	checker_check_any(scope, tlit);
 
 	invpos = 0;
 	while (!lexer_tok_valid_chars(&tlit->tok, invpos, &invpos)) {
-		invchar = tlit->tok.text[invpos];
-		if (checker_scfg(scope)->invchar) {
-			lexer_dprint_tok_chr(&tlit->tok, invpos, stdout);
-			printf(": Invalid character '");
-			lexer_dprint_char(invchar, stdout);
-			printf("' inside character literal.\n");
-		}
+		if (checker_scfg(scope)->invchar)
+			checker_diag_chr(tlit, invpos, dm_invchar_charlit);
 		++invpos;
 	}
 
@@ -4464,9 +5430,7 @@ static int checker_check_fundef_sclass(checker_scope_t *scope,
 		if (sclass->sctype == asc_extern &&
 		    checker_scfg(scope)->sclass) {
 			tsclass = (checker_tok_t *) sclass->tsclass.data;
-			lexer_dprint_tok(&tsclass->tok, stdout);
-			printf(": Improper use of storage class 'extern' with "
-			    "function definition.\n");
+			checker_diag(tsclass, dm_extern_fundef, NULL);
 		}
 	}
 
@@ -4475,8 +5439,7 @@ static int checker_check_fundef_sclass(checker_scope_t *scope,
 		    checker_scfg(scope)->hdr) {
 			atok = ast_tree_first_tok(&dspecs->node);
 			tok = (checker_tok_t *) atok->data;
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": Non-static function defined in a header.\n");
+			checker_diag(tok, dm_hdr_fundef, NULL);
 		}
 	}
 
@@ -4510,17 +5473,14 @@ static int checker_check_gdecln_idlist_sclass(checker_scope_t *scope,
 			if (fundecl && checker_scfg(scope)->decl) {
 				atok = ast_decl_get_ident(entry->decl);
 				tok = (checker_tok_t *) atok->data;
-				lexer_dprint_tok(&tok->tok, stdout);
-				printf(": Multiple function declarators.\n");
+				checker_diag(tok, dm_multi_fundecl, NULL);
 				break;
 			}
 
 			if (vardecl && checker_scfg(scope)->decl) {
 				atok = ast_decl_get_ident(entry->decl);
 				tok = (checker_tok_t *) atok->data;
-				lexer_dprint_tok(&tok->tok, stdout);
-				printf(": Mixing function and variable "
-				    "declarators.\n");
+				checker_diag(tok, dm_mixed_fun_var, NULL);
 				break;
 			}
 
@@ -4530,9 +5490,7 @@ static int checker_check_gdecln_idlist_sclass(checker_scope_t *scope,
 			if (fundecl && checker_scfg(scope)->decl) {
 				atok = ast_decl_get_ident(entry->decl);
 				tok = (checker_tok_t *) atok->data;
-				lexer_dprint_tok(&tok->tok, stdout);
-				printf(": Mixing function and variable "
-				    "declarators.\n");
+				checker_diag(tok, dm_mixed_fun_var, NULL);
 				break;
 			}
 
@@ -4544,10 +5502,7 @@ static int checker_check_gdecln_idlist_sclass(checker_scope_t *scope,
 				    checker_scfg(scope)->sclass) {
 					atok = ast_decl_get_ident(entry->decl);
 					tok = (checker_tok_t *) atok->data;
-					lexer_dprint_tok(&tok->tok, stdout);
-
-					printf(": Non-static variable "
-					    "defined in a header.\n");
+					checker_diag(tok, dm_hdr_vardef, NULL);
 				}
 			}
 
@@ -4819,10 +5774,8 @@ static int checker_check_nulldecln(checker_scope_t *scope,
 	if (rc != EOK)
 		goto error;
 
-	if (checker_scfg(scope)->estmt) {
-		lexer_dprint_tok(&tscolon->tok, stdout);
-		printf(": Empty declaration.\n");
-	}
+	if (checker_scfg(scope)->estmt)
+		checker_diag(tscolon, dm_empty_decln, NULL);
 
 	return EOK;
 error:
@@ -4853,8 +5806,7 @@ static int checker_check_externc(checker_scope_t *scope,
 
 	if (strcmp(tlang->tok.text, "\"C\"") != 0 &&
 	    checker_scfg(scope)->hdr) {
-		lexer_dprint_tok(&tlang->tok, stdout);
-		printf(": Linked language is not 'C'.\n");
+		checker_diag(tlang, dm_externc_lang, NULL);
 	}
 
 	rc = checker_check_lbegin(scope, textern,
@@ -4924,6 +5876,65 @@ static int checker_check_global_decln(checker_scope_t *scope, ast_node_t *decl)
 	return rc;
 }
 
+/** Run checks on a module in incremental mode.
+ *
+ * Only declarations whose diagnostics are not up to date are checked.
+ * Remembered diagnostics of all declarations are then reported
+ * in order.
+ *
+ * @param mod Checker module
+ * @return EOK on success or error code
+ */
+static int checker_module_check_incr(checker_module_t *mod)
+{
+	checker_t *checker = mod->checker;
+	checker_decl_t *cdecl;
+	checker_scope_t *scope;
+	diag_sink_ops_t *sink_ops;
+	void *sink_arg;
+	size_t i;
+	int rc;
+
+	scope = checker_scope_toplvl(mod, false);
+	if (scope == NULL)
+		return ENOMEM;
+
+	cdecl = checker_module_first_decl(mod);
+	while (cdecl != NULL) {
+		if (!cdecl->checked) {
+			diag_list_clear(&cdecl->diags);
+
+			/* Divert diagnostics to the declaration's list */
+			sink_ops = checker->sink_ops;
+			sink_arg = checker->sink_arg;
+			checker->sink_ops = &diag_list_sink;
+			checker->sink_arg = &cdecl->diags;
+
+			rc = checker_check_global_decln(scope, cdecl->decl);
+
+			checker->sink_ops = sink_ops;
+			checker->sink_arg = sink_arg;
+
+			if (rc == EOK)
+				rc = checker->sink_rc;
+			if (rc != EOK) {
+				checker_scope_destroy(scope);
+				return rc;
+			}
+
+			cdecl->checked = true;
+		}
+
+		for (i = 0; i < cdecl->diags.ndiags; i++)
+			checker_report(checker, &cdecl->diags.diag[i]);
+
+		cdecl = checker_next_decl(mod, cdecl);
+	}
+
+	checker_scope_destroy(scope);
+	return EOK;
+}
+
 /** Run checks on a module.
  *
  * @param mod Checker module
@@ -4934,18 +5945,38 @@ static int checker_module_check(checker_module_t *mod, bool fix)
 {
 	int rc;
 	ast_node_t *decl;
+	checker_tok_t *ftok;
+	checker_tok_t *ltok;
 	checker_scope_t *scope;
+	trace_t *trace = mod->checker->trace;
+	uint64_t start;
+
+	if (mod->checker->incr)
+		return checker_module_check_incr(mod);
 
 	scope = checker_scope_toplvl(mod, fix);
 	if (scope == NULL)
 		return ENOMEM;
 
 	decl = ast_module_first(mod->ast);
-	while (decl != NULL) {
-		rc = checker_check_global_decln(scope, decl);
-		if (rc != EOK) {
-			checker_scope_destroy(scope);
-			return rc;
+	while (decl != NULL && !mod->checker->stop) {
+		ftok = (checker_tok_t *) ast_tree_first_tok(decl)->data;
+		ltok = (checker_tok_t *) ast_tree_last_tok(decl)->data;
+
+		/* Skip declarations entirely outside of checked lines */
+		if (checker_lines_checked(mod->checker, ftok->tok.bpos.line,
+		    ltok->tok.epos.line)) {
+			start = trace != NULL ? trace_now() : 0;
+			rc = checker_check_global_decln(scope, decl);
+			if (rc != EOK) {
+				checker_scope_destroy(scope);
+				return rc;
+			}
+
+			if (trace != NULL) {
+				trace_span(trace, "decl", "decl", start,
+				    ftok->tok.bpos.line);
+			}
 		}
 
 		decl = ast_module_next(decl);
@@ -4997,11 +6028,10 @@ static int checker_check_line_indent(unsigned tabs, unsigned spaces,
 		tok->lbegin = true;
 
 	if (extra != 0) {
-		if (fix) {
+		if (checker_fix_tok(tok, dm_indent_mixed, fix)) {
 			need_fix = true;
 		} else {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": Mixing tabs and spaces in indentation.\n");
+			checker_diag(tok, dm_indent_mixed, NULL);
 		}
 	}
 
@@ -5026,43 +6056,36 @@ static int checker_check_line_indent(unsigned tabs, unsigned spaces,
 	}
 
 	if (req_spaces == 0 && spaces != 0) {
-		if (fix) {
+		if (checker_fix_tok(tok, dm_indent_noncont, fix)) {
 			need_fix = true;
 		} else {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": Non-continuation line should not "
-			    "have any spaces for indentation "
-			    "(found %u)\n", spaces);
+			checker_diag_num(tok, dm_indent_noncont, spaces, 0);
 		}
 	}
 
 	if (spaces != req_spaces) {
-		if (fix) {
+		if (checker_fix_tok(tok, dm_indent_spaces, fix)) {
 			need_fix = true;
 		} else {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": Line is indented by %u "
-			    "spaces (should be %u)\n",
-			    spaces, req_spaces);
+			checker_diag_num(tok, dm_indent_spaces, spaces,
+			    req_spaces);
 		}
 	}
 
 	if (tok->indlvl != tabs) {
-		if (fix) {
+		if (checker_fix_tok(tok, dm_indent_tabs, fix)) {
 			need_fix = true;
 		} else {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": Wrong indentation: found %u tabs, "
-			    "should be %u tabs\n", tabs, tok->indlvl);
+			checker_diag_num(tok, dm_indent_tabs, tabs,
+			    tok->indlvl);
 		}
 	}
 
 	if (tok->tok.ttype == ltt_tab) {
-		if (fix) {
+		if (checker_fix_tok(tok, dm_mixed_tabs_spaces, fix)) {
 			need_fix = true;
 		} else {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": Mixing tabs and spaces.\n");
+			checker_diag(tok, dm_mixed_tabs_spaces, NULL);
 		}
 	}
 
@@ -5105,21 +6128,19 @@ static void checker_module_alltoks(checker_module_t *mod, bool fix)
 	checker_tok_t *tok;
 	checker_tok_t *bs;
 	size_t invpos;
-	char invchar;
 
 	tok = checker_module_first_tok(mod);
-	while (tok->tok.ttype != ltt_eof) {
+	while (tok->tok.ttype != ltt_eof && !mod->checker->stop) {
 		if (tok->tok.ttype == ltt_elbspace &&
 		    mod->checker->cfg->invchar) {
-			if (fix) {
+			if (checker_fix_tok(tok, dm_backslash, fix)) {
 				bs = tok;
 				tok = checker_next_tok(tok);
 
 				checker_line_remove_ws_before(bs);
 				checker_remove_token(bs);
 			} else {
-				lexer_dprint_tok(&tok->tok, stdout);
-				printf(": Backslash outside of preprocessor directive.\n");
+				checker_diag(tok, dm_backslash, NULL);
 			}
 		}
 
@@ -5129,29 +6150,22 @@ static void checker_module_alltoks(checker_module_t *mod, bool fix)
 			invpos = 0;
 			while (!lexer_tok_valid_chars(&tok->tok, invpos,
 			    &invpos)) {
-				invchar = tok->tok.text[invpos];
-				lexer_dprint_tok_chr(&tok->tok, invpos, stdout);
-				printf(": Invalid character '");
-				lexer_dprint_char(invchar, stdout);
-				printf("' inside comment.\n");
+				checker_diag_chr(tok, invpos,
+				    dm_invchar_comment);
 				++invpos;
 			}
 		}
 
-		if (!tok->checked && !parser_ttype_ignore(tok->tok.ttype)) {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(" Token not checked\n");
-		}
+		if (!tok->checked && !parser_ttype_ignore(tok->tok.ttype))
+			checker_diag(tok, dm_tok_not_checked, NULL);
 
 		if (tok->indlvl != tok->pindlvl && !parser_ttype_ignore(tok->tok.ttype)) {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": Indentation mismatch: parser %u, checker %u.\n",
+			checker_diag_num(tok, dm_indlvl_mismatch,
 			    tok->pindlvl, tok->indlvl);
 		}
 
 		if (tok->seccont != tok->pseccont && !parser_ttype_ignore(tok->tok.ttype)) {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": Secondary indentation mismatch: parser %u, checker %u.\n",
+			checker_diag_num(tok, dm_seccont_mismatch,
 			    tok->pseccont, tok->seccont);
 		}
 
@@ -5171,7 +6185,7 @@ static int checker_block_comment_line(checker_tok_t *tok, bool fix)
 	int rc;
 
 	if (tok->tok.ttype != ltt_ctext || tok->tok.text[0] != '*') {
-		if (fix) {
+		if (checker_fix_tok(tok, dm_cmt_asterisk, fix)) {
 			rc = checker_prepend_tok(tok, ltt_ctext, "*");
 			if (rc != EOK)
 				return rc;
@@ -5180,12 +6194,10 @@ static int checker_block_comment_line(checker_tok_t *tok, bool fix)
 			if (rc != EOK)
 				return rc;
 		} else {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": '*' expected at beginning "
-			    "of block comment line.\n");
+			checker_diag(tok, dm_cmt_asterisk, NULL);
 		}
 	} else if (tok->tok.ttype == ltt_ctext && tok->tok.text[1] != '\0') {
-		if (fix) {
+		if (checker_fix_tok(tok, dm_cmt_space, fix)) {
 			rc = checker_prepend_tok(tok, ltt_ctext, "*");
 			if (rc != EOK)
 				return rc;
@@ -5198,8 +6210,7 @@ static int checker_block_comment_line(checker_tok_t *tok, bool fix)
 			if (rc != EOK)
 				return rc;
 		} else {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": Space expected after '*'.\n");
+			checker_diag(tok, dm_cmt_space, NULL);
 		}
 	}
 
@@ -5232,8 +6243,7 @@ static int checker_module_comment(checker_tok_t *tbegin, bool fix,
 	}
 
 	if (tok->tok.ttype == ltt_eof) {
-		lexer_dprint_tok(&tbegin->tok, stdout);
-		printf(": Unterminated comment.\n");
+		checker_diag(tbegin, dm_cmt_unterminated, NULL);
 		*tnext = tok;
 		return EOK;
 	}
@@ -5260,7 +6270,7 @@ static int checker_module_comment(checker_tok_t *tbegin, bool fix,
 	 * open is on a separate line.
 	 */
 	if (tbegin->tok.ttype == ltt_copen && tok->tok.ttype != ltt_newline) {
-		if (fix) {
+		if (checker_fix_tok(tbegin, dm_cmt_text_nl, fix)) {
 			/* Remove spaces/tabs at beginning of comment */
 			tok = checker_next_tok(tbegin);
 			while (tok->tok.ttype == ltt_space ||
@@ -5274,8 +6284,7 @@ static int checker_module_comment(checker_tok_t *tbegin, bool fix,
 			if (rc != EOK)
 				return rc;
 		} else {
-			lexer_dprint_tok(&tbegin->tok, stdout);
-			printf(": Comment text should begin on a new line.\n");
+			checker_diag(tbegin, dm_cmt_text_nl, NULL);
 		}
 	}
 
@@ -5321,7 +6330,7 @@ static int checker_module_comment(checker_tok_t *tbegin, bool fix,
 	tclose = tok;
 
 	if (!checker_is_tok_lbegin(tclose)) {
-		if (fix) {
+		if (checker_fix_tok(tclose, dm_cmt_close_nl, fix)) {
 			/* Remove spaces/tabs before comment close */
 			tok = checker_prev_tok(tclose);
 			while (tok->tok.ttype == ltt_space ||
@@ -5335,9 +6344,7 @@ static int checker_module_comment(checker_tok_t *tbegin, bool fix,
 			if (rc != EOK)
 				return rc;
 		} else {
-			lexer_dprint_tok(&tclose->tok, stdout);
-			printf(": Block comment closing '*/' should be on "
-			    "a new line.\n");
+			checker_diag(tclose, dm_cmt_close_nl, NULL);
 		}
 	}
 
@@ -5357,7 +6364,7 @@ static int checker_module_comments(checker_module_t *mod, bool fix)
 	int rc;
 
 	tok = checker_module_first_tok(mod);
-	while (tok->tok.ttype != ltt_eof) {
+	while (tok->tok.ttype != ltt_eof && !mod->checker->stop) {
 		if (tok->tok.ttype == ltt_copen ||
 		    tok->tok.ttype == ltt_dcopen) {
 			rc = checker_module_comment(tok, fix, &tnext);
@@ -5390,7 +6397,7 @@ static int checker_module_lines(checker_module_t *mod, bool fix)
 	int rc;
 
 	tok = checker_module_first_tok(mod);
-	while (tok->tok.ttype != ltt_eof) {
+	while (tok->tok.ttype != ltt_eof && !mod->checker->stop) {
 		/* Tab indentation at beginning of line */
 		tabs = 0;
 		while (tok->tok.ttype == ltt_tab) {
@@ -5434,24 +6441,13 @@ static int checker_module_lines(checker_module_t *mod, bool fix)
 
 		/* Check for trailing whitespace */
 		if (nonws && trailws) {
-			if (fix) {
+			if (checker_fix_tok(tok, dm_trailing_ws, fix)) {
 				checker_line_remove_ws_before(tok);
 			} else {
-				lexer_dprint_tok(&tok->tok, stdout);
-				printf(": Whitespace at end of line\n");
+				checker_diag(tok, dm_trailing_ws, NULL);
 			}
 		}
 
-#if 0
-		/* Check for overlong lines */
-		if (tok->tok.bpos.col > 1 + line_length_limit) {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": Line too long (%zu characters above %u "
-			    "character limit)\n", tok->tok.bpos.col -
-			    line_length_limit - 1, line_length_limit);
-		}
-#endif
-
 		/* Skip newline */
 		if (tok->tok.ttype != ltt_eof)
 			tok = checker_next_tok(tok);
@@ -5475,7 +6471,8 @@ static int checker_check_empty_line_block(checker_module_t *mod, bool bof,
 	checker_tok_t *tok;
 
 	if (bof) {
-		if (fix) {
+		if (checker_fix_tok(checker_module_first_tok(mod),
+		    dm_bof_empty_line, fix)) {
 			tok = checker_module_first_tok(mod);
 			while (tok != NULL && lexer_is_wspace(tok->tok.ttype)) {
 				checker_remove_token(tok);
@@ -5483,12 +6480,10 @@ static int checker_check_empty_line_block(checker_module_t *mod, bool bof,
 			}
 		} else {
 			tok = checker_module_first_tok(mod);
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": Unexpected empty line at beginning of "
-			    "file.\n");
+			checker_diag(tok, dm_bof_empty_line, NULL);
 		}
 	} else if (empty_lc > 1) {
-		if (fix) {
+		if (checker_fix_tok(etok, dm_multi_empty_lines, fix)) {
 			/* Skip the first empty line */
 			tok = etok;
 			while (tok->tok.ttype != ltt_eof &&
@@ -5503,8 +6498,7 @@ static int checker_check_empty_line_block(checker_module_t *mod, bool bof,
 			while (checker_line_is_blank(tok))
 				tok = checker_remove_line(tok);
 		} else {
-			lexer_dprint_tok(&etok->tok, stdout);
-			printf(": Unexpected multiple consecutive empty lines.\n");
+			checker_diag(etok, dm_multi_empty_lines, NULL);
 		}
 	}
 
@@ -5534,7 +6528,7 @@ static int checker_module_vspacing(checker_module_t *mod, bool fix)
 	empty_lc = 0;
 
 	tok = checker_module_first_tok(mod);
-	while (tok->tok.ttype != ltt_eof) {
+	while (tok->tok.ttype != ltt_eof && !mod->checker->stop) {
 		lbtok = tok;
 		nonws = false;
 
@@ -5574,22 +6568,20 @@ static int checker_module_vspacing(checker_module_t *mod, bool fix)
 
 	ptok = checker_prev_tok(tok);
 	if (ptok->tok.ttype != ltt_newline) {
-		if (fix) {
+		if (checker_fix_tok(tok, dm_eof_newline, fix)) {
 			rc = checker_append_tok(ptok, ltt_newline, "\n");
 			if (rc != EOK)
 				return rc;
 		} else {
-			lexer_dprint_tok(&tok->tok, stdout);
-			printf(": Expected newline at end of file.\n");
+			checker_diag(tok, dm_eof_newline, NULL);
 		}
 	}
 
 	if (empty_lc > 0) {
-		if (fix) {
+		if (checker_fix_tok(ptok, dm_eof_empty_lines, fix)) {
 			checker_remove_ws_before(ptok);
 		} else {
-			lexer_dprint_tok(&ptok->tok, stdout);
-			printf(": Unexpected empty lines at end of file.\n");
+			checker_diag(ptok, dm_eof_empty_lines, NULL);
 		}
 	}
 
@@ -5605,10 +6597,13 @@ static int checker_module_vspacing(checker_module_t *mod, bool fix)
  */
 static int checker_build_toks(checker_t *checker)
 {
+	checker_stats_mark_t mark;
 	int rc;
 
 	if (checker->mod == NULL) {
+		checker_phase_begin(checker, &mark);
 		rc = checker_module_lex(checker, &checker->mod);
+		checker_phase_end(checker, cph_lex, &mark);
 		if (rc != EOK)
 			return rc;
 	}
@@ -5625,6 +6620,8 @@ static int checker_build_toks(checker_t *checker)
  */
 static int checker_build_ast(checker_t *checker)
 {
+	checker_stats_mark_t mark;
+	size_t nnodes;
 	int rc;
 
 	rc = checker_build_toks(checker);
@@ -5632,7 +6629,15 @@ static int checker_build_ast(checker_t *checker)
 		return rc;
 
 	if (checker->mod->ast == NULL) {
+		checker_phase_begin(checker, &mark);
+		nnodes = alloc_track_nallocs(as_ast);
 		rc = checker_module_parse(checker->mod);
+		/* Each AST node is a block charged to the AST subsystem */
+		if (checker->stats != NULL) {
+			checker->stats->nnodes += alloc_track_nallocs(as_ast) -
+			    nnodes;
+		}
+		checker_phase_end(checker, cph_parse, &mark);
 		if (rc != EOK)
 			return rc;
 	}
@@ -5640,15 +6645,369 @@ static int checker_build_ast(checker_t *checker)
 	return EOK;
 }
 
-/** Run checker.
+/** Start keeping track of lines changed by fixes.
  *
- * @param checker Checker
- * @param fix @c true to attempt to fix issues instead of reporting them,
- *        @c false to simply report all issues
+ * @param mod Checker module
+ * @return EOK on success, ENOMEM if out of memory
  */
-int checker_run(checker_t *checker, bool fix)
+static int checker_module_fixed_init(checker_module_t *mod)
 {
-	int rc;
+	checker_tok_t *etok;
+
+	etok = checker_module_last_tok(mod);
+
+	/*
+	 * Line numbers start at one, removing the last newline marks
+	 * one more line.
+	 */
+	mod->nlines = etok->tok.epos.line + 2;
+	mod->lfixed = alloc_calloc(as_checker, mod->nlines, sizeof(bool));
+	if (mod->lfixed == NULL)
+		return ENOMEM;
+
+	return EOK;
+}
+
+/** Determine if character separates check group names in a directive.
+ *
+ * @param c Character
+ * @return @c true iff @a c is a separator
+ */
+static bool checker_supp_sep(char c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == ',';
+}
+
+/** Parse check group names following a suppression directive.
+ *
+ * Names are separated by whitespace or commas. Unknown names are
+ * ignored.
+ *
+ * @param text Text following the directive
+ * @param len Length of @a text
+ * @param named Set to @c true if @a text contains any name
+ * @return Mask of named check groups
+ */
+static unsigned checker_supp_groups(const char *text, size_t len,
+    bool *named)
+{
+	const char *name;
+	unsigned mask = 0;
+	size_t i, n;
+	int g;
+
+	i = 0;
+	while (i < len) {
+		if (checker_supp_sep(text[i])) {
+			++i;
+			continue;
+		}
+
+		n = 0;
+		while (i + n < len && !checker_supp_sep(text[i + n]))
+			++n;
+
+		*named = true;
+		for (g = dg_decl; g < dg_internal; g++) {
+			name = diag_group_str(g);
+			if (strlen(name) == n && memcmp(name, text + i, n) == 0)
+				mask |= 1u << g;
+		}
+
+		i += n;
+	}
+
+	return mask;
+}
+
+/** Interpret suppression directive.
+ *
+ * The directive must be the first word of the comment. It is followed
+ * by the names of the check groups it applies to (until the end of
+ * the line). If no names are given, it applies to all check groups.
+ *
+ * @param tok Token with suppression directive
+ * @param rmask Place to store mask of check groups
+ * @param rline Place to store line of the directive or, for
+ *              ccheck-disable-next-line, the line following the comment
+ * @return @c true iff @a tok is a valid directive
+ */
+static bool checker_supp_dir(checker_tok_t *tok, unsigned *rmask,
+    size_t *rline)
+{
+	checker_tok_t *t;
+	const char *text;
+	unsigned mask = 0;
+	bool named = false;
+	size_t eline;
+	size_t i;
+
+	if (tok->tok.ttype == ltt_dscomment) {
+		/* Skip slashes and the directive itself */
+		text = tok->tok.text;
+		i = 0;
+		while (text[i] == '/')
+			++i;
+		while (text[i] == ' ' || text[i] == '\t')
+			++i;
+		while (text[i] != '\0' && !checker_supp_sep(text[i]))
+			++i;
+
+		mask = checker_supp_groups(text + i, tok->tok.text_size - i,
+		    &named);
+		eline = tok->tok.epos.line;
+	} else {
+		/* Skip whitespace and leading asterisks of block comment */
+		t = checker_prev_tok(tok);
+		while (t != NULL && (lexer_is_wspace(t->tok.ttype) ||
+		    (t->tok.ttype == ltt_ctext &&
+		    t->tok.text_size == 1 && t->tok.text[0] == '*')))
+			t = checker_prev_tok(t);
+
+		if (t == NULL || (t->tok.ttype != ltt_copen &&
+		    t->tok.ttype != ltt_dcopen))
+			return false;
+
+		t = checker_next_tok(tok);
+		while (t != NULL && t->tok.ttype != ltt_cclose &&
+		    t->tok.ttype != ltt_newline) {
+			if (t->tok.ttype == ltt_ctext) {
+				mask |= checker_supp_groups(t->tok.text,
+				    t->tok.text_size, &named);
+			}
+
+			t = checker_next_tok(t);
+		}
+
+		while (t != NULL && t->tok.ttype != ltt_cclose)
+			t = checker_next_tok(t);
+
+		eline = t != NULL ? t->tok.epos.line : tok->tok.epos.line;
+	}
+
+	if (!named)
+		mask = (1u << dg_internal) - 1;
+
+	*rmask = mask;
+	*rline = tok->tok.sdir == lsd_disable_next_line ? eline + 1 :
+	    tok->tok.bpos.line;
+	return true;
+}
+
+/** Compare two suppression changes by line for sorting.
+ *
+ * @param a Pointer to first change (checker_supp_ev_t *)
+ * @param b Pointer to second change (checker_supp_ev_t *)
+ * @return Less than, equal to or greater than zero
+ */
+static int checker_supp_ev_cmp(const void *a, const void *b)
+{
+	const checker_supp_ev_t *ea = (const checker_supp_ev_t *) a;
+	const checker_supp_ev_t *eb = (const checker_supp_ev_t *) b;
+
+	if (ea->line != eb->line)
+		return ea->line < eb->line ? -1 : 1;
+
+	return 0;
+}
+
+/** Append suppression change.
+ *
+ * @param ev Pointer to array of changes
+ * @param nev Pointer to number of changes
+ * @param alloc Pointer to number of allocated entries
+ * @param line Line where the change takes effect
+ * @param group Check group
+ * @param begin @c true if suppression begins, @c false if it ends
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int checker_supp_ev_add(checker_supp_ev_t **ev, size_t *nev,
+    size_t *alloc, size_t line, diag_group_t group, bool begin)
+{
+	checker_supp_ev_t *nev_arr;
+	size_t nalloc;
+
+	if (*nev >= *alloc) {
+		nalloc = *alloc != 0 ? 2 * *alloc : supp_ev_init_alloc;
+		nev_arr = alloc_realloc(as_checker, *ev,
+		    nalloc * sizeof(checker_supp_ev_t));
+		if (nev_arr == NULL)
+			return ENOMEM;
+
+		*ev = nev_arr;
+		*alloc = nalloc;
+	}
+
+	(*ev)[*nev].line = line;
+	(*ev)[*nev].group = group;
+	(*ev)[*nev].begin = begin;
+	++*nev;
+	return EOK;
+}
+
+/** Build table of suppressed check groups from annotations.
+ *
+ * If the table changes, remembered diagnostics of all declarations
+ * (incremental mode) are invalidated.
+ *
+ * @param mod Checker module
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int checker_module_supp_build(checker_module_t *mod)
+{
+	checker_supp_ev_t *ev = NULL;
+	size_t nev = 0;
+	size_t alloc = 0;
+	checker_supp_t *supp = NULL;
+	size_t nsupp = 0;
+	size_t open[dg_internal];
+	unsigned count[dg_internal];
+	checker_tok_t *tok;
+	checker_decl_t *cdecl;
+	unsigned mask, gmask;
+	size_t line;
+	size_t i;
+	int g;
+	int rc;
+
+	/* Lines are numbered from 1, zero means not suppressed */
+	for (g = dg_decl; g < dg_internal; g++) {
+		open[g] = 0;
+		count[g] = 0;
+	}
+
+	tok = mod->nsdirs != 0 ? checker_module_first_tok(mod) : NULL;
+	while (tok != NULL) {
+		if (tok->tok.sdir == lsd_none ||
+		    !checker_supp_dir(tok, &mask, &line)) {
+			tok = checker_next_tok(tok);
+			continue;
+		}
+
+		for (g = dg_decl; g < dg_internal; g++) {
+			if ((mask & (1u << g)) == 0)
+				continue;
+
+			rc = EOK;
+			switch (tok->tok.sdir) {
+			case lsd_disable:
+				if (open[g] == 0)
+					open[g] = line;
+				break;
+			case lsd_enable:
+				if (open[g] == 0)
+					break;
+				rc = checker_supp_ev_add(&ev, &nev, &alloc,
+				    open[g], g, true);
+				if (rc == EOK) {
+					rc = checker_supp_ev_add(&ev, &nev,
+					    &alloc, line + 1, g, false);
+				}
+				open[g] = 0;
+				break;
+			case lsd_disable_next_line:
+				rc = checker_supp_ev_add(&ev, &nev, &alloc,
+				    line, g, true);
+				if (rc == EOK) {
+					rc = checker_supp_ev_add(&ev, &nev,
+					    &alloc, line + 1, g, false);
+				}
+				break;
+			default:
+				assert(false);
+				break;
+			}
+
+			if (rc != EOK)
+				goto error;
+		}
+
+		tok = checker_next_tok(tok);
+	}
+
+	/* Disabled until the end of the file */
+	for (g = dg_decl; g < dg_internal; g++) {
+		if (open[g] != 0) {
+			rc = checker_supp_ev_add(&ev, &nev, &alloc, open[g],
+			    g, true);
+			if (rc != EOK)
+				goto error;
+		}
+	}
+
+	if (nev > 0) {
+		qsort(ev, nev, sizeof(checker_supp_ev_t), checker_supp_ev_cmp);
+		supp = alloc_calloc(as_checker, nev, sizeof(checker_supp_t));
+		if (supp == NULL) {
+			rc = ENOMEM;
+			goto error;
+		}
+	}
+
+	mask = 0;
+	i = 0;
+	while (i < nev) {
+		line = ev[i].line;
+		while (i < nev && ev[i].line == line) {
+			if (ev[i].begin)
+				++count[ev[i].group];
+			else
+				--count[ev[i].group];
+			++i;
+		}
+
+		gmask = 0;
+		for (g = dg_decl; g < dg_internal; g++) {
+			if (count[g] > 0)
+				gmask |= 1u << g;
+		}
+
+		if (gmask != mask) {
+			supp[nsupp].bline = line;
+			supp[nsupp].mask = gmask;
+			++nsupp;
+			mask = gmask;
+		}
+	}
+
+	alloc_free(ev);
+
+	if (nsupp != mod->nsupp || (nsupp > 0 && memcmp(supp, mod->supp,
+	    nsupp * sizeof(checker_supp_t)) != 0)) {
+		cdecl = checker_module_first_decl(mod);
+		while (cdecl != NULL) {
+			cdecl->checked = false;
+			cdecl = checker_next_decl(mod, cdecl);
+		}
+	}
+
+	alloc_free(mod->supp);
+	mod->supp = supp;
+	mod->nsupp = nsupp;
+	mod->supp_valid = true;
+	return EOK;
+error:
+	alloc_free(ev);
+	return rc;
+}
+
+/** Run checker.
+ *
+ * @param checker Checker
+ * @param fix @c true to attempt to fix issues instead of reporting them,
+ *        @c false to simply report all issues
+ */
+int checker_run(checker_t *checker, bool fix)
+{
+	checker_stats_mark_t mark;
+	size_t nvisits;
+	int rc;
+
+	if (checker->incr && fix)
+		return EINVAL;
+
+	/* Declarations may have changed since the last run */
+	checker->dext_valid = false;
 
 	if (checker->mod == NULL || checker->mod->ast == NULL) {
 		rc = checker_build_ast(checker);
@@ -5656,32 +7015,500 @@ int checker_run(checker_t *checker, bool fix)
 			return rc;
 	}
 
-	if (checker->cfg->fmt)
+	if (!checker->mod->supp_valid) {
+		rc = checker_module_supp_build(checker->mod);
+		if (rc != EOK)
+			return rc;
+	}
+
+	if (fix && checker->mod->lfixed == NULL) {
+		rc = checker_module_fixed_init(checker->mod);
+		if (rc != EOK)
+			return rc;
+	}
+
+	nvisits = checker->mod->nvisits;
+	checker->nissues = 0;
+	checker->stop = false;
+
+	if (checker->cfg->fmt) {
+		checker_phase_begin(checker, &mark);
 		checker_module_comments(checker->mod, fix);
+		checker_phase_end(checker, cph_comments, &mark);
+	}
+
+	/* Skip the remaining passes once the issue limit is reached */
+	if (checker->stop)
+		goto out;
 
+	checker_phase_begin(checker, &mark);
 	rc = checker_module_check(checker->mod, fix);
 	if (rc != EOK)
 		return rc;
 
-	checker_module_alltoks(checker->mod, fix);
+	if (!checker->stop) {
+		checker_module_alltoks(checker->mod, fix);
 
-	/*
-	 * Make sure comments after the last C declaration are marked
-	 * as not continuation.
-	 */
-	checker_prev_comments_nocont(checker_module_last_tok(checker->mod));
+		/*
+		 * Make sure comments after the last C declaration are marked
+		 * as not continuation.
+		 */
+		checker_prev_comments_nocont(
+		    checker_module_last_tok(checker->mod));
+	}
+	checker_phase_end(checker, cph_check, &mark);
 
-	if (checker->cfg->fmt) {
+	if (checker->cfg->fmt && !checker->stop) {
+		checker_phase_begin(checker, &mark);
 		rc = checker_module_lines(checker->mod, fix);
+		checker_phase_end(checker, cph_lines, &mark);
 		if (rc != EOK)
 			return rc;
 
+		if (checker->stop)
+			goto out;
+
+		checker_phase_begin(checker, &mark);
 		rc = checker_module_vspacing(checker->mod, fix);
+		checker_phase_end(checker, cph_vspacing, &mark);
 		if (rc != EOK)
 			return rc;
 	}
+out:
+	if (checker->stats != NULL)
+		checker->stats->nvisits += checker->mod->nvisits - nvisits;
+
+	return checker->sink_rc;
+}
+
+/** Determine if token precedes another token.
+ *
+ * @param a First token
+ * @param b Second token
+ * @return @c true iff @a a is located before @a b
+ */
+static bool checker_tok_before(checker_tok_t *a, checker_tok_t *b)
+{
+	if (a->tok.bpos.line != b->tok.bpos.line)
+		return a->tok.bpos.line < b->tok.bpos.line;
+
+	return a->tok.bpos.col < b->tok.bpos.col;
+}
+
+/** Count line breaks in token text.
+ *
+ * @param tok Token
+ * @return Number of newline characters in token text
+ */
+static size_t checker_tok_nlines(checker_tok_t *tok)
+{
+	size_t nl = 0;
+	size_t i;
+
+	for (i = 0; i < tok->tok.text_size; i++) {
+		if (tok->tok.text[i] == '\n')
+			++nl;
+	}
+
+	return nl;
+}
+
+/** Remove declaration from checker module and destroy it.
+ *
+ * @param cdecl Checker declaration
+ */
+static void checker_module_remove_decl(checker_decl_t *cdecl)
+{
+	ast_module_remove(cdecl->decl);
+	ast_tree_destroy(cdecl->decl);
+	checker_decl_destroy(cdecl);
+}
+
+/** Discard module AST and all declarations.
+ *
+ * @param mod Checker module
+ */
+static void checker_module_drop_ast(checker_module_t *mod)
+{
+	checker_decl_t *cdecl;
+
+	while ((cdecl = checker_module_first_decl(mod)) != NULL)
+		checker_decl_destroy(cdecl);
+
+	if (mod->ast != NULL) {
+		ast_tree_destroy(&mod->ast->node);
+		mod->ast = NULL;
+	}
+}
+
+/** Update checker module after the source was edited.
+ *
+ * The source is lexed again starting after the last declaration that
+ * ends on a line before the first edit, until the new tokens line up
+ * with the first token of a declaration that starts on a line after
+ * the last edit (or until the end of the file). Only declarations
+ * within the re-lexed range are parsed again. All other declarations
+ * are kept. Since checks look at neighboring tokens, the kept
+ * declarations immediately before and after the re-lexed range are
+ * checked again by the next checker_run(), together with the new
+ * declarations.
+ *
+ * If parsing fails, the module AST is discarded and rebuilt from
+ * scratch on the next run.
+ *
+ * @param checker Checker in incremental mode
+ * @param text New source text
+ * @param size Size of new source text
+ * @param edits Edits that transform the old source to the new one,
+ *              sorted by position and not overlapping
+ * @param nedits Number of edits
+ * @return EOK on success, EINVAL if edits do not match the source,
+ *         or other error code
+ */
+int checker_update(checker_t *checker, const char *text, size_t size,
+    checker_edit_t *edits, size_t nedits)
+{
+	checker_module_t *mod;
+	checker_decl_t *prev;
+	checker_decl_t *cdecl;
+	checker_decl_t *next;
+	checker_decl_t *reuse;
+	checker_tok_t *tok;
+	checker_tok_t *ntok;
+	checker_tok_t *stok;
+	checker_tok_t *rtok;
+	checker_tok_t *ctok;
+	checker_tok_t *tdbeg;
+	checker_tok_t *tdend;
+	checker_tok_t *fnew;
+	buf_input_t binput;
+	checker_parser_input_t pinput;
+	lexer_t *lexer = NULL;
+	parser_t *parser = NULL;
+	lexer_tok_t ltok;
+	ast_node_t *node;
+	list_t ntoks;
+	link_t *link;
+	size_t dbeg, dend;
+	size_t osize, nsize;
+	size_t offs, soffs, coffs, noffs;
+	size_t onl, nnl;
+	bool dropped;
+	size_t i;
+	int rc;
+
+	if (!checker->incr)
+		return EINVAL;
+
+	if (nedits == 0)
+		return EOK;
+
+	osize = 0;
+	nsize = 0;
+	for (i = 0; i < nedits; i++) {
+		if (i > 0 && edits[i].pos < edits[i - 1].pos +
+		    edits[i - 1].old_size)
+			return EINVAL;
+
+		osize += edits[i].old_size;
+		nsize += edits[i].new_size;
+	}
+
+	dbeg = edits[0].pos;
+	dend = edits[nedits - 1].pos + edits[nedits - 1].old_size;
+	if (dend - osize + nsize > size)
+		return EINVAL;
+
+	/* Make sure we have tokens of the old source */
+	rc = checker_build_toks(checker);
+	if (rc != EOK)
+		return rc;
+
+	mod = checker->mod;
+	checker->sink_rc = EOK;
+
+	/* Find first and last token touched by the edits */
+	tdbeg = NULL;
+	tdend = NULL;
+	offs = 0;
+	tok = checker_module_first_tok(mod);
+	while (tok != NULL && offs <= dend) {
+		if (tdbeg == NULL && offs + tok->tok.text_size >= dbeg)
+			tdbeg = tok;
+		tdend = tok;
+		offs += tok->tok.text_size;
+		tok = checker_next_tok(tok);
+	}
+
+	if (tdbeg == NULL || offs < dend)
+		return EINVAL;
+
+	/*
+	 * Find the last declaration ending on a line before the edits
+	 * and the first declaration starting on a line after them.
+	 */
+	prev = NULL;
+	cdecl = checker_module_first_decl(mod);
+	while (cdecl != NULL && checker_decl_last_tok(cdecl)->tok.epos.line <
+	    tdbeg->tok.bpos.line) {
+		prev = cdecl;
+		cdecl = checker_next_decl(mod, cdecl);
+	}
+
+	reuse = cdecl;
+	while (reuse != NULL && checker_decl_first_tok(reuse)->tok.bpos.line <=
+	    tdend->tok.epos.line)
+		reuse = checker_next_decl(mod, reuse);
+
+	/* Re-lex from the end of the previous declaration */
+	stok = prev != NULL ? checker_next_tok(checker_decl_last_tok(prev)) :
+	    checker_module_first_tok(mod);
+
+	soffs = 0;
+	tok = checker_module_first_tok(mod);
+	while (tok != stok) {
+		soffs += tok->tok.text_size;
+		tok = checker_next_tok(tok);
+	}
+
+	/* Continue lexing at the first re-lexed token */
+	buf_input_init(&binput, text, size, "");
+	binput.pos = soffs;
+	binput.cpos = stok->tok.bpos;
+
+	rc = lexer_create(&lexer_buf_input, &binput, &lexer);
+	if (rc != EOK)
+		return rc;
+
+	list_initialize(&ntoks);
+	ctok = stok;
+	coffs = soffs;
+	noffs = soffs;
+	rtok = NULL;
+
+	while (true) {
+		/* Skip declarations that the new tokens ran over */
+		while (reuse != NULL) {
+			while (ctok != checker_decl_first_tok(reuse)) {
+				coffs += ctok->tok.text_size;
+				ctok = checker_next_tok(ctok);
+			}
+
+			if (coffs + nsize - osize >= noffs)
+				break;
+
+			reuse = checker_next_decl(mod, reuse);
+		}
+
+		/* Synchronized with old tokens? */
+		if (reuse != NULL && coffs + nsize - osize == noffs &&
+		    lexer->state == ls_normal) {
+			rtok = ctok;
+			break;
+		}
+
+		rc = lexer_get_tok(lexer, &ltok);
+		if (rc != EOK)
+			goto error;
+
+		rc = checker_tok_new(&ltok, &ntok);
+		if (rc != EOK) {
+			lexer_free_tok(&ltok);
+			goto error;
+		}
+
+		ntok->mod = mod;
+		list_append(&ntok->ltoks, &ntoks);
+		noffs += ltok.text_size;
+
+		if (ltok.sdir != lsd_none)
+			++mod->nsdirs;
+
+		if (ltok.ttype == ltt_eof) {
+			reuse = NULL;
+			break;
+		}
+	}
+
+	lexer_destroy(lexer);
+	lexer = NULL;
+
+	/* Remove declarations and tokens in the re-lexed range */
+	while (cdecl != reuse) {
+		next = checker_next_decl(mod, cdecl);
+		checker_module_remove_decl(cdecl);
+		cdecl = next;
+	}
+
+	onl = 0;
+	tok = stok;
+	while (tok != rtok) {
+		ntok = checker_next_tok(tok);
+		onl += checker_tok_nlines(tok);
+		checker_tok_destroy(tok);
+		tok = ntok;
+	}
+
+	/* Insert new tokens */
+	nnl = 0;
+	fnew = NULL;
+	while ((link = list_first(&ntoks)) != NULL) {
+		tok = list_get_instance(link, checker_tok_t, ltoks);
+		list_remove(link);
+		nnl += checker_tok_nlines(tok);
+
+		if (rtok != NULL)
+			list_insert_before(&tok->ltoks, &rtok->ltoks);
+		else
+			list_append(&tok->ltoks, &mod->toks);
+
+		if (fnew == NULL)
+			fnew = tok;
+	}
+
+	/* Shift line numbers of the rest of the module */
+	if (nnl != onl) {
+		tok = rtok;
+		while (tok != NULL) {
+			tok->tok.bpos.line = tok->tok.bpos.line + nnl - onl;
+			tok->tok.epos.line = tok->tok.epos.line + nnl - onl;
+			tok = checker_next_tok(tok);
+		}
+
+		cdecl = reuse;
+		while (cdecl != NULL) {
+			for (i = 0; i < cdecl->diags.ndiags; i++) {
+				cdecl->diags.diag[i].bline += nnl - onl;
+				cdecl->diags.diag[i].eline += nnl - onl;
+			}
+
+			cdecl = checker_next_decl(mod, cdecl);
+		}
+	}
+
+	/* Suppression directives may have been edited or moved */
+	if (mod->nsdirs != 0)
+		mod->supp_valid = false;
+
+	/* Parse new declarations */
+	if (mod->ast == NULL) {
+		rc = ast_module_create(&mod->ast);
+		if (rc != EOK)
+			goto error_ast;
+	}
+
+	rc = parser_create(&checker_parser_input, &pinput, fnew, 0, false,
+	    &parser);
+	if (rc != EOK)
+		goto error_ast;
+
+	parser_set_errf(parser, checker->errf);
+
+	dropped = false;
+	while (true) {
+		tok = parser_next_tok(parser);
+
+		/* Drop declarations that the new declarations ran over */
+		while (reuse != NULL &&
+		    checker_tok_before(checker_decl_first_tok(reuse), tok)) {
+			next = checker_next_decl(mod, reuse);
+			checker_module_remove_decl(reuse);
+			reuse = next;
+			dropped = true;
+		}
+
+		if (tok->tok.ttype == ltt_eof || (reuse != NULL &&
+		    checker_decl_first_tok(reuse) == tok))
+			break;
+
+		rc = parser_process_decln(parser, &node);
+		if (rc != EOK)
+			goto error_ast;
+
+		ast_module_insert_before(mod->ast, node,
+		    reuse != NULL ? reuse->decl : NULL);
+
+		rc = checker_decl_create(mod, node, reuse);
+		if (rc != EOK) {
+			ast_module_remove(node);
+			ast_tree_destroy(node);
+			goto error_ast;
+		}
+	}
+
+	parser_destroy(parser);
+
+	/*
+	 * Tokens of dropped declarations are now part of new declarations.
+	 * Forget what the old checks have annotated them with.
+	 */
+	if (dropped) {
+		tok = rtok;
+		while (tok != NULL && (reuse == NULL ||
+		    tok != checker_decl_first_tok(reuse))) {
+			tok->checked = false;
+			tok->indlvl = 0;
+			tok->lbegin = false;
+			tok->seccont = false;
+			tok = checker_next_tok(tok);
+		}
+	}
+
+	/* Neighbors of the re-lexed range need to be checked again */
+	if (prev != NULL)
+		prev->checked = false;
+	if (reuse != NULL)
+		reuse->checked = false;
 
 	return EOK;
+error:
+	while ((link = list_first(&ntoks)) != NULL)
+		checker_tok_destroy(list_get_instance(link, checker_tok_t,
+		    ltoks));
+	if (lexer != NULL)
+		lexer_destroy(lexer);
+	return rc;
+error_ast:
+	if (parser != NULL)
+		parser_destroy(parser);
+	checker_module_drop_ast(mod);
+	return rc;
+}
+
+/** Print collected diagnostics.
+ *
+ * Diagnostics collected in the checker's diagnostic list are sorted
+ * by position and printed.
+ *
+ * @param checker Checker
+ * @param fmt Output format
+ * @param f Output file
+ * @return EOK on success or error code
+ */
+int checker_print_diags(checker_t *checker, diag_fmt_t fmt, FILE *f)
+{
+	diag_list_sort(&checker->diags);
+	return diag_list_print(&checker->diags, fmt, f);
+}
+
+/** Determine if fixing issues changed the source code.
+ *
+ * @param checker Checker
+ * @return @c true iff checker_run() with fixing enabled changed any line
+ */
+bool checker_modified(checker_t *checker)
+{
+	size_t l;
+
+	if (checker->mod == NULL || checker->mod->lfixed == NULL)
+		return false;
+
+	for (l = 0; l < checker->mod->nlines; l++) {
+		if (checker->mod->lfixed[l])
+			return true;
+	}
+
+	return false;
 }
 
 /** Print source code.
@@ -5696,15 +7523,396 @@ int checker_print(checker_t *checker, FILE *f)
 
 	tok = checker_module_first_tok(checker->mod);
 	while (tok->tok.ttype != ltt_eof) {
-		if (fputs(tok->tok.text, f) < 0)
+		if (fwrite(tok->tok.text, 1, tok->tok.text_size, f) !=
+		    tok->tok.text_size)
+			return EIO;
+
+		tok = checker_next_tok(tok);
+	}
+
+	return EOK;
+}
+
+/** Print lines of the original source in a diff.
+ *
+ * @param diff Diff
+ * @param bline First line
+ * @param eline Last line
+ * @param prefix Line prefix (' ' or '-')
+ * @param f Output file
+ * @return EOK on success or error code
+ */
+static int checker_diff_olines(checker_diff_t *diff, size_t bline,
+    size_t eline, char prefix, FILE *f)
+{
+	size_t l;
+	size_t b, e;
+
+	for (l = bline; l <= eline; l++) {
+		b = diff->ostart[l];
+		e = diff->ostart[l + 1];
+
+		if (fputc(prefix, f) == EOF)
 			return EIO;
+		if (fwrite(diff->otext + b, 1, e - b, f) != e - b)
+			return EIO;
+		if (diff->otext[e - 1] != '\n' &&
+		    fputs("\n\\ No newline at end of file\n", f) < 0)
+			return EIO;
+	}
+
+	return EOK;
+}
+
+/** Count lines in a part of the fixed source.
+ *
+ * @param diff Diff
+ * @param b Start offset
+ * @param e End offset
+ * @return Number of lines (a last line without newline is counted)
+ */
+static size_t checker_diff_nlines(checker_diff_t *diff, size_t b, size_t e)
+{
+	size_t n;
+	size_t i;
+
+	n = 0;
+	for (i = b; i < e; i++) {
+		if (diff->ntext[i] == '\n')
+			++n;
+	}
+
+	if (e > b && diff->ntext[e - 1] != '\n')
+		++n;
+
+	return n;
+}
+
+/** Print lines of a part of the fixed source in a diff.
+ *
+ * @param diff Diff
+ * @param b Start offset
+ * @param e End offset
+ * @param f Output file
+ * @return EOK on success or error code
+ */
+static int checker_diff_nlines_print(checker_diff_t *diff, size_t b,
+    size_t e, FILE *f)
+{
+	size_t i;
+
+	for (i = b; i < e; i++) {
+		if ((i == b || diff->ntext[i - 1] == '\n') &&
+		    fputc('+', f) == EOF)
+			return EIO;
+		if (fputc(diff->ntext[i], f) == EOF)
+			return EIO;
+	}
+
+	if (e > b && diff->ntext[e - 1] != '\n' &&
+	    fputs("\n\\ No newline at end of file\n", f) < 0)
+		return EIO;
+
+	return EOK;
+}
+
+/** Determine the fixed source replacing a run of changed lines.
+ *
+ * @param diff Diff
+ * @param bline First changed line
+ * @param eline Last changed line
+ * @param rb Place to store start offset in fixed source
+ * @param re Place to store end offset in fixed source
+ */
+static void checker_diff_run(checker_diff_t *diff, size_t bline,
+    size_t eline, size_t *rb, size_t *re)
+{
+	size_t p;
 
+	/* Starts where the preceding unchanged line ends */
+	if (bline > 1) {
+		p = bline - 1;
+		*rb = diff->nstart[p] + diff->ostart[p + 1] - diff->ostart[p];
+	} else {
+		*rb = 0;
+	}
+
+	/* Ends where the following unchanged line starts */
+	if (eline < diff->nlines)
+		*re = diff->nstart[eline + 1];
+	else
+		*re = diff->nsize;
+}
+
+/** Print one hunk of a diff.
+ *
+ * @param diff Diff
+ * @param bline First original line of the hunk
+ * @param eline Last original line of the hunk
+ * @param delta Difference between new and original line numbers
+ * @param f Output file
+ * @return EOK on success or error code
+ */
+static int checker_diff_hunk(checker_diff_t *diff, size_t bline,
+    size_t eline, long *delta, FILE *f)
+{
+	size_t l, r;
+	size_t nb, ne;
+	size_t onl, nnl;
+	int rc;
+
+	/* Count lines */
+	onl = eline - bline + 1;
+	nnl = 0;
+	l = bline;
+	while (l <= eline) {
+		if (!diff->changed[l]) {
+			++nnl;
+			++l;
+			continue;
+		}
+
+		r = l;
+		while (r < eline && diff->changed[r + 1])
+			++r;
+
+		checker_diff_run(diff, l, r, &nb, &ne);
+		nnl += checker_diff_nlines(diff, nb, ne);
+		l = r + 1;
+	}
+
+	/* An empty range starts at the line preceding it */
+	if (fprintf(f, "@@ -%zu,%zu +%ld,%zu @@\n", bline, onl,
+	    (long) bline + *delta - (nnl == 0 ? 1 : 0), nnl) < 0)
+		return EIO;
+
+	l = bline;
+	while (l <= eline) {
+		if (!diff->changed[l]) {
+			rc = checker_diff_olines(diff, l, l, ' ', f);
+			if (rc != EOK)
+				return rc;
+			++l;
+			continue;
+		}
+
+		r = l;
+		while (r < eline && diff->changed[r + 1])
+			++r;
+
+		rc = checker_diff_olines(diff, l, r, '-', f);
+		if (rc != EOK)
+			return rc;
+
+		checker_diff_run(diff, l, r, &nb, &ne);
+		rc = checker_diff_nlines_print(diff, nb, ne, f);
+		if (rc != EOK)
+			return rc;
+
+		l = r + 1;
+	}
+
+	*delta += (long) nnl - (long) onl;
+	return EOK;
+}
+
+/** Build fixed source and find unchanged lines in it.
+ *
+ * @param checker Checker
+ * @param diff Diff
+ * @return EOK on success or error code
+ */
+static int checker_diff_build(checker_t *checker, checker_diff_t *diff)
+{
+	checker_tok_t *tok;
+	FILE *nf;
+	size_t offs;
+	size_t line;
+	size_t l;
+	size_t i;
+	int rc;
+
+	for (l = 1; l <= diff->nlines; l++) {
+		diff->changed[l] = l < checker->mod->nlines &&
+		    checker->mod->lfixed[l];
+		diff->nstart[l] = SIZE_MAX;
+	}
+
+	nf = open_memstream(&diff->ntext, &diff->nsize);
+	if (nf == NULL)
+		return ENOMEM;
+
+	rc = checker_print(checker, nf);
+	if (fclose(nf) < 0 && rc == EOK)
+		rc = ENOMEM;
+	if (rc != EOK)
+		return rc;
+
+	/*
+	 * Tokens starting on an unchanged line are neither new nor moved
+	 * nor altered, their text gives the position of unchanged lines
+	 * in the fixed source.
+	 */
+	offs = 0;
+	tok = checker_module_first_tok(checker->mod);
+	while (tok->tok.ttype != ltt_eof) {
+		line = tok->tok.bpos.line;
+		if (line <= diff->nlines && !diff->changed[line]) {
+			if (tok->tok.bpos.col == 1)
+				diff->nstart[line] = offs;
+
+			for (i = 0; i < tok->tok.text_size; i++) {
+				if (tok->tok.text[i] != '\n')
+					continue;
+
+				++line;
+				if (line > diff->nlines || diff->changed[line])
+					continue;
+
+				diff->nstart[line] = offs + i + 1;
+			}
+		}
+
+		offs += tok->tok.text_size;
 		tok = checker_next_tok(tok);
 	}
 
+	/* Changes past the last line are shown as a change of the last line */
+	for (l = diff->nlines + 1; l < checker->mod->nlines; l++) {
+		if (checker->mod->lfixed[l] && diff->nlines > 0)
+			diff->changed[diff->nlines] = true;
+	}
+
+	/* Treat lines we cannot locate as changed */
+	for (l = 1; l <= diff->nlines; l++) {
+		if (diff->nstart[l] == SIZE_MAX)
+			diff->changed[l] = true;
+	}
+
 	return EOK;
 }
 
+/** Print fixes as a unified diff.
+ *
+ * The changed lines are determined from the edits made by fixing issues
+ * (checker_run() with fixing enabled), the original and fixed source are
+ * not compared. Nothing is printed if fixing did not change the source.
+ *
+ * @param checker Checker
+ * @param text Original source text
+ * @param size Size of @a text in bytes
+ * @param fname File name to use in the diff header
+ * @param f Output file
+ * @return EOK on success or error code
+ */
+int checker_print_diff(checker_t *checker, const char *text, size_t size,
+    const char *fname, FILE *f)
+{
+	checker_diff_t diff;
+	size_t bline, eline;
+	size_t l, n;
+	long delta;
+	int rc;
+
+	if (!checker_modified(checker))
+		return EOK;
+
+	memset(&diff, 0, sizeof(diff));
+	diff.otext = text;
+	diff.osize = size;
+
+	n = 0;
+	for (l = 0; l < size; l++) {
+		if (text[l] == '\n')
+			++n;
+	}
+
+	if (size > 0 && text[size - 1] != '\n')
+		++n;
+
+	diff.nlines = n;
+	diff.ostart = alloc_calloc(as_checker, n + 2, sizeof(size_t));
+	diff.nstart = alloc_calloc(as_checker, n + 2, sizeof(size_t));
+	diff.changed = alloc_calloc(as_checker, n + 2, sizeof(bool));
+	if (diff.ostart == NULL || diff.nstart == NULL ||
+	    diff.changed == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	n = 1;
+	for (l = 0; l < size; l++) {
+		if (text[l] == '\n')
+			diff.ostart[++n] = l + 1;
+	}
+
+	diff.ostart[1] = 0;
+	diff.ostart[diff.nlines + 1] = size;
+
+	rc = checker_diff_build(checker, &diff);
+	if (rc != EOK)
+		goto error;
+
+	if (fprintf(f, "--- a/%s\n+++ b/%s\n", fname, fname) < 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	if (diff.nlines == 0) {
+		/* Everything is new */
+		if (fprintf(f, "@@ -0,0 +1,%zu @@\n",
+		    checker_diff_nlines(&diff, 0, diff.nsize)) < 0) {
+			rc = EIO;
+			goto error;
+		}
+
+		rc = checker_diff_nlines_print(&diff, 0, diff.nsize, f);
+		if (rc != EOK)
+			goto error;
+	}
+
+	delta = 0;
+	l = 1;
+	while (l <= diff.nlines) {
+		if (!diff.changed[l]) {
+			++l;
+			continue;
+		}
+
+		/* Extend hunk while changes are close enough to merge */
+		bline = l > checker_diff_ctx ? l - checker_diff_ctx : 1;
+		eline = l;
+		while (eline < diff.nlines) {
+			n = eline + 1;
+			while (n <= diff.nlines && !diff.changed[n] &&
+			    n - eline <= 2 * checker_diff_ctx)
+				++n;
+
+			if (n <= diff.nlines && diff.changed[n]) {
+				eline = n;
+			} else {
+				break;
+			}
+		}
+
+		l = eline + 1;
+		eline = eline + checker_diff_ctx < diff.nlines ?
+		    eline + checker_diff_ctx : diff.nlines;
+
+		rc = checker_diff_hunk(&diff, bline, eline, &delta, f);
+		if (rc != EOK)
+			goto error;
+	}
+
+	rc = EOK;
+error:
+	alloc_free(diff.ostart);
+	alloc_free(diff.nstart);
+	alloc_free(diff.changed);
+	free(diff.ntext);
+	return rc;
+}
+
 /** Dump AST.
  *
  * @param checker Checker
@@ -5855,3 +8063,37 @@ void checker_cfg_init(checker_cfg_t *cfg)
 	cfg->nblock = true;
 	cfg->sclass = true;
 }
+
+/** Get mask of check groups enabled in checker configuration.
+ *
+ * @param cfg Configuration
+ * @return Mask of enabled check groups (bit number is diag_group_t)
+ */
+unsigned checker_cfg_get_mask(checker_cfg_t *cfg)
+{
+	return (cfg->decl ? 1u << dg_decl : 0) |
+	    (cfg->estmt ? 1u << dg_estmt : 0) |
+	    (cfg->fmt ? 1u << dg_fmt : 0) |
+	    (cfg->hdr ? 1u << dg_hdr : 0) |
+	    (cfg->invchar ? 1u << dg_invchar : 0) |
+	    (cfg->loop ? 1u << dg_loop : 0) |
+	    (cfg->nblock ? 1u << dg_nblock : 0) |
+	    (cfg->sclass ? 1u << dg_sclass : 0);
+}
+
+/** Set check groups enabled in checker configuration from a mask.
+ *
+ * @param cfg Configuration to fill in
+ * @param mask Mask of enabled check groups (bit number is diag_group_t)
+ */
+void checker_cfg_set_mask(checker_cfg_t *cfg, unsigned mask)
+{
+	cfg->decl = (mask & (1u << dg_decl)) != 0;
+	cfg->estmt = (mask & (1u << dg_estmt)) != 0;
+	cfg->fmt = (mask & (1u << dg_fmt)) != 0;
+	cfg->hdr = (mask & (1u << dg_hdr)) != 0;
+	cfg->invchar = (mask & (1u << dg_invchar)) != 0;
+	cfg->loop = (mask & (1u << dg_loop)) != 0;
+	cfg->nblock = (mask & (1u << dg_nblock)) != 0;
+	cfg->sclass = (mask & (1u << dg_sclass)) != 0;
+}
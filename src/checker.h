@@ -28,17 +28,37 @@
 #define CHECKER_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <types/checker.h>
+#include <types/diag.h>
 #include <types/lexer.h>
+#include <types/trace.h>
 
 extern int checker_create(lexer_input_ops_t *, void *, checker_mtype_t,
     checker_cfg_t *, checker_t **);
 extern int checker_print(checker_t *, FILE *);
+extern int checker_print_diff(checker_t *, const char *, size_t, const char *,
+    FILE *);
 extern int checker_dump_ast(checker_t *, FILE *);
 extern int checker_dump_toks(checker_t *, FILE *);
 extern void checker_destroy(checker_t *);
 extern int checker_run(checker_t *, bool);
+extern bool checker_modified(checker_t *);
+extern void checker_set_sink(checker_t *, diag_sink_ops_t *, void *);
+extern void checker_set_errf(checker_t *, FILE *);
+extern void checker_set_incr(checker_t *);
+extern void checker_set_fps(checker_t *);
+extern void checker_set_stats(checker_t *, checker_stats_t *);
+extern void checker_set_trace(checker_t *, trace_t *);
+extern void checker_set_max_issues(checker_t *, unsigned);
+extern const char *checker_phase_str(checker_phase_t);
+extern int checker_set_lines(checker_t *, checker_lrange_t *, size_t);
+extern int checker_update(checker_t *, const char *, size_t,
+    checker_edit_t *, size_t);
+extern int checker_print_diags(checker_t *, diag_fmt_t, FILE *);
 extern void checker_cfg_init(checker_cfg_t *);
+extern unsigned checker_cfg_get_mask(checker_cfg_t *);
+extern void checker_cfg_set_mask(checker_cfg_t *, unsigned);
 
 #endif
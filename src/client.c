@@ -0,0 +1,196 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Check server client
+ *
+ * Send a check request to the check server and reproduce its output
+ * and exit status, so that the client can be used in place of ccheck.
+ */
+
+#include <client.h>
+#include <errno.h>
+#include <limits.h>
+#include <merrno.h>
+#include <server.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+enum {
+	/** Size of chunks standard input is sent in */
+	client_input_chunk = 65536
+};
+
+/** Send request to server.
+ *
+ * @param sock Socket
+ * @param argc Number of arguments
+ * @param argv Arguments (argv[0] is not sent)
+ * @return EOK on success, EIO on error
+ */
+static int client_send_req(int sock, int argc, char *argv[])
+{
+	char cwd[PATH_MAX];
+	char *buf;
+	size_t nread;
+	bool input = false;
+	int i;
+	int rc;
+
+	if (getcwd(cwd, sizeof(cwd)) == NULL)
+		return EIO;
+
+	rc = server_write_msg(sock, smt_cwd, cwd, strlen(cwd));
+	if (rc != EOK)
+		return rc;
+
+	for (i = 1; i < argc; i++) {
+		if (strncmp(argv[i], "--stdin=", 8) == 0)
+			input = true;
+
+		rc = server_write_msg(sock, smt_arg, argv[i], strlen(argv[i]));
+		if (rc != EOK)
+			return rc;
+	}
+
+	if (input) {
+		buf = malloc(client_input_chunk);
+		if (buf == NULL)
+			return ENOMEM;
+
+		while ((nread = fread(buf, 1, client_input_chunk, stdin)) > 0) {
+			rc = server_write_msg(sock, smt_input, buf, nread);
+			if (rc != EOK) {
+				free(buf);
+				return rc;
+			}
+		}
+
+		free(buf);
+		if (ferror(stdin))
+			return EIO;
+	}
+
+	return server_write_msg(sock, smt_end, NULL, 0);
+}
+
+/** Receive reply from server.
+ *
+ * @param sock Socket
+ * @param rstatus Place to store exit status
+ * @return EOK on success, EIO on error
+ */
+static int client_recv_reply(int sock, int *rstatus)
+{
+	server_msg_t mtype;
+	char *data;
+	size_t size;
+	uint8_t *sb;
+	int rc;
+
+	while (true) {
+		rc = server_read_msg(sock, &mtype, &data, &size);
+		if (rc != EOK)
+			return rc;
+
+		switch (mtype) {
+		case smt_out:
+			fwrite(data, 1, size, stdout);
+			break;
+		case smt_err:
+			/* Keep order of standard and error output */
+			fflush(stdout);
+			fwrite(data, 1, size, stderr);
+			break;
+		case smt_exit:
+			if (size != 4) {
+				free(data);
+				return EIO;
+			}
+
+			sb = (uint8_t *) data;
+			*rstatus = sb[0] | sb[1] << 8 | sb[2] << 16 |
+			    sb[3] << 24;
+			free(data);
+			return EOK;
+		default:
+			free(data);
+			return EIO;
+		}
+
+		free(data);
+	}
+}
+
+/** Run check on the check server.
+ *
+ * @param sockpath Server socket path
+ * @param argc Number of arguments
+ * @param argv Arguments as for ccheck (argv[0] is not used)
+ * @param rstatus Place to store exit status
+ * @return EOK on success, ENOENT if the server is not running, EIO
+ *         on communication error
+ */
+int client_run(const char *sockpath, int argc, char *argv[], int *rstatus)
+{
+	struct sockaddr_un addr;
+	int sock;
+	int rc;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (strlen(sockpath) >= sizeof(addr.sun_path))
+		return ENOENT;
+
+	strcpy(addr.sun_path, sockpath);
+
+	sock = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (sock < 0)
+		return ENOENT;
+
+	if (connect(sock, (struct sockaddr *) &addr, sizeof(addr)) < 0) {
+		close(sock);
+		return ENOENT;
+	}
+
+	rc = client_send_req(sock, argc, argv);
+	if (rc != EOK) {
+		/*
+		 * The server may have rejected the request before reading
+		 * all of it (e.g. as too large). Its reply says why.
+		 * Otherwise it sees the end of stream and closes
+		 * the connection without a reply.
+		 */
+		(void) shutdown(sock, SHUT_WR);
+	}
+
+	rc = client_recv_reply(sock, rstatus);
+
+	close(sock);
+	return rc != EOK ? EIO : EOK;
+}
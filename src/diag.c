@@ -0,0 +1,980 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Diagnostics
+ *
+ * Diagnostics are reported by the checker as structured records. They
+ * are collected in a per-file list, sorted by position and only formatted
+ * once the file has been checked.
+ *
+ * Diagnostics can be printed as human-readable text, as JSON lines (one
+ * object per diagnostic) or in a compact binary format. The binary format
+ * consists of a stream header (magic 'CCKD' followed by one version byte)
+ * and a sequence of records, each starting with a record type byte.
+ * All integers are little-endian, strings are prefixed with a 16-bit
+ * length.
+ *
+ *   'F' file record: name (string). Precedes diagnostics for that file.
+ *   'D' diagnostic record: message ID (16 bits), check group (8 bits),
+ *       token type (8 bits), begin line, begin column, end line,
+ *       end column, two numeric arguments (32 bits each), character
+ *       argument (8 bits), fingerprint (64 bits, as low and high 32 bits,
+ *       zero if not computed),
+ *       text argument (string), token text (string).
+ */
+
+#include <assert.h>
+#include <diag.h>
+#include <lexer.h>
+#include <merrno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int diag_list_report(void *, diag_t *);
+static int diag_write_bin_file(const char *, FILE *);
+
+diag_sink_ops_t diag_list_sink = {
+	.report = diag_list_report
+};
+
+enum {
+	/** Initial number of entries allocated in a diagnostic list */
+	diag_list_init_alloc = 16,
+	/** Maximum length of formatted message including null terminator */
+	diag_msg_max_len = 256,
+	/** Binary format version */
+	diag_bin_version = 2
+};
+
+/** Binary format magic */
+static const char diag_bin_magic[4] = { 'C', 'C', 'K', 'D' };
+
+/** Binary format record types */
+enum {
+	/** File record */
+	dbr_file = 'F',
+	/** Diagnostic record */
+	dbr_diag = 'D'
+};
+
+/** Diagnostic message information */
+typedef struct {
+	/** Stable message name */
+	const char *name;
+	/** Check group */
+	diag_group_t group;
+	/** Message format */
+	const char *fmt;
+	/** Separator between token tag and message (if not ": ") */
+	const char *sep;
+} diag_msg_info_t;
+
+/** Message table.
+ *
+ * The format can contain the following conversions: %s (text argument),
+ * %u (next numeric argument), %c (character argument, escaped).
+ */
+static const diag_msg_info_t diag_msgs[dm_limit] = {
+	[dm_lbegin] = { "lbegin", dg_fmt, "%s" },
+	[dm_nows_before] = { "nows-before", dg_fmt, "%s" },
+	[dm_nows_after] = { "nows-after", dg_fmt, "%s" },
+	[dm_nsbrk_before] = { "nsbrk-before", dg_fmt, "%s" },
+	[dm_nsbrk_after] = { "nsbrk-after", dg_fmt, "%s" },
+	[dm_brkspace_before] = { "brkspace-before", dg_fmt, "%s" },
+	[dm_brkspace_after] = { "brkspace-after", dg_fmt, "%s" },
+	[dm_nbspace_before] = { "nbspace-before", dg_fmt, "%s" },
+	[dm_binop_lbegin] = { "binop-lbegin", dg_fmt, "%s" },
+	[dm_do_braces] = {
+		"do-braces", dg_loop,
+		"Body of 'do' loop should always have braces."
+	},
+	[dm_for_empty_next] = {
+		"for-empty-next", dg_loop,
+		"For loop with empty next expression. Use while instead."
+	},
+	[dm_null_stmt] = {
+		"null-stmt", dg_estmt,
+		"Unexpected null statement."
+	},
+	[dm_nested_block] = {
+		"nested-block", dg_nblock,
+		"Gratuitous nested block."
+	},
+	[dm_empty_member] = {
+		"empty-member", dg_estmt,
+		"Empty struct or union member declaration."
+	},
+	[dm_invchar_strlit] = {
+		"invchar-strlit", dg_invchar,
+		"Invalid character '%c' inside string literal."
+	},
+	[dm_invchar_charlit] = {
+		"invchar-charlit", dg_invchar,
+		"Invalid character '%c' inside character literal."
+	},
+	[dm_invchar_comment] = {
+		"invchar-comment", dg_invchar,
+		"Invalid character '%c' inside comment."
+	},
+	[dm_extern_fundef] = {
+		"extern-fundef", dg_sclass,
+		"Improper use of storage class 'extern' with function "
+		    "definition."
+	},
+	[dm_hdr_fundef] = {
+		"hdr-fundef", dg_hdr,
+		"Non-static function defined in a header."
+	},
+	[dm_multi_fundecl] = {
+		"multi-fundecl", dg_decl,
+		"Multiple function declarators."
+	},
+	[dm_mixed_fun_var] = {
+		"mixed-fun-var", dg_decl,
+		"Mixing function and variable declarators."
+	},
+	[dm_hdr_vardef] = {
+		"hdr-vardef", dg_sclass,
+		"Non-static variable defined in a header."
+	},
+	[dm_empty_decln] = { "empty-decln", dg_estmt, "Empty declaration." },
+	[dm_externc_lang] = {
+		"externc-lang", dg_hdr,
+		"Linked language is not 'C'."
+	},
+	[dm_indent_mixed] = {
+		"indent-mixed", dg_fmt,
+		"Mixing tabs and spaces in indentation."
+	},
+	[dm_indent_noncont] = {
+		"indent-noncont", dg_fmt,
+		"Non-continuation line should not have any spaces for "
+		    "indentation (found %u)"
+	},
+	[dm_indent_spaces] = {
+		"indent-spaces", dg_fmt,
+		"Line is indented by %u spaces (should be %u)"
+	},
+	[dm_indent_tabs] = {
+		"indent-tabs", dg_fmt,
+		"Wrong indentation: found %u tabs, should be %u tabs"
+	},
+	[dm_mixed_tabs_spaces] = {
+		"mixed-tabs-spaces", dg_fmt,
+		"Mixing tabs and spaces."
+	},
+	[dm_backslash] = {
+		"backslash", dg_invchar,
+		"Backslash outside of preprocessor directive."
+	},
+	[dm_tok_not_checked] = {
+		"tok-not-checked", dg_internal,
+		"Token not checked", " "
+	},
+	[dm_indlvl_mismatch] = {
+		"indlvl-mismatch", dg_internal,
+		"Indentation mismatch: parser %u, checker %u."
+	},
+	[dm_seccont_mismatch] = {
+		"seccont-mismatch", dg_internal,
+		"Secondary indentation mismatch: parser %u, checker %u."
+	},
+	[dm_cmt_asterisk] = {
+		"cmt-asterisk", dg_fmt,
+		"'*' expected at beginning of block comment line."
+	},
+	[dm_cmt_space] = { "cmt-space", dg_fmt, "Space expected after '*'." },
+	[dm_cmt_unterminated] = {
+		"cmt-unterminated", dg_fmt,
+		"Unterminated comment."
+	},
+	[dm_cmt_text_nl] = {
+		"cmt-text-nl", dg_fmt,
+		"Comment text should begin on a new line."
+	},
+	[dm_cmt_close_nl] = {
+		"cmt-close-nl", dg_fmt,
+		"Block comment closing '*/' should be on a new line."
+	},
+	[dm_trailing_ws] = {
+		"trailing-ws", dg_fmt,
+		"Whitespace at end of line"
+	},
+	[dm_bof_empty_line] = {
+		"bof-empty-line", dg_fmt,
+		"Unexpected empty line at beginning of file."
+	},
+	[dm_multi_empty_lines] = {
+		"multi-empty-lines", dg_fmt,
+		"Unexpected multiple consecutive empty lines."
+	},
+	[dm_eof_newline] = {
+		"eof-newline", dg_fmt,
+		"Expected newline at end of file."
+	},
+	[dm_eof_empty_lines] = {
+		"eof-empty-lines", dg_fmt,
+		"Unexpected empty lines at end of file."
+	}
+};
+
+/** Check group names */
+static const char *diag_group_names[] = {
+	[dg_decl] = "decl",
+	[dg_estmt] = "estmt",
+	[dg_fmt] = "fmt",
+	[dg_hdr] = "hdr",
+	[dg_invchar] = "invchar",
+	[dg_loop] = "loop",
+	[dg_nblock] = "nblock",
+	[dg_sclass] = "sclass",
+	[dg_internal] = "internal"
+};
+
+/** Initialize diagnostic list.
+ *
+ * @param list Diagnostic list
+ */
+void diag_list_init(diag_list_t *list)
+{
+	list->fname = NULL;
+	list->diag = NULL;
+	list->ndiags = 0;
+	list->alloc = 0;
+}
+
+/** Finalize diagnostic list, freeing all entries.
+ *
+ * @param list Diagnostic list
+ */
+void diag_list_fini(diag_list_t *list)
+{
+	diag_list_clear(list);
+	free(list->diag);
+	diag_list_init(list);
+}
+
+/** Remove all entries from diagnostic list.
+ *
+ * The memory allocated for the entries is kept so that the list can be
+ * reused without reallocating.
+ *
+ * @param list Diagnostic list
+ */
+void diag_list_clear(diag_list_t *list)
+{
+	size_t i;
+
+	for (i = 0; i < list->ndiags; i++)
+		diag_free_strs(&list->diag[i]);
+
+	free(list->fname);
+	list->fname = NULL;
+	list->ndiags = 0;
+}
+
+/** Append diagnostic to list.
+ *
+ * The file name and token text are copied, other arguments are
+ * expected to be static.
+ *
+ * @param list Diagnostic list
+ * @param diag Diagnostic
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int diag_list_append(diag_list_t *list, diag_t *diag)
+{
+	diag_t *ndiag;
+	diag_t *d;
+	size_t nalloc;
+
+	if (list->fname == NULL) {
+		/* All entries share the same file name */
+		list->fname = strdup(diag->file);
+		if (list->fname == NULL)
+			return ENOMEM;
+	}
+
+	if (list->ndiags >= list->alloc) {
+		nalloc = list->alloc != 0 ? 2 * list->alloc :
+		    diag_list_init_alloc;
+		ndiag = realloc(list->diag, nalloc * sizeof(diag_t));
+		if (ndiag == NULL)
+			return ENOMEM;
+
+		list->diag = ndiag;
+		list->alloc = nalloc;
+	}
+
+	d = &list->diag[list->ndiags];
+	*d = *diag;
+	d->file = list->fname;
+	d->seq = list->ndiags;
+	d->text = NULL;
+	d->ttext = NULL;
+
+	if (diag->text != NULL) {
+		d->text = strdup(diag->text);
+		if (d->text == NULL)
+			return ENOMEM;
+	}
+
+	if (diag->ttext != NULL) {
+		d->ttext = strdup(diag->ttext);
+		if (d->ttext == NULL) {
+			diag_free_strs(d);
+			return ENOMEM;
+		}
+	}
+
+	++list->ndiags;
+	return EOK;
+}
+
+/** Diagnostic list sink report function.
+ *
+ * @param arg Diagnostic list (diag_list_t *)
+ * @param diag Diagnostic
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int diag_list_report(void *arg, diag_t *diag)
+{
+	diag_list_t *list = (diag_list_t *) arg;
+
+	return diag_list_append(list, diag);
+}
+
+/** Compare two diagnostics by position.
+ *
+ * Diagnostics at the same position are ordered as they were reported.
+ *
+ * @param a First diagnostic (diag_t *)
+ * @param b Second diagnostic (diag_t *)
+ * @return Less than, equal to or greater than zero
+ */
+static int diag_cmp(const void *a, const void *b)
+{
+	const diag_t *da = (const diag_t *) a;
+	const diag_t *db = (const diag_t *) b;
+
+	if (da->bline != db->bline)
+		return da->bline < db->bline ? -1 : 1;
+	if (da->bcol != db->bcol)
+		return da->bcol < db->bcol ? -1 : 1;
+	if (da->seq != db->seq)
+		return da->seq < db->seq ? -1 : 1;
+
+	return 0;
+}
+
+/** Sort diagnostics in list by position.
+ *
+ * @param list Diagnostic list
+ */
+void diag_list_sort(diag_list_t *list)
+{
+	if (list->ndiags > 1)
+		qsort(list->diag, list->ndiags, sizeof(diag_t), diag_cmp);
+}
+
+/** Print all diagnostics in list.
+ *
+ * @param list Diagnostic list
+ * @param fmt Output format
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+int diag_list_print(diag_list_t *list, diag_fmt_t fmt, FILE *f)
+{
+	size_t i;
+	int rc;
+
+	if (fmt == dfmt_bin && list->ndiags > 0) {
+		rc = diag_write_bin_file(list->fname, f);
+		if (rc != EOK)
+			return rc;
+	}
+
+	for (i = 0; i < list->ndiags; i++) {
+		switch (fmt) {
+		case dfmt_text:
+			rc = diag_print(&list->diag[i], f);
+			break;
+		case dfmt_jsonl:
+			rc = diag_print_jsonl(&list->diag[i], f);
+			break;
+		case dfmt_bin:
+			rc = diag_write_bin(&list->diag[i], f);
+			break;
+		default:
+			assert(false);
+			rc = EINVAL;
+			break;
+		}
+
+		if (rc != EOK)
+			return rc;
+	}
+
+	return EOK;
+}
+
+/** Print diagnostic position range.
+ *
+ * @param diag Diagnostic
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_print_range(diag_t *diag, FILE *f)
+{
+	if (diag->bline == diag->eline && diag->bcol == diag->ecol) {
+		if (fprintf(f, "%s:%zu:%zu", diag->file, diag->bline,
+		    diag->bcol) < 0)
+			return EIO;
+	} else if (diag->bline == diag->eline) {
+		if (fprintf(f, "%s:%zu:%zu-%zu", diag->file, diag->bline,
+		    diag->bcol, diag->ecol) < 0)
+			return EIO;
+	} else {
+		if (fprintf(f, "%s:%zu:%zu-%zu:%zu", diag->file, diag->bline,
+		    diag->bcol, diag->eline, diag->ecol) < 0)
+			return EIO;
+	}
+
+	return EOK;
+}
+
+/** Print diagnostic token tag.
+ *
+ * @param diag Diagnostic
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_print_tag(diag_t *diag, FILE *f)
+{
+	const char *cp;
+	int rc;
+
+	if (fputc('<', f) == EOF)
+		return EIO;
+
+	rc = diag_print_range(diag, f);
+	if (rc != EOK)
+		return rc;
+
+	if (fprintf(f, ":%s", lexer_str_ttype(diag->ttype)) < 0)
+		return EIO;
+
+	if (diag->ttext != NULL) {
+		if (fputc(':', f) == EOF)
+			return EIO;
+
+		if (diag->ttype == ltt_invalid) {
+			cp = diag->ttext;
+			while (*cp != '\0') {
+				rc = lexer_dprint_char(*cp++, f);
+				if (rc != EOK)
+					return rc;
+			}
+		} else {
+			if (fputs(diag->ttext, f) < 0)
+				return EIO;
+		}
+	}
+
+	if (fputc('>', f) == EOF)
+		return EIO;
+
+	return EOK;
+}
+
+/** Format diagnostic message.
+ *
+ * The message is truncated if it does not fit into the buffer.
+ *
+ * @param diag Diagnostic
+ * @param buf Buffer to store the message to
+ * @param bsize Buffer size
+ */
+void diag_format_msg(diag_t *diag, char *buf, size_t bsize)
+{
+	const char *cp;
+	unsigned narg;
+	size_t pos;
+	uint8_t b;
+	int n;
+
+	assert(bsize > 0);
+
+	narg = 0;
+	pos = 0;
+	cp = diag_msgs[diag->msg].fmt;
+	while (*cp != '\0' && pos + 1 < bsize) {
+		if (cp[0] == '%' && cp[1] != '\0') {
+			switch (cp[1]) {
+			case 's':
+				n = snprintf(buf + pos, bsize - pos, "%s",
+				    diag->text != NULL ? diag->text : "");
+				break;
+			case 'u':
+				assert(narg < 2);
+				n = snprintf(buf + pos, bsize - pos, "%u",
+				    diag->num[narg++]);
+				break;
+			case 'c':
+				/* Same escaping as lexer_dprint_char() */
+				b = (uint8_t) diag->chr;
+				if (b < 32 || b >= 127) {
+					n = snprintf(buf + pos, bsize - pos,
+					    "#%02x", diag->chr);
+				} else if (diag->chr == '#') {
+					n = snprintf(buf + pos, bsize - pos,
+					    "##");
+				} else {
+					n = snprintf(buf + pos, bsize - pos,
+					    "%c", diag->chr);
+				}
+				break;
+			default:
+				assert(false);
+				n = 0;
+				break;
+			}
+
+			if (n < 0)
+				n = 0;
+			pos += (size_t) n;
+			if (pos >= bsize)
+				pos = bsize - 1;
+			cp += 2;
+		} else {
+			buf[pos++] = *cp++;
+		}
+	}
+
+	buf[pos] = '\0';
+}
+
+/** Print diagnostic as human-readable text.
+ *
+ * @param diag Diagnostic
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+int diag_print(diag_t *diag, FILE *f)
+{
+	char msg[diag_msg_max_len];
+	const char *sep;
+	int rc;
+
+	rc = diag_print_tag(diag, f);
+	if (rc != EOK)
+		return rc;
+
+	sep = diag_msgs[diag->msg].sep;
+	if (sep == NULL)
+		sep = ": ";
+
+	diag_format_msg(diag, msg, sizeof(msg));
+	if (fprintf(f, "%s%s\n", sep, msg) < 0)
+		return EIO;
+
+	return EOK;
+}
+
+/** Print string as a JSON string literal.
+ *
+ * @param str String
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_print_json_str(const char *str, FILE *f)
+{
+	const char *cp;
+	uint8_t b;
+
+	if (fputc('"', f) == EOF)
+		return EIO;
+
+	cp = str;
+	while (*cp != '\0') {
+		b = (uint8_t) *cp;
+		if (*cp == '"' || *cp == '\\') {
+			if (fputc('\\', f) == EOF || fputc(*cp, f) == EOF)
+				return EIO;
+		} else if (b < 32) {
+			if (fprintf(f, "\\u%04x", b) < 0)
+				return EIO;
+		} else {
+			if (fputc(*cp, f) == EOF)
+				return EIO;
+		}
+
+		++cp;
+	}
+
+	if (fputc('"', f) == EOF)
+		return EIO;
+
+	return EOK;
+}
+
+/** Print diagnostic as a JSON object on a single line.
+ *
+ * @param diag Diagnostic
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+int diag_print_jsonl(diag_t *diag, FILE *f)
+{
+	char msg[diag_msg_max_len];
+	int rc;
+
+	if (fputs("{\"file\":", f) < 0)
+		return EIO;
+	rc = diag_print_json_str(diag->file, f);
+	if (rc != EOK)
+		return rc;
+
+	if (fprintf(f, ",\"line\":%zu,\"col\":%zu,\"eline\":%zu,"
+	    "\"ecol\":%zu,\"group\":\"%s\",\"id\":\"%s\",\"mid\":%u,"
+	    "\"tok\":", diag->bline, diag->bcol, diag->eline, diag->ecol,
+	    diag_group_str(diag->group), diag_msg_str(diag->msg),
+	    (unsigned) diag->msg) < 0)
+		return EIO;
+
+	rc = diag_print_json_str(lexer_str_ttype(diag->ttype), f);
+	if (rc != EOK)
+		return rc;
+
+	if (diag->ttext != NULL) {
+		if (fputs(",\"ttext\":", f) < 0)
+			return EIO;
+		rc = diag_print_json_str(diag->ttext, f);
+		if (rc != EOK)
+			return rc;
+	}
+
+	if (fputs(",\"msg\":", f) < 0)
+		return EIO;
+
+	diag_format_msg(diag, msg, sizeof(msg));
+	rc = diag_print_json_str(msg, f);
+	if (rc != EOK)
+		return rc;
+
+	if (fputs("}\n", f) < 0)
+		return EIO;
+
+	return EOK;
+}
+
+/** Write unsigned integer in little-endian byte order.
+ *
+ * @param val Value
+ * @param nbytes Number of bytes to write
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_write_uint(uint32_t val, unsigned nbytes, FILE *f)
+{
+	uint8_t buf[4];
+	unsigned i;
+
+	assert(nbytes <= 4);
+
+	for (i = 0; i < nbytes; i++) {
+		buf[i] = val & 0xff;
+		val >>= 8;
+	}
+
+	if (fwrite(buf, 1, nbytes, f) != nbytes)
+		return EIO;
+
+	return EOK;
+}
+
+/** Write length-prefixed string in binary format.
+ *
+ * @param str String or @c NULL (written as empty string)
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_write_str(const char *str, FILE *f)
+{
+	size_t len;
+	int rc;
+
+	len = str != NULL ? strlen(str) : 0;
+	if (len > UINT16_MAX)
+		len = UINT16_MAX;
+
+	rc = diag_write_uint(len, 2, f);
+	if (rc != EOK)
+		return rc;
+
+	if (len > 0 && fwrite(str, 1, len, f) != len)
+		return EIO;
+
+	return EOK;
+}
+
+/** Write binary diagnostic stream header.
+ *
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+int diag_bin_header(FILE *f)
+{
+	if (fwrite(diag_bin_magic, 1, 4, f) != 4)
+		return EIO;
+
+	return diag_write_uint(diag_bin_version, 1, f);
+}
+
+/** Write file record in binary format.
+ *
+ * @param fname File name
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_write_bin_file(const char *fname, FILE *f)
+{
+	if (fputc(dbr_file, f) == EOF)
+		return EIO;
+
+	return diag_write_str(fname, f);
+}
+
+/** Write diagnostic record in binary format.
+ *
+ * @param diag Diagnostic
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+int diag_write_bin(diag_t *diag, FILE *f)
+{
+	int rc;
+
+	if (fputc(dbr_diag, f) == EOF)
+		return EIO;
+
+	rc = diag_write_uint(diag->msg, 2, f);
+	if (rc == EOK)
+		rc = diag_write_uint(diag->group, 1, f);
+	if (rc == EOK)
+		rc = diag_write_uint(diag->ttype, 1, f);
+	if (rc == EOK)
+		rc = diag_write_uint(diag->bline, 4, f);
+	if (rc == EOK)
+		rc = diag_write_uint(diag->bcol, 4, f);
+	if (rc == EOK)
+		rc = diag_write_uint(diag->eline, 4, f);
+	if (rc == EOK)
+		rc = diag_write_uint(diag->ecol, 4, f);
+	if (rc == EOK)
+		rc = diag_write_uint(diag->num[0], 4, f);
+	if (rc == EOK)
+		rc = diag_write_uint(diag->num[1], 4, f);
+	if (rc == EOK)
+		rc = diag_write_uint((uint8_t) diag->chr, 1, f);
+	if (rc == EOK)
+		rc = diag_write_uint((uint32_t) diag->fp, 4, f);
+	if (rc == EOK)
+		rc = diag_write_uint((uint32_t) (diag->fp >> 32), 4, f);
+	if (rc == EOK)
+		rc = diag_write_str(diag->text, f);
+	if (rc == EOK)
+		rc = diag_write_str(diag->ttext, f);
+
+	return rc;
+}
+
+/** Read unsigned integer in little-endian byte order.
+ *
+ * @param nbytes Number of bytes to read
+ * @param f Input file
+ * @param rval Place to store value
+ * @return EOK on success, EIO on I/O error or end of file
+ */
+static int diag_read_uint(unsigned nbytes, FILE *f, uint32_t *rval)
+{
+	uint8_t buf[4];
+	uint32_t val;
+	unsigned i;
+
+	assert(nbytes <= 4);
+
+	if (fread(buf, 1, nbytes, f) != nbytes)
+		return EIO;
+
+	val = 0;
+	for (i = 0; i < nbytes; i++)
+		val |= (uint32_t) buf[i] << (8 * i);
+
+	*rval = val;
+	return EOK;
+}
+
+/** Read length-prefixed string in binary format.
+ *
+ * @param f Input file
+ * @param rstr Place to store newly allocated string or @c NULL if
+ *             the string is empty
+ * @return EOK on success, EIO on I/O error or end of file, ENOMEM if
+ *         out of memory
+ */
+static int diag_read_str(FILE *f, char **rstr)
+{
+	uint32_t len;
+	char *str;
+	int rc;
+
+	rc = diag_read_uint(2, f, &len);
+	if (rc != EOK)
+		return rc;
+
+	if (len == 0) {
+		*rstr = NULL;
+		return EOK;
+	}
+
+	str = malloc(len + 1);
+	if (str == NULL)
+		return ENOMEM;
+
+	if (fread(str, 1, len, f) != len) {
+		free(str);
+		return EIO;
+	}
+
+	str[len] = '\0';
+	*rstr = str;
+	return EOK;
+}
+
+/** Read diagnostic record in binary format.
+ *
+ * The record must have been written by diag_write_bin(). The text
+ * arguments are allocated and must be freed using diag_free_strs().
+ * The file name is not set.
+ *
+ * @param f Input file
+ * @param diag Place to store diagnostic
+ * @return EOK on success, EIO on I/O error or end of file, EINVAL if
+ *         the record is not valid, ENOMEM if out of memory
+ */
+int diag_read_bin(FILE *f, diag_t *diag)
+{
+	uint32_t val[12];
+	unsigned nbytes[12] = { 2, 1, 1, 4, 4, 4, 4, 4, 4, 1, 4, 4 };
+	char *text;
+	char *ttext;
+	unsigned i;
+	int rc;
+
+	if (fgetc(f) != dbr_diag)
+		return EINVAL;
+
+	for (i = 0; i < 12; i++) {
+		rc = diag_read_uint(nbytes[i], f, &val[i]);
+		if (rc != EOK)
+			return rc;
+	}
+
+	if (val[0] >= dm_limit || val[1] != diag_msg_group(val[0]) ||
+	    val[2] > ltt_error)
+		return EINVAL;
+
+	rc = diag_read_str(f, &text);
+	if (rc != EOK)
+		return rc;
+
+	rc = diag_read_str(f, &ttext);
+	if (rc != EOK) {
+		free(text);
+		return rc;
+	}
+
+	memset(diag, 0, sizeof(diag_t));
+	diag->msg = val[0];
+	diag->group = val[1];
+	diag->ttype = val[2];
+	diag->bline = val[3];
+	diag->bcol = val[4];
+	diag->eline = val[5];
+	diag->ecol = val[6];
+	diag->num[0] = val[7];
+	diag->num[1] = val[8];
+	diag->chr = (char) val[9];
+	diag->fp = val[10] | (uint64_t) val[11] << 32;
+	diag->text = text;
+	diag->ttext = ttext;
+	return EOK;
+}
+
+/** Free text arguments of a diagnostic.
+ *
+ * @param diag Diagnostic read by diag_read_bin() or stored in
+ *             a diagnostic list
+ */
+void diag_free_strs(diag_t *diag)
+{
+	free((char *) diag->text);
+	free((char *) diag->ttext);
+	diag->text = NULL;
+	diag->ttext = NULL;
+}
+
+/** Get stable name of diagnostic message.
+ *
+ * @param msg Message ID
+ * @return Message name
+ */
+const char *diag_msg_str(diag_msg_t msg)
+{
+	assert(msg < dm_limit);
+	return diag_msgs[msg].name;
+}
+
+/** Get check group a diagnostic message belongs to.
+ *
+ * @param msg Message ID
+ * @return Check group
+ */
+diag_group_t diag_msg_group(diag_msg_t msg)
+{
+	assert(msg < dm_limit);
+	return diag_msgs[msg].group;
+}
+
+/** Get name of check group.
+ *
+ * @param group Check group
+ * @return Check group name
+ */
+const char *diag_group_str(diag_group_t group)
+{
+	return diag_group_names[group];
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Diagnostics
+ */
+
+#ifndef DIAG_H
+#define DIAG_H
+
+#include <stdio.h>
+#include <types/diag.h>
+
+extern diag_sink_ops_t diag_list_sink;
+
+extern void diag_list_init(diag_list_t *);
+extern void diag_list_fini(diag_list_t *);
+extern void diag_list_clear(diag_list_t *);
+extern int diag_list_append(diag_list_t *, diag_t *);
+extern void diag_list_sort(diag_list_t *);
+extern int diag_list_print(diag_list_t *, diag_fmt_t, FILE *);
+extern void diag_format_msg(diag_t *, char *, size_t);
+extern int diag_print(diag_t *, FILE *);
+extern int diag_print_jsonl(diag_t *, FILE *);
+extern int diag_bin_header(FILE *);
+extern int diag_write_bin(diag_t *, FILE *);
+extern int diag_read_bin(FILE *, diag_t *);
+extern void diag_free_strs(diag_t *);
+extern const char *diag_msg_str(diag_msg_t);
+extern const char *diag_group_str(diag_group_t);
+extern diag_group_t diag_msg_group(diag_msg_t);
+
+#endif
@@ -0,0 +1,320 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * List of source files to check
+ *
+ * Files can be added either explicitly or by recursively scanning
+ * a directory for C source and header files.
+ */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <flist.h>
+#include <merrno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum {
+	/** Initial number of entries allocated in a file list */
+	flist_init_alloc = 64
+};
+
+/** Create file list.
+ *
+ * @param dirfd Directory relative paths are resolved against
+ *              (or @c AT_FDCWD)
+ * @param errf Output stream for errors
+ * @param rflist Place to store pointer to new file list
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int flist_create(int dirfd, FILE *errf, flist_t **rflist)
+{
+	flist_t *flist;
+
+	flist = calloc(1, sizeof(flist_t));
+	if (flist == NULL)
+		return ENOMEM;
+
+	flist->dirfd = dirfd;
+	flist->errf = errf;
+
+	*rflist = flist;
+	return EOK;
+}
+
+/** Destroy file list.
+ *
+ * @param flist File list
+ */
+void flist_destroy(flist_t *flist)
+{
+	size_t i;
+
+	if (flist == NULL)
+		return;
+
+	for (i = 0; i < flist->nentries; i++)
+		free(flist->entry[i].path);
+
+	free(flist->entry);
+	free(flist);
+}
+
+/** Add file to file list.
+ *
+ * @param flist File list
+ * @param path File path
+ * @param size File size in bytes
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int flist_add_file(flist_t *flist, const char *path, size_t size)
+{
+	flist_entry_t *nentry;
+	size_t nalloc;
+	char *dpath;
+
+	if (flist->nentries >= flist->alloc) {
+		nalloc = flist->alloc != 0 ? 2 * flist->alloc :
+		    flist_init_alloc;
+		nentry = realloc(flist->entry, nalloc * sizeof(flist_entry_t));
+		if (nentry == NULL)
+			return ENOMEM;
+
+		flist->entry = nentry;
+		flist->alloc = nalloc;
+	}
+
+	dpath = strdup(path);
+	if (dpath == NULL)
+		return ENOMEM;
+
+	flist->entry[flist->nentries].path = dpath;
+	flist->entry[flist->nentries].size = size;
+	++flist->nentries;
+	return EOK;
+}
+
+/** Determine if file name has an extension of a C source or header file.
+ *
+ * @param name File name
+ * @return @c true iff file name ends with .c or .h
+ */
+bool flist_is_src_name(const char *name)
+{
+	const char *ext;
+
+	ext = strrchr(name, '.');
+	if (ext == NULL || ext == name)
+		return false;
+
+	return strcmp(ext, ".c") == 0 || strcmp(ext, ".h") == 0;
+}
+
+/** Compare two strings for sorting.
+ *
+ * @param a Pointer to first string (char **)
+ * @param b Pointer to second string (char **)
+ * @return Less than, equal to or greater than zero
+ */
+static int flist_name_cmp(const void *a, const void *b)
+{
+	char *const *sa = (char *const *) a;
+	char *const *sb = (char *const *) b;
+
+	return strcmp(*sa, *sb);
+}
+
+/** Scan directory recursively, adding all C source and header files.
+ *
+ * Directory entries are visited in sorted order so that the resulting
+ * list does not depend on the order of entries in the file system.
+ * Symbolic links are not followed.
+ *
+ * @param flist File list
+ * @param dpath Directory path
+ * @return EOK on success or error code
+ */
+static int flist_scan_dir(flist_t *flist, const char *dpath)
+{
+	DIR *dir;
+	struct dirent *de;
+	struct stat st;
+	int fd;
+	char **names = NULL;
+	char **nnames;
+	size_t nnames_used = 0;
+	size_t nalloc = 0;
+	char *path;
+	size_t i;
+	int rc;
+
+	fd = openat(flist->dirfd, dpath, O_RDONLY | O_DIRECTORY);
+	dir = fd >= 0 ? fdopendir(fd) : NULL;
+	if (dir == NULL) {
+		if (fd >= 0)
+			close(fd);
+		fprintf(flist->errf, "Cannot open directory '%s'.\n", dpath);
+		return EIO;
+	}
+
+	while ((de = readdir(dir)) != NULL) {
+		if (strcmp(de->d_name, ".") == 0 ||
+		    strcmp(de->d_name, "..") == 0)
+			continue;
+
+		if (nnames_used >= nalloc) {
+			nalloc = nalloc != 0 ? 2 * nalloc : flist_init_alloc;
+			nnames = realloc(names, nalloc * sizeof(char *));
+			if (nnames == NULL) {
+				rc = ENOMEM;
+				goto error;
+			}
+
+			names = nnames;
+		}
+
+		names[nnames_used] = strdup(de->d_name);
+		if (names[nnames_used] == NULL) {
+			rc = ENOMEM;
+			goto error;
+		}
+
+		++nnames_used;
+	}
+
+	closedir(dir);
+	dir = NULL;
+
+	if (nnames_used > 0)
+		qsort(names, nnames_used, sizeof(char *), flist_name_cmp);
+
+	for (i = 0; i < nnames_used; i++) {
+		if (asprintf(&path, "%s/%s", dpath, names[i]) < 0) {
+			rc = ENOMEM;
+			goto error;
+		}
+
+		if (fstatat(flist->dirfd, path, &st, AT_SYMLINK_NOFOLLOW) < 0) {
+			/* Vanished or inaccessible, skip it */
+			free(path);
+			continue;
+		}
+
+		if (S_ISDIR(st.st_mode)) {
+			rc = flist_scan_dir(flist, path);
+		} else if (S_ISREG(st.st_mode) &&
+		    flist_is_src_name(names[i])) {
+			rc = flist_add_file(flist, path, st.st_size);
+		} else {
+			rc = EOK;
+		}
+
+		free(path);
+		if (rc != EOK)
+			goto error;
+	}
+
+	for (i = 0; i < nnames_used; i++)
+		free(names[i]);
+	free(names);
+	return EOK;
+error:
+	if (dir != NULL)
+		closedir(dir);
+	for (i = 0; i < nnames_used; i++)
+		free(names[i]);
+	free(names);
+	return rc;
+}
+
+/** Add path to file list.
+ *
+ * If @a path is a directory, it is scanned recursively and all C source
+ * and header files are added. Otherwise @a path is added as is (even
+ * if it does not exist, so that the error is reported when checking it).
+ *
+ * @param flist File list
+ * @param path File or directory path
+ * @return EOK on success or error code
+ */
+int flist_add_path(flist_t *flist, const char *path)
+{
+	struct stat st;
+
+	if (fstatat(flist->dirfd, path, &st, 0) < 0)
+		return flist_add_file(flist, path, 0);
+
+	if (S_ISDIR(st.st_mode)) {
+		flist->dirs = true;
+		return flist_scan_dir(flist, path);
+	}
+
+	return flist_add_file(flist, path, st.st_size);
+}
+
+/** Compare two file list entries by path.
+ *
+ * @param a Pointer to first entry (flist_entry_t *)
+ * @param b Pointer to second entry (flist_entry_t *)
+ * @return Less than, equal to or greater than zero
+ */
+static int flist_entry_cmp(const void *a, const void *b)
+{
+	const flist_entry_t *ea = (const flist_entry_t *) a;
+	const flist_entry_t *eb = (const flist_entry_t *) b;
+
+	return strcmp(ea->path, eb->path);
+}
+
+/** Sort file list by path and remove duplicate entries.
+ *
+ * @param flist File list
+ */
+void flist_uniq(flist_t *flist)
+{
+	size_t i;
+	size_t n;
+
+	if (flist->nentries == 0)
+		return;
+
+	qsort(flist->entry, flist->nentries, sizeof(flist_entry_t),
+	    flist_entry_cmp);
+
+	n = 1;
+	for (i = 1; i < flist->nentries; i++) {
+		if (strcmp(flist->entry[i].path,
+		    flist->entry[n - 1].path) == 0) {
+			/* Keep the most recent size */
+			flist->entry[n - 1].size = flist->entry[i].size;
+			free(flist->entry[i].path);
+		} else {
+			flist->entry[n++] = flist->entry[i];
+		}
+	}
+
+	flist->nentries = n;
+}
@@ -0,0 +1,880 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Complexity fuzzer
+ *
+ * Looks for inputs on which the parser or the checker does super-linear
+ * work. A random fragment template with a hole is generated from
+ * a simplified C grammar (an expression, statement, declarator,
+ * initializer or global declaration). The template is nested into itself
+ * a growing number of times and the work done checking the result is
+ * measured as the number of tokens read by the parser (including
+ * re-reads when trying multiple parsing options) plus the number of
+ * tokens visited by the checker walking the token list.
+ *
+ * Inputs where work grows faster than size^1.5 or exceeds
+ * fuzz_max_work_per_tok per token are saved as regression test cases.
+ * Regression test cases are checked by fuzz_test(), which requires
+ * the work to stay below fuzz_max_work_per_tok per token.
+ */
+
+#include <buf_input.h>
+#include <checker.h>
+#include <fcntl.h>
+#include <file_input.h>
+#include <flist.h>
+#include <fuzz.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+	/** Maximum depth of a generated fragment template */
+	fuzz_max_depth = 4,
+	/** Number of times the template is nested in the smallest input */
+	fuzz_k0 = 4,
+	/** Maximum number of times the template is nested */
+	fuzz_kmax = 64,
+	/** Maximum work per token (ordinary sources need less than 20) */
+	fuzz_max_work_per_tok = 64
+};
+
+/** Text before the template in each category */
+static const char *fuzz_ctx_prefix[fzc_limit] = {
+	[fzc_expr] = "int f(void)\n{\n\tx = ",
+	[fzc_stmt] = "int f(void)\n{\n",
+	[fzc_dlr] = "int ",
+	[fzc_init] = "struct s a = ",
+	[fzc_gdecl] = ""
+};
+
+/** Innermost fragment in each category */
+static const char *fuzz_leaf[fzc_limit] = {
+	[fzc_expr] = "a",
+	[fzc_stmt] = "\tx = 1;\n",
+	[fzc_dlr] = "a",
+	[fzc_init] = "1",
+	[fzc_gdecl] = ""
+};
+
+/** Text after the template in each category */
+static const char *fuzz_ctx_suffix[fzc_limit] = {
+	[fzc_expr] = ";\n}\n",
+	[fzc_stmt] = "}\n",
+	[fzc_dlr] = ";\n",
+	[fzc_init] = ";\n",
+	[fzc_gdecl] = ""
+};
+
+/** Primary expressions */
+static const char *fuzz_prim[] = {
+	"a", "b", "12", "\"s\"", "'c'", "NULL"
+};
+
+/** Type names (the first five can also be used in a typedef) */
+static const char *fuzz_types[] = {
+	"int", "char *", "struct s", "foo_t", "unsigned long", "const int *",
+	"int (*)(void)"
+};
+
+/** Binary operators */
+static const char *fuzz_binops[] = {
+	"+", "-", "*", "/", "<<", "&&", "||", "==", "<", "&", "|", ","
+};
+
+/** Prefix unary operators */
+static const char *fuzz_unops[] = {
+	"-", "!", "~", "*", "&", "++"
+};
+
+/** Get next pseudo-random number.
+ *
+ * @param fz Fuzzer
+ * @param n Upper bound (exclusive), must be non-zero
+ * @return Number between 0 and @a n - 1
+ */
+static unsigned fuzz_rand(fuzz_t *fz, unsigned n)
+{
+	fz->seed = fz->seed * 1103515245 + 12345;
+	return (fz->seed >> 16) % n;
+}
+
+/** Pick random string from an array.
+ *
+ * @param fz Fuzzer
+ * @param strs Array of strings
+ * @param n Number of strings
+ * @return Randomly chosen string
+ */
+static const char *fuzz_pick(fuzz_t *fz, const char **strs, size_t n)
+{
+	return strs[fuzz_rand(fz, n)];
+}
+
+/** Generate the hole (switch output to text after the hole).
+ *
+ * @param fz Fuzzer
+ */
+static void fuzz_hole(fuzz_t *fz)
+{
+	fz->f = fz->sf;
+}
+
+/** Generate expression.
+ *
+ * @param fz Fuzzer
+ * @param depth Maximum depth
+ * @param hole @c true to generate the hole inside the expression
+ */
+static void fuzz_gen_expr(fuzz_t *fz, unsigned depth, bool hole)
+{
+	bool hl;
+
+	if (depth == 0) {
+		if (hole)
+			fuzz_hole(fz);
+		else
+			fprintf(fz->f, "%s", fuzz_pick(fz, fuzz_prim, 6));
+		return;
+	}
+
+	/* Which operand gets the hole */
+	hl = hole && fuzz_rand(fz, 2) == 0;
+
+	switch (fuzz_rand(fz, 11)) {
+	case 0:
+		fprintf(fz->f, "(");
+		fuzz_gen_expr(fz, depth - 1, hole);
+		fprintf(fz->f, ")");
+		break;
+	case 1:
+		fuzz_gen_expr(fz, fuzz_rand(fz, depth), hl);
+		fprintf(fz->f, " %s ", fuzz_pick(fz, fuzz_binops, 12));
+		fuzz_gen_expr(fz, depth - 1, hole && !hl);
+		break;
+	case 2:
+		fprintf(fz->f, "%s", fuzz_pick(fz, fuzz_unops, 6));
+		fuzz_gen_expr(fz, depth - 1, hole);
+		break;
+	case 3:
+		fprintf(fz->f, "(%s)", fuzz_pick(fz, fuzz_types, 7));
+		fuzz_gen_expr(fz, depth - 1, hole);
+		break;
+	case 4:
+		fprintf(fz->f, "f(");
+		fuzz_gen_expr(fz, depth - 1, hl);
+		fprintf(fz->f, ", ");
+		fuzz_gen_expr(fz, fuzz_rand(fz, depth), hole && !hl);
+		fprintf(fz->f, ")");
+		break;
+	case 5:
+		fuzz_gen_expr(fz, depth - 1, hl);
+		fprintf(fz->f, "[");
+		fuzz_gen_expr(fz, fuzz_rand(fz, depth), hole && !hl);
+		fprintf(fz->f, "]");
+		break;
+	case 6:
+		fuzz_gen_expr(fz, depth - 1, hole);
+		fprintf(fz->f, fuzz_rand(fz, 2) == 0 ? ".m" : "->m");
+		break;
+	case 7:
+		fuzz_gen_expr(fz, fuzz_rand(fz, depth), hl);
+		fprintf(fz->f, " ? ");
+		fuzz_gen_expr(fz, depth - 1, hole && !hl);
+		fprintf(fz->f, " : ");
+		fuzz_gen_expr(fz, fuzz_rand(fz, depth), false);
+		break;
+	case 8:
+		fprintf(fz->f, "sizeof(");
+		fuzz_gen_expr(fz, depth - 1, hole);
+		fprintf(fz->f, ")");
+		break;
+	case 9:
+		fprintf(fz->f, "(%s){ ", fuzz_pick(fz, fuzz_types, 7));
+		fuzz_gen_expr(fz, depth - 1, hole);
+		fprintf(fz->f, " }");
+		break;
+	default:
+		fuzz_gen_expr(fz, fuzz_rand(fz, depth), hl);
+		fprintf(fz->f, " = ");
+		fuzz_gen_expr(fz, depth - 1, hole && !hl);
+		break;
+	}
+}
+
+/** Generate statement.
+ *
+ * @param fz Fuzzer
+ * @param depth Maximum depth
+ * @param hole @c true to generate the hole inside the statement
+ */
+static void fuzz_gen_stmt(fuzz_t *fz, unsigned depth, bool hole)
+{
+	bool hl;
+
+	if (depth == 0) {
+		if (hole) {
+			fuzz_hole(fz);
+		} else {
+			fprintf(fz->f, "\tx = ");
+			fuzz_gen_expr(fz, fuzz_rand(fz, 3), false);
+			fprintf(fz->f, ";\n");
+		}
+		return;
+	}
+
+	/* Which sub-statement gets the hole */
+	hl = hole && fuzz_rand(fz, 2) == 0;
+
+	switch (fuzz_rand(fz, 9)) {
+	case 0:
+		fprintf(fz->f, "\tif (");
+		fuzz_gen_expr(fz, fuzz_rand(fz, 3), false);
+		fprintf(fz->f, ")\n");
+		fuzz_gen_stmt(fz, depth - 1, hole);
+		break;
+	case 1:
+		/* Braces keep a sequence in the hole from splitting if-else */
+		fprintf(fz->f, "\tif (");
+		fuzz_gen_expr(fz, fuzz_rand(fz, 3), false);
+		fprintf(fz->f, ") {\n");
+		fuzz_gen_stmt(fz, depth - 1, hl);
+		fprintf(fz->f, "\t} else {\n");
+		fuzz_gen_stmt(fz, depth - 1, hole && !hl);
+		fprintf(fz->f, "\t}\n");
+		break;
+	case 2:
+		fprintf(fz->f, "\twhile (");
+		fuzz_gen_expr(fz, fuzz_rand(fz, 3), false);
+		fprintf(fz->f, ")\n");
+		fuzz_gen_stmt(fz, depth - 1, hole);
+		break;
+	case 3:
+		fprintf(fz->f, "\tfor (i = 0; i < ");
+		fuzz_gen_expr(fz, fuzz_rand(fz, 3), false);
+		fprintf(fz->f, "; i++)\n");
+		fuzz_gen_stmt(fz, depth - 1, hole);
+		break;
+	case 4:
+		fprintf(fz->f, "\tdo {\n");
+		fuzz_gen_stmt(fz, depth - 1, hole);
+		fprintf(fz->f, "\t} while (");
+		fuzz_gen_expr(fz, fuzz_rand(fz, 3), false);
+		fprintf(fz->f, ");\n");
+		break;
+	case 5:
+		fprintf(fz->f, "\t{\n");
+		fuzz_gen_stmt(fz, depth - 1, hl);
+		fuzz_gen_stmt(fz, depth - 1, hole && !hl);
+		fprintf(fz->f, "\t}\n");
+		break;
+	case 6:
+		fprintf(fz->f, "\tswitch (");
+		fuzz_gen_expr(fz, fuzz_rand(fz, 3), false);
+		fprintf(fz->f, ") {\n\tcase 1:\n");
+		fuzz_gen_stmt(fz, depth - 1, hole);
+		fprintf(fz->f, "\t\tbreak;\n\t}\n");
+		break;
+	case 7:
+		fprintf(fz->f, "l%u:\n", fuzz_rand(fz, 10));
+		fuzz_gen_stmt(fz, depth - 1, hole);
+		break;
+	default:
+		/* Sequence of statements */
+		fuzz_gen_stmt(fz, depth - 1, false);
+		fuzz_gen_stmt(fz, 0, hole);
+		break;
+	}
+}
+
+/** Generate declarator.
+ *
+ * @param fz Fuzzer
+ * @param depth Maximum depth
+ * @param hole @c true to generate the hole inside the declarator
+ */
+static void fuzz_gen_dlr(fuzz_t *fz, unsigned depth, bool hole)
+{
+	if (depth == 0) {
+		if (hole)
+			fuzz_hole(fz);
+		else
+			fprintf(fz->f, "a");
+		return;
+	}
+
+	/*
+	 * Array and function declarators only follow a parenthesized pointer
+	 * declarator, so that the result is valid
+	 */
+	switch (fuzz_rand(fz, 5)) {
+	case 0:
+		fprintf(fz->f, "*");
+		fuzz_gen_dlr(fz, depth - 1, hole);
+		break;
+	case 1:
+		fprintf(fz->f, "*const ");
+		fuzz_gen_dlr(fz, depth - 1, hole);
+		break;
+	case 2:
+		fprintf(fz->f, "(*");
+		fuzz_gen_dlr(fz, depth - 1, hole);
+		fprintf(fz->f, ")[%u]", fuzz_rand(fz, 100));
+		break;
+	case 3:
+		fprintf(fz->f, "(*");
+		fuzz_gen_dlr(fz, depth - 1, hole);
+		fprintf(fz->f, ")(int, char *)");
+		break;
+	default:
+		fprintf(fz->f, "(*");
+		fuzz_gen_dlr(fz, depth - 1, hole);
+		fprintf(fz->f, ")(void)");
+		break;
+	}
+}
+
+/** Generate initializer.
+ *
+ * @param fz Fuzzer
+ * @param depth Maximum depth
+ * @param hole @c true to generate the hole inside the initializer
+ */
+static void fuzz_gen_init(fuzz_t *fz, unsigned depth, bool hole)
+{
+	bool hl;
+
+	if (depth == 0) {
+		if (hole)
+			fuzz_hole(fz);
+		else
+			fuzz_gen_expr(fz, fuzz_rand(fz, 2), false);
+		return;
+	}
+
+	/* Which element gets the hole */
+	hl = hole && fuzz_rand(fz, 2) == 0;
+
+	switch (fuzz_rand(fz, 4)) {
+	case 0:
+		fprintf(fz->f, "{ ");
+		fuzz_gen_init(fz, depth - 1, hl);
+		fprintf(fz->f, ", ");
+		fuzz_gen_init(fz, fuzz_rand(fz, depth), hole && !hl);
+		fprintf(fz->f, " }");
+		break;
+	case 1:
+		fprintf(fz->f, "{ ");
+		fuzz_gen_init(fz, depth - 1, hole);
+		fprintf(fz->f, " }");
+		break;
+	case 2:
+		fprintf(fz->f, "{ .a = ");
+		fuzz_gen_init(fz, depth - 1, hole);
+		fprintf(fz->f, " }");
+		break;
+	default:
+		fprintf(fz->f, "{ [%u] = ", fuzz_rand(fz, 10));
+		fuzz_gen_init(fz, depth - 1, hole);
+		fprintf(fz->f, ", }");
+		break;
+	}
+}
+
+/** Generate global declaration followed by the hole.
+ *
+ * Nesting the resulting template gives a sequence of declarations.
+ *
+ * @param fz Fuzzer
+ * @param depth Maximum depth
+ */
+static void fuzz_gen_gdecl(fuzz_t *fz, unsigned depth)
+{
+	switch (fuzz_rand(fz, 4)) {
+	case 0:
+		fprintf(fz->f, "int ");
+		fuzz_gen_dlr(fz, depth, false);
+		fprintf(fz->f, ";\n");
+		break;
+	case 1:
+		fprintf(fz->f, "static struct s a = ");
+		fuzz_gen_init(fz, depth, false);
+		fprintf(fz->f, ";\n");
+		break;
+	case 2:
+		fprintf(fz->f, "int f(void)\n{\n");
+		fuzz_gen_stmt(fz, depth, false);
+		fprintf(fz->f, "}\n");
+		break;
+	default:
+		fprintf(fz->f, "typedef %s t;\n", fuzz_pick(fz, fuzz_types, 5));
+		break;
+	}
+
+	fprintf(fz->f, "\n");
+	fuzz_hole(fz);
+}
+
+/** Generate random fragment template.
+ *
+ * @param fz Fuzzer
+ * @param tmpl Template to fill in
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int fuzz_tmpl_gen(fuzz_t *fz, fuzz_tmpl_t *tmpl)
+{
+	unsigned depth;
+	int rc = EOK;
+
+	memset(tmpl, 0, sizeof(fuzz_tmpl_t));
+
+	fz->pf = open_memstream(&tmpl->prefix, &tmpl->prefix_size);
+	if (fz->pf == NULL)
+		return ENOMEM;
+
+	fz->sf = open_memstream(&tmpl->suffix, &tmpl->suffix_size);
+	if (fz->sf == NULL) {
+		fclose(fz->pf);
+		free(tmpl->prefix);
+		return ENOMEM;
+	}
+
+	fz->f = fz->pf;
+	tmpl->cat = fuzz_rand(fz, fzc_limit);
+	depth = 1 + fuzz_rand(fz, fuzz_max_depth);
+
+	switch (tmpl->cat) {
+	case fzc_expr:
+		fuzz_gen_expr(fz, depth, true);
+		break;
+	case fzc_stmt:
+		fuzz_gen_stmt(fz, depth, true);
+		break;
+	case fzc_dlr:
+		fuzz_gen_dlr(fz, depth, true);
+		break;
+	case fzc_init:
+		fuzz_gen_init(fz, depth, true);
+		break;
+	default:
+		fuzz_gen_gdecl(fz, depth);
+		break;
+	}
+
+	if (fclose(fz->pf) != 0)
+		rc = ENOMEM;
+	if (fclose(fz->sf) != 0)
+		rc = ENOMEM;
+
+	if (rc != EOK) {
+		free(tmpl->prefix);
+		free(tmpl->suffix);
+	}
+
+	return rc;
+}
+
+/** Free fragment template.
+ *
+ * @param tmpl Template
+ */
+static void fuzz_tmpl_fini(fuzz_tmpl_t *tmpl)
+{
+	free(tmpl->prefix);
+	free(tmpl->suffix);
+}
+
+/** Create input by nesting template.
+ *
+ * @param tmpl Template
+ * @param k Number of times to nest the template
+ * @param rtext Place to store pointer to newly allocated text
+ * @param rsize Place to store size of text
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int fuzz_input(fuzz_tmpl_t *tmpl, unsigned k, char **rtext,
+    size_t *rsize)
+{
+	FILE *f;
+	unsigned i;
+
+	f = open_memstream(rtext, rsize);
+	if (f == NULL)
+		return ENOMEM;
+
+	fprintf(f, "%s", fuzz_ctx_prefix[tmpl->cat]);
+	for (i = 0; i < k; i++)
+		fwrite(tmpl->prefix, 1, tmpl->prefix_size, f);
+	fprintf(f, "%s", fuzz_leaf[tmpl->cat]);
+	for (i = 0; i < k; i++)
+		fwrite(tmpl->suffix, 1, tmpl->suffix_size, f);
+	fprintf(f, "%s", fuzz_ctx_suffix[tmpl->cat]);
+
+	if (fclose(f) != 0) {
+		free(*rtext);
+		return ENOMEM;
+	}
+
+	return EOK;
+}
+
+/** Measure work done checking input.
+ *
+ * Errors in the input (e.g. parse errors) are not reported.
+ *
+ * @param ops Lexer input ops
+ * @param arg Lexer input argument
+ * @param mtype Module type
+ * @param nullf Output stream that discards output
+ * @param work Place to store work done
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int fuzz_measure(lexer_input_ops_t *ops, void *arg,
+    checker_mtype_t mtype, FILE *nullf, fuzz_work_t *work)
+{
+	checker_cfg_t cfg;
+	checker_stats_t stats;
+	checker_t *checker;
+	int rc;
+
+	checker_cfg_init(&cfg);
+	memset(&stats, 0, sizeof(stats));
+
+	rc = checker_create(ops, arg, mtype, &cfg, &checker);
+	if (rc != EOK)
+		return rc;
+
+	checker_set_errf(checker, nullf);
+	checker_set_stats(checker, &stats);
+
+	rc = checker_run(checker, false);
+	checker_destroy(checker);
+	if (rc == ENOMEM)
+		return rc;
+
+	work->ntoks = stats.ntoks;
+	work->nptoks = stats.nptoks;
+	work->nvisits = stats.nvisits;
+	return EOK;
+}
+
+/** Get total work.
+ *
+ * @param work Work done
+ * @return Number of tokens read by the parser and visited by the checker
+ */
+static size_t fuzz_work_total(fuzz_work_t *work)
+{
+	return work->nptoks + work->nvisits;
+}
+
+/** Determine if work per token exceeds the limit.
+ *
+ * @param work Work done
+ * @return @c true iff work exceeds @c fuzz_max_work_per_tok per token
+ */
+static bool fuzz_work_exceeds(fuzz_work_t *work)
+{
+	return fuzz_work_total(work) > fuzz_max_work_per_tok * work->ntoks;
+}
+
+/** Determine if work grows faster than size^1.5.
+ *
+ * @param a Work done on smaller input
+ * @param b Work done on larger input
+ * @return @c true iff growth from @a a to @a b is super-linear
+ */
+static bool fuzz_superlinear(fuzz_work_t *a, fuzz_work_t *b)
+{
+	double rt;
+	double rw;
+
+	if (a->ntoks == 0 || fuzz_work_total(a) == 0)
+		return false;
+
+	rt = (double)b->ntoks / a->ntoks;
+	rw = (double)fuzz_work_total(b) / fuzz_work_total(a);
+	return rw * rw > rt * rt * rt;
+}
+
+/** Save input as regression test case.
+ *
+ * @param dir Directory
+ * @param seed Fuzzer seed
+ * @param iter Iteration (fragment number)
+ * @param k0 Number of times the template is nested in the smaller input
+ * @param w0 Work done on the smaller input
+ * @param k Number of times the template is nested in @a text
+ * @param w Work done on @a text
+ * @param text Input text
+ * @param size Size of @a text
+ * @param rpath Place to store newly allocated path of the saved file
+ * @return EOK on success or error code
+ */
+static int fuzz_save(const char *dir, uint32_t seed, unsigned iter,
+    unsigned k0, fuzz_work_t *w0, unsigned k, fuzz_work_t *w,
+    const char *text, size_t size, char **rpath)
+{
+	char *path;
+	FILE *f;
+	int rc = EOK;
+
+	if (asprintf(&path, "%s/fuzz-%u-%u.c", dir, (unsigned)seed,
+	    iter) < 0)
+		return ENOMEM;
+
+	f = fopen(path, "w");
+	if (f == NULL) {
+		fprintf(stderr, "Cannot open '%s'.\n", path);
+		free(path);
+		return EIO;
+	}
+
+	fprintf(f, "/*\n * Found by ccheck --fuzz (seed %u, fragment %u)\n"
+	    " * Nested %u times: %zu tokens, %zu read by parser, "
+	    "%zu visited by checker\n"
+	    " * Nested %u times: %zu tokens, %zu read by parser, "
+	    "%zu visited by checker\n */\n\n", (unsigned)seed, iter,
+	    k0, w0->ntoks, w0->nptoks, w0->nvisits,
+	    k, w->ntoks, w->nptoks, w->nvisits);
+
+	if (fwrite(text, 1, size, f) != size)
+		rc = EIO;
+	if (fclose(f) != 0)
+		rc = EIO;
+
+	if (rc != EOK) {
+		fprintf(stderr, "Error writing '%s'.\n", path);
+		free(path);
+		return rc;
+	}
+
+	*rpath = path;
+	return EOK;
+}
+
+/** Measure work done checking template nested @a k times.
+ *
+ * @param fz Fuzzer
+ * @param tmpl Template
+ * @param k Number of times to nest the template
+ * @param rtext Place to store pointer to newly allocated input text
+ * @param rsize Place to store size of input text
+ * @param work Place to store work done
+ * @return EOK on success or error code
+ */
+static int fuzz_try(fuzz_t *fz, fuzz_tmpl_t *tmpl, unsigned k, char **rtext,
+    size_t *rsize, fuzz_work_t *work)
+{
+	buf_input_t binput;
+	int rc;
+
+	rc = fuzz_input(tmpl, k, rtext, rsize);
+	if (rc != EOK)
+		return rc;
+
+	buf_input_init(&binput, *rtext, *rsize, "fuzz.c");
+	rc = fuzz_measure(&lexer_buf_input, &binput, cmod_c, fz->nullf,
+	    work);
+	if (rc != EOK) {
+		free(*rtext);
+		return rc;
+	}
+
+	return EOK;
+}
+
+/** Run complexity fuzzer.
+ *
+ * @param dir Directory to save regression test cases to
+ * @param niters Number of fragment templates to try
+ * @param seed Seed for pseudo-random number generator
+ * @return EOK if no super-linear growth was found, EINVAL if it was,
+ *         other error code on failure
+ */
+int fuzz_run(const char *dir, unsigned niters, uint32_t seed)
+{
+	fuzz_t fz;
+	fuzz_tmpl_t tmpl;
+	fuzz_work_t w0;
+	fuzz_work_t w;
+	char *text;
+	size_t size;
+	char *path;
+	unsigned iter;
+	unsigned k;
+	unsigned nfound;
+	bool found;
+	int rc;
+
+	memset(&fz, 0, sizeof(fz));
+	fz.seed = seed;
+
+	fz.nullf = fopen("/dev/null", "w");
+	if (fz.nullf == NULL)
+		return EIO;
+
+	nfound = 0;
+	for (iter = 0; iter < niters; iter++) {
+		rc = fuzz_tmpl_gen(&fz, &tmpl);
+		if (rc != EOK)
+			goto error;
+
+		rc = fuzz_try(&fz, &tmpl, fuzz_k0, &text, &size, &w0);
+		if (rc != EOK) {
+			fuzz_tmpl_fini(&tmpl);
+			goto error;
+		}
+
+		found = false;
+		for (k = 2 * fuzz_k0; k <= fuzz_kmax; k *= 2) {
+			free(text);
+			rc = fuzz_try(&fz, &tmpl, k, &text, &size, &w);
+			if (rc != EOK) {
+				fuzz_tmpl_fini(&tmpl);
+				goto error;
+			}
+
+			/* Stop before it takes too long */
+			if (fuzz_work_exceeds(&w)) {
+				found = true;
+				break;
+			}
+		}
+
+		if (k > fuzz_kmax)
+			k = fuzz_kmax;
+		if (fuzz_superlinear(&w0, &w))
+			found = true;
+
+		if (found) {
+			rc = fuzz_save(dir, seed, iter, fuzz_k0, &w0, k, &w,
+			    text, size, &path);
+			if (rc != EOK) {
+				free(text);
+				fuzz_tmpl_fini(&tmpl);
+				goto error;
+			}
+
+			printf("Fragment %u: work grows from %zu to %zu for "
+			    "%zu to %zu tokens, saved as '%s'.\n", iter,
+			    fuzz_work_total(&w0), fuzz_work_total(&w),
+			    w0.ntoks, w.ntoks, path);
+			free(path);
+			++nfound;
+		}
+
+		free(text);
+		fuzz_tmpl_fini(&tmpl);
+	}
+
+	fclose(fz.nullf);
+
+	printf("Tried %u fragments (seed %u), %u with super-linear "
+	    "growth.\n", niters, (unsigned)seed, nfound);
+	return nfound == 0 ? EOK : EINVAL;
+error:
+	fclose(fz.nullf);
+	return rc;
+}
+
+/** Check complexity regression test cases.
+ *
+ * Work done checking each C source or header file under @a dir must not
+ * exceed @c fuzz_max_work_per_tok per token.
+ *
+ * @param dir Directory with regression test cases
+ * @return EOK if all files pass, EINVAL if some file does not pass,
+ *         other error code on failure
+ */
+int fuzz_test(const char *dir)
+{
+	flist_t *flist = NULL;
+	file_input_t finput;
+	fuzz_work_t work;
+	checker_mtype_t mtype;
+	const char *path;
+	FILE *nullf = NULL;
+	FILE *f;
+	size_t len;
+	size_t i;
+	unsigned nfail;
+	int rc;
+
+	nullf = fopen("/dev/null", "w");
+	if (nullf == NULL)
+		return EIO;
+
+	rc = flist_create(AT_FDCWD, stderr, &flist);
+	if (rc != EOK)
+		goto error;
+
+	rc = flist_add_path(flist, dir);
+	if (rc != EOK)
+		goto error;
+
+	flist_uniq(flist);
+
+	nfail = 0;
+	for (i = 0; i < flist->nentries; i++) {
+		path = flist->entry[i].path;
+		len = strlen(path);
+		mtype = len >= 2 && strcmp(path + len - 2, ".h") == 0 ?
+		    cmod_header : cmod_c;
+
+		f = fopen(path, "r");
+		if (f == NULL) {
+			fprintf(stderr, "Cannot open '%s'.\n", path);
+			rc = ENOENT;
+			goto error;
+		}
+
+		file_input_init(&finput, f, path);
+		rc = fuzz_measure(&lexer_file_input, &finput, mtype, nullf,
+		    &work);
+		fclose(f);
+		if (rc != EOK)
+			goto error;
+
+		if (fuzz_work_exceeds(&work)) {
+			printf("'%s': %zu tokens, %zu read by parser, %zu "
+			    "visited by checker (limit %d per token).\n",
+			    path, work.ntoks, work.nptoks, work.nvisits,
+			    (int)fuzz_max_work_per_tok);
+			++nfail;
+		}
+	}
+
+	printf("Checked %zu files, %u exceed work limit.\n",
+	    flist->nentries, nfail);
+
+	flist_destroy(flist);
+	fclose(nullf);
+	return nfail == 0 ? EOK : EINVAL;
+error:
+	flist_destroy(flist);
+	fclose(nullf);
+	return rc;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Hashing
+ *
+ * 64-bit FNV-1a, used for cache keys and diagnostic fingerprints. These
+ * are stored on disk, so the function must not change.
+ */
+
+#include <hash.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** FNV-1a 64-bit prime */
+#define HASH_FNV_PRIME 0x100000001b3ULL
+
+/** Hash data using FNV-1a.
+ *
+ * Hashing data in several parts gives the same result as hashing
+ * the concatenation of the parts.
+ *
+ * @param hash Hash of preceding data (HASH_FNV_BASIS for none)
+ * @param data Data
+ * @param size Size of data in bytes
+ * @return Hash of preceding data followed by @a data
+ */
+uint64_t hash_fnv(uint64_t hash, const void *data, size_t size)
+{
+	const uint8_t *bp = (const uint8_t *) data;
+	size_t i;
+
+	for (i = 0; i < size; i++) {
+		hash ^= bp[i];
+		hash *= HASH_FNV_PRIME;
+	}
+
+	return hash;
+}
@@ -24,6 +24,7 @@
  * Lexer (lexical analyzer)
  */
 
+#include <alloc.h>
 #include <assert.h>
 #include <lexer.h>
 #include <merrno.h>
@@ -45,7 +46,7 @@ int lexer_create(lexer_input_ops_t *ops, void *arg, lexer_t **rlexer)
 {
 	lexer_t *lexer;
 
-	lexer = calloc(1, sizeof(lexer_t));
+	lexer = alloc_calloc(as_lexer, 1, sizeof(lexer_t));
 	if (lexer == NULL)
 		return ENOMEM;
 
@@ -64,7 +65,7 @@ void lexer_destroy(lexer_t *lexer)
 	if (lexer == NULL)
 		return;
 
-	free(lexer);
+	alloc_free(lexer);
 }
 
 /** Determine if character is a letter (C language)
@@ -202,6 +203,35 @@ static bool is_bad_ctrl(char c)
 	return false;
 }
 
+/** Map entire input to scan it in place.
+ *
+ * @param lexer Lexer
+ */
+static void lexer_map(lexer_t *lexer)
+{
+	const char *ibuf;
+	size_t size;
+	src_pos_t rpos;
+	int rc;
+
+	rc = lexer->input_ops->map(lexer->input_arg, &ibuf, &size, &rpos);
+	if (rc != EOK) {
+		/* Treat as end of input, lexer_get_tok() reports it */
+		lexer->in_rc = rc;
+		size = 0;
+	}
+
+	lexer->in_eof = true;
+	lexer->buf_bpos = rpos;
+	lexer->pos = rpos;
+	if (size > 0) {
+		lexer->ibuf = ibuf;
+		lexer->buf_used = size;
+	} else {
+		lexer->buf[0] = '\0';
+	}
+}
+
 /** Get valid pointer to characters in input buffer.
  *
  * Returns a pointer into the input buffer, ensuring it contains
@@ -209,12 +239,32 @@ static bool is_bad_ctrl(char c)
  *
  * @return Pointer to characters in input buffer.
  */
-static char *lexer_chars(lexer_t *lexer)
+static const char *lexer_chars(lexer_t *lexer)
 {
 	int rc;
 	size_t nread;
 	src_pos_t rpos;
 
+	if (lexer->ibuf != NULL) {
+		if (lexer->buf_used - lexer->buf_pos >=
+		    lexer_buf_low_watermark)
+			return lexer->ibuf + lexer->buf_pos;
+
+		/* Copy the rest so that it is followed by a null character */
+		memcpy(lexer->buf, lexer->ibuf + lexer->buf_pos,
+		    lexer->buf_used - lexer->buf_pos);
+		lexer->buf_used -= lexer->buf_pos;
+		lexer->buf_pos = 0;
+		lexer->buf[lexer->buf_used] = '\0';
+		lexer->ibuf = NULL;
+	}
+
+	if (!lexer->in_eof && lexer->buf_used == 0 &&
+	    lexer->input_ops->map != NULL) {
+		lexer_map(lexer);
+		return lexer_chars(lexer);
+	}
+
 	if (!lexer->in_eof && lexer->buf_used - lexer->buf_pos <
 	    lexer_buf_low_watermark) {
 		/* Move data to beginning of buffer */
@@ -228,7 +278,9 @@ static char *lexer_chars(lexer_t *lexer)
 		    lexer->buf_used, lexer_buf_size - lexer->buf_used,
 		    &nread, &rpos);
 		if (rc != EOK) {
-			printf("read error\n");
+			/* Treat as end of input, lexer_get_tok() reports it */
+			lexer->in_rc = rc;
+			nread = 0;
 		}
 		if (nread < lexer_buf_size - lexer->buf_used)
 			lexer->in_eof = true;
@@ -245,6 +297,19 @@ static char *lexer_chars(lexer_t *lexer)
 	return lexer->buf + lexer->buf_pos;
 }
 
+/** Determine if lexer reached end of input.
+ *
+ * Must be called after lexer_chars(). Null characters in the input
+ * are not treated as end of input.
+ *
+ * @param lexer Lexer
+ * @return @c true iff there are no more characters
+ */
+static bool lexer_at_eof(lexer_t *lexer)
+{
+	return lexer->in_eof && lexer->buf_pos >= lexer->buf_used;
+}
+
 /** Get current lexer position in source code.
  *
  * @param lexer Lexer
@@ -269,10 +334,11 @@ static void lexer_get_pos(lexer_t *lexer, src_pos_t *pos)
  */
 static int lexer_advance(lexer_t *lexer, size_t nchars, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 
 	while (nchars > 0) {
-		tok->text = realloc(tok->text, tok->text_size + 2);
+		tok->text = alloc_realloc(as_lexer, tok->text,
+		    tok->text_size + 2);
 		if (tok->text == NULL)
 			return ENOMEM;
 
@@ -281,7 +347,7 @@ static int lexer_advance(lexer_t *lexer, size_t nchars, lexer_tok_t *tok)
 		tok->text[tok->text_size + 1] = '\0';
 		tok->text_size++;
 		++lexer->buf_pos;
-		assert(lexer->buf_pos < lexer_buf_size);
+		assert(lexer->ibuf != NULL || lexer->buf_pos < lexer_buf_size);
 		src_pos_fwd_char(&lexer->pos, p[0]);
 		--nchars;
 	}
@@ -405,6 +471,33 @@ static int lexer_cclose(lexer_t *lexer, lexer_tok_t *tok)
 	return EOK;
 }
 
+/** Recognize suppression directive.
+ *
+ * This is called for every comment word, so it rejects anything that
+ * does not start with the common prefix as early as possible.
+ *
+ * @param word Word (not necessarily null-terminated)
+ * @param len Length of word in characters
+ * @return Suppression directive or @c lsd_none
+ */
+static lexer_sdir_t lexer_sdir_word(const char *word, size_t len)
+{
+	if (len < 13 || word[0] != 'c' || memcmp(word, "ccheck-", 7) != 0)
+		return lsd_none;
+
+	word += 7;
+	len -= 7;
+
+	if (len == 7 && memcmp(word, "disable", 7) == 0)
+		return lsd_disable;
+	if (len == 6 && memcmp(word, "enable", 6) == 0)
+		return lsd_enable;
+	if (len == 17 && memcmp(word, "disable-next-line", 17) == 0)
+		return lsd_disable_next_line;
+
+	return lsd_none;
+}
+
 /** Lex comment text.
  *
  * @param lexer Lexer
@@ -414,14 +507,14 @@ static int lexer_cclose(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_ctext(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	int rc;
 
 	lexer_get_pos(lexer, &tok->bpos);
 
 	p = lexer_chars(lexer);
-	while (p[0] != ' ' && p[0] != '\t' && p[0] != '\n' &&
-	    (p[0] != '*' || p[1] != '/')) {
+	while (!lexer_at_eof(lexer) && p[0] != ' ' && p[0] != '\t' &&
+	    p[0] != '\n' && (p[0] != '*' || p[1] != '/')) {
 		lexer_get_pos(lexer, &tok->epos);
 
 		rc = lexer_advance(lexer, 1, tok);
@@ -434,6 +527,7 @@ static int lexer_ctext(lexer_t *lexer, lexer_tok_t *tok)
 	}
 
 	tok->ttype = ltt_ctext;
+	tok->sdir = lexer_sdir_word(tok->text, tok->text_size);
 	return EOK;
 }
 
@@ -446,7 +540,8 @@ static int lexer_ctext(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_dscomment(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
+	size_t i, n;
 	int rc;
 
 	lexer_get_pos(lexer, &tok->bpos);
@@ -457,7 +552,7 @@ static int lexer_dscomment(lexer_t *lexer, lexer_tok_t *tok)
 	}
 
 	p = lexer_chars(lexer);
-	while (p[0] != '\0' && (p[1] != '\n' || p[0] == '\\')) {
+	while (!lexer_at_eof(lexer) && (p[1] != '\n' || p[0] == '\\')) {
 		rc = lexer_advance(lexer, 1, tok);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
@@ -469,7 +564,7 @@ static int lexer_dscomment(lexer_t *lexer, lexer_tok_t *tok)
 
 	lexer_get_pos(lexer, &tok->epos);
 
-	if (p[0] != '\0') {
+	if (!lexer_at_eof(lexer)) {
 		/* Skip trailing newline */
 		rc = lexer_advance(lexer, 1, tok);
 		if (rc != EOK) {
@@ -479,6 +574,19 @@ static int lexer_dscomment(lexer_t *lexer, lexer_tok_t *tok)
 	}
 
 	tok->ttype = ltt_dscomment;
+
+	/* Directive is the first word after the slashes */
+	i = 0;
+	while (tok->text[i] == '/')
+		++i;
+	while (tok->text[i] == ' ' || tok->text[i] == '\t')
+		++i;
+	n = 0;
+	while (tok->text[i + n] != '\0' && tok->text[i + n] != ' ' &&
+	    tok->text[i + n] != '\t' && tok->text[i + n] != '\n')
+		++n;
+
+	tok->sdir = lexer_sdir_word(tok->text + i, n);
 	return EOK;
 }
 
@@ -491,10 +599,11 @@ static int lexer_dscomment(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_preproc(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	int rc;
 
 	lexer_get_pos(lexer, &tok->bpos);
+	lexer_get_pos(lexer, &tok->epos);
 
 	p = lexer_chars(lexer);
 
@@ -502,7 +611,7 @@ static int lexer_preproc(lexer_t *lexer, lexer_tok_t *tok)
 	 * Preprocessor frament ends with newline, except for
 	 * backslash-newline
 	 */
-	while (p[0] != '\0' && (p[1] != '\n' || p[0] == '\\')) {
+	while (!lexer_at_eof(lexer) && (p[1] != '\n' || p[0] == '\\')) {
 		if (p[0] == '/' && p[1] == '*') {
 			/* Comment inside prerocessor line */
 			rc = lexer_advance(lexer, 2, tok);
@@ -512,7 +621,8 @@ static int lexer_preproc(lexer_t *lexer, lexer_tok_t *tok)
 			}
 
 			p = lexer_chars(lexer);
-			while (p[0] != '\0' && (p[0] != '*' || p[1] != '/')) {
+			while (!lexer_at_eof(lexer) &&
+			    (p[0] != '*' || p[1] != '/')) {
 				rc = lexer_advance(lexer, 1, tok);
 				if (rc != EOK) {
 					lexer_free_tok(tok);
@@ -523,7 +633,9 @@ static int lexer_preproc(lexer_t *lexer, lexer_tok_t *tok)
 			}
 		}
 
-		if (p[0] != '\0') {
+		if (!lexer_at_eof(lexer)) {
+			/* In case the fragment ends at end of file */
+			lexer_get_pos(lexer, &tok->epos);
 			rc = lexer_advance(lexer, 1, tok);
 			if (rc != EOK) {
 				lexer_free_tok(tok);
@@ -534,7 +646,7 @@ static int lexer_preproc(lexer_t *lexer, lexer_tok_t *tok)
 		}
 	}
 
-	if (p[0] != '\0') {
+	if (!lexer_at_eof(lexer)) {
 		lexer_get_pos(lexer, &tok->epos);
 		rc = lexer_advance(lexer, 1, tok);
 		if (rc != EOK) {
@@ -558,11 +670,11 @@ static int lexer_preproc(lexer_t *lexer, lexer_tok_t *tok)
 static int lexer_onechar(lexer_t *lexer, lexer_toktype_t ttype,
     lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 
 	lexer_get_pos(lexer, &tok->bpos);
 	lexer_get_pos(lexer, &tok->epos);
-	tok->text = malloc(2);
+	tok->text = alloc_malloc(as_lexer, 2);
 	p = lexer_chars(lexer);
 	if (tok->text == NULL)
 		return ENOMEM;
@@ -584,12 +696,12 @@ static int lexer_onechar(lexer_t *lexer, lexer_toktype_t ttype,
 static int lexer_keyword(lexer_t *lexer, lexer_toktype_t ttype,
     size_t nchars, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	int rc;
 
 	lexer_get_pos(lexer, &tok->bpos);
 
-	tok->text = malloc(nchars + 1);
+	tok->text = alloc_malloc(as_lexer, nchars + 1);
 	p = lexer_chars(lexer);
 	if (tok->text == NULL)
 		return ENOMEM;
@@ -619,7 +731,7 @@ static int lexer_keyword(lexer_t *lexer, lexer_toktype_t ttype,
  */
 static int lexer_ident(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	int rc;
 
 	lexer_get_pos(lexer, &tok->bpos);
@@ -654,7 +766,7 @@ static int lexer_ident(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_number(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	int rc;
 	bool floating;
 	int base;
@@ -820,7 +932,7 @@ dec_point:
 static int lexer_charstr(lexer_t *lexer, lexer_tok_t *tok)
 {
 	lexer_toktype_t ltt;
-	char *p;
+	const char *p;
 	char delim;
 	int rc;
 
@@ -865,7 +977,7 @@ static int lexer_charstr(lexer_t *lexer, lexer_tok_t *tok)
 		}
 
 		p = lexer_chars(lexer);
-		if (p[0] == '\0') {
+		if (lexer_at_eof(lexer)) {
 			tok->ttype = ltt_invalid;
 			return EOK;
 		}
@@ -882,7 +994,7 @@ static int lexer_charstr(lexer_t *lexer, lexer_tok_t *tok)
 			}
 
 			p = lexer_chars(lexer);
-			if (p[0] == '\0') {
+			if (lexer_at_eof(lexer)) {
 				tok->ttype = ltt_invalid;
 				return EOK;
 			}
@@ -940,12 +1052,12 @@ static int lexer_eof(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_get_tok_normal(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 
 	memset(tok, 0, sizeof(lexer_tok_t));
 
 	p = lexer_chars(lexer);
-	if (p[0] == '\0')
+	if (lexer_at_eof(lexer))
 		return lexer_eof(lexer, tok);
 
 	switch (p[0]) {
@@ -1290,11 +1402,11 @@ static int lexer_get_tok_normal(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_get_tok_comment(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	memset(tok, 0, sizeof(lexer_tok_t));
 
 	p = lexer_chars(lexer);
-	if (p[0] == '\0')
+	if (lexer_at_eof(lexer))
 		return lexer_eof(lexer, tok);
 
 	switch (p[0]) {
@@ -1365,6 +1477,11 @@ int lexer_get_tok(lexer_t *lexer, lexer_tok_t *tok)
 	if (rc != EOK)
 		return rc;
 
+	if (lexer->in_rc != EOK) {
+		lexer_free_tok(tok);
+		return lexer->in_rc;
+	}
+
 	return EOK;
 }
 
@@ -1377,7 +1494,7 @@ int lexer_get_tok(lexer_t *lexer, lexer_tok_t *tok)
 void lexer_free_tok(lexer_tok_t *tok)
 {
 	if (tok->text != NULL)
-		free(tok->text);
+		alloc_free(tok->text);
 	tok->text = NULL;
 }
 
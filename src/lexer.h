@@ -35,7 +35,7 @@ extern int lexer_create(lexer_input_ops_t *, void *, lexer_t **);
 extern void lexer_destroy(lexer_t *);
 extern int lexer_get_tok(lexer_t *, lexer_tok_t *);
 extern void lexer_free_tok(lexer_tok_t *);
-extern int lexer_dprint_char(char , FILE *);
+extern int lexer_dprint_char(char, FILE *);
 extern int lexer_dprint_tok(lexer_tok_t *, FILE *);
 extern int lexer_dprint_tok_chr(lexer_tok_t *, size_t, FILE *);
 extern int lexer_print_tok(lexer_tok_t *, FILE *);
@@ -0,0 +1,513 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Line filter
+ *
+ * Line ranges to check in each file, either specified explicitly
+ * or taken from the hunks of a unified diff (such as produced by git diff).
+ */
+
+#include <lfilter.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+enum {
+	/** Initial number of entries allocated in an array */
+	lfilter_init_alloc = 8
+};
+
+/** Create line filter.
+ *
+ * @param rlfilter Place to store pointer to new line filter
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int lfilter_create(lfilter_t **rlfilter)
+{
+	lfilter_t *lfilter;
+
+	lfilter = calloc(1, sizeof(lfilter_t));
+	if (lfilter == NULL)
+		return ENOMEM;
+
+	*rlfilter = lfilter;
+	return EOK;
+}
+
+/** Destroy line filter.
+ *
+ * @param lfilter Line filter or @c NULL
+ */
+void lfilter_destroy(lfilter_t *lfilter)
+{
+	size_t i;
+
+	if (lfilter == NULL)
+		return;
+
+	for (i = 0; i < lfilter->nfiles; i++) {
+		free(lfilter->file[i].fname);
+		free(lfilter->file[i].range);
+	}
+
+	free(lfilter->file);
+	free(lfilter);
+}
+
+/** Skip leading "./" components of a path.
+ *
+ * @param path Path
+ * @return Pointer into @a path
+ */
+static const char *lfilter_path_skip_dot(const char *path)
+{
+	while (path[0] == '.' && path[1] == '/') {
+		path += 2;
+		while (path[0] == '/')
+			++path;
+	}
+
+	return path;
+}
+
+/** Find line ranges for a file.
+ *
+ * @param lfilter Line filter
+ * @param fname File path
+ * @return Line ranges for the file or @c NULL if there are none
+ */
+lfilter_file_t *lfilter_find(lfilter_t *lfilter, const char *fname)
+{
+	size_t i;
+
+	fname = lfilter_path_skip_dot(fname);
+
+	for (i = 0; i < lfilter->nfiles; i++) {
+		if (strcmp(lfilter->file[i].fname, fname) == 0)
+			return &lfilter->file[i];
+	}
+
+	return NULL;
+}
+
+/** Add line range to line filter.
+ *
+ * @param lfilter Line filter
+ * @param fname File path
+ * @param bline First line
+ * @param eline Last line
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int lfilter_add(lfilter_t *lfilter, const char *fname, size_t bline,
+    size_t eline)
+{
+	lfilter_file_t *file;
+	lfilter_file_t *nfile;
+	checker_lrange_t *nrange;
+	size_t nalloc;
+
+	file = lfilter_find(lfilter, fname);
+	if (file == NULL) {
+		if (lfilter->nfiles >= lfilter->alloc) {
+			nalloc = lfilter->alloc != 0 ? 2 * lfilter->alloc :
+			    lfilter_init_alloc;
+			nfile = realloc(lfilter->file,
+			    nalloc * sizeof(lfilter_file_t));
+			if (nfile == NULL)
+				return ENOMEM;
+
+			lfilter->file = nfile;
+			lfilter->alloc = nalloc;
+		}
+
+		file = &lfilter->file[lfilter->nfiles];
+		memset(file, 0, sizeof(lfilter_file_t));
+		file->fname = strdup(lfilter_path_skip_dot(fname));
+		if (file->fname == NULL)
+			return ENOMEM;
+
+		++lfilter->nfiles;
+	}
+
+	if (file->nranges >= file->alloc) {
+		nalloc = file->alloc != 0 ? 2 * file->alloc :
+		    lfilter_init_alloc;
+		nrange = realloc(file->range,
+		    nalloc * sizeof(checker_lrange_t));
+		if (nrange == NULL)
+			return ENOMEM;
+
+		file->range = nrange;
+		file->alloc = nalloc;
+	}
+
+	file->range[file->nranges].bline = bline;
+	file->range[file->nranges].eline = eline;
+	++file->nranges;
+	return EOK;
+}
+
+/** Parse line number.
+ *
+ * @param str String
+ * @param rend Place to store pointer to first character after the number
+ * @param rline Place to store line number
+ * @return EOK on success, EINVAL if @a str does not start with a number
+ */
+static int lfilter_parse_num(const char *str, const char **rend,
+    size_t *rline)
+{
+	unsigned long long val;
+	char *end;
+
+	if (str[0] < '0' || str[0] > '9')
+		return EINVAL;
+
+	errno = 0;
+	val = strtoull(str, &end, 10);
+	if (errno != 0 || val > SIZE_MAX / 2)
+		return EINVAL;
+
+	*rend = end;
+	*rline = (size_t) val;
+	return EOK;
+}
+
+/** Parse line range specification.
+ *
+ * The specification has the form <file>:<range>[,<range>...] where
+ * each range is either a single line number or <first>-<last>.
+ *
+ * @param lfilter Line filter
+ * @param spec Line range specification
+ * @param errf Output stream for errors
+ * @return EOK on success, EINVAL if @a spec is not valid,
+ *         ENOMEM if out of memory
+ */
+int lfilter_parse_spec(lfilter_t *lfilter, const char *spec, FILE *errf)
+{
+	const char *colon;
+	const char *p;
+	char *fname;
+	size_t bline;
+	size_t eline;
+	int rc;
+
+	colon = strrchr(spec, ':');
+	if (colon == NULL || colon == spec || colon[1] == '\0')
+		goto inval;
+
+	fname = strndup(spec, colon - spec);
+	if (fname == NULL)
+		return ENOMEM;
+
+	p = colon + 1;
+	while (true) {
+		rc = lfilter_parse_num(p, &p, &bline);
+		if (rc != EOK)
+			goto error;
+
+		eline = bline;
+		if (*p == '-') {
+			rc = lfilter_parse_num(p + 1, &p, &eline);
+			if (rc != EOK)
+				goto error;
+		}
+
+		if (bline < 1 || eline < bline) {
+			rc = EINVAL;
+			goto error;
+		}
+
+		rc = lfilter_add(lfilter, fname, bline, eline);
+		if (rc != EOK)
+			goto error;
+
+		if (*p == '\0')
+			break;
+
+		if (*p != ',') {
+			rc = EINVAL;
+			goto error;
+		}
+
+		++p;
+	}
+
+	free(fname);
+	return EOK;
+error:
+	free(fname);
+	if (rc != EINVAL)
+		return rc;
+inval:
+	fprintf(errf, "Invalid line range specification '%s'.\n", spec);
+	return EINVAL;
+}
+
+/** Parse hunk header of a unified diff.
+ *
+ * @param line Line starting with "@@ -"
+ * @param rostart Place to store first line in the old file
+ * @param rolines Place to store number of lines in the old file
+ * @param rnstart Place to store first line in the new file
+ * @param rnlines Place to store number of lines in the new file
+ * @return EOK on success, EINVAL if @a line is not a valid hunk header
+ */
+static int lfilter_parse_hunk(const char *line, size_t *rostart,
+    size_t *rolines, size_t *rnstart, size_t *rnlines)
+{
+	const char *p = line + 4;
+	int rc;
+
+	rc = lfilter_parse_num(p, &p, rostart);
+	if (rc != EOK)
+		return rc;
+
+	*rolines = 1;
+	if (*p == ',') {
+		rc = lfilter_parse_num(p + 1, &p, rolines);
+		if (rc != EOK)
+			return rc;
+	}
+
+	if (p[0] != ' ' || p[1] != '+')
+		return EINVAL;
+
+	rc = lfilter_parse_num(p + 2, &p, rnstart);
+	if (rc != EOK)
+		return rc;
+
+	*rnlines = 1;
+	if (*p == ',') {
+		rc = lfilter_parse_num(p + 1, &p, rnlines);
+		if (rc != EOK)
+			return rc;
+	}
+
+	if (p[0] != ' ' || p[1] != '@' || p[2] != '@')
+		return EINVAL;
+
+	return EOK;
+}
+
+/** Parse unified diff, adding changed lines of the new files.
+ *
+ * For each hunk the added lines are added to the filter. For hunks that
+ * only remove lines the two lines around the removed ones are added
+ * (as they become adjacent). Removed files are ignored.
+ *
+ * @param lfilter Line filter
+ * @param f Unified diff
+ * @param errf Output stream for errors
+ * @return EOK on success, EINVAL if the diff is not valid,
+ *         ENOMEM if out of memory, EIO on I/O error
+ */
+int lfilter_parse_diff(lfilter_t *lfilter, FILE *f, FILE *errf)
+{
+	char *line = NULL;
+	size_t line_alloc = 0;
+	ssize_t len;
+	char *fname = NULL;
+	size_t ostart, olines;
+	size_t nstart, nlines;
+	size_t oleft = 0;
+	size_t nleft = 0;
+	int rc;
+
+	while ((len = getline(&line, &line_alloc, f)) >= 0) {
+		/* Strip line terminator and trailing tabs */
+		while (len > 0 && (line[len - 1] == '\n' ||
+		    line[len - 1] == '\r' || line[len - 1] == '\t'))
+			line[--len] = '\0';
+
+		if (oleft > 0 || nleft > 0) {
+			/* Hunk body */
+			if (line[0] == '-' && oleft > 0) {
+				--oleft;
+			} else if (line[0] == '+' && nleft > 0) {
+				--nleft;
+			} else if (line[0] == ' ' && oleft > 0 && nleft > 0) {
+				--oleft;
+				--nleft;
+			} else if (line[0] != '\\') {
+				fprintf(errf, "Invalid diff: truncated "
+				    "hunk.\n");
+				rc = EINVAL;
+				goto error;
+			}
+
+			continue;
+		}
+
+		if (strncmp(line, "+++ ", 4) == 0) {
+			free(fname);
+			fname = NULL;
+
+			if (strcmp(line + 4, "/dev/null") == 0)
+				continue;
+
+			if (line[4] == '"') {
+				fprintf(errf, "Skipping quoted file name %s.\n",
+				    line + 4);
+				continue;
+			}
+
+			/* Strip destination prefix */
+			fname = strdup(strncmp(line + 4, "b/", 2) == 0 ?
+			    line + 6 : line + 4);
+			if (fname == NULL) {
+				rc = ENOMEM;
+				goto error;
+			}
+		} else if (strncmp(line, "@@ -", 4) == 0) {
+			rc = lfilter_parse_hunk(line, &ostart, &olines,
+			    &nstart, &nlines);
+			if (rc != EOK) {
+				fprintf(errf, "Invalid diff hunk header "
+				    "'%s'.\n", line);
+				goto error;
+			}
+
+			oleft = olines;
+			nleft = nlines;
+
+			if (fname == NULL)
+				continue;
+
+			if (nlines > 0) {
+				rc = lfilter_add(lfilter, fname, nstart,
+				    nstart + nlines - 1);
+			} else {
+				/* Lines removed after line nstart */
+				rc = lfilter_add(lfilter, fname,
+				    nstart > 0 ? nstart : 1, nstart + 1);
+			}
+
+			if (rc != EOK)
+				goto error;
+		}
+	}
+
+	if (ferror(f)) {
+		rc = EIO;
+		goto error;
+	}
+
+	if (oleft > 0 || nleft > 0) {
+		fprintf(errf, "Invalid diff: truncated hunk.\n");
+		rc = EINVAL;
+		goto error;
+	}
+
+	free(fname);
+	free(line);
+	return EOK;
+error:
+	free(fname);
+	free(line);
+	return rc;
+}
+
+/** Add lines changed with respect to a git revision.
+ *
+ * Runs git diff in directory @a dir. File names are relative to @a dir.
+ *
+ * @param lfilter Line filter
+ * @param dir Directory within the git working tree
+ * @param rev Revision to compare the working tree with
+ * @param errf Output stream for errors
+ * @return EOK on success, EINVAL if @a rev is not valid,
+ *         EIO if git failed, ENOMEM if out of memory
+ */
+int lfilter_git_diff(lfilter_t *lfilter, const char *dir, const char *rev,
+    FILE *errf)
+{
+	int pfd[2];
+	pid_t pid;
+	FILE *f;
+	int status;
+	int rc;
+
+	/* Do not let the revision be interpreted as an option */
+	if (rev[0] == '-' || rev[0] == '\0') {
+		fprintf(errf, "Invalid revision '%s'.\n", rev);
+		return EINVAL;
+	}
+
+	if (pipe(pfd) < 0)
+		return EIO;
+
+	pid = fork();
+	if (pid < 0) {
+		close(pfd[0]);
+		close(pfd[1]);
+		return EIO;
+	}
+
+	if (pid == 0) {
+		/* Child */
+		close(pfd[0]);
+		if (dup2(pfd[1], STDOUT_FILENO) < 0)
+			_exit(127);
+		close(pfd[1]);
+
+		execlp("git", "git", "-C", dir, "-c", "core.quotePath=false",
+		    "diff", "-U0", "--no-color", "--no-ext-diff",
+		    "--relative", "--src-prefix=a/", "--dst-prefix=b/", rev,
+		    "--", (char *) NULL);
+		_exit(127);
+	}
+
+	close(pfd[1]);
+	f = fdopen(pfd[0], "r");
+	if (f == NULL) {
+		close(pfd[0]);
+		(void) waitpid(pid, &status, 0);
+		return ENOMEM;
+	}
+
+	rc = lfilter_parse_diff(lfilter, f, errf);
+	fclose(f);
+
+	while (waitpid(pid, &status, 0) < 0) {
+		if (errno != EINTR)
+			return EIO;
+	}
+
+	if (rc != EOK)
+		return rc;
+
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		fprintf(errf, "Cannot get changes from git diff '%s'.\n", rev);
+		return EIO;
+	}
+
+	return EOK;
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef LFILTER_H
+#define LFILTER_H
+
+#include <stdio.h>
+#include <types/lfilter.h>
+
+extern int lfilter_create(lfilter_t **);
+extern void lfilter_destroy(lfilter_t *);
+extern int lfilter_add(lfilter_t *, const char *, size_t, size_t);
+extern int lfilter_parse_spec(lfilter_t *, const char *, FILE *);
+extern int lfilter_parse_diff(lfilter_t *, FILE *, FILE *);
+extern int lfilter_git_diff(lfilter_t *, const char *, const char *, FILE *);
+extern lfilter_file_t *lfilter_find(lfilter_t *, const char *);
+
+#endif
@@ -24,240 +24,2382 @@
  * C-style checker tool
  */
 
+#include <alloc.h>
+#include <baseline.h>
+#include <bench.h>
+#include <buf_input.h>
 #include <checker.h>
+#include <client.h>
+#include <diag.h>
+#include <fcntl.h>
 #include <file_input.h>
+#include <flist.h>
+#include <fuzz.h>
+#include <lfilter.h>
+#include <limits.h>
 #include <lexer.h>
+#include <mcache.h>
 #include <merrno.h>
 #include <parser.h>
+#include <pconf.h>
+#include <pthread.h>
+#include <rcache.h>
+#include <server.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <test/alloc.h>
 #include <test/ast.h>
+#include <test/baseline.h>
 #include <test/checker.h>
+#include <test/diag.h>
+#include <test/golden.h>
 #include <test/lexer.h>
+#include <test/lfilter.h>
+#include <test/mcache.h>
 #include <test/parser.h>
+#include <test/pconf.h>
+#include <test/rcache.h>
+#include <test/stress.h>
+#include <test/sycek.h>
+#include <test/wpool.h>
+#include <time.h>
+#include <trace.h>
+#include <unistd.h>
+#include <watch.h>
+#include <wpool.h>
 
-static void print_syntax(void)
+enum {
+	/** Size of standard output buffer */
+	stdout_buf_size = 65536,
+	/** Maximum number of parallel jobs */
+	check_max_jobs = 1024,
+	/** Initial buffer size for reading a file */
+	check_read_init_alloc = 16384,
+	/** Default maximum cache size in bytes */
+	check_cache_def_size = 64 * 1024 * 1024,
+	/** Maximum cache size in MiB */
+	check_max_cache_size = 1024 * 1024,
+	/** Maximum number of temporary file names to try */
+	check_max_tmp_tries = 100,
+	/** Default memory limit for modules kept in memory in MiB */
+	check_watch_def_mem = 256,
+	/** Number of slowest files listed by --stats */
+	check_stats_slowest = 10,
+	/** Default maximum slowdown in percent for --bench-compare */
+	check_bench_def_threshold = 10,
+	/** Maximum slowdown in percent that can be specified */
+	check_bench_max_threshold = 1000,
+	/** Default number of fragments tried by --fuzz */
+	check_fuzz_def_iters = 1000
+};
+
+/** Standard output buffer */
+static char stdout_buf[stdout_buf_size];
+
+/** Options for checking files */
+typedef struct {
+	/** Checker flags */
+	checker_flags_t flags;
+	/** Keep the original of a fixed file as <file>.orig */
+	bool backup;
+	/** Print fixes as a unified diff instead of writing files */
+	bool diff;
+	/** Checker configuration */
+	checker_cfg_t cfg;
+	/** Output format for issues */
+	diag_fmt_t fmt;
+	/** Number of files to check in parallel */
+	unsigned njobs;
+	/** Print timing and memory statistics */
+	bool stats;
+	/** Result cache or @c NULL */
+	rcache_t *rcache;
+	/** Only check these line ranges or @c NULL to check all lines */
+	lfilter_t *lfilter;
+	/** Do not report issues in this baseline or @c NULL */
+	baseline_t *baseline;
+	/** Record fingerprints of all issues or @c NULL */
+	baseline_wr_t *blwr;
+	/** Configuration from .ccheck files or @c NULL */
+	pconf_t *pconf;
+	/** Event trace or @c NULL */
+	trace_t *trace;
+	/** Stop checking a file after this many issues (zero for no limit) */
+	unsigned max_issues;
+	/** Directory relative paths are resolved against */
+	int dirfd;
+	/** File contents read from standard input or @c NULL */
+	char *inbuf;
+	/** Size of @c inbuf */
+	size_t inbuf_size;
+	/** Output stream for issues */
+	FILE *outf;
+	/** Output stream for errors */
+	FILE *errf;
+} check_opts_t;
+
+/** Statistics of checking one file (--stats) */
+typedef struct {
+	/** Checker statistics */
+	checker_stats_t cs;
+	/** Number of issues reported in each check group */
+	unsigned nissues[dg_internal + 1];
+	/** Results were taken from the result cache */
+	bool cached;
+} check_fstats_t;
+
+/** Statistics of checking a list of files */
+typedef struct {
+	/** Number of checked files with issues */
+	unsigned srepcnt;
+	/** Number of checked files without issues */
+	unsigned snorepcnt;
+	/** Number of files that could not be checked */
+	unsigned fcnt;
+	/** Last error code (EOK if all files were checked) */
+	int rc;
+	/** Sum of statistics of all checked files (--stats) */
+	check_fstats_t total;
+	/** Number of files included in @c total */
+	size_t nfiles;
+	/** Total wall time of each file in file list order (--stats) */
+	uint64_t *fwall;
+} check_stats_t;
+
+/** Parallel check job (checking one file) */
+typedef struct {
+	/** Buffered standard output */
+	char *out;
+	/** Size of buffered standard output */
+	size_t out_size;
+	/** Buffered error output */
+	char *err;
+	/** Size of buffered error output */
+	size_t err_size;
+	/** Return code of check_file() */
+	int rc;
+	/** @c true if issues were reported */
+	bool issues;
+	/** Statistics (--stats) */
+	check_fstats_t fs;
+	/** @c true if the job is finished */
+	bool done;
+} check_job_t;
+
+/** Parallel check of a list of files */
+typedef struct {
+	/** File list */
+	flist_t *flist;
+	/** File list entries in scheduling order */
+	flist_entry_t **sched;
+	/** Jobs (in file list order) */
+	check_job_t *job;
+	/** Diagnostic list for each worker */
+	diag_list_t *diags;
+	/** Options (read-only) */
+	check_opts_t *opts;
+	/** Protects job completion */
+	pthread_mutex_t lock;
+	/** Signalled when a job is finished */
+	pthread_cond_t done_cv;
+} check_par_t;
+
+static void print_syntax(FILE *f)
+{
+	fprintf(f, "C-style checker\n");
+	fprintf(f, "syntax:\n"
+	    "\tccheck [options] <file|dir>... Check C-style in the specified "
+	    "files\n"
+	    "\t  and all .c/.h files under the specified directories\n"
+	    "\tccheck --test Run internal unit tests\n"
+	    "\tccheck --test-stress <dir> Check files under <dir> from many "
+	    "threads\n"
+	    "\tccheck --test-alloc <dir> Check files under <dir> for memory "
+	    "leaks\n"
+	    "\tccheck --run-golden <dir> Compare results for test inputs under "
+	    "<dir>\n"
+	    "\t  with expected results\n"
+	    "\tccheck --bench-edit <file> Measure re-check latency after "
+	    "edits\n"
+	    "\tccheck --bench [<json>] Measure throughput on synthetic "
+	    "sources\n"
+	    "\tccheck --bench-gen <dir> Write synthetic sources to <dir>\n"
+	    "\tccheck --bench-compare <json> [<pct>] Fail if any phase is "
+	    "more than\n"
+	    "\t  <pct> percent (default 10) slower than saved results\n"
+	    "\tccheck --fuzz <dir> [<n> [<seed>]] Try <n> generated fragments, "
+	    "save\n"
+	    "\t  those with super-linear work to <dir>\n"
+	    "\tccheck --test-complexity <dir> Check work done on files "
+	    "under <dir>\n"
+	    "\tccheck --server <socket> [-j <n>] Serve check requests\n"
+	    "\tccheck --client <socket> [options] <file|dir>... Check using "
+	    "server\n"
+	    "options:\n"
+	    "\t--fix Attempt to fix issues instead of just reporting them\n"
+	    "\t--no-backup Do not keep <file>.orig when fixing <file>\n"
+	    "\t--diff With --fix, print fixes as a unified diff instead of "
+	    "writing files\n"
+	    "\t--dump-ast Dump internal abstract syntax tree\n"
+	    "\t--dump-toks Dump tokenized source file\n"
+	    "\t--format=<fmt> Output format for issues\n"
+	    "\t  (text, jsonl, bin)\n"
+	    "\t-j <n> Check up to <n> files in parallel (0 = number of CPUs)\n"
+	    "\t--cache=<dir> Reuse results for unchanged files\n"
+	    "\t--cache-size=<n> Limit cache size to <n> MiB (default 64)\n"
+	    "\t--stdin=<name> Check standard input as file <name>\n"
+	    "\t--watch Keep checking files in the specified directories as "
+	    "they change\n"
+	    "\t--watch-mem=<n> Keep up to <n> MiB of checked files in memory "
+	    "(default 256)\n"
+	    "\t--lines <file>:<first>[-<last>],... Only report issues on the "
+	    "specified lines\n\t\t(line-based checks still scan the whole "
+	    "file)\n"
+	    "\t--git-diff <rev> Only report issues on lines changed since git "
+	    "revision <rev>\n"
+	    "\t--write-baseline=<file> Record all issues found in baseline "
+	    "<file>\n"
+	    "\t--baseline=<file> Only report issues not recorded in "
+	    "baseline <file>\n"
+	    "\t-d <check> Disable a particular group of checks\n"
+	    "\t  (decl, estmt, fmt, hdr, invchar, loop, nblock, sclass)\n"
+	    "\t--no-config Do not read .ccheck configuration files\n"
+	    "\t--stats Print per-phase timing and memory statistics\n"
+	    "\t--trace=<file> Write spans of files, phases and declarations "
+	    "to <file>\n"
+	    "\t  in Chrome trace event format\n"
+	    "\t--fail-fast Stop checking a file at the first issue\n"
+	    "\t--max-issues=<n> Stop checking a file after <n> issues\n");
+}
+
+/** Read the rest of a file into memory.
+ *
+ * @param f File
+ * @param rbuf Place to store pointer to newly allocated buffer
+ * @param rsize Place to store number of bytes read
+ * @return EOK on success, ENOMEM if out of memory, EIO on I/O error
+ */
+static int check_read_all(FILE *f, char **rbuf, size_t *rsize)
+{
+	char *buf = NULL;
+	char *nbuf;
+	size_t size = 0;
+	size_t alloc = 0;
+	size_t nread;
+
+	do {
+		if (size >= alloc) {
+			alloc = alloc != 0 ? 2 * alloc : check_read_init_alloc;
+			nbuf = realloc(buf, alloc);
+			if (nbuf == NULL) {
+				free(buf);
+				return ENOMEM;
+			}
+
+			buf = nbuf;
+		}
+
+		nread = fread(buf + size, 1, alloc - size, f);
+		size += nread;
+	} while (nread > 0);
+
+	if (ferror(f)) {
+		free(buf);
+		return EIO;
+	}
+
+	*rbuf = buf;
+	*rsize = size;
+	return EOK;
+}
+
+/** Open file for reading.
+ *
+ * @param opts Options
+ * @param fname File name (relative to @a opts->dirfd)
+ * @param mode Mode for fdopen()
+ * @param flags Flags for openat()
+ * @return Open file or @c NULL on failure
+ */
+static FILE *check_fopen(check_opts_t *opts, const char *fname,
+    const char *mode, int flags)
+{
+	FILE *f;
+	int fd;
+
+	fd = openat(opts->dirfd, fname, flags, 0666);
+	if (fd < 0)
+		return NULL;
+
+	f = fdopen(fd, mode);
+	if (f == NULL)
+		close(fd);
+
+	return f;
+}
+
+/** Read file into memory.
+ *
+ * @param opts Options
+ * @param fname File name
+ * @param rbuf Place to store pointer to newly allocated buffer
+ * @param rsize Place to store file size
+ * @param errf Output stream for errors
+ * @return EOK on success, ENOENT if the file cannot be opened, ENOMEM
+ *         if out of memory, EIO on I/O error
+ */
+static int check_read_file(check_opts_t *opts, const char *fname,
+    char **rbuf, size_t *rsize, FILE *errf)
+{
+	FILE *f;
+	int rc;
+
+	f = check_fopen(opts, fname, "rt", O_RDONLY);
+	if (f == NULL) {
+		fprintf(errf, "Cannot open '%s'.\n", fname);
+		return ENOENT;
+	}
+
+	rc = check_read_all(f, rbuf, rsize);
+	fclose(f);
+	if (rc != EOK)
+		fprintf(errf, "Error reading '%s'.\n", fname);
+	return rc;
+}
+
+/** Determine if diagnostic fingerprints need to be computed.
+ *
+ * @param opts Options
+ * @return @c true iff issues are matched against or recorded in a baseline
+ */
+static bool check_fps(check_opts_t *opts)
+{
+	return opts->baseline != NULL || opts->blwr != NULL;
+}
+
+/** Look up file in the result cache.
+ *
+ * @param opts Options
+ * @param fname File name
+ * @param text File contents
+ * @param size Size of @a text
+ * @param cfg Checker configuration
+ * @param mtype Module type
+ * @param diags Empty diagnostic list to store cached diagnostics to
+ * @param key Place to store cache key
+ * @return EOK on a hit, ENOENT on a miss, ENOMEM if out of memory
+ */
+static int check_cache_lookup(check_opts_t *opts, const char *fname,
+    const char *text, size_t size, checker_cfg_t *cfg,
+    checker_mtype_t mtype, diag_list_t *diags, rcache_key_t *key)
+{
+	rcache_key(opts->rcache, text, size, cfg, mtype, check_fps(opts), key);
+	return rcache_lookup(opts->rcache, key, fname, diags);
+}
+
+/** Determine module type from file name extension.
+ *
+ * @param fname File name
+ * @param rmtype Place to store module type
+ * @param errf Output stream for errors
+ * @return EOK on success, EINVAL if the extension is not recognized
+ */
+static int check_mtype(const char *fname, checker_mtype_t *rmtype,
+    FILE *errf)
+{
+	const char *ext;
+
+	ext = strrchr(fname, '.');
+	if (ext == NULL) {
+		fprintf(errf, "File '%s' has no extension.\n", fname);
+		return EINVAL;
+	}
+
+	if (strcmp(ext, ".c") == 0 || strcmp(ext, ".C") == 0) {
+		*rmtype = cmod_c;
+	} else if (strcmp(ext, ".h") == 0 || strcmp(ext, ".H") == 0) {
+		*rmtype = cmod_header;
+	} else {
+		fprintf(errf, "Unknown file extension '%s'.\n", ext);
+		return EINVAL;
+	}
+
+	return EOK;
+}
+
+/** Determine checker configuration and module type of a file.
+ *
+ * @param opts Options
+ * @param fname File name
+ * @param rcfg Place to store pointer to checker configuration
+ * @param rmtype Place to store module type
+ * @param errf Output stream for errors
+ * @return EOK on success, EINVAL if the file type is not recognized
+ *         or a configuration file is not valid, or other error code
+ */
+static int check_file_cfg(check_opts_t *opts, const char *fname,
+    checker_cfg_t **rcfg, checker_mtype_t *rmtype, FILE *errf)
+{
+	pconf_file_t pf;
+	int rc;
+
+	if (opts->pconf == NULL) {
+		*rcfg = &opts->cfg;
+		return check_mtype(fname, rmtype, errf);
+	}
+
+	rc = pconf_file(opts->pconf, fname, &pf);
+	if (rc != EOK)
+		return rc;
+
+	*rcfg = pf.cfg;
+	if (pf.mtype_set) {
+		*rmtype = pf.mtype;
+		return EOK;
+	}
+
+	return check_mtype(fname, rmtype, errf);
+}
+
+/** Create temporary file next to a file.
+ *
+ * @param opts Options
+ * @param fname File name
+ * @param mode Permissions of the new file
+ * @param rtmpname Place to store newly allocated name of temporary file
+ * @return Open file or @c NULL on failure
+ */
+static FILE *check_tmp_create(check_opts_t *opts, const char *fname,
+    mode_t mode, char **rtmpname)
+{
+	char *tmpname;
+	FILE *f;
+	int fd;
+	int i;
+
+	for (i = 0; i < check_max_tmp_tries; i++) {
+		if (asprintf(&tmpname, "%s.ccheck-%ld-%d", fname,
+		    (long) getpid(), i) < 0)
+			return NULL;
+
+		fd = openat(opts->dirfd, tmpname, O_WRONLY | O_CREAT | O_EXCL,
+		    mode);
+		if (fd >= 0)
+			break;
+
+		free(tmpname);
+		if (errno != EEXIST)
+			return NULL;
+	}
+
+	if (i >= check_max_tmp_tries)
+		return NULL;
+
+	/* Not affected by umask */
+	(void) fchmod(fd, mode);
+
+	f = fdopen(fd, "wt");
+	if (f == NULL) {
+		close(fd);
+		(void) unlinkat(opts->dirfd, tmpname, 0);
+		free(tmpname);
+		return NULL;
+	}
+
+	*rtmpname = tmpname;
+	return f;
+}
+
+/** Write fixed source code over the original file.
+ *
+ * The fixed code is written to a temporary file which then replaces
+ * the original file, so the file is never seen partially written.
+ * The original file is kept as <file>.orig (as a hard link, without
+ * copying) unless disabled in @a opts.
+ *
+ * @param opts Options
+ * @param fname File name
+ * @param checker Checker that has fixed the file
+ * @param errf Output stream for errors
+ * @return EOK on success or error code
+ */
+static int check_write_fixed(check_opts_t *opts, const char *fname,
+    checker_t *checker, FILE *errf)
+{
+	struct stat st;
+	char *tmpname = NULL;
+	char *bkname = NULL;
+	FILE *f;
+	int rc;
+
+	if (fstatat(opts->dirfd, fname, &st, 0) < 0) {
+		fprintf(errf, "Cannot open '%s'.\n", fname);
+		return EIO;
+	}
+
+	f = check_tmp_create(opts, fname, st.st_mode & 07777, &tmpname);
+	if (f == NULL) {
+		fprintf(errf, "Cannot create temporary file for '%s'.\n",
+		    fname);
+		return EIO;
+	}
+
+	rc = checker_print(checker, f);
+	if (fclose(f) < 0 && rc == EOK)
+		rc = EIO;
+	if (rc != EOK) {
+		fprintf(errf, "Error writing '%s'.\n", tmpname);
+		goto error;
+	}
+
+	if (opts->backup) {
+		if (asprintf(&bkname, "%s.orig", fname) < 0) {
+			bkname = NULL;
+			rc = ENOMEM;
+			goto error;
+		}
+
+		if ((unlinkat(opts->dirfd, bkname, 0) < 0 && errno != ENOENT) ||
+		    linkat(opts->dirfd, fname, opts->dirfd, bkname, 0) < 0) {
+			fprintf(errf, "Error linking '%s' to '%s'.\n", fname,
+			    bkname);
+			rc = EIO;
+			goto error;
+		}
+	}
+
+	if (renameat(opts->dirfd, tmpname, opts->dirfd, fname) < 0) {
+		fprintf(errf, "Error renaming '%s' to '%s'.\n", tmpname,
+		    fname);
+		rc = EIO;
+		goto error;
+	}
+
+	free(bkname);
+	free(tmpname);
+	return EOK;
+error:
+	(void) unlinkat(opts->dirfd, tmpname, 0);
+	free(bkname);
+	free(tmpname);
+	return rc;
+}
+
+/** Record issues in baseline and/or drop issues found in baseline.
+ *
+ * @param opts Options
+ * @param diags Diagnostic list (sorted by position)
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int check_baseline(check_opts_t *opts, diag_list_t *diags)
+{
+	int rc;
+
+	if (opts->blwr != NULL) {
+		rc = baseline_wr_add(opts->blwr, diags);
+		if (rc != EOK)
+			return rc;
+	}
+
+	if (opts->baseline != NULL) {
+		rc = baseline_filter(opts->baseline, diags);
+		if (rc != EOK)
+			return rc;
+	}
+
+	return EOK;
+}
+
+/** Count reported issues by check group.
+ *
+ * @param fs File statistics
+ * @param diags Reported issues
+ */
+static void check_fstats_issues(check_fstats_t *fs, diag_list_t *diags)
+{
+	size_t i;
+
+	for (i = 0; i < diags->ndiags; i++)
+		++fs->nissues[diags->diag[i].group];
+}
+
+/** Print number of issues in each check group.
+ *
+ * @param nissues Number of issues indexed by check group
+ * @param f Output stream
+ */
+static void check_issues_print(unsigned *nissues, FILE *f)
+{
+	diag_group_t g;
+	bool any = false;
+
+	for (g = 0; g <= dg_internal; g++) {
+		if (nissues[g] == 0)
+			continue;
+
+		fprintf(f, "%s %s %u", any ? "," : "", diag_group_str(g),
+		    nissues[g]);
+		any = true;
+	}
+
+	if (!any)
+		fprintf(f, " none");
+}
+
+/** Get total wall time of all checker phases.
+ *
+ * @param cs Checker statistics
+ * @return Wall time in nanoseconds
+ */
+static uint64_t check_stats_wall(checker_stats_t *cs)
+{
+	checker_phase_t ph;
+	uint64_t wall = 0;
+
+	for (ph = 0; ph < cph_limit; ph++)
+		wall += cs->wall[ph];
+
+	return wall;
+}
+
+/** Print statistics of checking one file.
+ *
+ * @param fname File name
+ * @param fs File statistics
+ * @param f Output stream
+ */
+static void check_fstats_print(const char *fname, check_fstats_t *fs,
+    FILE *f)
+{
+	checker_phase_t ph;
+
+	if (fs->cached) {
+		fprintf(f, "Stats '%s': cached, issues:", fname);
+		check_issues_print(fs->nissues, f);
+		fprintf(f, "\n");
+		return;
+	}
+
+	fprintf(f, "Stats '%s': %zu bytes, %zu tokens (%zu read by parser, "
+	    "%zu visited by checker), issues:", fname, fs->cs.nbytes,
+	    fs->cs.ntoks, fs->cs.nptoks, fs->cs.nvisits);
+	check_issues_print(fs->nissues, f);
+	fprintf(f, "\n");
+
+	fprintf(f, "Stats '%s': wall/CPU ms:", fname);
+	for (ph = 0; ph < cph_limit; ph++) {
+		fprintf(f, " %s %.3f/%.3f", checker_phase_str(ph),
+		    fs->cs.wall[ph] / 1e6, fs->cs.cpu[ph] / 1e6);
+	}
+
+	fprintf(f, "\n");
+
+	/* AST nodes and memory use are only known if allocations are tracked */
+	if (!alloc_track_enabled())
+		return;
+
+	fprintf(f, "Stats '%s': %zu AST nodes, peak KiB:", fname,
+	    fs->cs.nnodes);
+	for (ph = 0; ph < cph_limit; ph++) {
+		fprintf(f, " %s %zu", checker_phase_str(ph),
+		    fs->cs.peak[ph] / 1024);
+	}
+
+	fprintf(f, "\n");
+}
+
+/** Check a single file.
+ *
+ * @param opts Options
+ * @param fname File name
+ * @param diags Diagnostic list to collect issues in (must be empty)
+ * @param outf Output stream for issues
+ * @param errf Output stream for errors
+ * @param fs Place to store statistics or @c NULL
+ * @return EOK on success (regardless whether issues are found), error code
+ *         if the file could not be checked
+ */
+static int check_file_run(check_opts_t *opts, const char *fname,
+    diag_list_t *diags, FILE *outf, FILE *errf, check_fstats_t *fs)
+{
+	int rc;
+	checker_flags_t flags = opts->flags;
+	checker_t *checker = NULL;
+	checker_cfg_t *cfg;
+	checker_mtype_t mtype;
+	file_input_t finput;
+	buf_input_t binput;
+	lfilter_file_t *lfile;
+	rcache_key_t key;
+	bool cached;
+	const char *btext = NULL;
+	size_t bsize = 0;
+	char *text = NULL;
+	size_t size = 0;
+	FILE *f = NULL;
+	uint64_t pstart;
+
+	if (fs != NULL)
+		memset(fs, 0, sizeof(check_fstats_t));
+
+	rc = check_file_cfg(opts, fname, &cfg, &mtype, errf);
+	if (rc != EOK)
+		goto error;
+
+	/*
+	 * Fixing or dumping needs the checker, not just the diagnostics.
+	 * Cached results are for all lines and all issues.
+	 */
+	cached = opts->rcache != NULL && opts->lfilter == NULL &&
+	    opts->max_issues == 0 &&
+	    (flags & (cf_fix | cf_dump_ast | cf_dump_toks)) == 0;
+
+	if (opts->inbuf != NULL) {
+		btext = opts->inbuf;
+		bsize = opts->inbuf_size;
+	} else if (opts->diff || cached) {
+		/* The diff and the cache key need the whole text */
+		rc = check_read_file(opts, fname, &text, &size, errf);
+		if (rc != EOK)
+			goto error;
+
+		btext = text;
+		bsize = size;
+	} else {
+		f = check_fopen(opts, fname, "rt", O_RDONLY);
+		if (f == NULL) {
+			fprintf(errf, "Cannot open '%s'.\n", fname);
+			rc = ENOENT;
+			goto error;
+		}
+	}
+
+	if (cached) {
+		rc = check_cache_lookup(opts, fname, btext, bsize, cfg, mtype,
+		    diags, &key);
+		if (rc == EOK) {
+			rc = check_baseline(opts, diags);
+			if (rc != EOK)
+				goto error;
+
+			if (fs != NULL) {
+				fs->cached = true;
+				check_fstats_issues(fs, diags);
+			}
+
+			rc = diag_list_print(diags, opts->fmt, outf);
+			if (rc != EOK)
+				goto error;
+
+			free(text);
+			return EOK;
+		}
+
+		if (rc != ENOENT)
+			goto error;
+	}
+
+	if (btext != NULL) {
+		buf_input_init(&binput, btext, bsize, fname);
+		rc = checker_create(&lexer_buf_input, &binput, mtype, cfg,
+		    &checker);
+	} else {
+		file_input_init(&finput, f, fname);
+		rc = checker_create(&lexer_file_input, &finput, mtype, cfg,
+		    &checker);
+	}
+	if (rc != EOK)
+		goto error;
+
+	checker_set_sink(checker, &diag_list_sink, diags);
+	checker_set_errf(checker, errf);
+	if (fs != NULL)
+		checker_set_stats(checker, &fs->cs);
+	checker_set_trace(checker, opts->trace);
+	checker_set_max_issues(checker, opts->max_issues);
+	if (check_fps(opts))
+		checker_set_fps(checker);
+
+	if (opts->lfilter != NULL) {
+		lfile = lfilter_find(opts->lfilter, fname);
+		rc = checker_set_lines(checker, lfile != NULL ? lfile->range :
+		    NULL, lfile != NULL ? lfile->nranges : 0);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if ((flags & cf_dump_ast) != 0) {
+		rc = checker_dump_ast(checker, outf);
+		if (rc != EOK)
+			goto error;
+
+		fprintf(outf, "\n");
+	}
+
+	if ((flags & cf_dump_toks) != 0) {
+		rc = checker_dump_toks(checker, outf);
+		if (rc != EOK)
+			goto error;
+
+		fprintf(outf, "\n");
+	}
+
+	rc = checker_run(checker, (flags & cf_fix) != 0);
+	if (rc != EOK)
+		goto error;
+
+	if (opts->diff) {
+		/* Standard output only contains the diff */
+		pstart = opts->trace != NULL ? trace_now() : 0;
+		rc = checker_print_diff(checker, btext, bsize, fname, outf);
+		if (rc != EOK)
+			goto error;
+
+		if (opts->trace != NULL)
+			trace_span(opts->trace, "phase", "print", pstart, 0);
+
+		free(text);
+		checker_destroy(checker);
+		return EOK;
+	}
+
+	diag_list_sort(diags);
+
+	/* Failing to update the cache is not an error */
+	if (cached)
+		(void) rcache_store(opts->rcache, &key, diags);
+
+	rc = check_baseline(opts, diags);
+	if (rc != EOK)
+		goto error;
+
+	if (fs != NULL)
+		check_fstats_issues(fs, diags);
+
+	pstart = opts->trace != NULL ? trace_now() : 0;
+	rc = diag_list_print(diags, opts->fmt, outf);
+	if (rc != EOK)
+		goto error;
+
+	if (f != NULL) {
+		fclose(f);
+		f = NULL;
+	}
+
+	/* Leave files that need no fixes untouched */
+	if ((flags & cf_fix) != 0 && checker_modified(checker)) {
+		rc = check_write_fixed(opts, fname, checker, errf);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if (opts->trace != NULL)
+		trace_span(opts->trace, "phase", "print", pstart, 0);
+
+	checker_destroy(checker);
+	free(text);
+
+	return EOK;
+error:
+	if (checker != NULL)
+		checker_destroy(checker);
+	if (f != NULL)
+		fclose(f);
+	free(text);
+	return rc;
+}
+
+/** Check a single file, writing a span for it to the event trace (if any).
+ *
+ * @param opts Options
+ * @param fname File name
+ * @param diags Diagnostic list to collect issues in (must be empty)
+ * @param outf Output stream for issues
+ * @param errf Output stream for errors
+ * @param fs Place to store statistics or @c NULL
+ * @return EOK on success (regardless whether issues are found), error code
+ *         if the file could not be checked
+ */
+static int check_file(check_opts_t *opts, const char *fname,
+    diag_list_t *diags, FILE *outf, FILE *errf, check_fstats_t *fs)
+{
+	alloc_track_t track;
+	uint64_t start;
+	int rc;
+
+	/* Charge memory used for checking the file to its statistics */
+	if (fs != NULL) {
+		alloc_track_init(&track);
+		alloc_track_set(&track);
+	}
+
+	start = opts->trace != NULL ? trace_now() : 0;
+	rc = check_file_run(opts, fname, diags, outf, errf, fs);
+	if (opts->trace != NULL)
+		trace_span(opts->trace, "file", fname, start, 0);
+
+	if (fs != NULL)
+		alloc_track_set(NULL);
+	return rc;
+}
+
+/** Account for the result of checking one file.
+ *
+ * @param stats Statistics to update
+ * @param rc Return code of check_file()
+ * @param issues @c true if issues were reported for the file
+ */
+static void check_stats_add(check_stats_t *stats, int rc, bool issues)
+{
+	if (rc != EOK) {
+		++stats->fcnt;
+		stats->rc = rc;
+	} else if (issues) {
+		++stats->srepcnt;
+	} else {
+		++stats->snorepcnt;
+	}
+}
+
+/** Account for statistics of checking one file (--stats).
+ *
+ * @param stats Statistics to update
+ * @param idx Index of file in file list
+ * @param fs File statistics
+ */
+static void check_stats_add_file(check_stats_t *stats, size_t idx,
+    check_fstats_t *fs)
+{
+	checker_stats_t *tcs = &stats->total.cs;
+	checker_phase_t ph;
+	diag_group_t g;
+
+	for (ph = 0; ph < cph_limit; ph++) {
+		tcs->wall[ph] += fs->cs.wall[ph];
+		tcs->cpu[ph] += fs->cs.cpu[ph];
+		if (fs->cs.peak[ph] > tcs->peak[ph])
+			tcs->peak[ph] = fs->cs.peak[ph];
+	}
+
+	tcs->nbytes += fs->cs.nbytes;
+	tcs->ntoks += fs->cs.ntoks;
+	tcs->nptoks += fs->cs.nptoks;
+	tcs->nvisits += fs->cs.nvisits;
+	tcs->nnodes += fs->cs.nnodes;
+
+	for (g = 0; g <= dg_internal; g++)
+		stats->total.nissues[g] += fs->nissues[g];
+
+	stats->fwall[idx] = check_stats_wall(&fs->cs);
+	++stats->nfiles;
+}
+
+/** Check all files in a file list one after another.
+ *
+ * @param opts Options
+ * @param flist File list
+ * @param stats Statistics to update
+ */
+static void check_files_serial(check_opts_t *opts, flist_t *flist,
+    check_stats_t *stats)
+{
+	diag_list_t diags;
+	check_fstats_t fs;
+	size_t i;
+	int rc;
+
+	/* Diagnostic list is reused for all files */
+	diag_list_init(&diags);
+
+	for (i = 0; i < flist->nentries; i++) {
+		rc = check_file(opts, flist->entry[i].path, &diags, opts->outf,
+		    opts->errf, opts->stats ? &fs : NULL);
+		check_stats_add(stats, rc, diags.ndiags > 0);
+		if (opts->stats && rc == EOK) {
+			fflush(opts->outf);
+			check_fstats_print(flist->entry[i].path, &fs,
+			    opts->errf);
+			check_stats_add_file(stats, i, &fs);
+		}
+
+		/* Keep order with errors reported to stderr */
+		if (diags.ndiags > 0)
+			fflush(opts->outf);
+
+		diag_list_clear(&diags);
+	}
+
+	diag_list_fini(&diags);
+}
+
+/** Run one parallel check job.
+ *
+ * Output is collected in memory and printed by the main thread
+ * in file list order.
+ *
+ * @param arg Parallel check (check_par_t *)
+ * @param widx Worker index
+ * @param jidx Job index
+ */
+static void check_par_run(void *arg, unsigned widx, size_t jidx)
+{
+	check_par_t *par = (check_par_t *) arg;
+	diag_list_t *diags = &par->diags[widx];
+	check_job_t *job;
+	FILE *outf;
+	FILE *errf = NULL;
+	int rc;
+
+	job = &par->job[par->sched[jidx] - par->flist->entry];
+
+	outf = open_memstream(&job->out, &job->out_size);
+	if (outf == NULL) {
+		rc = ENOMEM;
+		goto done;
+	}
+
+	errf = open_memstream(&job->err, &job->err_size);
+	if (errf == NULL) {
+		rc = ENOMEM;
+		goto done;
+	}
+
+	rc = check_file(par->opts, par->sched[jidx]->path, diags, outf, errf,
+	    par->opts->stats ? &job->fs : NULL);
+	job->issues = diags->ndiags > 0;
+	if (par->opts->stats && rc == EOK)
+		check_fstats_print(par->sched[jidx]->path, &job->fs, errf);
+	diag_list_clear(diags);
+done:
+	if (errf != NULL && fclose(errf) < 0 && rc == EOK)
+		rc = ENOMEM;
+	if (outf != NULL && fclose(outf) < 0 && rc == EOK)
+		rc = ENOMEM;
+
+	pthread_mutex_lock(&par->lock);
+	job->rc = rc;
+	job->done = true;
+	pthread_cond_broadcast(&par->done_cv);
+	pthread_mutex_unlock(&par->lock);
+}
+
+static wpool_ops_t check_par_ops = {
+	.run = check_par_run
+};
+
+/** Compare file list entries for scheduling (largest first).
+ *
+ * @param a Pointer to first entry (flist_entry_t **)
+ * @param b Pointer to second entry (flist_entry_t **)
+ * @return Less than, equal to or greater than zero
+ */
+static int check_sched_cmp(const void *a, const void *b)
+{
+	flist_entry_t *ea = *(flist_entry_t **) a;
+	flist_entry_t *eb = *(flist_entry_t **) b;
+
+	if (ea->size != eb->size)
+		return ea->size > eb->size ? -1 : 1;
+
+	/* Keep list order among files of the same size */
+	return ea < eb ? -1 : (ea > eb ? 1 : 0);
+}
+
+/** Check all files in a file list using multiple threads.
+ *
+ * Files are scheduled largest first, but their output is printed
+ * in file list order, as soon as all preceding files are finished.
+ *
+ * @param opts Options
+ * @param flist File list
+ * @param njobs Number of worker threads
+ * @param stats Statistics to update
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int check_files_par(check_opts_t *opts, flist_t *flist,
+    unsigned njobs, check_stats_t *stats)
+{
+	check_par_t par;
+	check_job_t *job;
+	wpool_t *pool = NULL;
+	size_t i;
+	unsigned w;
+	int rc;
+
+	memset(&par, 0, sizeof(par));
+	par.flist = flist;
+	par.opts = opts;
+	pthread_mutex_init(&par.lock, NULL);
+	pthread_cond_init(&par.done_cv, NULL);
+
+	par.job = calloc(flist->nentries, sizeof(check_job_t));
+	par.sched = calloc(flist->nentries, sizeof(flist_entry_t *));
+	par.diags = calloc(njobs, sizeof(diag_list_t));
+	if (par.job == NULL || par.sched == NULL || par.diags == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	for (w = 0; w < njobs; w++)
+		diag_list_init(&par.diags[w]);
+
+	for (i = 0; i < flist->nentries; i++)
+		par.sched[i] = &flist->entry[i];
+
+	qsort(par.sched, flist->nentries, sizeof(flist_entry_t *),
+	    check_sched_cmp);
+
+	rc = wpool_create(njobs, flist->nentries, &check_par_ops, &par,
+	    &pool);
+	if (rc != EOK)
+		goto error;
+
+	for (i = 0; i < flist->nentries; i++) {
+		job = &par.job[i];
+
+		pthread_mutex_lock(&par.lock);
+		while (!job->done)
+			pthread_cond_wait(&par.done_cv, &par.lock);
+		pthread_mutex_unlock(&par.lock);
+
+		if (job->out_size > 0) {
+			fwrite(job->out, 1, job->out_size, opts->outf);
+			fflush(opts->outf);
+		}
+
+		if (job->err_size > 0)
+			fwrite(job->err, 1, job->err_size, opts->errf);
+
+		free(job->out);
+		free(job->err);
+		job->out = NULL;
+		job->err = NULL;
+
+		check_stats_add(stats, job->rc, job->issues);
+		if (opts->stats && job->rc == EOK)
+			check_stats_add_file(stats, i, &job->fs);
+	}
+
+	wpool_destroy(pool);
+	pool = NULL;
+	rc = EOK;
+error:
+	if (pool != NULL)
+		wpool_destroy(pool);
+	if (par.job != NULL) {
+		for (i = 0; i < flist->nentries; i++) {
+			free(par.job[i].out);
+			free(par.job[i].err);
+		}
+	}
+
+	if (par.diags != NULL) {
+		for (w = 0; w < njobs; w++)
+			diag_list_fini(&par.diags[w]);
+	}
+
+	free(par.job);
+	free(par.sched);
+	free(par.diags);
+	pthread_cond_destroy(&par.done_cv);
+	pthread_mutex_destroy(&par.lock);
+	return rc;
+}
+
+/** Print summary of checking a list of files.
+ *
+ * Print whether all files passed, followed by statistics if they did not.
+ *
+ * @param opts Options
+ * @param stats Statistics
+ * @return EOK if all files passed, EINVAL otherwise
+ */
+static int check_stats_print(check_opts_t *opts, check_stats_t *stats)
+{
+	if (stats->srepcnt == 0 && stats->fcnt == 0) {
+		fprintf(opts->outf, "Ccheck passed.\n");
+		return EOK;
+	}
+
+	fprintf(opts->outf, "Ccheck failed.\n");
+	fprintf(opts->outf, "Checked files with issues: %u\n", stats->srepcnt);
+	fprintf(opts->outf, "Checked files without issues: %u\n",
+	    stats->snorepcnt);
+	fprintf(opts->outf, "Files with parse errors: %u\n", stats->fcnt);
+	return EINVAL;
+}
+
+/** Compare files by wall time for sorting (slowest first).
+ *
+ * @param a Pointer to first entry (uint64_t * pointing into wall times)
+ * @param b Pointer to second entry (uint64_t * pointing into wall times)
+ * @return Less than, equal to or greater than zero
+ */
+static int check_slowest_cmp(const void *a, const void *b)
+{
+	uint64_t *wa = *(uint64_t **) a;
+	uint64_t *wb = *(uint64_t **) b;
+
+	if (*wa != *wb)
+		return *wa > *wb ? -1 : 1;
+
+	/* Keep list order among files with the same time */
+	return wa < wb ? -1 : (wa > wb ? 1 : 0);
+}
+
+/** Print total statistics of checking a list of files (--stats).
+ *
+ * @param opts Options
+ * @param flist File list
+ * @param stats Statistics
+ * @param elapsed Elapsed wall time in nanoseconds
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int check_stats_print_total(check_opts_t *opts, flist_t *flist,
+    check_stats_t *stats, uint64_t elapsed)
+{
+	checker_stats_t *tcs = &stats->total.cs;
+	FILE *f = opts->errf;
+	uint64_t **slow;
+	uint64_t wall = 0;
+	uint64_t cpu = 0;
+	checker_phase_t ph;
+	size_t i, n;
+
+	fprintf(f, "Statistics for %zu files (%.3f ms elapsed):\n",
+	    stats->nfiles, elapsed / 1e6);
+	fprintf(f, "  %-10s %12s %12s\n", "Phase", "Wall [ms]", "CPU [ms]");
+	for (ph = 0; ph < cph_limit; ph++) {
+		fprintf(f, "  %-10s %12.3f %12.3f\n", checker_phase_str(ph),
+		    tcs->wall[ph] / 1e6, tcs->cpu[ph] / 1e6);
+		wall += tcs->wall[ph];
+		cpu += tcs->cpu[ph];
+	}
+
+	fprintf(f, "  %-10s %12.3f %12.3f\n", "total", wall / 1e6, cpu / 1e6);
+	fprintf(f, "  Bytes read: %zu\n", tcs->nbytes);
+	fprintf(f, "  Tokens: %zu\n", tcs->ntoks);
+	fprintf(f, "  Tokens read by parser: %zu\n", tcs->nptoks);
+	fprintf(f, "  Tokens visited by checker: %zu\n", tcs->nvisits);
+	if (alloc_track_enabled()) {
+		fprintf(f, "  AST nodes: %zu\n", tcs->nnodes);
+		fprintf(f, "  Peak memory (largest file) [KiB]:");
+		for (ph = 0; ph < cph_limit; ph++) {
+			fprintf(f, " %s %zu", checker_phase_str(ph),
+			    tcs->peak[ph] / 1024);
+		}
+
+		fprintf(f, "\n");
+	}
+	fprintf(f, "  Issues:");
+	check_issues_print(stats->total.nissues, f);
+	fprintf(f, "\n");
+
+	if (flist->nentries < 2)
+		return EOK;
+
+	slow = calloc(flist->nentries, sizeof(uint64_t *));
+	if (slow == NULL)
+		return ENOMEM;
+
+	for (i = 0; i < flist->nentries; i++)
+		slow[i] = &stats->fwall[i];
+
+	qsort(slow, flist->nentries, sizeof(uint64_t *), check_slowest_cmp);
+
+	n = flist->nentries;
+	if (n > check_stats_slowest)
+		n = check_stats_slowest;
+
+	fprintf(f, "Slowest files (wall time):\n");
+	for (i = 0; i < n; i++) {
+		fprintf(f, "  %12.3f ms  %s\n", *slow[i] / 1e6,
+		    flist->entry[slow[i] - stats->fwall].path);
+	}
+
+	free(slow);
+	return EOK;
+}
+
+/** Get current wall clock time.
+ *
+ * @return Time in nanoseconds
+ */
+static uint64_t check_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/** Check all files in a file list.
+ *
+ * If @a summary is @c true, print a summary line stating whether all
+ * files passed, followed by statistics if they did not.
+ *
+ * @param opts Options
+ * @param flist File list
+ * @param summary @c true to print summary
+ * @return EOK if all files were checked (and, with @a summary, no issues
+ *         were found), error code otherwise
+ */
+static int check_files(check_opts_t *opts, flist_t *flist, bool summary)
+{
+	check_stats_t stats;
+	unsigned njobs;
+	uint64_t t0 = 0;
+	int rc;
+
+	memset(&stats, 0, sizeof(stats));
+	stats.rc = EOK;
+
+	if (opts->stats) {
+		stats.fwall = calloc(flist->nentries + 1, sizeof(uint64_t));
+		if (stats.fwall == NULL) {
+			fprintf(opts->errf, "Out of memory.\n");
+			return ENOMEM;
+		}
+
+		t0 = check_now();
+	}
+
+	njobs = opts->njobs;
+	if (njobs > flist->nentries)
+		njobs = flist->nentries;
+
+	if (njobs > 1) {
+		rc = check_files_par(opts, flist, njobs, &stats);
+		if (rc != EOK) {
+			fprintf(opts->errf, "Out of memory.\n");
+			free(stats.fwall);
+			return rc;
+		}
+	} else {
+		check_files_serial(opts, flist, &stats);
+	}
+
+	if (opts->stats) {
+		rc = check_stats_print_total(opts, flist, &stats,
+		    check_now() - t0);
+		free(stats.fwall);
+		if (rc != EOK) {
+			fprintf(opts->errf, "Out of memory.\n");
+			return rc;
+		}
+	}
+
+	if (!summary)
+		return stats.rc;
+
+	return check_stats_print(opts, &stats);
+}
+
+/** Remove files ignored by configuration files from file list.
+ *
+ * @param opts Options
+ * @param flist File list
+ * @return EOK on success or error code (files that could not be looked
+ *         up are kept)
+ */
+static int check_pconf_flist(check_opts_t *opts, flist_t *flist)
+{
+	pconf_file_t pf;
+	size_t i, n;
+	int rc = EOK;
+
+	if (opts->pconf == NULL)
+		return EOK;
+
+	n = 0;
+	for (i = 0; i < flist->nentries; i++) {
+		if (rc == EOK)
+			rc = pconf_file(opts->pconf, flist->entry[i].path, &pf);
+
+		if (rc == EOK && pf.ignore)
+			free(flist->entry[i].path);
+		else
+			flist->entry[n++] = flist->entry[i];
+	}
+
+	flist->nentries = n;
+	return rc;
+}
+
+/** Check a single file, re-using the state of its previous check.
+ *
+ * @param opts Options
+ * @param mcache Module cache
+ * @param fname File name
+ * @param diags Diagnostic list to collect issues in (must be empty)
+ * @return EOK on success (regardless whether issues are found), error code
+ *         if the file could not be checked
+ */
+static int check_watch_file(check_opts_t *opts, mcache_t *mcache,
+    const char *fname, diag_list_t *diags)
+{
+	checker_cfg_t *cfg;
+	checker_mtype_t mtype;
+	char *buf;
+	size_t size;
+	int rc;
+
+	rc = check_file_cfg(opts, fname, &cfg, &mtype, opts->errf);
+	if (rc != EOK)
+		return rc;
+
+	rc = check_read_file(opts, fname, &buf, &size, opts->errf);
+	if (rc != EOK)
+		return rc;
+
+	rc = mcache_check(mcache, fname, mtype, cfg, buf, size, diags,
+	    opts->errf);
+	free(buf);
+	if (rc != EOK)
+		return rc;
+
+	diag_list_sort(diags);
+
+	rc = check_baseline(opts, diags);
+	if (rc != EOK)
+		return rc;
+
+	return diag_list_print(diags, opts->fmt, opts->outf);
+}
+
+/** Check changed files in watch mode and print summary.
+ *
+ * Files that no longer exist are dropped from the module cache.
+ *
+ * @param opts Options
+ * @param mcache Module cache
+ * @param flist Changed files
+ */
+static void check_watch_files(check_opts_t *opts, mcache_t *mcache,
+    flist_t *flist)
+{
+	check_stats_t stats;
+	diag_list_t diags;
+	const char *fname;
+	size_t i;
+	int rc;
+
+	memset(&stats, 0, sizeof(stats));
+	stats.rc = EOK;
+	diag_list_init(&diags);
+
+	/* Files that cannot be looked up fail below */
+	(void) check_pconf_flist(opts, flist);
+
+	for (i = 0; i < flist->nentries; i++) {
+		fname = flist->entry[i].path;
+		if (faccessat(opts->dirfd, fname, F_OK, 0) < 0 &&
+		    errno == ENOENT) {
+			/* File was removed */
+			mcache_remove(mcache, fname);
+			continue;
+		}
+
+		rc = check_watch_file(opts, mcache, fname, &diags);
+		check_stats_add(&stats, rc, diags.ndiags > 0);
+		diag_list_clear(&diags);
+	}
+
+	diag_list_fini(&diags);
+
+	if (stats.srepcnt + stats.snorepcnt + stats.fcnt > 0)
+		(void) check_stats_print(opts, &stats);
+	fflush(opts->outf);
+}
+
+/** Check files and keep checking them as they change.
+ *
+ * All files are checked first. Then, whenever source files in the watched
+ * directories change, only the changed files are checked again and their
+ * diagnostics are printed, followed by a summary. Checked files are kept
+ * in memory so that only the changed declarations need to be checked
+ * again. This only returns on error.
+ *
+ * @param opts Options
+ * @param flist Files to check initially
+ * @param dirs Directories to watch
+ * @param ndirs Number of directories to watch
+ * @param max_mem Limit for memory used by checked files kept in memory
+ * @return Error code
+ */
+static int check_watch(check_opts_t *opts, flist_t *flist, char **dirs,
+    int ndirs, uint64_t max_mem)
+{
+	watch_t *watch = NULL;
+	mcache_t *mcache = NULL;
+	flist_t *changed = NULL;
+	int i;
+	int rc;
+
+	rc = watch_create(opts->errf, &watch);
+	if (rc != EOK)
+		goto error;
+
+	/* Start watching before the initial check so no change is missed */
+	for (i = 0; i < ndirs; i++) {
+		rc = watch_add_dir(watch, dirs[i]);
+		if (rc != EOK)
+			goto error;
+	}
+
+	rc = mcache_create(max_mem, &mcache);
+	if (rc != EOK)
+		goto error;
+
+	if (check_fps(opts))
+		mcache_set_fps(mcache);
+
+	check_watch_files(opts, mcache, flist);
+
+	while (true) {
+		rc = flist_create(opts->dirfd, opts->errf, &changed);
+		if (rc != EOK)
+			goto error;
+
+		rc = watch_wait(watch, changed);
+		if (rc != EOK)
+			goto error;
+
+		check_watch_files(opts, mcache, changed);
+		flist_destroy(changed);
+		changed = NULL;
+	}
+
+error:
+	if (rc == ENOMEM)
+		fprintf(opts->errf, "Out of memory.\n");
+	flist_destroy(changed);
+	mcache_destroy(mcache);
+	watch_destroy(watch);
+	return rc;
+}
+
+/** Parse output format name.
+ *
+ * @param name Format name
+ * @param rfmt Place to store output format
+ * @param errf Output stream for errors
+ *
+ * @return EOK on success, EINVAL if no such format exists
+ */
+static int parse_format(const char *name, diag_fmt_t *rfmt, FILE *errf)
+{
+	if (strcmp(name, "text") == 0) {
+		*rfmt = dfmt_text;
+	} else if (strcmp(name, "jsonl") == 0) {
+		*rfmt = dfmt_jsonl;
+	} else if (strcmp(name, "bin") == 0) {
+		*rfmt = dfmt_bin;
+	} else {
+		fprintf(errf, "Invalid output format '%s'.\n", name);
+		return EINVAL;
+	}
+
+	return EOK;
+}
+
+/** Parse number of parallel jobs.
+ *
+ * @param str Number of jobs as string
+ * @param rnjobs Place to store number of jobs
+ * @param errf Output stream for errors
+ *
+ * @return EOK on success, EINVAL if @a str is not a valid number
+ */
+static int parse_njobs(const char *str, unsigned *rnjobs, FILE *errf)
+{
+	unsigned long n;
+	long ncpus;
+	char *end;
+
+	n = strtoul(str, &end, 10);
+	if (*str == '\0' || *end != '\0' || n > check_max_jobs) {
+		fprintf(errf, "Invalid number of jobs '%s'.\n", str);
+		return EINVAL;
+	}
+
+	if (n == 0) {
+		ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+		n = ncpus > 0 ? (unsigned long) ncpus : 1;
+	}
+
+	*rnjobs = n;
+	return EOK;
+}
+
+/** Parse unsigned number.
+ *
+ * @param str Number as string
+ * @param what What the number is (for error message)
+ * @param max Maximum allowed value
+ * @param rval Place to store number
+ * @param errf Output stream for errors
+ *
+ * @return EOK on success, EINVAL if @a str is not a valid number
+ */
+static int parse_uint(const char *str, const char *what, unsigned max,
+    unsigned *rval, FILE *errf)
+{
+	unsigned long n;
+	char *end;
+
+	n = strtoul(str, &end, 10);
+	if (*str == '\0' || *end != '\0' || n > max) {
+		fprintf(errf, "Invalid %s '%s'.\n", what, str);
+		return EINVAL;
+	}
+
+	*rval = n;
+	return EOK;
+}
+
+/** Parse size in MiB.
+ *
+ * @param str Size in MiB as string
+ * @param what What the size is of (for error message)
+ * @param rsize Place to store size in bytes
+ * @param errf Output stream for errors
+ *
+ * @return EOK on success, EINVAL if @a str is not a valid size
+ */
+static int parse_size_mib(const char *str, const char *what, uint64_t *rsize,
+    FILE *errf)
 {
-	printf("C-style checker\n");
-	printf("syntax:\n"
-	    "\tccheck [options] <file> Check C-style in the specified file\n"
-	    "\tccheck --test Run internal unit tests\n"
-	    "options:\n"
-	    "\t--fix Attempt to fix issues instead of just reporting them\n"
-	    "\t--dump-ast Dump internal abstract syntax tree\n"
-	    "\t--dump-toks Dump tokenized source file\n"
-	    "\t-d <check> Disable a particular group of checks\n"
-	    "\t  (decl, estmt, fmt, hdr, invchar, loop, sclass)\n");
+	unsigned long n;
+	char *end;
+
+	n = strtoul(str, &end, 10);
+	if (*str == '\0' || *end != '\0' || n == 0 ||
+	    n > check_max_cache_size) {
+		fprintf(errf, "Invalid %s size '%s'.\n", what, str);
+		return EINVAL;
+	}
+
+	*rsize = (uint64_t) n * 1024 * 1024;
+	return EOK;
+}
+
+/** Disable a check group in configuration based on check name.
+ *
+ * @param cfg Configuration to alter
+ * @param check_name Name of check to disable
+ * @param errf Output stream for errors
+ *
+ * @return EOK on success, EINVAL if no such check exists
+ */
+static int check_disable(checker_cfg_t *cfg, const char *check_name,
+    FILE *errf)
+{
+	if (strcmp(check_name, "decl") == 0) {
+		cfg->decl = false;
+	} else if (strcmp(check_name, "estmt") == 0) {
+		cfg->estmt = false;
+	} else if (strcmp(check_name, "fmt") == 0) {
+		cfg->fmt = false;
+	} else if (strcmp(check_name, "hdr") == 0) {
+		cfg->hdr = false;
+	} else if (strcmp(check_name, "invchar") == 0) {
+		cfg->invchar = false;
+	} else if (strcmp(check_name, "loop") == 0) {
+		cfg->loop = false;
+	} else if (strcmp(check_name, "nblock") == 0) {
+		cfg->nblock = false;
+	} else if (strcmp(check_name, "sclass") == 0) {
+		cfg->sclass = false;
+	} else {
+		fprintf(errf, "Invalid check name '%s'.\n", check_name);
+		return EINVAL;
+	}
+
+	return EOK;
 }
 
-static int check_file(const char *fname, checker_flags_t flags,
-    checker_cfg_t *cfg)
+/** Run tests.
+ *
+ * @return EOK
+ */
+static int run_tests(void)
 {
 	int rc;
-	checker_t *checker = NULL;
-	checker_mtype_t mtype;
-	char *bkname;
-	const char *ext;
-	file_input_t finput;
-	FILE *f = NULL;
 
-	ext = strrchr(fname, '.');
-	if (ext == NULL) {
-		fprintf(stderr, "File '%s' has no extension.\n", fname);
+	rc = test_lexer();
+	printf("test_lexer -> %d\n", rc);
+
+	rc = test_ast();
+	printf("test_ast -> %d\n", rc);
+
+	rc = test_parser();
+	printf("test_parser -> %d\n", rc);
+
+	rc = test_checker();
+	printf("test_checker -> %d\n", rc);
+
+	rc = test_diag();
+	printf("test_diag -> %d\n", rc);
+
+	rc = test_wpool();
+	printf("test_wpool -> %d\n", rc);
+
+	rc = test_rcache();
+	printf("test_rcache -> %d\n", rc);
+
+	rc = test_mcache();
+	printf("test_mcache -> %d\n", rc);
+
+	rc = test_lfilter();
+	printf("test_lfilter -> %d\n", rc);
+
+	rc = test_baseline();
+	printf("test_baseline -> %d\n", rc);
+
+	rc = test_pconf();
+	printf("test_pconf -> %d\n", rc);
+
+	rc = test_sycek();
+	printf("test_sycek -> %d\n", rc);
+
+	return EOK;
+}
+
+/** Determine if path refers to a directory.
+ *
+ * @param path Path
+ * @return @c true iff @a path exists and is a directory
+ */
+static bool check_is_dir(const char *path)
+{
+	struct stat st;
+
+	return stat(path, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+/** Restrict file list to files with line ranges to check.
+ *
+ * If no files were specified, all C source and header files with line
+ * ranges to check are added. Otherwise only specified files that have
+ * line ranges to check are kept.
+ *
+ * @param lfilter Line filter
+ * @param flist File list
+ * @param add @c true if no files were specified
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int check_lfilter_flist(lfilter_t *lfilter, flist_t *flist,
+    bool add)
+{
+	size_t i, n;
+	int rc;
+
+	if (add) {
+		for (i = 0; i < lfilter->nfiles; i++) {
+			if (!flist_is_src_name(lfilter->file[i].fname))
+				continue;
+
+			rc = flist_add_path(flist, lfilter->file[i].fname);
+			if (rc != EOK)
+				return rc;
+		}
+
+		return EOK;
+	}
+
+	n = 0;
+	for (i = 0; i < flist->nentries; i++) {
+		if (lfilter_find(lfilter, flist->entry[i].path) != NULL)
+			flist->entry[n++] = flist->entry[i];
+		else
+			free(flist->entry[i].path);
+	}
+
+	flist->nentries = n;
+	return EOK;
+}
+
+/** Resolve path relative to the requester's working directory.
+ *
+ * @param req Request
+ * @param path Path
+ * @param rpath Place to store pointer to newly allocated resolved path
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int check_req_path(server_req_t *req, const char *path, char **rpath)
+{
+	char *p;
+
+	if (req->cwd != NULL && path[0] != '/') {
+		if (asprintf(&p, "%s/%s", req->cwd, path) < 0)
+			return ENOMEM;
+	} else {
+		p = strdup(path);
+		if (p == NULL)
+			return ENOMEM;
+	}
+
+	*rpath = p;
+	return EOK;
+}
+
+/** Check files according to command-line arguments.
+ *
+ * This is used both for the command line and for requests received
+ * by the check server.
+ *
+ * @param req Request (arguments, working directory and I/O streams)
+ * @return EOK on success, error code on failure (non-zero exit status)
+ */
+static int ccheck_main(server_req_t *req)
+{
+	int argc = req->argc;
+	char **argv = req->argv;
+	FILE *errf = req->errf;
+	int rc;
+	int i;
+	check_opts_t opts;
+	flist_t *flist = NULL;
+	const char *stdin_name = NULL;
+	const char *cache_dir = NULL;
+	char *cache_path = NULL;
+	uint64_t cache_size = check_cache_def_size;
+	uint64_t watch_mem = (uint64_t) check_watch_def_mem * 1024 * 1024;
+	bool watch = false;
+	bool no_config = false;
+	const char *git_rev = NULL;
+	const char *bl_path = NULL;
+	const char *wbl_path = NULL;
+	char *bl_rpath = NULL;
+	char *wbl_rpath = NULL;
+	const char *trace_path = NULL;
+	char *trace_rpath = NULL;
+	bool summary;
+	int first;
+
+	memset(&opts, 0, sizeof(opts));
+	checker_cfg_init(&opts.cfg);
+	opts.fmt = dfmt_text;
+	opts.backup = true;
+	opts.njobs = 1;
+	opts.dirfd = req->dirfd;
+	opts.outf = req->outf;
+	opts.errf = req->errf;
+
+	i = 1;
+	while (argc > i && argv[i][0] == '-') {
+		if (strcmp(argv[i], "--fix") == 0) {
+			++i;
+			opts.flags |= cf_fix;
+		} else if (strcmp(argv[i], "--diff") == 0) {
+			++i;
+			opts.diff = true;
+		} else if (strcmp(argv[i], "--no-backup") == 0) {
+			++i;
+			opts.backup = false;
+		} else if (strcmp(argv[i], "--dump-ast") == 0) {
+			++i;
+			opts.flags |= cf_dump_ast;
+		} else if (strcmp(argv[i], "--dump-toks") == 0) {
+			++i;
+			opts.flags |= cf_dump_toks;
+		} else if (strncmp(argv[i], "--format=", 9) == 0) {
+			rc = parse_format(argv[i] + 9, &opts.fmt, errf);
+			if (rc != EOK)
+				goto error;
+			++i;
+		} else if (strncmp(argv[i], "--cache=", 8) == 0) {
+			cache_dir = argv[i] + 8;
+			++i;
+		} else if (strncmp(argv[i], "--cache-size=", 13) == 0) {
+			rc = parse_size_mib(argv[i] + 13, "cache", &cache_size,
+			    errf);
+			if (rc != EOK)
+				goto error;
+			++i;
+		} else if (strcmp(argv[i], "--watch") == 0) {
+			++i;
+			watch = true;
+		} else if (strcmp(argv[i], "--no-config") == 0) {
+			++i;
+			no_config = true;
+		} else if (strcmp(argv[i], "--stats") == 0) {
+			++i;
+			opts.stats = true;
+
+			/*
+			 * Tracking must be enabled before the first allocation,
+			 * which is not possible in the server.
+			 */
+			if (req->cwd == NULL)
+				alloc_track_enable();
+		} else if (strncmp(argv[i], "--trace=", 8) == 0) {
+			trace_path = argv[i] + 8;
+			++i;
+		} else if (strcmp(argv[i], "--fail-fast") == 0) {
+			++i;
+			opts.max_issues = 1;
+		} else if (strncmp(argv[i], "--max-issues=", 13) == 0) {
+			rc = parse_uint(argv[i] + 13, "number of issues",
+			    UINT_MAX, &opts.max_issues, errf);
+			if (rc != EOK)
+				goto error;
+			++i;
+		} else if (strncmp(argv[i], "--watch-mem=", 12) == 0) {
+			rc = parse_size_mib(argv[i] + 12, "memory", &watch_mem,
+			    errf);
+			if (rc != EOK)
+				goto error;
+			++i;
+		} else if (strncmp(argv[i], "--baseline=", 11) == 0) {
+			bl_path = argv[i] + 11;
+			++i;
+		} else if (strncmp(argv[i], "--write-baseline=", 17) == 0) {
+			wbl_path = argv[i] + 17;
+			++i;
+		} else if (strncmp(argv[i], "--stdin=", 8) == 0) {
+			stdin_name = argv[i] + 8;
+			++i;
+		} else if (strcmp(argv[i], "-j") == 0) {
+			++i;
+			if (argc <= i) {
+				fprintf(errf, "Option '-j' needs an "
+				    "argument.\n");
+				rc = EINVAL;
+				goto error;
+			}
+
+			rc = parse_njobs(argv[i], &opts.njobs, errf);
+			if (rc != EOK)
+				goto error;
+			++i;
+		} else if (strncmp(argv[i], "-j", 2) == 0) {
+			rc = parse_njobs(argv[i] + 2, &opts.njobs, errf);
+			if (rc != EOK)
+				goto error;
+			++i;
+		} else if (strcmp(argv[i], "--lines") == 0) {
+			++i;
+			if (argc <= i) {
+				fprintf(errf, "Option '--lines' needs an "
+				    "argument.\n");
+				rc = EINVAL;
+				goto error;
+			}
+
+			if (opts.lfilter == NULL) {
+				rc = lfilter_create(&opts.lfilter);
+				if (rc != EOK)
+					goto error;
+			}
+
+			rc = lfilter_parse_spec(opts.lfilter, argv[i], errf);
+			if (rc != EOK)
+				goto error;
+			++i;
+		} else if (strcmp(argv[i], "--git-diff") == 0) {
+			++i;
+			if (argc <= i) {
+				fprintf(errf, "Option '--git-diff' needs an "
+				    "argument.\n");
+				rc = EINVAL;
+				goto error;
+			}
+
+			git_rev = argv[i];
+			++i;
+		} else if (strcmp(argv[i], "-") == 0) {
+			++i;
+			break;
+		} else if (strcmp(argv[i], "-d") == 0) {
+			++i;
+			if (argc <= i) {
+				fprintf(errf, "Option '-d' needs an "
+				    "argument.\n");
+				rc = EINVAL;
+				goto error;
+			}
+
+			rc = check_disable(&opts.cfg, argv[i], errf);
+			if (rc != EOK)
+				goto error;
+			++i;
+		} else {
+			fprintf(errf, "Invalid option.\n");
+			rc = EINVAL;
+			goto error;
+		}
+	}
+
+	if (opts.diff && (opts.flags & cf_fix) == 0) {
+		fprintf(errf, "Option '--diff' requires '--fix'.\n");
 		rc = EINVAL;
 		goto error;
 	}
 
-	if (strcmp(ext, ".c") == 0 || strcmp(ext, ".C") == 0) {
-		mtype = cmod_c;
-	} else if (strcmp(ext, ".h") == 0 || strcmp(ext, ".H") == 0) {
-		mtype = cmod_header;
-	} else {
-		fprintf(stderr, "Unknown file extension '%s'.\n", ext);
+	if (opts.max_issues != 0 && ((opts.flags & cf_fix) != 0 ||
+	    bl_path != NULL || wbl_path != NULL)) {
+		fprintf(errf, "Options '--fail-fast' and '--max-issues' cannot "
+		    "be combined with '--fix', '--baseline' or "
+		    "'--write-baseline'.\n");
 		rc = EINVAL;
 		goto error;
 	}
 
-	f = fopen(fname, "rt");
-	if (f == NULL) {
-		fprintf(stderr, "Cannot open '%s'.\n", fname);
-		rc = ENOENT;
+	if (stdin_name != NULL) {
+		if (argc > i || ((opts.flags & cf_fix) != 0 && !opts.diff)) {
+			fprintf(errf, "Option '--stdin' cannot be combined "
+			    "with file arguments or '--fix' (without "
+			    "'--diff').\n");
+			rc = EINVAL;
+			goto error;
+		}
+	} else if (argc <= i && opts.lfilter == NULL && git_rev == NULL) {
+		fprintf(errf, "Argument missing.\n");
+		rc = EINVAL;
 		goto error;
 	}
 
-	file_input_init(&finput, f, fname);
+	if (watch) {
+		if (stdin_name != NULL || cache_dir != NULL ||
+		    opts.lfilter != NULL || git_rev != NULL ||
+		    wbl_path != NULL || opts.stats || trace_path != NULL ||
+		    opts.max_issues != 0 ||
+		    (opts.flags & (cf_fix | cf_dump_ast | cf_dump_toks)) != 0) {
+			fprintf(errf, "Option '--watch' cannot be combined "
+			    "with '--stdin', '--cache', '--fix', '--lines', "
+			    "'--git-diff', '--write-baseline', '--stats', "
+			    "'--trace', '--fail-fast', '--max-issues' or "
+			    "dumping.\n");
+			rc = EINVAL;
+			goto error;
+		}
+
+		/* The request would never finish */
+		if (req->cwd != NULL) {
+			fprintf(errf, "Option '--watch' is not supported "
+			    "by the check server.\n");
+			rc = EINVAL;
+			goto error;
+		}
+
+		for (first = i; first < argc; first++) {
+			if (!check_is_dir(argv[first])) {
+				fprintf(errf, "Option '--watch' needs "
+				    "directory arguments, '%s' is not a "
+				    "directory.\n", argv[first]);
+				rc = EINVAL;
+				goto error;
+			}
+		}
+	}
 
-	rc = checker_create(&lexer_file_input, &finput, mtype, cfg, &checker);
+	rc = flist_create(req->dirfd, errf, &flist);
 	if (rc != EOK)
 		goto error;
 
-	if ((flags & cf_dump_ast) != 0) {
-		rc = checker_dump_ast(checker, stdout);
-		if (rc != EOK)
+	if (stdin_name != NULL) {
+		rc = check_read_all(req->inf, &opts.inbuf, &opts.inbuf_size);
+		if (rc != EOK) {
+			fprintf(errf, "Error reading standard input.\n");
 			goto error;
+		}
 
-		printf("\n");
+		rc = flist_add_file(flist, stdin_name, opts.inbuf_size);
+		if (rc != EOK)
+			goto error;
 	}
 
-	if ((flags & cf_dump_toks) != 0) {
-		rc = checker_dump_toks(checker, stdout);
+	/* Print summary when checking more than a single file */
+	summary = argc - i > 1;
+	first = i;
+
+	while (argc > i) {
+		rc = flist_add_path(flist, argv[i]);
 		if (rc != EOK)
 			goto error;
 
-		printf("\n");
+		++i;
 	}
 
-	rc = checker_run(checker, (flags & cf_fix) != 0);
-	if (rc != EOK)
-		goto error;
+	if (git_rev != NULL) {
+		if (opts.lfilter == NULL) {
+			rc = lfilter_create(&opts.lfilter);
+			if (rc != EOK)
+				goto error;
+		}
 
-	fclose(f);
+		rc = lfilter_git_diff(opts.lfilter, req->cwd != NULL ?
+		    req->cwd : ".", git_rev, errf);
+		if (rc != EOK)
+			goto error;
+	}
 
-	if ((flags & cf_fix) != 0) {
-		if (asprintf(&bkname, "%s.orig", fname) < 0) {
-			rc = ENOMEM;
+	if (opts.lfilter != NULL) {
+		rc = check_lfilter_flist(opts.lfilter, flist,
+		    stdin_name == NULL && i == first);
+		if (rc != EOK)
+			goto error;
+
+		summary = flist->nentries > 1;
+	}
+
+	if (!no_config) {
+		rc = pconf_create(req->cwd, &opts.cfg, errf, &opts.pconf);
+		if (rc != EOK) {
+			if (rc == EIO)
+				fprintf(errf, "Cannot determine working "
+				    "directory.\n");
 			goto error;
 		}
 
-		if (rename(fname, bkname) < 0) {
-			fprintf(stderr, "Error renaming '%s' to '%s'.\n", fname,
-			    bkname);
-			rc = EIO;
+		rc = check_pconf_flist(&opts, flist);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if (flist->dirs)
+		summary = true;
+
+	/* Keep the output a valid patch */
+	if (opts.diff)
+		summary = false;
+
+	if (opts.fmt == dfmt_bin) {
+		rc = diag_bin_header(opts.outf);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if (bl_path != NULL) {
+		rc = check_req_path(req, bl_path, &bl_rpath);
+		if (rc != EOK)
+			goto error;
+
+		rc = baseline_open(bl_rpath, &opts.baseline);
+		if (rc != EOK) {
+			fprintf(errf, "Cannot open baseline '%s'.\n", bl_path);
 			goto error;
 		}
+	}
 
-		f = fopen(fname, "wt");
-		if (f == NULL) {
-			fprintf(stderr, "Cannot open '%s' for writing.\n", fname);
-			rc = EIO;
+	if (wbl_path != NULL) {
+		rc = check_req_path(req, wbl_path, &wbl_rpath);
+		if (rc != EOK)
+			goto error;
+
+		rc = baseline_wr_create(&opts.blwr);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if (cache_dir != NULL) {
+		rc = check_req_path(req, cache_dir, &cache_path);
+		if (rc != EOK)
+			goto error;
+
+		rc = rcache_open(cache_path, cache_size, &opts.rcache);
+		if (rc == ENOTSUP) {
+			/* The cache only saves time, check without it */
+			fprintf(errf, "Cannot identify ccheck binary, "
+			    "not using cache '%s'.\n", cache_dir);
+			opts.rcache = NULL;
+		} else if (rc != EOK) {
+			fprintf(errf, "Cannot open cache '%s'.\n", cache_dir);
 			goto error;
 		}
+	}
 
-		rc = checker_print(checker, f);
+	if (trace_path != NULL) {
+		rc = check_req_path(req, trace_path, &trace_rpath);
 		if (rc != EOK)
 			goto error;
 
-		if (fclose(f) < 0) {
-			fprintf(stderr, "Error writing '%s'.\n", fname);
-			rc = EIO;
+		rc = trace_create(trace_rpath, &opts.trace);
+		if (rc != EOK) {
+			fprintf(errf, "Cannot create trace '%s'.\n",
+			    trace_path);
 			goto error;
 		}
 	}
 
-	checker_destroy(checker);
+	if (watch)
+		rc = check_watch(&opts, flist, argv + first, argc - first,
+		    watch_mem);
+	else
+		rc = check_files(&opts, flist, summary);
 
-	return EOK;
+	if (opts.trace != NULL) {
+		if (trace_close(opts.trace) != EOK) {
+			fprintf(errf, "Cannot write trace '%s'.\n",
+			    trace_path);
+			rc = EIO;
+		}
+
+		opts.trace = NULL;
+	}
+
+	if (opts.blwr != NULL && (rc == EOK || rc == EINVAL)) {
+		/* Also if issues were found or files failed to parse */
+		if (baseline_wr_write(opts.blwr, wbl_rpath) != EOK) {
+			fprintf(errf, "Cannot write baseline '%s'.\n",
+			    wbl_path);
+			rc = EIO;
+		}
+	}
 error:
-	if (checker != NULL)
-		checker_destroy(checker);
-	if (f != NULL)
-		fclose(f);
+	(void) trace_close(opts.trace);
+	free(trace_rpath);
+	baseline_wr_destroy(opts.blwr);
+	baseline_close(opts.baseline);
+	free(bl_rpath);
+	free(wbl_rpath);
+	rcache_close(opts.rcache);
+	lfilter_destroy(opts.lfilter);
+	pconf_destroy(opts.pconf);
+	free(cache_path);
+	free(opts.inbuf);
+	flist_destroy(flist);
 	return rc;
 }
 
-/** Disable a check group in configuration based on check name.
+/** Run server request.
  *
- * @param cfg Configuration to alter
- * @param check_name Name of check to disable
+ * @param arg Not used
+ * @param req Request
+ * @return EOK on success, error code on failure (non-zero exit status)
+ */
+static int ccheck_server_run(void *arg, server_req_t *req)
+{
+	(void) arg;
+	return ccheck_main(req);
+}
+
+static server_ops_t ccheck_server_ops = {
+	.run = ccheck_server_run
+};
+
+/** Run check server.
  *
- * @return EOK on success, EINVAL if no such check exists
+ * @param argc Number of arguments
+ * @param argv Arguments (argv[1] is --server)
+ * @return EOK on success or error code
  */
-static int check_disable(checker_cfg_t *cfg, const char *check_name)
+static int ccheck_server(int argc, char *argv[])
 {
-	if (strcmp(check_name, "decl") == 0) {
-		cfg->decl = false;
-	} else if (strcmp(check_name, "estmt") == 0) {
-		cfg->estmt = false;
-	} else if (strcmp(check_name, "fmt") == 0) {
-		cfg->fmt = false;
-	} else if (strcmp(check_name, "hdr") == 0) {
-		cfg->hdr = false;
-	} else if (strcmp(check_name, "invchar") == 0) {
-		cfg->invchar = false;
-	} else if (strcmp(check_name, "loop") == 0) {
-		cfg->loop = false;
-	} else if (strcmp(check_name, "nblock") == 0) {
-		cfg->nblock = false;
-	} else if (strcmp(check_name, "sclass") == 0) {
-		cfg->sclass = false;
-	} else {
-		fprintf(stderr, "Invalid check name '%s'.\n", check_name);
+	unsigned nworkers = 0;
+	int rc;
+
+	if (argc == 5 && strcmp(argv[3], "-j") == 0) {
+		rc = parse_njobs(argv[4], &nworkers, stderr);
+		if (rc != EOK)
+			return rc;
+	} else if (argc != 3) {
+		print_syntax(stderr);
 		return EINVAL;
 	}
 
-	return EOK;
+	if (nworkers == 0)
+		(void) parse_njobs("0", &nworkers, stderr);
+
+	return server_run(argv[2], nworkers, &ccheck_server_ops, NULL);
 }
 
 int main(int argc, char *argv[])
 {
+	server_req_t req;
+	unsigned threshold;
+	unsigned niters;
+	unsigned seed;
+	int status;
 	int rc;
-	int i;
-	checker_flags_t flags = 0;
-	checker_cfg_t cfg;
-
-	checker_cfg_init(&cfg);
 
-	(void)argc;
-	(void)argv;
+	/* Diagnostics are written in bulk, use a large output buffer */
+	setvbuf(stdout, stdout_buf, _IOFBF, stdout_buf_size);
 
 	if (argc < 2) {
-		print_syntax();
+		print_syntax(stdout);
 		return 1;
 	}
 
-	if (argc == 2 && strcmp(argv[1], "--test") == 0) {
-		/* Run tests */
-		rc = test_lexer();
-		printf("test_lexer -> %d\n", rc);
-
-		rc = test_ast();
-		printf("test_ast -> %d\n", rc);
+	memset(&req, 0, sizeof(req));
+	req.dirfd = AT_FDCWD;
+	req.inf = stdin;
+	req.outf = stdout;
+	req.errf = stderr;
 
-		rc = test_parser();
-		printf("test_parser -> %d\n", rc);
+	if (argc == 2 && strcmp(argv[1], "--test") == 0) {
+		rc = run_tests();
+	} else if (argc == 3 && strcmp(argv[1], "--test-stress") == 0) {
+		rc = test_stress(argv[2]);
+	} else if (argc == 3 && strcmp(argv[1], "--test-alloc") == 0) {
+		rc = test_alloc(argv[2]);
+	} else if (argc == 3 && strcmp(argv[1], "--run-golden") == 0) {
+		rc = test_golden(argv[2]);
+	} else if (argc == 3 && strcmp(argv[1], "--bench-edit") == 0) {
+		rc = bench_edit(argv[2], stdout);
+	} else if ((argc == 2 || argc == 3) &&
+	    strcmp(argv[1], "--bench") == 0) {
+		rc = bench_run(argc == 3 ? argv[2] : NULL, stdout);
+	} else if (argc == 3 && strcmp(argv[1], "--bench-gen") == 0) {
+		rc = bench_gen(argv[2]);
+	} else if ((argc == 3 || argc == 4) &&
+	    strcmp(argv[1], "--bench-compare") == 0) {
+		threshold = check_bench_def_threshold;
+		rc = argc == 4 ? parse_uint(argv[3], "threshold",
+		    check_bench_max_threshold, &threshold, stderr) : EOK;
+		if (rc == EOK)
+			rc = bench_compare(argv[2], threshold, stdout);
+	} else if (argc >= 3 && argc <= 5 &&
+	    strcmp(argv[1], "--fuzz") == 0) {
+		niters = check_fuzz_def_iters;
+		seed = 1;
+		rc = argc >= 4 ? parse_uint(argv[3], "number of iterations",
+		    UINT_MAX, &niters, stderr) : EOK;
+		if (rc == EOK && argc == 5) {
+			rc = parse_uint(argv[4], "seed", UINT_MAX, &seed,
+			    stderr);
+		}
+		if (rc == EOK)
+			rc = fuzz_run(argv[2], niters, seed);
+	} else if (argc == 3 && strcmp(argv[1], "--test-complexity") == 0) {
+		rc = fuzz_test(argv[2]);
+	} else if (strcmp(argv[1], "--server") == 0) {
+		rc = ccheck_server(argc, argv);
+	} else if (strcmp(argv[1], "--client") == 0) {
+		if (argc < 3) {
+			print_syntax(stderr);
+			return 1;
+		}
 
-		rc = test_checker();
-		printf("test_checker -> %d\n", rc);
-	} else {
-		i = 1;
-		while (argc > i && argv[i][0] == '-') {
-			if (strcmp(argv[i], "--fix") == 0) {
-				++i;
-				flags |= cf_fix;
-			} else if (strcmp(argv[i], "--dump-ast") == 0) {
-				++i;
-				flags |= cf_dump_ast;
-			} else if (strcmp(argv[i], "--dump-toks") == 0) {
-				++i;
-				flags |= cf_dump_toks;
-			} else if (strcmp(argv[i], "-") == 0) {
-				++i;
-				break;
-			} else if (strcmp(argv[i], "-d") == 0) {
-				++i;
-				if (argc <= i) {
-					fprintf(stderr,
-					    "Option '-d' needs an argument.\n");
-					return 1;
-				}
-
-				rc = check_disable(&cfg, argv[i]);
-				if (rc != EOK)
-					return 1;
-				++i;
-			} else {
-				fprintf(stderr, "Invalid option.\n");
-				return 1;
-			}
+		/*
+		 * Arguments following the socket path are the same as for
+		 * ccheck, the socket path takes the place of argv[0].
+		 */
+		rc = client_run(argv[2], argc - 2, argv + 2, &status);
+		if (rc == EOK) {
+			fflush(stdout);
+			return status;
 		}
 
-		if (argc <= i) {
-			fprintf(stderr, "Argument missing.\n");
+		if (rc != ENOENT) {
+			fprintf(stderr, "Error communicating with server.\n");
 			return 1;
 		}
 
-		rc = check_file(argv[i], flags, &cfg);
+		/* Server not running, check in this process */
+		req.argc = argc - 2;
+		req.argv = argv + 2;
+		rc = ccheck_main(&req);
+	} else {
+		req.argc = argc;
+		req.argv = argv;
+		rc = ccheck_main(&req);
 	}
 
 	if (rc != EOK)
@@ -0,0 +1,367 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Module cache
+ *
+ * Checkers of recently checked modules are kept in memory in incremental
+ * mode. When a module is checked again, the new source text is compared
+ * with the text the checker state corresponds to and only the changed
+ * range is passed to checker_update(), so only declarations affected by
+ * the change are parsed and checked again.
+ *
+ * The memory used by an entry is estimated from the number of tokens
+ * in the module. When the estimate for all entries exceeds the limit,
+ * least recently used entries are evicted. A module that has been
+ * evicted is simply checked from scratch the next time.
+ */
+
+#include <adt/list.h>
+#include <buf_input.h>
+#include <checker.h>
+#include <diag.h>
+#include <lexer.h>
+#include <mcache.h>
+#include <merrno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+	/** Estimated memory used per token (including the AST) in bytes */
+	mcache_tok_mem = 448
+};
+
+/** Create module cache.
+ *
+ * @param max_mem Maximum estimated memory used by entries in bytes
+ * @param rmcache Place to store pointer to new module cache
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int mcache_create(size_t max_mem, mcache_t **rmcache)
+{
+	mcache_t *mcache;
+
+	mcache = calloc(1, sizeof(mcache_t));
+	if (mcache == NULL)
+		return ENOMEM;
+
+	list_initialize(&mcache->entries);
+	mcache->max_mem = max_mem;
+
+	*rmcache = mcache;
+	return EOK;
+}
+
+/** Compute fingerprints of reported diagnostics.
+ *
+ * Only affects modules that are not in the cache yet.
+ *
+ * @param mcache Module cache
+ */
+void mcache_set_fps(mcache_t *mcache)
+{
+	mcache->fps = true;
+}
+
+/** Destroy module cache entry.
+ *
+ * @param entry Module cache entry
+ */
+static void mcache_entry_destroy(mcache_entry_t *entry)
+{
+	if (link_used(&entry->lentries)) {
+		list_remove(&entry->lentries);
+		entry->mcache->mem -= entry->mem;
+	}
+
+	if (entry->checker != NULL)
+		checker_destroy(entry->checker);
+	free(entry->text);
+	free(entry->fname);
+	free(entry);
+}
+
+/** Destroy module cache.
+ *
+ * @param mcache Module cache
+ */
+void mcache_destroy(mcache_t *mcache)
+{
+	link_t *link;
+
+	if (mcache == NULL)
+		return;
+
+	while ((link = list_first(&mcache->entries)) != NULL) {
+		mcache_entry_destroy(list_get_instance(link, mcache_entry_t,
+		    lentries));
+	}
+
+	free(mcache);
+}
+
+/** Find module cache entry.
+ *
+ * @param mcache Module cache
+ * @param fname File name
+ * @return Entry or @c NULL if there is no entry for @a fname
+ */
+static mcache_entry_t *mcache_find(mcache_t *mcache, const char *fname)
+{
+	list_foreach(mcache->entries, lentries, mcache_entry_t, entry) {
+		if (strcmp(entry->fname, fname) == 0)
+			return entry;
+	}
+
+	return NULL;
+}
+
+/** Estimate memory used by module cache entry.
+ *
+ * @param entry Module cache entry
+ * @return Estimated memory used in bytes
+ */
+static size_t mcache_entry_mem(mcache_entry_t *entry)
+{
+	size_t ntoks;
+
+	ntoks = list_count(&entry->checker->mod->toks);
+	return sizeof(mcache_entry_t) + entry->size + ntoks * mcache_tok_mem;
+}
+
+/** Evict least recently used entries until cache fits in its limit.
+ *
+ * @param mcache Module cache
+ */
+static void mcache_evict(mcache_t *mcache)
+{
+	link_t *link;
+
+	while (mcache->mem > mcache->max_mem) {
+		link = list_last(&mcache->entries);
+		if (link == NULL)
+			break;
+
+		mcache_entry_destroy(list_get_instance(link, mcache_entry_t,
+		    lentries));
+	}
+}
+
+/** Create module cache entry and check the module from scratch.
+ *
+ * @param mcache Module cache
+ * @param fname File name
+ * @param mtype Module type
+ * @param cfg Checker configuration (must remain valid while the entry
+ *            exists)
+ * @param text Source text
+ * @param size Size of @a text in bytes
+ * @param diags Diagnostic list to collect issues in
+ * @param errf Output stream for errors
+ * @param rentry Place to store pointer to new entry
+ * @return EOK on success or error code
+ */
+static int mcache_entry_create(mcache_t *mcache, const char *fname,
+    checker_mtype_t mtype, checker_cfg_t *cfg, const char *text, size_t size,
+    diag_list_t *diags, FILE *errf, mcache_entry_t **rentry)
+{
+	mcache_entry_t *entry;
+	int rc;
+
+	entry = calloc(1, sizeof(mcache_entry_t));
+	if (entry == NULL)
+		return ENOMEM;
+
+	entry->mcache = mcache;
+	link_initialize(&entry->lentries);
+	entry->mtype = mtype;
+	entry->cfg = cfg;
+	entry->size = size;
+	entry->fname = strdup(fname);
+	/* One extra byte so that an empty text is not a null pointer */
+	entry->text = malloc(size + 1);
+	if (entry->fname == NULL || entry->text == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	memcpy(entry->text, text, size);
+
+	buf_input_init(&entry->binput, entry->text, size, entry->fname);
+
+	rc = checker_create(&lexer_buf_input, &entry->binput, mtype, cfg,
+	    &entry->checker);
+	if (rc != EOK)
+		goto error;
+
+	checker_set_incr(entry->checker);
+	if (mcache->fps)
+		checker_set_fps(entry->checker);
+	checker_set_sink(entry->checker, &diag_list_sink, diags);
+	checker_set_errf(entry->checker, errf);
+
+	rc = checker_run(entry->checker, false);
+	if (rc != EOK)
+		goto error;
+
+	*rentry = entry;
+	return EOK;
+error:
+	mcache_entry_destroy(entry);
+	return rc;
+}
+
+/** Update module cache entry to new source text and check the module.
+ *
+ * The changed range is determined as the part of the text between
+ * the longest common prefix and the longest common suffix of the old
+ * and new text.
+ *
+ * @param entry Module cache entry
+ * @param text New source text
+ * @param size Size of @a text in bytes
+ * @param diags Diagnostic list to collect issues in
+ * @param errf Output stream for errors
+ * @return EOK on success or error code
+ */
+static int mcache_entry_update(mcache_entry_t *entry, const char *text,
+    size_t size, diag_list_t *diags, FILE *errf)
+{
+	checker_edit_t edit;
+	size_t nedits;
+	size_t pfx, sfx;
+	size_t maxsfx;
+	char *ntext;
+	int rc;
+
+	pfx = 0;
+	while (pfx < entry->size && pfx < size && entry->text[pfx] == text[pfx])
+		++pfx;
+
+	maxsfx = (entry->size < size ? entry->size : size) - pfx;
+	sfx = 0;
+	while (sfx < maxsfx && entry->text[entry->size - 1 - sfx] ==
+	    text[size - 1 - sfx])
+		++sfx;
+
+	edit.pos = pfx;
+	edit.old_size = entry->size - pfx - sfx;
+	edit.new_size = size - pfx - sfx;
+	nedits = (edit.old_size != 0 || edit.new_size != 0) ? 1 : 0;
+
+	ntext = malloc(size + 1);
+	if (ntext == NULL)
+		return ENOMEM;
+
+	memcpy(ntext, text, size);
+
+	checker_set_sink(entry->checker, &diag_list_sink, diags);
+	checker_set_errf(entry->checker, errf);
+
+	rc = checker_update(entry->checker, ntext, size, &edit, nedits);
+	if (rc != EOK) {
+		free(ntext);
+		return rc;
+	}
+
+	free(entry->text);
+	entry->text = ntext;
+	entry->size = size;
+
+	return checker_run(entry->checker, false);
+}
+
+/** Check module, re-using the in-memory state of a previous check.
+ *
+ * If the module is in the cache, only the changed part is checked again.
+ * Otherwise the module is checked from scratch and added to the cache.
+ * If checking fails (e.g. due to a parse error), the module is removed
+ * from the cache.
+ *
+ * @param mcache Module cache
+ * @param fname File name
+ * @param mtype Module type
+ * @param cfg Checker configuration (must remain valid while the module
+ *            is in the cache)
+ * @param text Source text
+ * @param size Size of @a text in bytes
+ * @param diags Diagnostic list to collect issues in
+ * @param errf Output stream for errors
+ * @return EOK on success (regardless whether issues are found), error code
+ *         if the module could not be checked
+ */
+int mcache_check(mcache_t *mcache, const char *fname, checker_mtype_t mtype,
+    checker_cfg_t *cfg, const char *text, size_t size, diag_list_t *diags,
+    FILE *errf)
+{
+	mcache_entry_t *entry;
+	int rc;
+
+	entry = mcache_find(mcache, fname);
+	if (entry != NULL && (entry->mtype != mtype || entry->cfg != cfg)) {
+		mcache_entry_destroy(entry);
+		entry = NULL;
+	}
+
+	if (entry != NULL) {
+		list_remove(&entry->lentries);
+		mcache->mem -= entry->mem;
+
+		rc = mcache_entry_update(entry, text, size, diags, errf);
+		if (rc != EOK) {
+			mcache_entry_destroy(entry);
+			return rc;
+		}
+	} else {
+		rc = mcache_entry_create(mcache, fname, mtype, cfg, text,
+		    size, diags, errf, &entry);
+		if (rc != EOK)
+			return rc;
+	}
+
+	/* Stop diverting diagnostics to the caller's list */
+	checker_set_sink(entry->checker, &diag_list_sink,
+	    &entry->checker->diags);
+	checker_set_errf(entry->checker, stderr);
+
+	entry->mem = mcache_entry_mem(entry);
+	list_prepend(&entry->lentries, &mcache->entries);
+	mcache->mem += entry->mem;
+
+	mcache_evict(mcache);
+	return EOK;
+}
+
+/** Remove module from module cache.
+ *
+ * @param mcache Module cache
+ * @param fname File name
+ */
+void mcache_remove(mcache_t *mcache, const char *fname)
+{
+	mcache_entry_t *entry;
+
+	entry = mcache_find(mcache, fname);
+	if (entry != NULL)
+		mcache_entry_destroy(entry);
+}
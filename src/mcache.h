@@ -0,0 +1,39 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MCACHE_H
+#define MCACHE_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include <types/checker.h>
+#include <types/diag.h>
+#include <types/mcache.h>
+
+extern int mcache_create(size_t, mcache_t **);
+extern void mcache_set_fps(mcache_t *);
+extern void mcache_destroy(mcache_t *);
+extern int mcache_check(mcache_t *, const char *, checker_mtype_t,
+    checker_cfg_t *, const char *, size_t, diag_list_t *, FILE *);
+extern void mcache_remove(mcache_t *, const char *);
+
+#endif
@@ -24,6 +24,7 @@
  * Parser
  */
 
+#include <alloc.h>
 #include <assert.h>
 #include <ast.h>
 #include <parser.h>
@@ -73,7 +74,7 @@ int parser_create(parser_input_ops_t *ops, void *arg, void *tok,
 {
 	parser_t *parser;
 
-	parser = calloc(1, sizeof(parser_t));
+	parser = alloc_calloc(as_parser, 1, sizeof(parser_t));
 	if (parser == NULL)
 		return ENOMEM;
 
@@ -81,6 +82,7 @@ int parser_create(parser_input_ops_t *ops, void *arg, void *tok,
 	parser->input_arg = arg;
 	parser->indlvl = indlvl;
 	parser->seccont = seccont;
+	parser->errf = stderr;
 
 	parser->tok = tok;
 
@@ -88,6 +90,33 @@ int parser_create(parser_input_ops_t *ops, void *arg, void *tok,
 	return EOK;
 }
 
+/** Set parser error output stream.
+ *
+ * Error messages are written to @c stderr unless a different stream
+ * is set.
+ *
+ * @param parser Parser
+ * @param errf Error output stream
+ */
+void parser_set_errf(parser_t *parser, FILE *errf)
+{
+	parser->errf = errf;
+}
+
+/** Set counter of input tokens read.
+ *
+ * The counter is incremented for each input token read by the parser
+ * or any of its sub-parsers (including tokens ignored by the parser
+ * and tokens read repeatedly when trying multiple parsing options).
+ *
+ * @param parser Parser
+ * @param nread Counter or @c NULL not to count tokens
+ */
+void parser_set_nread(parser_t *parser, size_t *nread)
+{
+	parser->nread = nread;
+}
+
 /** Create a silent sub-parser.
  *
  * Create a parser starting at the same point as @ a parent, but
@@ -108,6 +137,8 @@ static int parser_create_silent_sub(parser_t *parent, parser_t **rparser)
 		return rc;
 
 	(*rparser)->silent = true;
+	(*rparser)->errf = parent->errf;
+	(*rparser)->nread = parent->nread;
 	return EOK;
 }
 
@@ -130,6 +161,8 @@ static int parser_create_indent_sub(parser_t *parent, parser_t **rparser)
 		return rc;
 
 	(*rparser)->silent = parent->silent;
+	(*rparser)->errf = parent->errf;
+	(*rparser)->nread = parent->nread;
 	return EOK;
 }
 
@@ -152,6 +185,8 @@ static int parser_create_secindent_sub(parser_t *parent, parser_t **rparser)
 		return rc;
 
 	(*rparser)->silent = parent->silent;
+	(*rparser)->errf = parent->errf;
+	(*rparser)->nread = parent->nread;
 	return EOK;
 }
 
@@ -175,6 +210,8 @@ static int parser_create_invindent_sub(parser_t *parent, parser_t **rparser)
 	if (rc != EOK)
 		return rc;
 
+	(*rparser)->errf = parent->errf;
+	(*rparser)->nread = parent->nread;
 	return EOK;
 }
 
@@ -195,7 +232,7 @@ static void parser_follow_up(parser_t *sub, parser_t *parent)
 void parser_destroy(parser_t *parser)
 {
 	if (parser != NULL)
-		free(parser);
+		alloc_free(parser);
 }
 
 /** Return @c true if token type is to be ignored when parsing.
@@ -244,10 +281,14 @@ static void parser_next_input_tok(parser_t *parser, void *itok,
 
 	parser->input_ops->read_tok(parser->input_arg, tok,
 	    parser->indlvl, parser->seccont, rtok);
+	if (parser->nread != NULL)
+		++*parser->nread;
 	while (parser_ttype_ignore(rtok->ttype)) {
 		tok = parser->input_ops->next_tok(parser->input_arg, tok);
 		parser->input_ops->read_tok(parser->input_arg, tok,
 		    parser->indlvl, parser->seccont, rtok);
+		if (parser->nread != NULL)
+			++*parser->nread;
 	}
 
 	*ritok = tok;
@@ -377,9 +418,9 @@ static int parser_match(parser_t *parser, lexer_toktype_t mtype, void **rdata)
 	ltype = parser_next_ttype(parser);
 	if (ltype != mtype) {
 		if (!parser->silent) {
-			fprintf(stderr, "Error: ");
-			parser_dprint_next_tok(parser, stderr);
-			fprintf(stderr, " unexpected, expected '%s'.\n",
+			fprintf(parser->errf, "Error: ");
+			parser_dprint_next_tok(parser, parser->errf);
+			fprintf(parser->errf, " unexpected, expected '%s'.\n",
 			    lexer_str_ttype(mtype));
 		}
 		return EINVAL;
@@ -870,9 +911,10 @@ static int parser_process_eterm(parser_t *parser, ast_node_t **rexpr)
 		return parser_process_eparen(parser, rexpr);
 	default:
 		if (!parser->silent) {
-			fprintf(stderr, "Error: ");
-			parser_dprint_next_tok(parser, stderr);
-			fprintf(stderr, " unexpected, expected expression.\n");
+			fprintf(parser->errf, "Error: ");
+			parser_dprint_next_tok(parser, parser->errf);
+			fprintf(parser->errf, " unexpected, "
+			    "expected expression.\n");
 		}
 		return EINVAL;
 	}
@@ -1883,7 +1925,7 @@ static int parser_process_econcat(parser_t *parser, ast_node_t **rexpr)
 
 		/* Success */
 		parser->tok = sparser->tok;
-		free(sparser);
+		alloc_free(sparser);
 		sparser = NULL;
 
 		if (econcat == NULL) {
@@ -3817,9 +3859,9 @@ static int parser_process_tsident(parser_t *parser, ast_node_t **rtype)
 		break;
 	default:
 		if (!parser->silent) {
-			fprintf(stderr, "Error: ");
-			parser_dprint_next_tok(parser, stderr);
-			fprintf(stderr, " unexpected, expected type "
+			fprintf(parser->errf, "Error: ");
+			parser_dprint_next_tok(parser, parser->errf);
+			fprintf(parser->errf, " unexpected, expected type "
 			    "identifer.\n");
 		}
 		return EINVAL;
@@ -4319,10 +4361,10 @@ static int parser_process_tspec(parser_t *parser, ast_node_t **rtype)
 			rc = parser_process_tsbasic(parser, rtype);
 		} else {
 			if (!parser->silent) {
-				fprintf(stderr, "Error: ");
-				parser_dprint_next_tok(parser, stderr);
-				fprintf(stderr, " unexpected, expected type "
-				    "specifier.\n");
+				fprintf(parser->errf, "Error: ");
+				parser_dprint_next_tok(parser, parser->errf);
+				fprintf(parser->errf, " unexpected, "
+				    "expected type specifier.\n");
 			}
 			return EINVAL;
 		}
@@ -4377,9 +4419,9 @@ static int parser_process_sqlist(parser_t *parser, ast_sqlist_t **rsqlist)
 		} else {
 			/* Unexpected */
 			if (!parser->silent) {
-				fprintf(stderr, "Error: ");
-				parser_dprint_next_tok(parser, stderr);
-				fprintf(stderr, " unexpected, expected "
+				fprintf(parser->errf, "Error: ");
+				parser_dprint_next_tok(parser, parser->errf);
+				fprintf(parser->errf, " unexpected, expected "
 				    "type specifier or qualifier.\n");
 			}
 
@@ -4473,9 +4515,10 @@ static int parser_process_dspecs(parser_t *parser, unsigned add_idents,
 	do {
 		if (parser_ttype_sclass(ltt)) {
 			if (have_sclass && !parser->silent) {
-				fprintf(stderr, "Error: ");
-				parser_dprint_next_tok(parser, stderr);
-				fprintf(stderr, ": Multiple storage classes.\n");
+				fprintf(parser->errf, "Error: ");
+				parser_dprint_next_tok(parser, parser->errf);
+				fprintf(parser->errf, ": Multiple storage "
+				    "classes.\n");
 
 				rc = EINVAL;
 				goto error;
@@ -4525,9 +4568,9 @@ static int parser_process_dspecs(parser_t *parser, unsigned add_idents,
 		} else {
 			/* Unexpected */
 			if (!parser->silent) {
-				fprintf(stderr, "Error: ");
-				parser_dprint_next_tok(parser, stderr);
-				fprintf(stderr, " unexpected, expected "
+				fprintf(parser->errf, "Error: ");
+				parser_dprint_next_tok(parser, parser->errf);
+				fprintf(parser->errf, " unexpected, expected "
 				    "declaration specifier.\n");
 			}
 
@@ -4912,9 +4955,9 @@ static int parser_process_dlist(parser_t *parser, ast_abs_allow_t aallow,
 		if (first && ast_decl_is_abstract(decl) &&
 		    aallow != ast_abs_allow && ltt != ltt_colon) {
 			if (!parser->silent) {
-				fprintf(stderr, "Error: ");
-				lexer_dprint_tok(&dtok, stderr);
-				fprintf(stderr, " unexpected abstract "
+				fprintf(parser->errf, "Error: ");
+				lexer_dprint_tok(&dtok, parser->errf);
+				fprintf(parser->errf, " unexpected abstract "
 				    "declarator.\n");
 			}
 			rc = EINVAL;
@@ -4929,10 +4972,10 @@ static int parser_process_dlist(parser_t *parser, ast_abs_allow_t aallow,
 		 */
 		if (first && decl->ntype == ant_dparen) {
 			if (!parser->silent) {
-				fprintf(stderr, "Error: ");
-				lexer_dprint_tok(&dtok, stderr);
-				fprintf(stderr, " parenthesized declarator "
-				    "(cough).\n");
+				fprintf(parser->errf, "Error: ");
+				lexer_dprint_tok(&dtok, parser->errf);
+				fprintf(parser->errf, " parenthesized "
+				    "declarator (cough).\n");
 			}
 			rc = EINVAL;
 			goto error;
@@ -5014,9 +5057,9 @@ static int parser_process_idlist(parser_t *parser, ast_abs_allow_t aallow,
 
 		if (ast_decl_is_abstract(decl) && aallow != ast_abs_allow) {
 			if (!parser->silent) {
-				fprintf(stderr, "Error: ");
-				lexer_dprint_tok(&dtok, stderr);
-				fprintf(stderr, " unexpected abstract "
+				fprintf(parser->errf, "Error: ");
+				lexer_dprint_tok(&dtok, parser->errf);
+				fprintf(parser->errf, " unexpected abstract "
 				    "declarator.\n");
 			}
 			rc = EINVAL;
@@ -5024,16 +5067,17 @@ static int parser_process_idlist(parser_t *parser, ast_abs_allow_t aallow,
 		}
 
 		/*
-		 * XXX Hack so as not to produce false warnings for macro declarators
-		 * at the cost of treating declarators that are totally enclosed
-		 * in parentheses as not valid C code even if they are.
+		 * XXX Hack so as not to produce false warnings for macro
+		 * declarators at the cost of treating declarators that are
+		 * totally enclosed in parentheses as not valid C code even
+		 * if they are.
 		 */
 		if (decl->ntype == ant_dparen) {
 			if (!parser->silent) {
-				fprintf(stderr, "Error: ");
-				lexer_dprint_tok(&dtok, stderr);
-				fprintf(stderr, " parenthesized declarator "
-				    "(cough).\n");
+				fprintf(parser->errf, "Error: ");
+				lexer_dprint_tok(&dtok, parser->errf);
+				fprintf(parser->errf, " parenthesized "
+				    "declarator (cough).\n");
 			}
 			rc = EINVAL;
 			goto error;
@@ -5298,9 +5342,9 @@ static int parser_process_aspec_attr(parser_t *parser, ast_aspec_attr_t **rattr)
 	/* XXX Attribute name can also be a reserved word */
 	ltt = parser_next_ttype(parser);
 	if (ltt != ltt_ident && !lexer_is_resword(ltt)) {
-		fprintf(stderr, "Error: ");
-		parser_dprint_next_tok(parser, stderr);
-		fprintf(stderr, " unexpected, expected identifier or "
+		fprintf(parser->errf, "Error: ");
+		parser_dprint_next_tok(parser, parser->errf);
+		fprintf(parser->errf, " unexpected, expected identifier or "
 		    "reserved word.\n");
 
 		rc = EINVAL;
@@ -5465,9 +5509,9 @@ static int parser_process_aslist(parser_t *parser, ast_aslist_t **raslist)
 		} else {
 			/* Unexpected */
 			if (!parser->silent) {
-				fprintf(stderr, "Error: ");
-				parser_dprint_next_tok(parser, stderr);
-				fprintf(stderr, " unexpected, expected "
+				fprintf(parser->errf, "Error: ");
+				parser_dprint_next_tok(parser, parser->errf);
+				fprintf(parser->errf, " unexpected, expected "
 				    "attribute specifier.\n");
 			}
 			return EINVAL;
@@ -5665,9 +5709,9 @@ again:
 	case ltt_lbrace:
 		if (more_decls) {
 			if (!parser->silent) {
-				fprintf(stderr, "Error: ");
-				parser_dprint_next_tok(parser, stderr);
-				fprintf(stderr, " '{' unexpected, "
+				fprintf(parser->errf, "Error: ");
+				parser_dprint_next_tok(parser, parser->errf);
+				fprintf(parser->errf, " '{' unexpected, "
 				    "expected ';'.\n");
 			}
 			rc = EINVAL;
@@ -5692,9 +5736,10 @@ again:
 		}
 
 		if (!parser->silent) {
-			fprintf(stderr, "Error: ");
-			parser_dprint_next_tok(parser, stderr);
-			fprintf(stderr, " unexpected, expected '{' or ';'.\n");
+			fprintf(parser->errf, "Error: ");
+			parser_dprint_next_tok(parser, parser->errf);
+			fprintf(parser->errf, " unexpected, "
+			    "expected '{' or ';'.\n");
 		}
 
 		rc = EINVAL;
@@ -5848,9 +5893,10 @@ static int parser_process_gmdecln(parser_t *parser, ast_gmdecln_t **rgmdecln)
 		break;
 	default:
 		if (!parser->silent) {
-			fprintf(stderr, "Error: ");
-			parser_dprint_next_tok(parser, stderr);
-			fprintf(stderr, " unexpected, expected '{' or ';'.\n");
+			fprintf(parser->errf, "Error: ");
+			parser_dprint_next_tok(parser, parser->errf);
+			fprintf(parser->errf, " unexpected, "
+			    "expected '{' or ';'.\n");
 		}
 		rc = EINVAL;
 		goto error;
@@ -6056,3 +6102,35 @@ error:
 	ast_tree_destroy(&module->node);
 	return rc;
 }
+
+/** Parse a single global declaration.
+ *
+ * This allows parsing only part of a module, e.g. when re-parsing
+ * declarations affected by an edit.
+ *
+ * @param parser Parser
+ * @param rnode Place to store pointer to new declaration
+ *
+ * @return EOK on success or non-zero error code
+ */
+int parser_process_decln(parser_t *parser, ast_node_t **rnode)
+{
+	return parser_process_global_decln(parser, rnode);
+}
+
+/** Return next input token that is not ignored.
+ *
+ * Ignored tokens (whitespace, comments, preprocessor directives) before
+ * it are skipped over (but not consumed).
+ *
+ * @param parser Parser
+ * @return Input token
+ */
+void *parser_next_tok(parser_t *parser)
+{
+	lexer_tok_t ltok;
+	void *itok;
+
+	parser_next_input_tok(parser, parser->tok, &itok, &ltok);
+	return itok;
+}
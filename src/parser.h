@@ -27,13 +27,18 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include <stdio.h>
 #include <types/ast.h>
 #include <types/parser.h>
 
 extern int parser_create(parser_input_ops_t *, void *, void *, unsigned,
     bool, parser_t **);
 extern void parser_destroy(parser_t *);
+extern void parser_set_errf(parser_t *, FILE *);
+extern void parser_set_nread(parser_t *, size_t *);
 extern int parser_process_module(parser_t *, ast_module_t **);
+extern int parser_process_decln(parser_t *, ast_node_t **);
+extern void *parser_next_tok(parser_t *);
 extern bool parser_ttype_ignore(lexer_toktype_t);
 
 #endif
@@ -0,0 +1,635 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Project configuration (.ccheck files)
+ *
+ * A .ccheck file applies to the directory it is in and to all directories
+ * below it. Configuration files in subdirectories refine the configuration
+ * of their parent directories. Each line contains one directive:
+ *
+ *   root                     Do not look for configuration further up
+ *   disable <group>...       Disable check groups
+ *   enable <group>...        Enable check groups disabled further up
+ *   ignore <pattern>...      Do not check matching files
+ *   type <pattern> c|h       Check matching files as C source / header
+ *
+ * Empty lines and lines starting with '#' are ignored. Patterns are
+ * matched against the path relative to the directory of the configuration
+ * file. A pattern without a slash matches at any directory level.
+ *
+ * Each directory is looked up and its configuration file parsed only once,
+ * the resulting checker configuration is kept with the directory.
+ * Directories are never modified once added, so only looking them up
+ * needs to be synchronized, not matching files against their patterns.
+ */
+
+#include <checker.h>
+#include <diag.h>
+#include <fnmatch.h>
+#include <merrno.h>
+#include <pconf.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+enum {
+	/** Initial number of directories allocated */
+	pconf_init_alloc = 16
+};
+
+/** Name of configuration file */
+static const char *pconf_fname = ".ccheck";
+
+/** Characters separating words in a configuration file */
+static const char *pconf_wsep = " \t\r\n";
+
+/** Create project configuration.
+ *
+ * @param cwd Directory relative paths are resolved against or @c NULL
+ *            for the current working directory
+ * @param cfg Checker configuration given on the command line (groups
+ *            disabled there cannot be enabled by configuration files)
+ * @param errf Output stream for errors
+ * @param rpconf Place to store pointer to new project configuration
+ * @return EOK on success, ENOMEM if out of memory, EIO if the current
+ *         working directory cannot be determined
+ */
+int pconf_create(const char *cwd, checker_cfg_t *cfg, FILE *errf,
+    pconf_t **rpconf)
+{
+	pconf_t *pconf;
+
+	pconf = calloc(1, sizeof(pconf_t));
+	if (pconf == NULL)
+		return ENOMEM;
+
+	if (cwd != NULL) {
+		pconf->cwd = strdup(cwd);
+		if (pconf->cwd == NULL) {
+			free(pconf);
+			return ENOMEM;
+		}
+	} else {
+		pconf->cwd = getcwd(NULL, 0);
+		if (pconf->cwd == NULL) {
+			free(pconf);
+			return EIO;
+		}
+	}
+
+	pconf->base_groups = checker_cfg_get_mask(cfg);
+	pconf->errf = errf;
+	pthread_rwlock_init(&pconf->lock, NULL);
+
+	*rpconf = pconf;
+	return EOK;
+}
+
+/** Destroy directory configuration.
+ *
+ * @param dir Directory configuration
+ */
+static void pconf_dir_destroy(pconf_dir_t *dir)
+{
+	size_t i;
+
+	for (i = 0; i < dir->nignore; i++)
+		free(dir->ignore[i]);
+	for (i = 0; i < dir->ntypes; i++)
+		free(dir->type[i].glob);
+
+	free(dir->ignore);
+	free(dir->type);
+	free(dir->path);
+	free(dir);
+}
+
+/** Destroy project configuration.
+ *
+ * @param pconf Project configuration or @c NULL
+ */
+void pconf_destroy(pconf_t *pconf)
+{
+	size_t i;
+
+	if (pconf == NULL)
+		return;
+
+	for (i = 0; i < pconf->ndirs; i++)
+		pconf_dir_destroy(pconf->dir[i]);
+
+	free(pconf->dir);
+	free(pconf->cwd);
+	pthread_rwlock_destroy(&pconf->lock);
+	free(pconf);
+}
+
+/** Make path absolute and normalize it.
+ *
+ * Empty and '.' components are removed and '..' components are resolved
+ * (without looking at the file system).
+ *
+ * @param pconf Project configuration
+ * @param path Path
+ * @param rapath Place to store pointer to newly allocated absolute path
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int pconf_abs_path(pconf_t *pconf, const char *path, char **rapath)
+{
+	char *buf;
+	char *p;
+	char *q;
+	size_t out;
+
+	if (path[0] == '/') {
+		buf = strdup(path);
+		if (buf == NULL)
+			return ENOMEM;
+	} else {
+		if (asprintf(&buf, "%s/%s", pconf->cwd, path) < 0)
+			return ENOMEM;
+	}
+
+	/* The result is never longer than the part processed so far */
+	out = 0;
+	p = buf;
+	while (*p != '\0') {
+		while (*p == '/')
+			++p;
+		if (*p == '\0')
+			break;
+
+		q = p;
+		while (*q != '\0' && *q != '/')
+			++q;
+
+		if (q - p == 2 && p[0] == '.' && p[1] == '.') {
+			while (out > 0 && buf[out - 1] != '/')
+				--out;
+			if (out > 0)
+				--out;
+		} else if (q - p != 1 || p[0] != '.') {
+			buf[out++] = '/';
+			memmove(buf + out, p, q - p);
+			out += q - p;
+		}
+
+		p = q;
+	}
+
+	if (out == 0)
+		buf[out++] = '/';
+	buf[out] = '\0';
+
+	*rapath = buf;
+	return EOK;
+}
+
+/** Find directory configuration.
+ *
+ * @param pconf Project configuration
+ * @param path Absolute directory path
+ * @param ridx Place to store index of the directory or where it should
+ *             be inserted
+ * @return @c true iff the directory was found
+ */
+static bool pconf_find(pconf_t *pconf, const char *path, size_t *ridx)
+{
+	size_t lo, hi, mid;
+	int c;
+
+	lo = 0;
+	hi = pconf->ndirs;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		c = strcmp(pconf->dir[mid]->path, path);
+		if (c == 0) {
+			*ridx = mid;
+			return true;
+		}
+
+		if (c < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	*ridx = lo;
+	return false;
+}
+
+/** Get check group by name.
+ *
+ * @param name Check group name
+ * @param rgroup Place to store check group
+ * @return @c true iff @a name is a valid check group name
+ */
+static bool pconf_group(const char *name, diag_group_t *rgroup)
+{
+	int g;
+
+	for (g = dg_decl; g < dg_internal; g++) {
+		if (strcmp(diag_group_str(g), name) == 0) {
+			*rgroup = g;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** Add ignore pattern to directory configuration.
+ *
+ * @param dir Directory configuration
+ * @param glob Pattern
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int pconf_add_ignore(pconf_dir_t *dir, const char *glob)
+{
+	char **nignore;
+
+	nignore = realloc(dir->ignore, (dir->nignore + 1) * sizeof(char *));
+	if (nignore == NULL)
+		return ENOMEM;
+
+	dir->ignore = nignore;
+	dir->ignore[dir->nignore] = strdup(glob);
+	if (dir->ignore[dir->nignore] == NULL)
+		return ENOMEM;
+
+	++dir->nignore;
+	return EOK;
+}
+
+/** Add file type override to directory configuration.
+ *
+ * @param dir Directory configuration
+ * @param glob Pattern
+ * @param mtype Module type of matching files
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int pconf_add_type(pconf_dir_t *dir, const char *glob,
+    checker_mtype_t mtype)
+{
+	pconf_type_t *ntype;
+
+	ntype = realloc(dir->type, (dir->ntypes + 1) * sizeof(pconf_type_t));
+	if (ntype == NULL)
+		return ENOMEM;
+
+	dir->type = ntype;
+	dir->type[dir->ntypes].glob = strdup(glob);
+	if (dir->type[dir->ntypes].glob == NULL)
+		return ENOMEM;
+
+	dir->type[dir->ntypes].mtype = mtype;
+	++dir->ntypes;
+	return EOK;
+}
+
+/** Parse configuration file.
+ *
+ * @param pconf Project configuration
+ * @param dir Directory configuration to fill in
+ * @param f Open configuration file
+ * @param fname Configuration file name (for error messages)
+ * @param rroot Set to @c true if the file contains the root directive
+ * @param ren Place to store mask of enabled check groups
+ * @param rdis Place to store mask of disabled check groups
+ * @return EOK on success, EINVAL if the file is not valid, EIO on
+ *         I/O error, ENOMEM if out of memory
+ */
+static int pconf_parse(pconf_t *pconf, pconf_dir_t *dir, FILE *f,
+    const char *fname, bool *rroot, unsigned *ren, unsigned *rdis)
+{
+	char *line = NULL;
+	size_t lsize = 0;
+	unsigned lnum = 0;
+	char *sp;
+	char *word;
+	char *glob;
+	char *arg;
+	diag_group_t group;
+	checker_mtype_t mtype;
+	int rc;
+
+	*ren = 0;
+	*rdis = 0;
+
+	while (getline(&line, &lsize, f) >= 0) {
+		++lnum;
+		word = strtok_r(line, pconf_wsep, &sp);
+		if (word == NULL || word[0] == '#')
+			continue;
+
+		if (strcmp(word, "root") == 0) {
+			if (strtok_r(NULL, pconf_wsep, &sp) != NULL)
+				goto invalid;
+			*rroot = true;
+		} else if (strcmp(word, "disable") == 0 ||
+		    strcmp(word, "enable") == 0) {
+			arg = strtok_r(NULL, pconf_wsep, &sp);
+			while (arg != NULL) {
+				if (!pconf_group(arg, &group)) {
+					fprintf(pconf->errf, "%s:%u: Invalid "
+					    "check name '%s'.\n", fname, lnum,
+					    arg);
+					rc = EINVAL;
+					goto error;
+				}
+
+				if (word[0] == 'd') {
+					*rdis |= 1u << group;
+					*ren &= ~(1u << group);
+				} else {
+					*ren |= 1u << group;
+					*rdis &= ~(1u << group);
+				}
+
+				arg = strtok_r(NULL, pconf_wsep, &sp);
+			}
+		} else if (strcmp(word, "ignore") == 0) {
+			arg = strtok_r(NULL, pconf_wsep, &sp);
+			while (arg != NULL) {
+				rc = pconf_add_ignore(dir, arg);
+				if (rc != EOK)
+					goto error;
+
+				arg = strtok_r(NULL, pconf_wsep, &sp);
+			}
+		} else if (strcmp(word, "type") == 0) {
+			glob = strtok_r(NULL, pconf_wsep, &sp);
+			arg = strtok_r(NULL, pconf_wsep, &sp);
+			if (glob == NULL || arg == NULL ||
+			    strtok_r(NULL, pconf_wsep, &sp) != NULL)
+				goto invalid;
+
+			if (strcmp(arg, "c") == 0) {
+				mtype = cmod_c;
+			} else if (strcmp(arg, "h") == 0) {
+				mtype = cmod_header;
+			} else {
+				fprintf(pconf->errf, "%s:%u: Invalid file type "
+				    "'%s'.\n", fname, lnum, arg);
+				rc = EINVAL;
+				goto error;
+			}
+
+			rc = pconf_add_type(dir, glob, mtype);
+			if (rc != EOK)
+				goto error;
+		} else {
+			fprintf(pconf->errf, "%s:%u: Unknown directive '%s'.\n",
+			    fname, lnum, word);
+			rc = EINVAL;
+			goto error;
+		}
+	}
+
+	if (ferror(f)) {
+		fprintf(pconf->errf, "Error reading '%s'.\n", fname);
+		rc = EIO;
+		goto error;
+	}
+
+	free(line);
+	return EOK;
+invalid:
+	fprintf(pconf->errf, "%s:%u: Invalid '%s' directive.\n", fname, lnum,
+	    word);
+	rc = EINVAL;
+error:
+	free(line);
+	return rc;
+}
+
+/** Get configuration of a directory.
+ *
+ * If the directory has not been seen yet, its configuration file
+ * (if any) is parsed and the configuration of its parent directories
+ * is determined.
+ *
+ * @param pconf Project configuration
+ * @param path Absolute normalized directory path
+ * @param rdir Place to store pointer to directory configuration
+ * @return EOK on success or error code
+ */
+static int pconf_get_dir(pconf_t *pconf, const char *path,
+    pconf_dir_t **rdir)
+{
+	pconf_dir_t *dir;
+	pconf_dir_t **ndir;
+	char *cfname = NULL;
+	char *ppath = NULL;
+	char *slash;
+	bool root = false;
+	unsigned en = 0;
+	unsigned dis = 0;
+	unsigned groups;
+	size_t nalloc;
+	size_t idx;
+	FILE *f;
+	int rc;
+
+	if (pconf_find(pconf, path, &idx)) {
+		*rdir = pconf->dir[idx];
+		return EOK;
+	}
+
+	dir = calloc(1, sizeof(pconf_dir_t));
+	if (dir == NULL)
+		return ENOMEM;
+
+	dir->path = strdup(path);
+	if (dir->path == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	if (asprintf(&cfname, "%s/%s", path[1] != '\0' ? path : "",
+	    pconf_fname) < 0) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	f = fopen(cfname, "rt");
+	if (f != NULL) {
+		dir->has_file = true;
+		rc = pconf_parse(pconf, dir, f, cfname, &root, &en, &dis);
+		fclose(f);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if (!root && path[1] != '\0') {
+		slash = strrchr(path, '/');
+		ppath = slash != path ? strndup(path, slash - path) :
+		    strdup("/");
+		if (ppath == NULL) {
+			rc = ENOMEM;
+			goto error;
+		}
+
+		rc = pconf_get_dir(pconf, ppath, &dir->parent);
+		if (rc != EOK)
+			goto error;
+	}
+
+	groups = dir->parent != NULL ? dir->parent->groups :
+	    (1u << dg_internal) - 1;
+	dir->groups = (groups & ~dis) | en;
+	checker_cfg_set_mask(&dir->cfg, dir->groups & pconf->base_groups);
+
+	/* Parent directories have been inserted in the meantime */
+	(void) pconf_find(pconf, path, &idx);
+
+	if (pconf->ndirs >= pconf->alloc) {
+		nalloc = pconf->alloc != 0 ? 2 * pconf->alloc :
+		    pconf_init_alloc;
+		ndir = realloc(pconf->dir, nalloc * sizeof(pconf_dir_t *));
+		if (ndir == NULL) {
+			rc = ENOMEM;
+			goto error;
+		}
+
+		pconf->dir = ndir;
+		pconf->alloc = nalloc;
+	}
+
+	memmove(&pconf->dir[idx + 1], &pconf->dir[idx],
+	    (pconf->ndirs - idx) * sizeof(pconf_dir_t *));
+	pconf->dir[idx] = dir;
+	++pconf->ndirs;
+
+	free(cfname);
+	free(ppath);
+	*rdir = dir;
+	return EOK;
+error:
+	free(cfname);
+	free(ppath);
+	pconf_dir_destroy(dir);
+	return rc;
+}
+
+/** Match path against pattern.
+ *
+ * @param glob Pattern
+ * @param rel Path relative to the directory of the configuration file
+ * @return @c true iff @a rel or one of its parent directories matches
+ */
+static bool pconf_match(const char *glob, const char *rel)
+{
+	const char *p;
+
+	if (glob[0] == '/')
+		++glob;
+
+	if (strchr(glob, '/') != NULL)
+		return fnmatch(glob, rel, FNM_PATHNAME | FNM_LEADING_DIR) == 0;
+
+	/* Pattern without a slash matches at any level */
+	p = rel;
+	while (p != NULL) {
+		if (fnmatch(glob, p, FNM_PATHNAME | FNM_LEADING_DIR) == 0)
+			return true;
+
+		p = strchr(p, '/');
+		if (p != NULL)
+			++p;
+	}
+
+	return false;
+}
+
+/** Get configuration of a file.
+ *
+ * @param pconf Project configuration
+ * @param fname File name
+ * @param pf Place to store file configuration
+ * @return EOK on success, EINVAL if a configuration file is not valid,
+ *         EIO on I/O error, ENOMEM if out of memory
+ */
+int pconf_file(pconf_t *pconf, const char *fname, pconf_file_t *pf)
+{
+	pconf_dir_t *dir;
+	pconf_dir_t *d;
+	char *apath = NULL;
+	char *dpath = NULL;
+	const char *rel;
+	char *slash;
+	size_t i;
+	int rc;
+
+	rc = pconf_abs_path(pconf, fname, &apath);
+	if (rc != EOK)
+		goto error;
+
+	slash = strrchr(apath, '/');
+	dpath = slash != apath ? strndup(apath, slash - apath) : strdup("/");
+	if (dpath == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	/* Usually the directory has been seen already */
+	pthread_rwlock_rdlock(&pconf->lock);
+	dir = pconf_find(pconf, dpath, &i) ? pconf->dir[i] : NULL;
+	pthread_rwlock_unlock(&pconf->lock);
+
+	if (dir == NULL) {
+		pthread_rwlock_wrlock(&pconf->lock);
+		rc = pconf_get_dir(pconf, dpath, &dir);
+		pthread_rwlock_unlock(&pconf->lock);
+		if (rc != EOK)
+			goto error;
+	}
+
+	pf->cfg = &dir->cfg;
+	pf->ignore = false;
+	pf->mtype_set = false;
+
+	/* Nearest configuration file and later directives take precedence */
+	for (d = dir; d != NULL; d = d->parent) {
+		if (!d->has_file)
+			continue;
+
+		rel = apath + (d->path[1] != '\0' ? strlen(d->path) : 0) + 1;
+
+		for (i = 0; i < d->nignore && !pf->ignore; i++)
+			pf->ignore = pconf_match(d->ignore[i], rel);
+
+		for (i = d->ntypes; i > 0 && !pf->mtype_set; i--) {
+			if (pconf_match(d->type[i - 1].glob, rel)) {
+				pf->mtype_set = true;
+				pf->mtype = d->type[i - 1].mtype;
+			}
+		}
+	}
+
+	rc = EOK;
+error:
+	free(apath);
+	free(dpath);
+	return rc;
+}
@@ -0,0 +1,648 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Result cache
+ *
+ * Diagnostics reported for a file are stored in a cache directory, keyed
+ * by a hash of the file contents, the enabled check groups, the module
+ * type, whether fingerprints are computed and the identity of the ccheck
+ * binary. When the same file is
+ * checked again, the stored diagnostics are replayed without lexing
+ * or parsing the file.
+ *
+ * Each entry is a separate file named after the key hash, in one of 256
+ * subdirectories. Entries are written to a temporary file and renamed
+ * into place, so concurrent ccheck processes can share the cache and
+ * never see a partially written entry. Entry format (little-endian):
+ *
+ *   magic 'CCKC', format version (8 bits), key hash (64 bits),
+ *   file size (64 bits), enabled check groups (32 bits),
+ *   module type (8 bits), number of diagnostics (32 bits),
+ *   followed by diagnostic records as written by diag_write_bin()
+ *
+ * The total size of entries is bounded. When the cache is closed after
+ * new entries have been stored, least recently used entries are removed
+ * until the cache fits in its size limit. Entries are touched on every
+ * hit so that their modification time reflects the last use.
+ */
+
+#include <checker.h>
+#include <dirent.h>
+#include <diag.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <hash.h>
+#include <merrno.h>
+#include <rcache.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum {
+	/** Cache entry format version */
+	rcache_version = 2,
+	/** Initial number of entries allocated when scanning the cache */
+	rcache_scan_init_alloc = 256
+};
+
+/** Cache entry magic */
+static const char rcache_magic[4] = { 'C', 'C', 'K', 'C' };
+
+/** Cache entry found when scanning the cache */
+typedef struct {
+	/** Entry path */
+	char *path;
+	/** Entry size */
+	uint64_t size;
+	/** Last use (modification time) */
+	struct timespec mtime;
+} rcache_scan_entry_t;
+
+/** Create directory including any missing parent directories.
+ *
+ * @param path Directory path
+ * @return EOK on success, EIO on failure
+ */
+static int rcache_mkdir(const char *path)
+{
+	char *p;
+	char *sp;
+	int rc;
+
+	p = strdup(path);
+	if (p == NULL)
+		return ENOMEM;
+
+	sp = p;
+	while (*sp == '/')
+		++sp;
+
+	while (true) {
+		sp = strchr(sp, '/');
+		if (sp != NULL)
+			*sp = '\0';
+
+		rc = mkdir(p, 0777);
+		if (rc < 0 && errno != EEXIST) {
+			free(p);
+			return EIO;
+		}
+
+		if (sp == NULL)
+			break;
+
+		*sp++ = '/';
+	}
+
+	free(p);
+	return EOK;
+}
+
+/** Open result cache.
+ *
+ * The cache directory is created if it does not exist.
+ *
+ * @param dir Cache directory
+ * @param max_size Maximum total size of cache entries in bytes
+ * @param rrcache Place to store pointer to new result cache
+ * @return EOK on success, ENOMEM if out of memory, EIO if the cache
+ *         directory cannot be created, ENOTSUP if the identity of the
+ *         running binary cannot be determined
+ */
+int rcache_open(const char *dir, uint64_t max_size, rcache_t **rrcache)
+{
+	rcache_t *rcache;
+	struct stat st;
+	int rc;
+
+	rcache = calloc(1, sizeof(rcache_t));
+	if (rcache == NULL)
+		return ENOMEM;
+
+	rcache->dir = strdup(dir);
+	if (rcache->dir == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	/*
+	 * Any rebuild of ccheck may change the results, so the running
+	 * binary is part of the key. Without it, results of a different
+	 * build could be replayed, so the cache cannot be used at all.
+	 */
+	if (stat("/proc/self/exe", &st) != 0) {
+		rc = ENOTSUP;
+		goto error;
+	}
+
+	rcache->exe_id = hash_fnv(HASH_FNV_BASIS, &st.st_ino,
+	    sizeof(st.st_ino));
+	rcache->exe_id = hash_fnv(rcache->exe_id, &st.st_size,
+	    sizeof(st.st_size));
+	rcache->exe_id = hash_fnv(rcache->exe_id, &st.st_mtim,
+	    sizeof(st.st_mtim));
+
+	rc = rcache_mkdir(dir);
+	if (rc != EOK)
+		goto error;
+
+	rcache->max_size = max_size;
+	pthread_mutex_init(&rcache->lock, NULL);
+	*rrcache = rcache;
+	return EOK;
+error:
+	free(rcache->dir);
+	free(rcache);
+	return rc;
+}
+
+/** Compute cache key for a file.
+ *
+ * @param rcache Result cache
+ * @param data File contents
+ * @param size File size
+ * @param cfg Checker configuration
+ * @param mtype Module type
+ * @param fps @c true if diagnostic fingerprints are computed
+ * @param key Place to store key
+ */
+void rcache_key(rcache_t *rcache, const void *data, size_t size,
+    checker_cfg_t *cfg, checker_mtype_t mtype, bool fps, rcache_key_t *key)
+{
+	uint8_t ver = rcache_version;
+	uint8_t fpflag = fps ? 1 : 0;
+	uint64_t hash;
+
+	key->size = size;
+	key->mtype = mtype;
+	key->cfgmask = checker_cfg_get_mask(cfg);
+
+	hash = hash_fnv(HASH_FNV_BASIS, data, size);
+	hash = hash_fnv(hash, &key->cfgmask, sizeof(key->cfgmask));
+	hash = hash_fnv(hash, &key->mtype, sizeof(key->mtype));
+	hash = hash_fnv(hash, &fpflag, sizeof(fpflag));
+	hash = hash_fnv(hash, &ver, sizeof(ver));
+	hash = hash_fnv(hash, &rcache->exe_id, sizeof(rcache->exe_id));
+	key->hash = hash;
+}
+
+/** Get path of a cache entry.
+ *
+ * @param rcache Result cache
+ * @param key Key
+ * @param rpath Place to store newly allocated path
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int rcache_entry_path(rcache_t *rcache, rcache_key_t *key,
+    char **rpath)
+{
+	if (asprintf(rpath, "%s/%02x/%014llx", rcache->dir,
+	    (unsigned) (key->hash >> 56),
+	    (unsigned long long) (key->hash & 0xffffffffffffffULL)) < 0)
+		return ENOMEM;
+
+	return EOK;
+}
+
+/** Write unsigned integer in little-endian byte order.
+ *
+ * @param val Value
+ * @param nbytes Number of bytes to write
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+static int rcache_write_uint(uint64_t val, unsigned nbytes, FILE *f)
+{
+	uint8_t buf[8];
+	unsigned i;
+
+	for (i = 0; i < nbytes; i++) {
+		buf[i] = val & 0xff;
+		val >>= 8;
+	}
+
+	if (fwrite(buf, 1, nbytes, f) != nbytes)
+		return EIO;
+
+	return EOK;
+}
+
+/** Read unsigned integer in little-endian byte order.
+ *
+ * @param nbytes Number of bytes to read
+ * @param f Input file
+ * @param rval Place to store value
+ * @return EOK on success, EIO on I/O error or end of file
+ */
+static int rcache_read_uint(unsigned nbytes, FILE *f, uint64_t *rval)
+{
+	uint8_t buf[8];
+	uint64_t val;
+	unsigned i;
+
+	if (fread(buf, 1, nbytes, f) != nbytes)
+		return EIO;
+
+	val = 0;
+	for (i = 0; i < nbytes; i++)
+		val |= (uint64_t) buf[i] << (8 * i);
+
+	*rval = val;
+	return EOK;
+}
+
+/** Read and verify cache entry header.
+ *
+ * @param f Entry file
+ * @param key Expected key
+ * @param rndiags Place to store number of diagnostics
+ * @return EOK on success, EINVAL if the entry does not match @a key
+ *         or is invalid, EIO on I/O error
+ */
+static int rcache_read_header(FILE *f, rcache_key_t *key, uint64_t *rndiags)
+{
+	char magic[4];
+	uint64_t val[5];
+	unsigned nbytes[5] = { 1, 8, 8, 4, 1 };
+	unsigned i;
+	int rc;
+
+	if (fread(magic, 1, 4, f) != 4)
+		return EIO;
+
+	if (memcmp(magic, rcache_magic, 4) != 0)
+		return EINVAL;
+
+	for (i = 0; i < 5; i++) {
+		rc = rcache_read_uint(nbytes[i], f, &val[i]);
+		if (rc != EOK)
+			return rc;
+	}
+
+	if (val[0] != rcache_version || val[1] != key->hash ||
+	    val[2] != key->size || val[3] != key->cfgmask ||
+	    val[4] != key->mtype)
+		return EINVAL;
+
+	return rcache_read_uint(4, f, rndiags);
+}
+
+/** Look up cached diagnostics.
+ *
+ * @param rcache Result cache
+ * @param key Key
+ * @param fname File name to use in replayed diagnostics
+ * @param diags Empty diagnostic list to append cached diagnostics to
+ * @return EOK if found, ENOENT if not found (or the entry is not valid),
+ *         ENOMEM if out of memory
+ */
+int rcache_lookup(rcache_t *rcache, rcache_key_t *key, const char *fname,
+    diag_list_t *diags)
+{
+	char *path;
+	FILE *f = NULL;
+	diag_t diag;
+	uint64_t ndiags;
+	uint64_t i;
+	int rc;
+
+	rc = rcache_entry_path(rcache, key, &path);
+	if (rc != EOK)
+		return rc;
+
+	f = fopen(path, "rb");
+	if (f == NULL) {
+		rc = ENOENT;
+		goto error;
+	}
+
+	rc = rcache_read_header(f, key, &ndiags);
+	if (rc != EOK)
+		goto error;
+
+	for (i = 0; i < ndiags; i++) {
+		rc = diag_read_bin(f, &diag);
+		if (rc != EOK)
+			goto error;
+
+		diag.file = fname;
+		rc = diag_list_append(diags, &diag);
+		diag_free_strs(&diag);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if (fgetc(f) != EOF) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	fclose(f);
+
+	/* Record last use for eviction */
+	(void) utimensat(AT_FDCWD, path, NULL, 0);
+	free(path);
+	return EOK;
+error:
+	if (f != NULL)
+		fclose(f);
+	free(path);
+	diag_list_clear(diags);
+	return rc == ENOMEM ? ENOMEM : ENOENT;
+}
+
+/** Write cache entry.
+ *
+ * @param f Entry file
+ * @param key Key
+ * @param diags Diagnostics
+ * @return EOK on success, EIO on I/O error
+ */
+static int rcache_write_entry(FILE *f, rcache_key_t *key, diag_list_t *diags)
+{
+	size_t i;
+	int rc;
+
+	if (fwrite(rcache_magic, 1, 4, f) != 4)
+		return EIO;
+
+	rc = rcache_write_uint(rcache_version, 1, f);
+	if (rc == EOK)
+		rc = rcache_write_uint(key->hash, 8, f);
+	if (rc == EOK)
+		rc = rcache_write_uint(key->size, 8, f);
+	if (rc == EOK)
+		rc = rcache_write_uint(key->cfgmask, 4, f);
+	if (rc == EOK)
+		rc = rcache_write_uint(key->mtype, 1, f);
+	if (rc == EOK)
+		rc = rcache_write_uint(diags->ndiags, 4, f);
+	if (rc != EOK)
+		return rc;
+
+	for (i = 0; i < diags->ndiags; i++) {
+		rc = diag_write_bin(&diags->diag[i], f);
+		if (rc != EOK)
+			return rc;
+	}
+
+	return EOK;
+}
+
+/** Store diagnostics in the cache.
+ *
+ * The entry is written to a temporary file first and then atomically
+ * renamed into place.
+ *
+ * @param rcache Result cache
+ * @param key Key
+ * @param diags Diagnostics reported for the file
+ * @return EOK on success, ENOMEM if out of memory, EIO on I/O error
+ */
+int rcache_store(rcache_t *rcache, rcache_key_t *key, diag_list_t *diags)
+{
+	char *path = NULL;
+	char *tmpname = NULL;
+	char *sp;
+	FILE *f = NULL;
+	int fd;
+	int rc;
+
+	rc = rcache_entry_path(rcache, key, &path);
+	if (rc != EOK)
+		return rc;
+
+	if (asprintf(&tmpname, "%s.XXXXXX", path) < 0) {
+		tmpname = NULL;
+		rc = ENOMEM;
+		goto error;
+	}
+
+	/* Create subdirectory */
+	sp = strrchr(path, '/');
+	*sp = '\0';
+	if (mkdir(path, 0777) < 0 && errno != EEXIST) {
+		rc = EIO;
+		goto error;
+	}
+
+	*sp = '/';
+
+	fd = mkstemp(tmpname);
+	if (fd < 0) {
+		free(tmpname);
+		tmpname = NULL;
+		rc = EIO;
+		goto error;
+	}
+
+	f = fdopen(fd, "wb");
+	if (f == NULL) {
+		close(fd);
+		rc = EIO;
+		goto error;
+	}
+
+	rc = rcache_write_entry(f, key, diags);
+	if (rc != EOK)
+		goto error;
+
+	rc = fclose(f);
+	f = NULL;
+	if (rc != 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	if (rename(tmpname, path) < 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	pthread_mutex_lock(&rcache->lock);
+	++rcache->nstored;
+	pthread_mutex_unlock(&rcache->lock);
+
+	free(tmpname);
+	free(path);
+	return EOK;
+error:
+	if (f != NULL)
+		fclose(f);
+	if (tmpname != NULL) {
+		(void) unlink(tmpname);
+		free(tmpname);
+	}
+
+	free(path);
+	return rc;
+}
+
+/** Compare cache entries by last use.
+ *
+ * @param a Pointer to first entry (rcache_scan_entry_t *)
+ * @param b Pointer to second entry (rcache_scan_entry_t *)
+ * @return Less than, equal to or greater than zero
+ */
+static int rcache_scan_cmp(const void *a, const void *b)
+{
+	const rcache_scan_entry_t *ea = (const rcache_scan_entry_t *) a;
+	const rcache_scan_entry_t *eb = (const rcache_scan_entry_t *) b;
+
+	if (ea->mtime.tv_sec != eb->mtime.tv_sec)
+		return ea->mtime.tv_sec < eb->mtime.tv_sec ? -1 : 1;
+	if (ea->mtime.tv_nsec != eb->mtime.tv_nsec)
+		return ea->mtime.tv_nsec < eb->mtime.tv_nsec ? -1 : 1;
+	return 0;
+}
+
+/** Scan one cache subdirectory.
+ *
+ * @param dpath Subdirectory path
+ * @param entries Pointer to array of entries
+ * @param nentries Pointer to number of entries
+ * @param alloc Pointer to number of allocated entries
+ * @param total Pointer to total size of entries
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int rcache_scan_subdir(const char *dpath, rcache_scan_entry_t **entries,
+    size_t *nentries, size_t *alloc, uint64_t *total)
+{
+	DIR *dir;
+	struct dirent *de;
+	struct stat st;
+	rcache_scan_entry_t *nent;
+	char *path;
+	size_t nalloc;
+	int rc = EOK;
+
+	dir = opendir(dpath);
+	if (dir == NULL)
+		return EOK;
+
+	while ((de = readdir(dir)) != NULL) {
+		if (de->d_name[0] == '.')
+			continue;
+
+		if (asprintf(&path, "%s/%s", dpath, de->d_name) < 0) {
+			rc = ENOMEM;
+			break;
+		}
+
+		if (lstat(path, &st) < 0 || !S_ISREG(st.st_mode)) {
+			free(path);
+			continue;
+		}
+
+		if (*nentries >= *alloc) {
+			nalloc = *alloc != 0 ? 2 * *alloc :
+			    rcache_scan_init_alloc;
+			nent = realloc(*entries,
+			    nalloc * sizeof(rcache_scan_entry_t));
+			if (nent == NULL) {
+				free(path);
+				rc = ENOMEM;
+				break;
+			}
+
+			*entries = nent;
+			*alloc = nalloc;
+		}
+
+		(*entries)[*nentries].path = path;
+		(*entries)[*nentries].size = st.st_size;
+		(*entries)[*nentries].mtime = st.st_mtim;
+		++*nentries;
+		*total += st.st_size;
+	}
+
+	closedir(dir);
+	return rc;
+}
+
+/** Remove least recently used entries until the cache fits its limit.
+ *
+ * @param rcache Result cache
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int rcache_evict(rcache_t *rcache)
+{
+	rcache_scan_entry_t *entries = NULL;
+	size_t nentries = 0;
+	size_t alloc = 0;
+	uint64_t total = 0;
+	char *dpath;
+	unsigned i;
+	size_t j;
+	int rc = EOK;
+
+	for (i = 0; i < 256; i++) {
+		if (asprintf(&dpath, "%s/%02x", rcache->dir, i) < 0) {
+			rc = ENOMEM;
+			break;
+		}
+
+		rc = rcache_scan_subdir(dpath, &entries, &nentries, &alloc,
+		    &total);
+		free(dpath);
+		if (rc != EOK)
+			break;
+	}
+
+	if (rc == EOK && total > rcache->max_size) {
+		qsort(entries, nentries, sizeof(rcache_scan_entry_t),
+		    rcache_scan_cmp);
+
+		/* Another process may have removed the entry already */
+		for (j = 0; j < nentries && total > rcache->max_size; j++) {
+			(void) unlink(entries[j].path);
+			total -= entries[j].size;
+		}
+	}
+
+	for (j = 0; j < nentries; j++)
+		free(entries[j].path);
+	free(entries);
+	return rc;
+}
+
+/** Close result cache.
+ *
+ * If any entries were stored, the cache is trimmed to its size limit.
+ *
+ * @param rcache Result cache
+ */
+void rcache_close(rcache_t *rcache)
+{
+	if (rcache == NULL)
+		return;
+
+	if (rcache->nstored > 0)
+		(void) rcache_evict(rcache);
+
+	pthread_mutex_destroy(&rcache->lock);
+	free(rcache->dir);
+	free(rcache);
+}
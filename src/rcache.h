@@ -0,0 +1,40 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef RCACHE_H
+#define RCACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <types/checker.h>
+#include <types/diag.h>
+#include <types/rcache.h>
+
+extern int rcache_open(const char *, uint64_t, rcache_t **);
+extern void rcache_close(rcache_t *);
+extern void rcache_key(rcache_t *, const void *, size_t, checker_cfg_t *,
+    checker_mtype_t, bool, rcache_key_t *);
+extern int rcache_lookup(rcache_t *, rcache_key_t *, const char *,
+    diag_list_t *);
+extern int rcache_store(rcache_t *, rcache_key_t *, diag_list_t *);
+
+#endif
@@ -0,0 +1,532 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Check server
+ *
+ * The server listens on a Unix domain socket. Each connection carries
+ * one check request: the client working directory, the command-line
+ * arguments and (optionally) standard input, followed by an end marker.
+ * The request is run as if ccheck had been started by the client and
+ * its standard and error output are streamed back as they are produced,
+ * followed by the exit status.
+ *
+ * Every message consists of a type byte (see server_msg_t), a 32-bit
+ * little-endian payload length and the payload. The exit status payload
+ * is a 32-bit little-endian integer.
+ *
+ * Requests are served by a fixed pool of worker threads, each accepting
+ * connections on the shared listening socket.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <merrno.h>
+#include <pthread.h>
+#include <server.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+enum {
+	/** Maximum payload size of a single message */
+	server_max_msg_size = 64 * 1024 * 1024,
+	/** Maximum total payload size of all messages of a request */
+	server_max_req_size = 64 * 1024 * 1024,
+	/** Maximum number of arguments in a request */
+	server_max_args = 4096,
+	/** Listening socket backlog */
+	server_backlog = 64,
+	/** Size of output stream buffer */
+	server_obuf_size = 65536
+};
+
+/** Write data to socket.
+ *
+ * @param sock Socket
+ * @param data Data
+ * @param size Size of data in bytes
+ * @return EOK on success, EIO on error
+ */
+static int server_write(int sock, const void *data, size_t size)
+{
+	const char *cp = (const char *) data;
+	ssize_t nw;
+
+	while (size > 0) {
+		nw = send(sock, cp, size, MSG_NOSIGNAL);
+		if (nw < 0 && errno == EINTR)
+			continue;
+		if (nw <= 0)
+			return EIO;
+
+		cp += nw;
+		size -= nw;
+	}
+
+	return EOK;
+}
+
+/** Read data from socket.
+ *
+ * @param sock Socket
+ * @param data Buffer
+ * @param size Number of bytes to read
+ * @return EOK on success, EIO on error or end of stream
+ */
+static int server_read(int sock, void *data, size_t size)
+{
+	char *cp = (char *) data;
+	ssize_t nr;
+
+	while (size > 0) {
+		nr = read(sock, cp, size);
+		if (nr < 0 && errno == EINTR)
+			continue;
+		if (nr <= 0)
+			return EIO;
+
+		cp += nr;
+		size -= nr;
+	}
+
+	return EOK;
+}
+
+/** Write protocol message.
+ *
+ * @param sock Socket
+ * @param mtype Message type
+ * @param data Payload
+ * @param size Payload size in bytes
+ * @return EOK on success, EIO on error
+ */
+int server_write_msg(int sock, server_msg_t mtype, const void *data,
+    size_t size)
+{
+	uint8_t hdr[5];
+	int rc;
+
+	hdr[0] = mtype;
+	hdr[1] = size & 0xff;
+	hdr[2] = (size >> 8) & 0xff;
+	hdr[3] = (size >> 16) & 0xff;
+	hdr[4] = (size >> 24) & 0xff;
+
+	rc = server_write(sock, hdr, sizeof(hdr));
+	if (rc != EOK)
+		return rc;
+
+	return server_write(sock, data, size);
+}
+
+/** Read protocol message.
+ *
+ * The payload is null-terminated (the terminator is not included
+ * in the size).
+ *
+ * @param sock Socket
+ * @param rmtype Place to store message type
+ * @param rdata Place to store pointer to newly allocated payload
+ * @param rsize Place to store payload size
+ * @return EOK on success, EIO on error or end of stream, EINVAL if
+ *         the message is too large, ENOMEM if out of memory
+ */
+int server_read_msg(int sock, server_msg_t *rmtype, char **rdata,
+    size_t *rsize)
+{
+	uint8_t hdr[5];
+	uint32_t size;
+	char *data;
+	int rc;
+
+	rc = server_read(sock, hdr, sizeof(hdr));
+	if (rc != EOK)
+		return rc;
+
+	size = hdr[1] | (uint32_t) hdr[2] << 8 | (uint32_t) hdr[3] << 16 |
+	    (uint32_t) hdr[4] << 24;
+	if (size > server_max_msg_size)
+		return EINVAL;
+
+	data = malloc(size + 1);
+	if (data == NULL)
+		return ENOMEM;
+
+	rc = server_read(sock, data, size);
+	if (rc != EOK) {
+		free(data);
+		return rc;
+	}
+
+	data[size] = '\0';
+	*rmtype = hdr[0];
+	*rdata = data;
+	*rsize = size;
+	return EOK;
+}
+
+/** Server output stream write function.
+ *
+ * @param cookie Output stream (server_ostream_t *)
+ * @param buf Data
+ * @param size Size of data in bytes
+ * @return Number of bytes written or -1 on error
+ */
+static ssize_t server_ostream_write(void *cookie, const char *buf,
+    size_t size)
+{
+	server_ostream_t *os = (server_ostream_t *) cookie;
+
+	if (size == 0)
+		return 0;
+
+	if (server_write_msg(os->sock, os->mtype, buf, size) != EOK)
+		return -1;
+
+	return size;
+}
+
+static cookie_io_functions_t server_ostream_io = {
+	.write = server_ostream_write
+};
+
+/** Received request */
+typedef struct {
+	/** Working directory */
+	char *cwd;
+	/** Arguments */
+	char **argv;
+	/** Number of arguments */
+	int argc;
+	/** Standard input contents */
+	char *input;
+	/** Size of standard input */
+	size_t input_size;
+	/** Total payload size of messages received so far */
+	size_t size;
+} server_rreq_t;
+
+/** Free received request.
+ *
+ * @param rreq Received request
+ */
+static void server_rreq_fini(server_rreq_t *rreq)
+{
+	int i;
+
+	for (i = 0; i < rreq->argc; i++)
+		free(rreq->argv[i]);
+	free(rreq->argv);
+	free(rreq->cwd);
+	free(rreq->input);
+}
+
+/** Receive request.
+ *
+ * The total size of the request is limited, so that a client cannot make
+ * the server allocate an unbounded amount of memory.
+ *
+ * @param sock Connection socket
+ * @param rreq Received request (zero-initialized)
+ * @return EOK on success, E2BIG if the request is too large (or has too
+ *         many arguments), other error code if receiving the request failed
+ */
+static int server_recv_req(int sock, server_rreq_t *rreq)
+{
+	server_msg_t mtype;
+	char *data;
+	char *ninput;
+	char **nargv;
+	size_t size;
+	int rc;
+
+	/* argv[0] is the program name */
+	rreq->argv = calloc(server_max_args + 1, sizeof(char *));
+	if (rreq->argv == NULL)
+		return ENOMEM;
+
+	rreq->argv[0] = strdup("ccheck");
+	if (rreq->argv[0] == NULL)
+		return ENOMEM;
+	rreq->argc = 1;
+
+	while (true) {
+		rc = server_read_msg(sock, &mtype, &data, &size);
+		if (rc == EINVAL)
+			return E2BIG;
+		if (rc != EOK)
+			return rc;
+
+		rreq->size += size;
+		if (rreq->size > server_max_req_size) {
+			free(data);
+			return E2BIG;
+		}
+
+		switch (mtype) {
+		case smt_cwd:
+			free(rreq->cwd);
+			rreq->cwd = data;
+			break;
+		case smt_arg:
+			if (rreq->argc >= server_max_args) {
+				free(data);
+				return E2BIG;
+			}
+
+			rreq->argv[rreq->argc++] = data;
+			break;
+		case smt_input:
+			ninput = realloc(rreq->input, rreq->input_size + size);
+			if (ninput == NULL && rreq->input_size + size > 0) {
+				free(data);
+				return ENOMEM;
+			}
+
+			rreq->input = ninput;
+			memcpy(rreq->input + rreq->input_size, data, size);
+			rreq->input_size += size;
+			free(data);
+			break;
+		case smt_end:
+			free(data);
+			if (rreq->cwd == NULL)
+				return EINVAL;
+
+			/* Trim argument array */
+			nargv = realloc(rreq->argv, (rreq->argc + 1) *
+			    sizeof(char *));
+			if (nargv != NULL)
+				rreq->argv = nargv;
+			return EOK;
+		default:
+			free(data);
+			return EINVAL;
+		}
+	}
+}
+
+/** Send exit status.
+ *
+ * @param sock Connection socket
+ * @param status Exit status
+ * @return EOK on success, EIO on error
+ */
+static int server_send_exit(int sock, int status)
+{
+	uint8_t sbuf[4];
+
+	sbuf[0] = status & 0xff;
+	sbuf[1] = (status >> 8) & 0xff;
+	sbuf[2] = (status >> 16) & 0xff;
+	sbuf[3] = (status >> 24) & 0xff;
+	return server_write_msg(sock, smt_exit, sbuf, sizeof(sbuf));
+}
+
+/** Serve one connection.
+ *
+ * @param server Server
+ * @param sock Connection socket
+ */
+static void server_serve(server_t *server, int sock)
+{
+	server_rreq_t rreq;
+	server_req_t req;
+	server_ostream_t out;
+	server_ostream_t err;
+	char obuf[server_obuf_size];
+	const char *emsg;
+	int dirfd = -1;
+	int status;
+	int rc;
+
+	memset(&rreq, 0, sizeof(rreq));
+	memset(&req, 0, sizeof(req));
+
+	rc = server_recv_req(sock, &rreq);
+	if (rc == E2BIG) {
+		/* The client can still read the reply */
+		emsg = "Request too large.\n";
+		if (server_write_msg(sock, smt_err, emsg, strlen(emsg)) ==
+		    EOK)
+			(void) server_send_exit(sock, 1);
+		goto error;
+	}
+
+	if (rc != EOK)
+		goto error;
+
+	dirfd = open(rreq.cwd, O_RDONLY | O_DIRECTORY);
+	if (dirfd < 0)
+		goto error;
+
+	out.sock = sock;
+	out.mtype = smt_out;
+	err.sock = sock;
+	err.mtype = smt_err;
+
+	req.argc = rreq.argc;
+	req.argv = rreq.argv;
+	req.cwd = rreq.cwd;
+	req.dirfd = dirfd;
+	req.inf = fmemopen(rreq.input != NULL ? rreq.input : "",
+	    rreq.input_size, "r");
+	req.outf = fopencookie(&out, "w", server_ostream_io);
+	req.errf = fopencookie(&err, "w", server_ostream_io);
+	if (req.inf == NULL || req.outf == NULL || req.errf == NULL)
+		goto error;
+
+	/* Same buffering as standard output and error output */
+	setvbuf(req.outf, obuf, _IOFBF, sizeof(obuf));
+	setvbuf(req.errf, NULL, _IOLBF, 0);
+
+	rc = server->ops->run(server->arg, &req);
+	status = rc == EOK ? 0 : 1;
+
+	if (fclose(req.outf) != 0 || fclose(req.errf) != 0) {
+		req.outf = NULL;
+		req.errf = NULL;
+		goto error;
+	}
+
+	req.outf = NULL;
+	req.errf = NULL;
+
+	(void) server_send_exit(sock, status);
+error:
+	if (req.inf != NULL)
+		fclose(req.inf);
+	if (req.outf != NULL)
+		fclose(req.outf);
+	if (req.errf != NULL)
+		fclose(req.errf);
+	if (dirfd >= 0)
+		close(dirfd);
+	server_rreq_fini(&rreq);
+}
+
+/** Server worker thread main function.
+ *
+ * @param arg Server (server_t *)
+ * @return NULL
+ */
+static void *server_worker(void *arg)
+{
+	server_t *server = (server_t *) arg;
+	int sock;
+
+	while (true) {
+		sock = accept(server->lsock, NULL, NULL);
+		if (sock < 0) {
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+			break;
+		}
+
+		server_serve(server, sock);
+		close(sock);
+	}
+
+	return NULL;
+}
+
+/** Run check server.
+ *
+ * Listen on a Unix domain socket and serve check requests. This
+ * function only returns on error.
+ *
+ * @param sockpath Socket path (an existing socket is replaced)
+ * @param nworkers Number of worker threads
+ * @param ops Ops for running requests
+ * @param arg Argument to @a ops
+ * @return Error code
+ */
+int server_run(const char *sockpath, unsigned nworkers, server_ops_t *ops,
+    void *arg)
+{
+	server_t server;
+	struct sockaddr_un addr;
+	struct stat st;
+	pthread_t *threads;
+	unsigned nthreads;
+	unsigned i;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (strlen(sockpath) >= sizeof(addr.sun_path)) {
+		fprintf(stderr, "Socket path '%s' is too long.\n", sockpath);
+		return EINVAL;
+	}
+
+	strcpy(addr.sun_path, sockpath);
+
+	/* Remove stale socket left behind by a previous server */
+	if (lstat(sockpath, &st) == 0 && S_ISSOCK(st.st_mode))
+		(void) unlink(sockpath);
+
+	server.ops = ops;
+	server.arg = arg;
+	server.lsock = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (server.lsock < 0) {
+		fprintf(stderr, "Cannot create socket.\n");
+		return EIO;
+	}
+
+	if (bind(server.lsock, (struct sockaddr *) &addr, sizeof(addr)) < 0 ||
+	    listen(server.lsock, server_backlog) < 0) {
+		fprintf(stderr, "Cannot listen on '%s'.\n", sockpath);
+		close(server.lsock);
+		return EIO;
+	}
+
+	/* The calling thread is one of the workers */
+	threads = calloc(nworkers, sizeof(pthread_t));
+	if (threads == NULL) {
+		close(server.lsock);
+		return ENOMEM;
+	}
+
+	nthreads = 0;
+	for (i = 1; i < nworkers; i++) {
+		if (pthread_create(&threads[nthreads], NULL, server_worker,
+		    &server) != 0)
+			break;
+		++nthreads;
+	}
+
+	(void) server_worker(&server);
+
+	/* Accepting failed, workers will fail as well */
+	for (i = 0; i < nthreads; i++)
+		pthread_join(threads[i], NULL);
+
+	free(threads);
+	close(server.lsock);
+	(void) unlink(sockpath);
+	return EIO;
+}
@@ -45,7 +45,7 @@ static int str_lexer_read(void *arg, char *buf, size_t bsize, size_t *nread,
 	size_t len;
 	size_t i;
 
-	len = strlen(sinput->str + sinput->pos);
+	len = sinput->len - sinput->pos;
 	if (bsize < len)
 		len = bsize;
 
@@ -57,16 +57,13 @@ static int str_lexer_read(void *arg, char *buf, size_t bsize, size_t *nread,
 	for (i = 0; i < len; i++)
 		src_pos_fwd_char(&sinput->cpos, sinput->str[sinput->pos++]);
 
-	printf("str_lexer_read: pos=");
-	src_pos_print_range(&sinput->cpos, &sinput->cpos, stdout);
-	printf("\n");
-
 	return EOK;
 }
 
 void str_input_init(str_input_t *sinput, const char *s)
 {
 	sinput->str = s;
+	sinput->len = strlen(s);
 	sinput->pos = 0;
 
 	src_pos_set(&sinput->cpos, "none", 1, 1);
@@ -0,0 +1,381 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Sycek library
+ *
+ * Stable interface for checking source code in-process: create a checker
+ * instance from a buffer or a file, run it with a set of check groups,
+ * then iterate over the issues found and/or retrieve the fixed text.
+ * Instances are independent of each other.
+ *
+ * The interface only uses types declared in sycek.h, so that the layout
+ * of internal structures is not part of the library ABI.
+ */
+
+#include <buf_input.h>
+#include <checker.h>
+#include <diag.h>
+#include <lexer.h>
+#include <merrno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sycek.h>
+
+enum {
+	/** Initial buffer size for reading a file */
+	sycek_read_init_alloc = 16384,
+	/** Maximum length of formatted message including null terminator */
+	sycek_msg_max_len = 256
+};
+
+/** Check group bits of the interface and the corresponding check groups */
+static const struct {
+	unsigned bit;
+	diag_group_t group;
+} sycek_groups[] = {
+	{ sycek_grp_decl, dg_decl },
+	{ sycek_grp_estmt, dg_estmt },
+	{ sycek_grp_fmt, dg_fmt },
+	{ sycek_grp_hdr, dg_hdr },
+	{ sycek_grp_invchar, dg_invchar },
+	{ sycek_grp_loop, dg_loop },
+	{ sycek_grp_nblock, dg_nblock },
+	{ sycek_grp_sclass, dg_sclass }
+};
+
+/** Sycek library checker instance */
+struct sycek {
+	/** Source text (owned copy) */
+	char *text;
+	/** Size of @c text */
+	size_t size;
+	/** File name */
+	char *fname;
+	/** Module type */
+	checker_mtype_t mtype;
+	/** Checker configuration used by the last run */
+	checker_cfg_t cfg;
+	/** Lexer input */
+	buf_input_t binput;
+	/** Checker of the last run or @c NULL */
+	checker_t *checker;
+	/** Issues found by the last run */
+	diag_list_t diags;
+	/** @c true iff the last run was successful */
+	bool run_ok;
+	/** Parse error output of the last run */
+	FILE *errf;
+	/** Buffer of @c errf */
+	char *errs;
+	/** Size of @c errs */
+	size_t errs_size;
+	/** Formatted message of the last diagnostic retrieved */
+	char msg[sycek_msg_max_len];
+};
+
+/** Create checker instance from source text in memory.
+ *
+ * The text is copied, so the buffer can be reused as soon as the function
+ * returns. The text does not need to be null-terminated.
+ *
+ * @param text Source text
+ * @param size Size of @a text in bytes
+ * @param fname File name used when reporting issues
+ * @param mtype Module type (C source or header)
+ * @param rsycek Place to store pointer to new instance
+ * @return EOK on success, EINVAL if @a mtype is not valid, ENOMEM if out
+ *         of memory
+ */
+int sycek_create_buf(const char *text, size_t size, const char *fname,
+    sycek_mtype_t mtype, sycek_t **rsycek)
+{
+	sycek_t *sycek;
+
+	if (mtype != sycek_mod_c && mtype != sycek_mod_header)
+		return EINVAL;
+
+	sycek = calloc(1, sizeof(sycek_t));
+	if (sycek == NULL)
+		return ENOMEM;
+
+	diag_list_init(&sycek->diags);
+
+	/* One extra byte so that an empty text is not a null pointer */
+	sycek->text = malloc(size + 1);
+	sycek->fname = strdup(fname);
+	if (sycek->text == NULL || sycek->fname == NULL) {
+		sycek_destroy(sycek);
+		return ENOMEM;
+	}
+
+	memcpy(sycek->text, text, size);
+	sycek->size = size;
+	sycek->mtype = mtype == sycek_mod_header ? cmod_header : cmod_c;
+
+	*rsycek = sycek;
+	return EOK;
+}
+
+/** Create checker instance from source file.
+ *
+ * @param fname File name
+ * @param mtype Module type (C source or header)
+ * @param rsycek Place to store pointer to new instance
+ * @return EOK on success, ENOENT if the file cannot be opened,
+ *         EIO on I/O error, EINVAL if @a mtype is not valid, ENOMEM if out
+ *         of memory
+ */
+int sycek_create_file(const char *fname, sycek_mtype_t mtype,
+    sycek_t **rsycek)
+{
+	FILE *f;
+	char *buf = NULL;
+	char *nbuf;
+	size_t size = 0;
+	size_t alloc = 0;
+	size_t nread;
+	int rc;
+
+	f = fopen(fname, "rb");
+	if (f == NULL)
+		return ENOENT;
+
+	do {
+		if (size >= alloc) {
+			alloc = alloc != 0 ? 2 * alloc : sycek_read_init_alloc;
+			nbuf = realloc(buf, alloc);
+			if (nbuf == NULL) {
+				rc = ENOMEM;
+				goto error;
+			}
+
+			buf = nbuf;
+		}
+
+		nread = fread(buf + size, 1, alloc - size, f);
+		size += nread;
+	} while (nread > 0);
+
+	if (ferror(f)) {
+		rc = EIO;
+		goto error;
+	}
+
+	fclose(f);
+	f = NULL;
+
+	rc = sycek_create_buf(buf, size, fname, mtype, rsycek);
+	if (rc != EOK)
+		goto error;
+
+	free(buf);
+	return EOK;
+error:
+	if (f != NULL)
+		fclose(f);
+	free(buf);
+	return rc;
+}
+
+/** Destroy results of the last run.
+ *
+ * @param sycek Checker instance
+ */
+static void sycek_run_fini(sycek_t *sycek)
+{
+	if (sycek->checker != NULL)
+		checker_destroy(sycek->checker);
+	sycek->checker = NULL;
+	sycek->run_ok = false;
+	diag_list_clear(&sycek->diags);
+
+	if (sycek->errf != NULL)
+		fclose(sycek->errf);
+	sycek->errf = NULL;
+
+	free(sycek->errs);
+	sycek->errs = NULL;
+	sycek->errs_size = 0;
+}
+
+/** Destroy checker instance.
+ *
+ * @param sycek Checker instance or @c NULL
+ */
+void sycek_destroy(sycek_t *sycek)
+{
+	if (sycek == NULL)
+		return;
+
+	sycek_run_fini(sycek);
+	diag_list_fini(&sycek->diags);
+	free(sycek->text);
+	free(sycek->fname);
+	free(sycek);
+}
+
+/** Check the source text.
+ *
+ * Each run starts from the original text, discarding the results
+ * of any previous run. With @a fix, issues are fixed where possible
+ * and only the remaining issues are reported.
+ *
+ * @param sycek Checker instance
+ * @param groups Mask of check groups to enable (sycek_grp_xxx, bits
+ *               not known to the library are ignored)
+ * @param fix @c true to fix issues, @c false to only report them
+ * @return EOK on success (regardless whether issues are found), EINVAL
+ *         if the text could not be parsed (see sycek_errors()), ENOMEM
+ *         if out of memory
+ */
+int sycek_run(sycek_t *sycek, unsigned groups, bool fix)
+{
+	unsigned mask = 0;
+	size_t i;
+	int rc;
+
+	sycek_run_fini(sycek);
+
+	for (i = 0; i < sizeof(sycek_groups) / sizeof(sycek_groups[0]); i++) {
+		if ((groups & sycek_groups[i].bit) != 0)
+			mask |= 1u << sycek_groups[i].group;
+	}
+
+	checker_cfg_set_mask(&sycek->cfg, mask);
+
+	sycek->errf = open_memstream(&sycek->errs, &sycek->errs_size);
+	if (sycek->errf == NULL)
+		return ENOMEM;
+
+	buf_input_init(&sycek->binput, sycek->text, sycek->size,
+	    sycek->fname);
+
+	rc = checker_create(&lexer_buf_input, &sycek->binput, sycek->mtype,
+	    &sycek->cfg, &sycek->checker);
+	if (rc != EOK)
+		return rc;
+
+	checker_set_sink(sycek->checker, &diag_list_sink, &sycek->diags);
+	checker_set_errf(sycek->checker, sycek->errf);
+	checker_set_fps(sycek->checker);
+
+	rc = checker_run(sycek->checker, fix);
+	if (rc != EOK)
+		return rc;
+
+	diag_list_sort(&sycek->diags);
+	sycek->run_ok = true;
+	return EOK;
+}
+
+/** Get number of issues found by the last run.
+ *
+ * @param sycek Checker instance
+ * @return Number of issues
+ */
+size_t sycek_diag_count(sycek_t *sycek)
+{
+	return sycek->diags.ndiags;
+}
+
+/** Get issue found by the last run.
+ *
+ * Issues are ordered by their position in the source text.
+ *
+ * @param sycek Checker instance
+ * @param idx Index of issue (less than sycek_diag_count())
+ * @param rdiag Place to store issue
+ * @return EOK on success, ENOENT if there is no such issue
+ */
+int sycek_diag_get(sycek_t *sycek, size_t idx, sycek_diag_t *rdiag)
+{
+	diag_t *diag;
+
+	if (idx >= sycek_diag_count(sycek))
+		return ENOENT;
+
+	diag = &sycek->diags.diag[idx];
+	diag_format_msg(diag, sycek->msg, sizeof(sycek->msg));
+
+	rdiag->file = diag->file;
+	rdiag->bline = diag->bline;
+	rdiag->bcol = diag->bcol;
+	rdiag->eline = diag->eline;
+	rdiag->ecol = diag->ecol;
+	rdiag->group = diag_group_str(diag->group);
+	rdiag->id = diag_msg_str(diag->msg);
+	rdiag->msg = sycek->msg;
+	rdiag->fp = diag->fp;
+	return EOK;
+}
+
+/** Get parse errors reported by the last run.
+ *
+ * @param sycek Checker instance
+ * @return Error messages (one per line) or empty string if none
+ */
+const char *sycek_errors(sycek_t *sycek)
+{
+	if (sycek->errf == NULL || fflush(sycek->errf) != 0 ||
+	    sycek->errs == NULL)
+		return "";
+
+	return sycek->errs;
+}
+
+/** Get source text after fixing issues.
+ *
+ * @param sycek Checker instance after a successful run with fixing
+ * @param rtext Place to store pointer to newly allocated text (null
+ *              terminated, to be freed by the caller using free())
+ * @param rsize Place to store size of text
+ * @return EOK on success, EINVAL if there was no successful run,
+ *         ENOMEM if out of memory
+ */
+int sycek_fixed_text(sycek_t *sycek, char **rtext, size_t *rsize)
+{
+	FILE *f;
+	char *text = NULL;
+	size_t size = 0;
+	int rc;
+
+	if (!sycek->run_ok)
+		return EINVAL;
+
+	f = open_memstream(&text, &size);
+	if (f == NULL)
+		return ENOMEM;
+
+	rc = checker_print(sycek->checker, f);
+	if (fclose(f) != 0 && rc == EOK)
+		rc = ENOMEM;
+	if (rc != EOK) {
+		free(text);
+		return rc;
+	}
+
+	*rtext = text;
+	*rsize = size;
+	return EOK;
+}
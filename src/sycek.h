@@ -0,0 +1,103 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Sycek library
+ *
+ * This header is self-contained and is installed along with the library.
+ * Values of the enumerations below are part of the interface and never
+ * change.
+ */
+
+#ifndef SYCEK_H
+#define SYCEK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Sycek library checker instance (opaque) */
+typedef struct sycek sycek_t;
+
+/** Module type */
+typedef enum {
+	/** C source file */
+	sycek_mod_c = 0,
+	/** Header file */
+	sycek_mod_header = 1
+} sycek_mtype_t;
+
+/** Check groups (bits of a check group mask) */
+enum {
+	/** Declaration style */
+	sycek_grp_decl = 0x1,
+	/** Empty statement */
+	sycek_grp_estmt = 0x2,
+	/** Formatting */
+	sycek_grp_fmt = 0x4,
+	/** Header style */
+	sycek_grp_hdr = 0x8,
+	/** Invalid characters */
+	sycek_grp_invchar = 0x10,
+	/** Loop style */
+	sycek_grp_loop = 0x20,
+	/** Nested block */
+	sycek_grp_nblock = 0x40,
+	/** Storage class issues */
+	sycek_grp_sclass = 0x80,
+	/** All check groups */
+	sycek_grp_all = 0xff
+};
+
+/** Issue found by the checker */
+typedef struct {
+	/** File name */
+	const char *file;
+	/** Line of beginning of range */
+	size_t bline;
+	/** Column of beginning of range */
+	size_t bcol;
+	/** Line of end of range */
+	size_t eline;
+	/** Column of end of range */
+	size_t ecol;
+	/** Check group name (e.g. "fmt") */
+	const char *group;
+	/** Stable message ID (e.g. "lbegin") */
+	const char *id;
+	/** Message text (valid until the next call to sycek_diag_get()) */
+	const char *msg;
+	/** Position-independent fingerprint of the issue */
+	uint64_t fp;
+} sycek_diag_t;
+
+extern int sycek_create_buf(const char *, size_t, const char *,
+    sycek_mtype_t, sycek_t **);
+extern int sycek_create_file(const char *, sycek_mtype_t, sycek_t **);
+extern void sycek_destroy(sycek_t *);
+extern int sycek_run(sycek_t *, unsigned, bool);
+extern size_t sycek_diag_count(sycek_t *);
+extern int sycek_diag_get(sycek_t *, size_t, sycek_diag_t *);
+extern const char *sycek_errors(sycek_t *);
+extern int sycek_fixed_text(sycek_t *, char **, size_t *);
+
+#endif
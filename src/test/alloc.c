@@ -0,0 +1,272 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Allocation test
+ *
+ * Checks (and fixes) every source file in a directory tree with
+ * allocation tracking enabled, verifying that the lexer, parser, AST
+ * and checker free all memory they allocate. Much faster than running
+ * each file through valgrind.
+ */
+
+#include <alloc.h>
+#include <checker.h>
+#include <fcntl.h>
+#include <flist.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str_input.h>
+#include <string.h>
+#include <sycek.h>
+#include <test/alloc.h>
+
+/** Source used to count AST nodes */
+static const char *str_nodes = "int main(void)\n{\n\treturn 0;\n}\n";
+
+/** Determine module type from file name.
+ *
+ * @param fname File name
+ * @return Module type
+ */
+static sycek_mtype_t test_alloc_mtype(const char *fname)
+{
+	const char *ext;
+
+	ext = strrchr(fname, '.');
+	if (ext != NULL && strcmp(ext, ".h") == 0)
+		return sycek_mod_header;
+
+	return sycek_mod_c;
+}
+
+/** Verify that the tracker detects a leak.
+ *
+ * @return EOK on success or EINVAL if the leak was not detected
+ */
+static int test_alloc_self(void)
+{
+	alloc_track_t track;
+	alloc_mark_t mark;
+	size_t nleaked;
+	void *p;
+
+	alloc_track_init(&track);
+	alloc_track_set(&track);
+
+	alloc_track_mark(&mark);
+	p = alloc_malloc(as_checker, 1);
+	nleaked = alloc_track_check(&mark);
+	alloc_free(p);
+
+	alloc_track_set(NULL);
+
+	if (p == NULL || nleaked != 1 || track.ss[as_checker].nblocks != 0) {
+		fprintf(stderr, "Allocation tracker failed to detect leak.\n");
+		return EINVAL;
+	}
+
+	return EOK;
+}
+
+/** Verify that AST nodes allocated while parsing are counted.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_alloc_nodes(void)
+{
+	checker_t *checker;
+	checker_stats_t stats;
+	str_input_t sinput;
+	checker_cfg_t cfg;
+	alloc_track_t track;
+	int rc;
+
+	memset(&stats, 0, sizeof(stats));
+	checker_cfg_init(&cfg);
+	str_input_init(&sinput, str_nodes);
+
+	alloc_track_init(&track);
+	alloc_track_set(&track);
+
+	rc = checker_create(&lexer_str_input, &sinput, cmod_c, &cfg, &checker);
+	if (rc != EOK)
+		goto error;
+
+	checker_set_stats(checker, &stats);
+	rc = checker_run(checker, false);
+	checker_destroy(checker);
+	if (rc != EOK)
+		goto error;
+
+	if (stats.nnodes == 0 || stats.nnodes != track.ss[as_ast].nallocs) {
+		fprintf(stderr, "AST nodes not counted.\n");
+		rc = EINVAL;
+		goto error;
+	}
+
+	alloc_track_set(NULL);
+	return EOK;
+error:
+	alloc_track_set(NULL);
+	return rc;
+}
+
+/** Check and fix one file, tracking allocations.
+ *
+ * @param fname File name
+ * @param track Allocation tracker
+ * @return EOK on success, EINVAL if memory was leaked, other error
+ *         code if the file could not be checked
+ */
+static int test_alloc_check(const char *fname, alloc_track_t *track)
+{
+	sycek_t *sycek;
+	char *text;
+	size_t size;
+	size_t nleaked;
+	size_t nlive;
+	unsigned i;
+	int rc;
+
+	rc = sycek_create_file(fname, test_alloc_mtype(fname), &sycek);
+	if (rc != EOK) {
+		fprintf(stderr, "Error reading '%s'.\n", fname);
+		return rc;
+	}
+
+	alloc_track_init(track);
+	alloc_track_set(track);
+
+	/* Parse errors are expected in some files, they free memory, too */
+	(void) sycek_run(sycek, sycek_grp_all, false);
+	if (sycek_run(sycek, sycek_grp_all, true) == EOK &&
+	    sycek_fixed_text(sycek, &text, &size) == EOK)
+		free(text);
+
+	sycek_destroy(sycek);
+	alloc_track_set(NULL);
+
+	nleaked = 0;
+	nlive = 0;
+	for (i = 0; i < as_limit; i++) {
+		nleaked += track->ss[i].nleaked;
+		nlive += track->ss[i].nblocks;
+	}
+
+	if (nleaked == 0 && nlive == 0)
+		return EOK;
+
+	fprintf(stderr, "%s: %zu blocks leaked by checker, %zu never freed "
+	    "(", fname, nleaked, nlive);
+	for (i = 0; i < as_limit; i++) {
+		fprintf(stderr, "%s%s: %zu", i > 0 ? ", " : "",
+		    alloc_subsys_name(i), track->ss[i].nblocks);
+	}
+	fprintf(stderr, ").\n");
+	return EINVAL;
+}
+
+/** Run allocation test.
+ *
+ * Must be called before any memory is allocated by the tracked
+ * subsystems, since it enables allocation tracking.
+ *
+ * @param dir Directory containing source files to check
+ * @return EOK on success or non-zero error code
+ */
+int test_alloc(const char *dir)
+{
+	flist_t *flist = NULL;
+	alloc_track_t track;
+	alloc_stats_t total[as_limit];
+	size_t peak;
+	size_t nbad;
+	size_t i;
+	unsigned j;
+	int rc;
+
+	alloc_track_enable();
+
+	rc = test_alloc_self();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_alloc_nodes();
+	if (rc != EOK)
+		return rc;
+
+	rc = flist_create(AT_FDCWD, stderr, &flist);
+	if (rc != EOK)
+		goto error;
+
+	rc = flist_add_path(flist, dir);
+	if (rc != EOK)
+		goto error;
+
+	flist_uniq(flist);
+	if (flist->nentries == 0) {
+		fprintf(stderr, "No source files found in '%s'.\n", dir);
+		rc = ENOENT;
+		goto error;
+	}
+
+	memset(total, 0, sizeof(total));
+	peak = 0;
+	nbad = 0;
+
+	for (i = 0; i < flist->nentries; i++) {
+		rc = test_alloc_check(flist->entry[i].path, &track);
+		if (rc == EINVAL)
+			++nbad;
+		else if (rc != EOK)
+			goto error;
+
+		for (j = 0; j < as_limit; j++) {
+			total[j].nallocs += track.ss[j].nallocs;
+			total[j].nbytes += track.ss[j].nbytes;
+			total[j].nleaked += track.ss[j].nleaked;
+			if (track.ss[j].peak > total[j].peak)
+				total[j].peak = track.ss[j].peak;
+		}
+
+		if (track.peak > peak)
+			peak = track.peak;
+	}
+
+	printf("Checked %zu files, %zu with leaks.\n", flist->nentries, nbad);
+	printf("%-8s %10s %12s %10s %8s\n", "", "allocs", "bytes",
+	    "max peak", "leaked");
+	for (j = 0; j < as_limit; j++) {
+		printf("%-8s %10zu %12zu %10zu %8zu\n", alloc_subsys_name(j),
+		    total[j].nallocs, total[j].nbytes, total[j].peak,
+		    total[j].nleaked);
+	}
+	printf("Max peak of all subsystems: %zu bytes.\n", peak);
+
+	rc = nbad == 0 ? EOK : EINVAL;
+error:
+	flist_destroy(flist);
+	return rc;
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test baseline of known issues
+ */
+
+#include <baseline.h>
+#include <checker.h>
+#include <diag.h>
+#include <merrno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str_input.h>
+#include <string.h>
+#include <test/baseline.h>
+#include <unistd.h>
+
+/** Source with issues recorded in baseline */
+static const char *str_old =
+    "int f(void)\n"
+    "{\n"
+    "\treturn 0 ;\n"
+    "}\n";
+
+/** Source with lines shifted and new issues */
+static const char *str_new =
+    "int g;\n"
+    "\n"
+    "int f(void)\n"
+    "{\n"
+    "\treturn 0 ;\n"
+    "\treturn 0 ;\n"
+    "}\n"
+    "\n"
+    "int h(void)\n"
+    "{\n"
+    "\treturn 0 ;\n"
+    "}\n";
+
+/** Check source code and collect sorted diagnostics.
+ *
+ * @param str Source code
+ * @param diags Diagnostic list to fill in
+ * @return EOK on success or non-zero error code
+ */
+static int test_baseline_check(const char *str, diag_list_t *diags)
+{
+	checker_t *checker;
+	str_input_t sinput;
+	checker_cfg_t cfg;
+	int rc;
+
+	checker_cfg_init(&cfg);
+	str_input_init(&sinput, str);
+
+	rc = checker_create(&lexer_str_input, &sinput, cmod_c, &cfg, &checker);
+	if (rc != EOK)
+		return rc;
+
+	checker_set_sink(checker, &diag_list_sink, diags);
+	checker_set_fps(checker);
+
+	rc = checker_run(checker, false);
+	checker_destroy(checker);
+	if (rc != EOK)
+		return rc;
+
+	diag_list_sort(diags);
+	return EOK;
+}
+
+/** Write baseline file with no empty slot.
+ *
+ * @param path File path
+ * @return EOK on success or error code
+ */
+static int test_baseline_write_full(const char *path)
+{
+	static const uint8_t hdr[32] = {
+		'C', 'C', 'K', 'B', 1, 0, 0, 0, 16, 0, 0, 0, 0, 0, 0, 0
+	};
+	uint8_t slot[8];
+	FILE *f;
+	unsigned i;
+	int rc;
+
+	f = fopen(path, "wb");
+	if (f == NULL)
+		return EIO;
+
+	rc = fwrite(hdr, 1, sizeof(hdr), f) == sizeof(hdr) ? EOK : EIO;
+	for (i = 0; i < 16 && rc == EOK; i++) {
+		memset(slot, 0, sizeof(slot));
+		slot[0] = i + 2;
+		if (fwrite(slot, 1, sizeof(slot), f) != sizeof(slot))
+			rc = EIO;
+	}
+
+	if (fclose(f) < 0)
+		rc = EIO;
+	return rc;
+}
+
+/** Run baseline tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_baseline(void)
+{
+	char path[] = "/tmp/ccheck-baseline-XXXXXX";
+	baseline_wr_t *wr = NULL;
+	baseline_t *baseline = NULL;
+	diag_list_t diags;
+	FILE *f;
+	int fd;
+	int rc;
+
+	diag_list_init(&diags);
+
+	fd = mkstemp(path);
+	if (fd < 0)
+		return EIO;
+	close(fd);
+
+	/* Empty file is not a valid baseline */
+	rc = baseline_open(path, &baseline);
+	if (rc != EINVAL) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = test_baseline_check(str_old, &diags);
+	if (rc != EOK)
+		goto error;
+
+	if (diags.ndiags != 1) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = baseline_wr_create(&wr);
+	if (rc != EOK)
+		goto error;
+
+	rc = baseline_wr_add(wr, &diags);
+	if (rc != EOK)
+		goto error;
+
+	rc = baseline_wr_write(wr, path);
+	if (rc != EOK)
+		goto error;
+
+	diag_list_clear(&diags);
+
+	rc = baseline_open(path, &baseline);
+	if (rc != EOK)
+		goto error;
+
+	/*
+	 * The known issue moved down two lines. The second copy in the same
+	 * function and the copy in another function are new.
+	 */
+	rc = test_baseline_check(str_new, &diags);
+	if (rc != EOK)
+		goto error;
+
+	rc = baseline_filter(baseline, &diags);
+	if (rc != EOK)
+		goto error;
+
+	if (diags.ndiags != 2 || diags.diag[0].bline != 6 ||
+	    diags.diag[1].bline != 11) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	baseline_close(baseline);
+	baseline = NULL;
+
+	/* Truncated baseline is detected */
+	f = fopen(path, "r+b");
+	if (f == NULL || ftruncate(fileno(f), 40) < 0) {
+		if (f != NULL)
+			fclose(f);
+		rc = EIO;
+		goto error;
+	}
+
+	fclose(f);
+
+	rc = baseline_open(path, &baseline);
+	if (rc != EINVAL) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	baseline = NULL;
+
+	/* Lookup terminates even if no slot is empty */
+	rc = test_baseline_write_full(path);
+	if (rc != EOK)
+		goto error;
+
+	rc = baseline_open(path, &baseline);
+	if (rc != EOK)
+		goto error;
+
+	if (baseline_contains(baseline, 1) || !baseline_contains(baseline, 2)) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	baseline_close(baseline);
+	baseline = NULL;
+	(void) unlink(path);
+
+	rc = baseline_open(path, &baseline);
+	if (rc != ENOENT) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	baseline_wr_destroy(wr);
+	diag_list_fini(&diags);
+	return EOK;
+error:
+	baseline_close(baseline);
+	baseline_wr_destroy(wr);
+	diag_list_fini(&diags);
+	(void) unlink(path);
+	return rc;
+}
@@ -25,9 +25,12 @@
  */
 
 #include <checker.h>
+#include <diag.h>
 #include <merrno.h>
 #include <src_pos.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <str_input.h>
 #include <string.h>
 #include <test/checker.h>
@@ -58,12 +61,465 @@ static int test_check_string(const char *str)
 		return rc;
 
 	rc = checker_run(checker, false);
+	if (rc != EOK)
+		goto error;
+
+	/* The fragment has style issues, we should have caught some */
+	if (checker->diags.ndiags == 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = checker_print_diags(checker, dfmt_text, stdout);
+	if (rc != EOK)
+		goto error;
+
+	checker_destroy(checker);
+
+	return EOK;
+error:
+	checker_destroy(checker);
+	return rc;
+}
+
+static const char *str_incr =
+    "/*\n * Module\n */\n\nstatic int a;\n\n"
+    "int foo(void)\n{\n\treturn 0;\n}\n\n"
+    "/* Bar */\nint bar(int x)\n{\n\tif (x)\n\t\treturn 1;\n"
+    "\treturn 0;\n}\n\nstatic int b;\n";
+
+/** Incremental checker test edit */
+typedef struct {
+	/** Text to find in the source (first occurrence) */
+	const char *find;
+	/** Text to replace it with */
+	const char *repl;
+} test_incr_edit_t;
+
+/** Edits applied one after another to str_incr */
+static test_incr_edit_t test_incr_edits[] = {
+	/* Edit inside a function body */
+	{ "return 0;\n}\n\n/*", "return  0;\n}\n\n/*" },
+	/* Add a declaration */
+	{ "static int a;\n", "static int a;\nint  c;\n" },
+	/* Join two declarations */
+	{ "int  c;\n\nint foo", "int  c; int foo" },
+	/* Open an unterminated comment */
+	{ "/* Bar */", "/* Bar" },
+	/* Close it again */
+	{ "/* Bar", "/* Bar */" },
+	/* Delete a line break between declarations */
+	{ "}\n\nstatic int b;", "}\nstatic int b;" },
+	/* Line breaks in the first declaration shift the rest */
+	{ "static int a;", "static\nint\na;" },
+	/* Trailing whitespace in a function header */
+	{ "int bar(int x)", "int bar(int x) " },
+	/* Suppress it with an annotation */
+	{ "/* Bar */", "/* ccheck-disable fmt */\n/* Bar */" },
+	/* Shift the annotation */
+	{ "static\nint\na;", "static int a;" },
+	/* Remove the annotation */
+	{ "/* ccheck-disable fmt */\n", "" }
+};
+
+/** Compare diagnostics of an incremental checker with a full check.
+ *
+ * @param checker Incremental checker
+ * @param str Current source
+ * @return EOK if diagnostics match, EINVAL if they do not
+ */
+static int test_incr_compare(checker_t *checker, const char *str)
+{
+	checker_t *fchecker;
+	str_input_t sinput;
+	checker_cfg_t cfg;
+	diag_t *a;
+	diag_t *b;
+	size_t i;
+	int rc;
+
+	checker_cfg_init(&cfg);
+	str_input_init(&sinput, str);
+
+	rc = checker_create(&lexer_str_input, &sinput, cmod_c, &cfg,
+	    &fchecker);
+	if (rc != EOK)
+		return rc;
+
+	rc = checker_run(fchecker, false);
+	if (rc != EOK)
+		goto error;
+
+	diag_list_sort(&checker->diags);
+	diag_list_sort(&fchecker->diags);
+
+	if (checker->diags.ndiags != fchecker->diags.ndiags) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	for (i = 0; i < checker->diags.ndiags; i++) {
+		a = &checker->diags.diag[i];
+		b = &fchecker->diags.diag[i];
+		if (a->bline != b->bline || a->bcol != b->bcol ||
+		    a->eline != b->eline || a->ecol != b->ecol ||
+		    a->msg != b->msg) {
+			rc = EINVAL;
+			goto error;
+		}
+	}
+
+	checker_destroy(fchecker);
+	return EOK;
+error:
+	checker_destroy(fchecker);
+	return rc;
+}
+
+/** Test incremental re-checking after edits.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_check_incr(void)
+{
+	checker_t *checker;
+	str_input_t sinput;
+	checker_cfg_t cfg;
+	checker_edit_t edit;
+	test_incr_edit_t *e;
+	char *str;
+	char *nstr;
+	char *p;
+	size_t i;
+	int rc;
+
+	checker_cfg_init(&cfg);
+
+	str = strdup(str_incr);
+	if (str == NULL)
+		return ENOMEM;
+
+	str_input_init(&sinput, str_incr);
+
+	rc = checker_create(&lexer_str_input, &sinput, cmod_c, &cfg, &checker);
+	if (rc != EOK) {
+		free(str);
+		return rc;
+	}
+
+	checker_set_incr(checker);
+
+	rc = checker_run(checker, false);
+	if (rc != EOK)
+		goto error;
+
+	for (i = 0; i < sizeof(test_incr_edits) / sizeof(test_incr_edit_t);
+	    i++) {
+		e = &test_incr_edits[i];
+		p = strstr(str, e->find);
+		if (p == NULL) {
+			rc = EINVAL;
+			goto error;
+		}
+
+		if (asprintf(&nstr, "%.*s%s%s", (int)(p - str), str, e->repl,
+		    p + strlen(e->find)) < 0) {
+			rc = ENOMEM;
+			goto error;
+		}
+
+		edit.pos = p - str;
+		edit.old_size = strlen(e->find);
+		edit.new_size = strlen(e->repl);
+
+		free(str);
+		str = nstr;
+
+		rc = checker_update(checker, str, strlen(str), &edit, 1);
+		if (rc != EOK)
+			goto error;
+
+		diag_list_clear(&checker->diags);
+		rc = checker_run(checker, false);
+		if (rc != EOK)
+			goto error;
+
+		rc = test_incr_compare(checker, str);
+		if (rc != EOK)
+			goto error;
+	}
+
+	checker_destroy(checker);
+	free(str);
+	return EOK;
+error:
+	checker_destroy(checker);
+	free(str);
+	return rc;
+}
+
+/** Test that fixing reports whether the source has changed.
+ *
+ * @param str Code fragment
+ * @param modified @c true iff fixing should change @a str
+ * @return EOK on success or non-zero error code
+ */
+static int test_check_modified(const char *str, bool modified)
+{
+	checker_t *checker;
+	str_input_t sinput;
+	checker_cfg_t cfg;
+	int rc;
+
+	checker_cfg_init(&cfg);
+	str_input_init(&sinput, str);
+
+	rc = checker_create(&lexer_str_input, &sinput, cmod_c, &cfg, &checker);
+	if (rc != EOK)
+		return rc;
+
+	rc = checker_run(checker, true);
+	if (rc != EOK)
+		goto error;
+
+	if (checker_modified(checker) != modified) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	checker_destroy(checker);
+	return EOK;
+error:
+	checker_destroy(checker);
+	return rc;
+}
+
+/** Source with trailing whitespace to test diff of fixes */
+static const char *str_diff =
+    "int a;\nint b;\nint c;\nint d;\nint e; \nint f;\n"
+    "int g;\nint h;\nint i;\nint j;\nint k;\nint l;\nint m;\n"
+    "int n; \nint o;\nint p;\nint q;\nint r;\nint s; ";
+
+/** Expected diff of fixes to str_diff */
+static const char *str_diff_out =
+    "--- a/test.c\n+++ b/test.c\n"
+    "@@ -2,7 +2,7 @@\n int b;\n int c;\n int d;\n-int e; \n+int e;\n"
+    " int f;\n int g;\n int h;\n"
+    "@@ -11,9 +11,9 @@\n int k;\n int l;\n int m;\n-int n; \n+int n;\n"
+    " int o;\n int p;\n int q;\n int r;\n-int s; \n"
+    "\\ No newline at end of file\n+int s;\n";
+
+/** Source with a block comment line missing space after '*' */
+static const char *str_diff_cmt =
+    "/*\n *foo bar\n */\nint a;\nint b;\nint c;\n";
+
+/** Expected diff of fixes to str_diff_cmt */
+static const char *str_diff_cmt_out =
+    "--- a/test.c\n+++ b/test.c\n"
+    "@@ -1,5 +1,5 @@\n /*\n- *foo bar\n+ * foo bar\n  */\n int a;\n"
+    " int b;\n";
+
+/** Test printing fixes to source as a unified diff.
+ *
+ * @param src Source code
+ * @param out Expected diff
+ * @return EOK on success or non-zero error code
+ */
+static int test_check_diff_src(const char *src, const char *out)
+{
+	checker_t *checker;
+	str_input_t sinput;
+	checker_cfg_t cfg;
+	char *buf = NULL;
+	size_t size;
+	FILE *f;
+	int rc;
+
+	checker_cfg_init(&cfg);
+	str_input_init(&sinput, src);
+
+	rc = checker_create(&lexer_str_input, &sinput, cmod_c, &cfg, &checker);
+	if (rc != EOK)
+		return rc;
+
+	rc = checker_run(checker, true);
+	if (rc != EOK)
+		goto error;
+
+	f = open_memstream(&buf, &size);
+	if (f == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	rc = checker_print_diff(checker, src, strlen(src), "test.c", f);
+	fclose(f);
+	if (rc != EOK)
+		goto error;
+
+	if (strcmp(buf, out) != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	free(buf);
+	checker_destroy(checker);
+	return EOK;
+error:
+	free(buf);
+	checker_destroy(checker);
+	return rc;
+}
+
+/** Test printing fixes as a unified diff.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_check_diff(void)
+{
+	int rc;
+
+	rc = test_check_diff_src(str_diff, str_diff_out);
 	if (rc != EOK)
 		return rc;
 
+	return test_check_diff_src(str_diff_cmt, str_diff_cmt_out);
+}
+
+/** Source with suppression annotations and trailing whitespace */
+static const char *str_supp =
+    "int a; \n/* ccheck-disable fmt */\nint b; \nint c; \n"
+    "/* ccheck-enable fmt */\nint d; \n"
+    "// ccheck-disable-next-line fmt\nint e; \nint f; \n"
+    "// ccheck-disable-next-line loop, hdr\nint g; \n"
+    "/*\n * ccheck-disable-next-line\n */\nint h; \n"
+    "/* ccheck-disable-next-line nosuch */\nint i; \n"
+    "/* Not ccheck-disable */\nint j; \n"
+    "/* ccheck-disable */\nint k; \n";
+
+/** Lines of str_supp where issues are expected */
+static size_t str_supp_lines[] = { 1, 6, 9, 11, 17, 19 };
+
+/** Source with all issues suppressed */
+static const char *str_supp_all =
+    "// ccheck-disable-next-line fmt\nint a; \n"
+    "/* ccheck-disable */\nint  b ;\n";
+
+/** Test suppressing checks with annotations.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_check_supp(void)
+{
+	checker_t *checker;
+	str_input_t sinput;
+	checker_cfg_t cfg;
+	size_t i;
+	int rc;
+
+	checker_cfg_init(&cfg);
+	str_input_init(&sinput, str_supp);
+
+	rc = checker_create(&lexer_str_input, &sinput, cmod_c, &cfg, &checker);
+	if (rc != EOK)
+		return rc;
+
+	rc = checker_run(checker, false);
+	if (rc != EOK)
+		goto error;
+
+	diag_list_sort(&checker->diags);
+
+	if (checker->diags.ndiags != sizeof(str_supp_lines) / sizeof(size_t)) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	for (i = 0; i < checker->diags.ndiags; i++) {
+		if (checker->diags.diag[i].bline != str_supp_lines[i]) {
+			rc = EINVAL;
+			goto error;
+		}
+	}
+
+	checker_destroy(checker);
+
+	/* Suppressed issues are not fixed either */
+	return test_check_modified(str_supp_all, false);
+error:
 	checker_destroy(checker);
+	return rc;
+}
+
+/** Test collecting checker statistics.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_check_stats(void)
+{
+	checker_t *checker = NULL;
+	checker_stats_t stats;
+	str_input_t sinput;
+	checker_cfg_t cfg;
+	int rc;
+
+	memset(&stats, 0, sizeof(stats));
+	checker_cfg_init(&cfg);
+	str_input_init(&sinput, str_incr);
+
+	rc = checker_create(&lexer_str_input, &sinput, cmod_c, &cfg, &checker);
+	if (rc != EOK)
+		return rc;
+
+	checker_set_stats(checker, &stats);
+
+	rc = checker_run(checker, false);
+	if (rc != EOK)
+		goto error;
+
+	checker_destroy(checker);
+	checker = NULL;
+
+	if (stats.nbytes != strlen(str_incr) || stats.ntoks == 0) {
+		rc = EINVAL;
+		goto error;
+	}
 
 	return EOK;
+error:
+	if (checker != NULL)
+		checker_destroy(checker);
+	return rc;
+}
+
+/** Test stopping after a number of issues.
+ *
+ * @param max Maximum number of issues
+ * @param nexp Number of issues expected
+ * @return EOK on success or non-zero error code
+ */
+static int test_check_max_issues(unsigned max, size_t nexp)
+{
+	checker_t *checker;
+	str_input_t sinput;
+	checker_cfg_t cfg;
+	int rc;
+
+	checker_cfg_init(&cfg);
+	str_input_init(&sinput, str_supp);
+
+	rc = checker_create(&lexer_str_input, &sinput, cmod_c, &cfg, &checker);
+	if (rc != EOK)
+		return rc;
+
+	checker_set_max_issues(checker, max);
+
+	rc = checker_run(checker, false);
+	if (rc == EOK && checker->diags.ndiags != nexp)
+		rc = EINVAL;
+
+	checker_destroy(checker);
+	return rc;
 }
 
 /** Run checker tests.
@@ -78,5 +534,43 @@ int test_checker(void)
 	if (rc != EOK)
 		return rc;
 
+	rc = test_check_modified(str_hello, true);
+	if (rc != EOK)
+		return rc;
+
+	rc = test_check_modified(str_incr, false);
+	if (rc != EOK)
+		return rc;
+
+	rc = test_check_diff();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_check_incr();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_check_supp();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_check_stats();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_check_max_issues(1, 1);
+	if (rc != EOK)
+		return rc;
+
+	rc = test_check_max_issues(4, 4);
+	if (rc != EOK)
+		return rc;
+
+	/* Limit higher than the number of issues */
+	rc = test_check_max_issues(100,
+	    sizeof(str_supp_lines) / sizeof(size_t));
+	if (rc != EOK)
+		return rc;
+
 	return EOK;
 }
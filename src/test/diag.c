@@ -0,0 +1,109 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test diagnostics
+ */
+
+#include <diag.h>
+#include <merrno.h>
+#include <stdio.h>
+#include <string.h>
+#include <test/diag.h>
+
+/** Fill in a test diagnostic.
+ *
+ * @param diag Diagnostic
+ * @param line Line number
+ * @param col Column number
+ * @param msg Message ID
+ */
+static void test_diag_init(diag_t *diag, size_t line, size_t col,
+    diag_msg_t msg)
+{
+	memset(diag, 0, sizeof(diag_t));
+	diag->file = "test.c";
+	diag->bline = line;
+	diag->bcol = col;
+	diag->eline = line;
+	diag->ecol = col;
+	diag->ttype = ltt_ident;
+	diag->ttext = "foo";
+	diag->group = diag_msg_group(msg);
+	diag->msg = msg;
+}
+
+/** Run diagnostic tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_diag(void)
+{
+	diag_list_t list;
+	diag_t diag;
+	int rc;
+
+	diag_list_init(&list);
+
+	test_diag_init(&diag, 3, 1, dm_indent_tabs);
+	diag.num[0] = 0;
+	diag.num[1] = 1;
+	rc = diag_list_append(&list, &diag);
+	if (rc != EOK)
+		goto error;
+
+	test_diag_init(&diag, 1, 5, dm_nows_before);
+	diag.text = "Unexpected \"whitespace\".";
+	rc = diag_list_append(&list, &diag);
+	if (rc != EOK)
+		goto error;
+
+	test_diag_init(&diag, 1, 5, dm_invchar_comment);
+	diag.chr = '#';
+	rc = diag_list_append(&list, &diag);
+	if (rc != EOK)
+		goto error;
+
+	diag_list_sort(&list);
+
+	/* Sorted by position, then by order of reporting */
+	if (list.diag[0].msg != dm_nows_before ||
+	    list.diag[1].msg != dm_invchar_comment ||
+	    list.diag[2].msg != dm_indent_tabs) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = diag_list_print(&list, dfmt_text, stdout);
+	if (rc != EOK)
+		goto error;
+
+	rc = diag_list_print(&list, dfmt_jsonl, stdout);
+	if (rc != EOK)
+		goto error;
+
+	diag_list_fini(&list);
+	return EOK;
+error:
+	diag_list_fini(&list);
+	return rc;
+}
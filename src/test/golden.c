@@ -0,0 +1,538 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Golden test runner
+ *
+ * Finds all test inputs (<name>-in.c or <name>-in.h) in a directory
+ * tree and compares the results of checking them with the expected
+ * results stored next to them:
+ *
+ *   <name>-out.txt    issues reported (if missing, no issues are
+ *                     expected unless <name>-err.txt exists)
+ *   <name>-err.txt    errors reported (e.g. parse errors)
+ *   <name>-fixed.c/h  source fixed by ccheck --fix
+ *
+ * This gives the same results as running ccheck, ccheck --fix and diff
+ * on each file, but everything is done in memory, in one process and
+ * in parallel.
+ */
+
+#include <buf_input.h>
+#include <checker.h>
+#include <diag.h>
+#include <fcntl.h>
+#include <flist.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <test/golden.h>
+#include <time.h>
+#include <wpool.h>
+
+enum {
+	/** Number of worker threads */
+	test_golden_nthreads = 8
+};
+
+/** Golden test case */
+typedef struct {
+	/** Input file name */
+	const char *fname;
+	/** Length of file name without the -in.c / -in.h suffix */
+	size_t blen;
+	/** Number of comparisons made */
+	unsigned ncmp;
+	/** Number of comparisons that failed */
+	unsigned nfail;
+	/** Report (null terminated) or @c NULL */
+	char *report;
+	/** Size of report */
+	size_t report_size;
+} test_golden_case_t;
+
+/** Golden test run */
+typedef struct {
+	/** Test cases */
+	test_golden_case_t *tcase;
+	/** Number of test cases */
+	size_t ncases;
+} test_golden_t;
+
+/** Get current time.
+ *
+ * @return Monotonic time in nanoseconds
+ */
+static uint64_t test_golden_now(void)
+{
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+		return 0;
+
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/** Determine if file name is that of a test input.
+ *
+ * @param fname File name
+ * @return @c true iff file name ends with -in.c or -in.h
+ */
+static bool test_golden_is_input(const char *fname)
+{
+	size_t len;
+
+	len = strlen(fname);
+	return len >= 5 && (strcmp(fname + len - 5, "-in.c") == 0 ||
+	    strcmp(fname + len - 5, "-in.h") == 0);
+}
+
+/** Read file into memory.
+ *
+ * @param fname File name
+ * @param rbuf Place to store pointer to newly allocated buffer
+ * @param rsize Place to store file size
+ * @return EOK on success, ENOENT if file cannot be opened, ENOMEM
+ *         if out of memory, EIO on I/O error
+ */
+static int test_golden_read(const char *fname, char **rbuf, size_t *rsize)
+{
+	FILE *f;
+	char *buf = NULL;
+	char *nbuf;
+	size_t size = 0;
+	size_t alloc = 0;
+	size_t nread;
+
+	f = fopen(fname, "r");
+	if (f == NULL)
+		return ENOENT;
+
+	do {
+		if (size + 1 >= alloc) {
+			alloc = alloc != 0 ? 2 * alloc : 4096;
+			nbuf = realloc(buf, alloc);
+			if (nbuf == NULL) {
+				free(buf);
+				fclose(f);
+				return ENOMEM;
+			}
+
+			buf = nbuf;
+		}
+
+		nread = fread(buf + size, 1, alloc - size - 1, f);
+		size += nread;
+	} while (nread > 0);
+
+	if (ferror(f)) {
+		free(buf);
+		fclose(f);
+		return EIO;
+	}
+
+	fclose(f);
+	buf[size] = '\0';
+	*rbuf = buf;
+	*rsize = size;
+	return EOK;
+}
+
+/** Compare actual result with expected result.
+ *
+ * If the results differ, the first differing line is reported.
+ *
+ * @param tcase Test case
+ * @param what What is compared
+ * @param exp Expected result
+ * @param esize Size of expected result
+ * @param act Actual result
+ * @param asize Size of actual result
+ * @param rf Report output stream
+ */
+static void test_golden_cmp(test_golden_case_t *tcase, const char *what,
+    const char *exp, size_t esize, const char *act, size_t asize, FILE *rf)
+{
+	size_t i;
+	size_t bol;
+	size_t line;
+	size_t ee;
+	size_t ae;
+
+	++tcase->ncmp;
+	if (esize == asize && memcmp(exp, act, esize) == 0)
+		return;
+
+	++tcase->nfail;
+
+	/* Find beginning of first differing line */
+	bol = 0;
+	line = 1;
+	for (i = 0; i < esize && i < asize && exp[i] == act[i]; i++) {
+		if (exp[i] == '\n') {
+			bol = i + 1;
+			++line;
+		}
+	}
+
+	ee = bol;
+	while (ee < esize && exp[ee] != '\n')
+		++ee;
+	ae = bol;
+	while (ae < asize && act[ae] != '\n')
+		++ae;
+
+	fprintf(rf, "%.*s: %s differs at line %zu\n", (int) tcase->blen,
+	    tcase->fname, what, line);
+	if (bol < esize)
+		fprintf(rf, "-%.*s\n", (int) (ee - bol), exp + bol);
+	if (bol < asize)
+		fprintf(rf, "+%.*s\n", (int) (ae - bol), act + bol);
+}
+
+/** Compare actual result with expected result stored in a file.
+ *
+ * @param tcase Test case
+ * @param suffix Suffix of the file with the expected result
+ * @param act Actual result
+ * @param asize Size of actual result
+ * @param rf Report output stream
+ * @return EOK on success, ENOENT if there is no expected result,
+ *         other error code if it cannot be read
+ */
+static int test_golden_cmp_file(test_golden_case_t *tcase,
+    const char *suffix, const char *act, size_t asize, FILE *rf)
+{
+	char *ename;
+	char *exp;
+	size_t esize;
+	int rc;
+
+	if (asprintf(&ename, "%.*s%s", (int) tcase->blen, tcase->fname,
+	    suffix) < 0)
+		return ENOMEM;
+
+	rc = test_golden_read(ename, &exp, &esize);
+	free(ename);
+	if (rc != EOK)
+		return rc;
+
+	test_golden_cmp(tcase, suffix + 1, exp, esize, act, asize, rf);
+	free(exp);
+	return EOK;
+}
+
+/** Check source text in memory.
+ *
+ * @param tcase Test case
+ * @param text Source text
+ * @param size Size of source text
+ * @param fix @c true to fix issues
+ * @param outf Output stream for issues
+ * @param errf Output stream for errors
+ * @param fixf Output stream for fixed source or @c NULL
+ * @return EOK on success or error code
+ */
+static int test_golden_check(test_golden_case_t *tcase, char *text,
+    size_t size, bool fix, FILE *outf, FILE *errf, FILE *fixf)
+{
+	checker_t *checker;
+	checker_cfg_t cfg;
+	checker_mtype_t mtype;
+	buf_input_t binput;
+	int rc;
+
+	mtype = tcase->fname[strlen(tcase->fname) - 1] == 'h' ?
+	    cmod_header : cmod_c;
+
+	checker_cfg_init(&cfg);
+	buf_input_init(&binput, text, size, tcase->fname);
+	rc = checker_create(&lexer_buf_input, &binput, mtype, &cfg, &checker);
+	if (rc != EOK)
+		return rc;
+
+	checker_set_errf(checker, errf);
+
+	rc = checker_run(checker, fix);
+	if (rc != EOK)
+		goto out;
+
+	diag_list_sort(&checker->diags);
+	rc = diag_list_print(&checker->diags, dfmt_text, outf);
+	if (rc != EOK)
+		goto out;
+
+	if (fixf != NULL) {
+		/* Files that need no fixes are left untouched */
+		if (checker_modified(checker))
+			rc = checker_print(checker, fixf);
+		else if (fwrite(text, 1, size, fixf) != size)
+			rc = EIO;
+	}
+out:
+	checker_destroy(checker);
+	return rc;
+}
+
+/** Run golden test case.
+ *
+ * @param tcase Test case
+ * @param rf Report output stream
+ * @return EOK on success or error code if the test case cannot be run
+ */
+static int test_golden_case(test_golden_case_t *tcase, FILE *rf)
+{
+	char *text = NULL;
+	size_t size;
+	char *out = NULL;
+	size_t out_size;
+	char *err = NULL;
+	size_t err_size;
+	char *fixed = NULL;
+	size_t fixed_size;
+	FILE *outf = NULL;
+	FILE *errf = NULL;
+	FILE *fixf = NULL;
+	bool have_err;
+	int rc;
+
+	rc = test_golden_read(tcase->fname, &text, &size);
+	if (rc != EOK)
+		goto error;
+
+	/* Report run, as by ccheck <file> */
+	outf = open_memstream(&out, &out_size);
+	errf = open_memstream(&err, &err_size);
+	if (outf == NULL || errf == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	/* Failing to parse is a valid result, compared via -err.txt */
+	(void) test_golden_check(tcase, text, size, false, outf, errf, NULL);
+	rc = fclose(outf) == 0 ? EOK : ENOMEM;
+	if (fclose(errf) != 0)
+		rc = ENOMEM;
+	outf = errf = NULL;
+	if (rc != EOK)
+		goto error;
+
+	rc = test_golden_cmp_file(tcase, "-err.txt", err, err_size, rf);
+	if (rc != EOK && rc != ENOENT)
+		goto error;
+	have_err = rc == EOK;
+
+	rc = test_golden_cmp_file(tcase, "-out.txt", out, out_size, rf);
+	if (rc == ENOENT && !have_err)
+		test_golden_cmp(tcase, "out.txt", "", 0, out, out_size, rf);
+	else if (rc != EOK && rc != ENOENT)
+		goto error;
+
+	/* Fix run, as by ccheck --fix <file> */
+	free(out);
+	free(err);
+	out = err = NULL;
+	outf = open_memstream(&out, &out_size);
+	errf = open_memstream(&err, &err_size);
+	fixf = open_memstream(&fixed, &fixed_size);
+	if (outf == NULL || errf == NULL || fixf == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	rc = test_golden_check(tcase, text, size, true, outf, errf, fixf);
+	if (fclose(fixf) != 0) {
+		fixf = NULL;
+		rc = ENOMEM;
+		goto error;
+	}
+
+	fixf = NULL;
+
+	if (rc == EOK) {
+		rc = test_golden_cmp_file(tcase,
+		    tcase->fname[strlen(tcase->fname) - 1] == 'h' ?
+		    "-fixed.h" : "-fixed.c", fixed, fixed_size, rf);
+		if (rc != EOK && rc != ENOENT)
+			goto error;
+	}
+
+	fclose(outf);
+	fclose(errf);
+	free(out);
+	free(err);
+	free(fixed);
+	free(text);
+	return EOK;
+error:
+	if (outf != NULL)
+		fclose(outf);
+	if (errf != NULL)
+		fclose(errf);
+	if (fixf != NULL)
+		fclose(fixf);
+	free(out);
+	free(err);
+	free(fixed);
+	free(text);
+	return rc;
+}
+
+/** Run golden test job.
+ *
+ * @param arg Golden test run (test_golden_t *)
+ * @param widx Worker index
+ * @param jidx Job index
+ */
+static void test_golden_job(void *arg, unsigned widx, size_t jidx)
+{
+	test_golden_t *golden = (test_golden_t *) arg;
+	test_golden_case_t *tcase = &golden->tcase[jidx];
+	FILE *rf;
+	int rc;
+
+	(void) widx;
+
+	rf = open_memstream(&tcase->report, &tcase->report_size);
+	if (rf == NULL) {
+		++tcase->nfail;
+		return;
+	}
+
+	rc = test_golden_case(tcase, rf);
+	if (rc != EOK) {
+		fprintf(rf, "%s: cannot run test (%d).\n", tcase->fname, rc);
+		++tcase->nfail;
+	}
+
+	fclose(rf);
+}
+
+/** Golden test work pool ops */
+static wpool_ops_t test_golden_wpool_ops = {
+	.run = test_golden_job
+};
+
+/** Run golden tests.
+ *
+ * @param dir Directory containing test cases
+ * @return EOK if all tests passed, EINVAL if some failed, other error
+ *         code if tests could not be run
+ */
+int test_golden(const char *dir)
+{
+	test_golden_t golden;
+	flist_t *flist = NULL;
+	wpool_t *pool;
+	char *ddir = NULL;
+	size_t len;
+	size_t i;
+	unsigned ncmp;
+	unsigned nfail;
+	size_t nfcases;
+	uint64_t t0;
+	int rc;
+
+	memset(&golden, 0, sizeof(golden));
+	t0 = test_golden_now();
+
+	/* Make file names the same as with test/<file> */
+	ddir = strdup(dir);
+	if (ddir == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	len = strlen(ddir);
+	while (len > 1 && ddir[len - 1] == '/')
+		ddir[--len] = '\0';
+
+	rc = flist_create(AT_FDCWD, stderr, &flist);
+	if (rc != EOK)
+		goto error;
+
+	rc = flist_add_path(flist, ddir);
+	if (rc != EOK)
+		goto error;
+
+	flist_uniq(flist);
+
+	golden.tcase = calloc(flist->nentries + 1,
+	    sizeof(test_golden_case_t));
+	if (golden.tcase == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	for (i = 0; i < flist->nentries; i++) {
+		if (!test_golden_is_input(flist->entry[i].path))
+			continue;
+
+		golden.tcase[golden.ncases].fname = flist->entry[i].path;
+		golden.tcase[golden.ncases].blen =
+		    strlen(flist->entry[i].path) - 5;
+		++golden.ncases;
+	}
+
+	if (golden.ncases == 0) {
+		fprintf(stderr, "No test cases found in '%s'.\n", dir);
+		rc = ENOENT;
+		goto error;
+	}
+
+	rc = wpool_create(test_golden_nthreads, golden.ncases,
+	    &test_golden_wpool_ops, &golden, &pool);
+	if (rc != EOK)
+		goto error;
+
+	wpool_destroy(pool);
+
+	ncmp = 0;
+	nfail = 0;
+	nfcases = 0;
+	for (i = 0; i < golden.ncases; i++) {
+		if (golden.tcase[i].report != NULL)
+			fputs(golden.tcase[i].report, stdout);
+		ncmp += golden.tcase[i].ncmp;
+		nfail += golden.tcase[i].nfail;
+		if (golden.tcase[i].nfail > 0)
+			++nfcases;
+	}
+
+	printf("Ran %zu test cases (%u comparisons) in %u ms, %zu failed.\n",
+	    golden.ncases, ncmp, (unsigned) ((test_golden_now() - t0) /
+	    1000000), nfcases);
+
+	rc = nfail == 0 ? EOK : EINVAL;
+error:
+	if (golden.tcase != NULL) {
+		for (i = 0; i < golden.ncases; i++)
+			free(golden.tcase[i].report);
+		free(golden.tcase);
+	}
+	flist_destroy(flist);
+	free(ddir);
+	return rc;
+}
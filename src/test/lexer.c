@@ -24,6 +24,7 @@
  * Test lexer
  */
 
+#include <buf_input.h>
 #include <lexer.h>
 #include <merrno.h>
 #include <src_pos.h>
@@ -99,6 +100,147 @@ static int test_lex_string(const char *str)
 	return EOK;
 }
 
+/** Buffer with a null character, followed by bytes that are not part of it */
+static const char buf_nul[] = "int a;\0int b;int c;";
+
+enum {
+	/** Size of the part of buf_nul that is lexed */
+	buf_nul_size = 13
+};
+
+/** Token types expected when lexing buf_nul */
+static lexer_toktype_t buf_nul_ttypes[] = {
+	ltt_int, ltt_space, ltt_ident, ltt_scolon, ltt_invalid,
+	ltt_int, ltt_space, ltt_ident, ltt_scolon, ltt_eof
+};
+
+/** Test lexing a memory buffer containing a null character.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_lex_buf(void)
+{
+	int rc;
+	lexer_t *lexer;
+	buf_input_t binput;
+	lexer_tok_t tok;
+	size_t i;
+
+	buf_input_init(&binput, buf_nul, buf_nul_size, "buf");
+
+	rc = lexer_create(&lexer_buf_input, &binput, &lexer);
+	if (rc != EOK)
+		return rc;
+
+	for (i = 0; i < sizeof(buf_nul_ttypes) / sizeof(lexer_toktype_t);
+	    i++) {
+		rc = lexer_get_tok(lexer, &tok);
+		if (rc != EOK)
+			goto error;
+
+		if (tok.ttype != buf_nul_ttypes[i]) {
+			lexer_free_tok(&tok);
+			rc = EINVAL;
+			goto error;
+		}
+
+		lexer_free_tok(&tok);
+	}
+
+	lexer_destroy(lexer);
+	return EOK;
+error:
+	lexer_destroy(lexer);
+	return rc;
+}
+
+/** Source lexed both from a buffer in place and through the lexer buffer */
+static const char *str_inplace =
+    "/*\n * Comment\n */\n\nint main(int argc, char *argv[])\n{\n"
+    "\tif (argc > 1 && argv[1][0] == '-')\n\t\treturn 1;\n"
+    "\treturn 0; /* end */\n}\n";
+
+/** Test that lexing a buffer in place gives the same tokens.
+ *
+ * Lexing str_inplace from a memory buffer (scanned in place) must give
+ * the same tokens as lexing it from a string (read into the lexer
+ * buffer). Every prefix is tried, so that the input ends at each
+ * possible position relative to the part copied at the end of input.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_lex_inplace(void)
+{
+	int rc;
+	lexer_t *slexer = NULL;
+	lexer_t *blexer = NULL;
+	str_input_t sinput;
+	buf_input_t binput;
+	lexer_tok_t stok;
+	lexer_tok_t btok;
+	char prefix[128];
+	size_t len;
+	size_t n;
+	bool same;
+
+	len = strlen(str_inplace);
+	if (len >= sizeof(prefix))
+		return EINVAL;
+
+	for (n = 0; n <= len; n++) {
+		memcpy(prefix, str_inplace, n);
+		prefix[n] = '\0';
+		str_input_init(&sinput, prefix);
+		buf_input_init(&binput, prefix, n, "none");
+
+		rc = lexer_create(&lexer_str_input, &sinput, &slexer);
+		if (rc != EOK)
+			goto error;
+
+		rc = lexer_create(&lexer_buf_input, &binput, &blexer);
+		if (rc != EOK)
+			goto error;
+
+		do {
+			rc = lexer_get_tok(slexer, &stok);
+			if (rc != EOK)
+				goto error;
+
+			rc = lexer_get_tok(blexer, &btok);
+			if (rc != EOK) {
+				lexer_free_tok(&stok);
+				goto error;
+			}
+
+			same = stok.ttype == btok.ttype &&
+			    stok.text_size == btok.text_size &&
+			    memcmp(stok.text, btok.text, stok.text_size) == 0 &&
+			    stok.bpos.line == btok.bpos.line &&
+			    stok.bpos.col == btok.bpos.col &&
+			    stok.epos.line == btok.epos.line &&
+			    stok.epos.col == btok.epos.col;
+
+			lexer_free_tok(&stok);
+			lexer_free_tok(&btok);
+			if (!same) {
+				rc = EINVAL;
+				goto error;
+			}
+		} while (stok.ttype != ltt_eof);
+
+		lexer_destroy(slexer);
+		slexer = NULL;
+		lexer_destroy(blexer);
+		blexer = NULL;
+	}
+
+	return EOK;
+error:
+	lexer_destroy(slexer);
+	lexer_destroy(blexer);
+	return rc;
+}
+
 /** Run lexer tests.
  *
  * @return EOK on success or non-zero error code
@@ -115,5 +257,13 @@ int test_lexer(void)
 	if (rc != EOK)
 		return rc;
 
+	rc = test_lex_buf();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_lex_inplace();
+	if (rc != EOK)
+		return rc;
+
 	return EOK;
 }
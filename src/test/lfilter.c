@@ -0,0 +1,303 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test line filter
+ */
+
+#include <checker.h>
+#include <diag.h>
+#include <lfilter.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str_input.h>
+#include <string.h>
+#include <test/lfilter.h>
+
+/** Invalid line range specifications */
+static const char *str_inval[] = {
+	"a.c", "a.c:", ":1", "a.c:5-3", "a.c:x", "a.c:1,", "a.c:0", "a.c:1-"
+};
+
+/** Unified diff to test parsing */
+static const char *str_diff =
+    "diff --git a/a.c b/a.c\n"
+    "--- a/a.c\n"
+    "+++ b/a.c\n"
+    "@@ -3,2 +3,3 @@\n"
+    "-int x;\n"
+    "-int y;\n"
+    "+int x;\n"
+    "++++ b/c.c\n"
+    "+int z;\n"
+    "@@ -10,2 +10,0 @@\n"
+    "-int v;\n"
+    "-int w;\n"
+    "diff --git a/b.c b/b.c\n"
+    "--- a/b.c\n"
+    "+++ /dev/null\n"
+    "@@ -1 +0,0 @@\n"
+    "-int b;\n";
+
+/** Source with issues on every line to test filtering */
+static const char *str_lines =
+    "int a; \n"
+    "int b; \n"
+    "int c; \n"
+    "int f(void)\n"
+    "{\n"
+    "return 0;\n"
+    "}\n";
+
+/** Source after fixing lines 2-3 of str_lines */
+static const char *str_lines_fixed =
+    "int a; \n"
+    "int b;\n"
+    "int c;\n"
+    "int f(void)\n"
+    "{\n"
+    "return 0;\n"
+    "}\n";
+
+/** Verify line ranges of a file.
+ *
+ * @param lfilter Line filter
+ * @param fname File name
+ * @param range Expected line ranges
+ * @param nranges Expected number of line ranges
+ * @return EOK on success, EINVAL if ranges do not match
+ */
+static int test_lfilter_verify(lfilter_t *lfilter, const char *fname,
+    checker_lrange_t *range, size_t nranges)
+{
+	lfilter_file_t *file;
+	size_t i;
+
+	file = lfilter_find(lfilter, fname);
+	if (file == NULL || file->nranges != nranges)
+		return EINVAL;
+
+	for (i = 0; i < nranges; i++) {
+		if (file->range[i].bline != range[i].bline ||
+		    file->range[i].eline != range[i].eline)
+			return EINVAL;
+	}
+
+	return EOK;
+}
+
+/** Test parsing line range specifications.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_lfilter_spec(void)
+{
+	lfilter_t *lfilter;
+	checker_lrange_t range[] = { { 3, 5 }, { 1, 1 }, { 9, 9 } };
+	FILE *errf;
+	size_t i;
+	int rc;
+
+	errf = fopen("/dev/null", "w");
+	if (errf == NULL)
+		return EIO;
+
+	rc = lfilter_create(&lfilter);
+	if (rc != EOK)
+		goto error;
+
+	rc = lfilter_parse_spec(lfilter, "./a.c:3-5,1", errf);
+	if (rc != EOK)
+		goto error;
+
+	rc = lfilter_parse_spec(lfilter, "a.c:9", errf);
+	if (rc != EOK)
+		goto error;
+
+	rc = test_lfilter_verify(lfilter, "./a.c", range, 3);
+	if (rc != EOK)
+		goto error;
+
+	for (i = 0; i < sizeof(str_inval) / sizeof(str_inval[0]); i++) {
+		if (lfilter_parse_spec(lfilter, str_inval[i], errf) != EINVAL) {
+			rc = EINVAL;
+			goto error;
+		}
+	}
+
+	lfilter_destroy(lfilter);
+	fclose(errf);
+	return EOK;
+error:
+	lfilter_destroy(lfilter);
+	fclose(errf);
+	return rc;
+}
+
+/** Test parsing unified diff.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_lfilter_diff(void)
+{
+	lfilter_t *lfilter = NULL;
+	checker_lrange_t range[] = { { 3, 5 }, { 10, 11 } };
+	FILE *f;
+	int rc;
+
+	f = fmemopen((void *) str_diff, strlen(str_diff), "r");
+	if (f == NULL)
+		return ENOMEM;
+
+	rc = lfilter_create(&lfilter);
+	if (rc != EOK)
+		goto error;
+
+	rc = lfilter_parse_diff(lfilter, f, stderr);
+	if (rc != EOK)
+		goto error;
+
+	/* Added line looking like a header must not start a new file */
+	if (lfilter->nfiles != 1) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = test_lfilter_verify(lfilter, "a.c", range, 2);
+	if (rc != EOK)
+		goto error;
+
+	lfilter_destroy(lfilter);
+	fclose(f);
+	return EOK;
+error:
+	lfilter_destroy(lfilter);
+	fclose(f);
+	return rc;
+}
+
+/** Test checking and fixing only some lines.
+ *
+ * @param fix @c true to fix issues, @c false to report them
+ * @return EOK on success or non-zero error code
+ */
+static int test_lfilter_check(bool fix)
+{
+	checker_t *checker;
+	str_input_t sinput;
+	checker_cfg_t cfg;
+	checker_lrange_t range = { 2, 3 };
+	diag_list_t diags;
+	char *buf = NULL;
+	size_t size;
+	FILE *f;
+	size_t i;
+	int rc;
+
+	checker_cfg_init(&cfg);
+	str_input_init(&sinput, str_lines);
+	diag_list_init(&diags);
+
+	rc = checker_create(&lexer_str_input, &sinput, cmod_c, &cfg, &checker);
+	if (rc != EOK)
+		return rc;
+
+	checker_set_sink(checker, &diag_list_sink, &diags);
+
+	rc = checker_set_lines(checker, &range, 1);
+	if (rc != EOK)
+		goto error;
+
+	rc = checker_run(checker, fix);
+	if (rc != EOK)
+		goto error;
+
+	if (fix) {
+		f = open_memstream(&buf, &size);
+		if (f == NULL) {
+			rc = ENOMEM;
+			goto error;
+		}
+
+		rc = checker_print(checker, f);
+		fclose(f);
+		if (rc != EOK)
+			goto error;
+
+		if (strcmp(buf, str_lines_fixed) != 0) {
+			rc = EINVAL;
+			goto error;
+		}
+	} else {
+		if (diags.ndiags != 2) {
+			rc = EINVAL;
+			goto error;
+		}
+
+		for (i = 0; i < diags.ndiags; i++) {
+			if (diags.diag[i].bline < 2 ||
+			    diags.diag[i].bline > 3) {
+				rc = EINVAL;
+				goto error;
+			}
+		}
+	}
+
+	free(buf);
+	diag_list_fini(&diags);
+	checker_destroy(checker);
+	return EOK;
+error:
+	free(buf);
+	diag_list_fini(&diags);
+	checker_destroy(checker);
+	return rc;
+}
+
+/** Run line filter tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_lfilter(void)
+{
+	int rc;
+
+	rc = test_lfilter_spec();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_lfilter_diff();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_lfilter_check(false);
+	if (rc != EOK)
+		return rc;
+
+	rc = test_lfilter_check(true);
+	if (rc != EOK)
+		return rc;
+
+	return EOK;
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <adt/list.h>
+#include <checker.h>
+#include <diag.h>
+#include <mcache.h>
+#include <merrno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <test/mcache.h>
+
+/** Source text before edit */
+static const char *str_old =
+    "int x;\n"
+    "\n"
+    "int f(void)\n"
+    "{\n"
+    "\treturn 0;\n"
+    "}\n";
+
+/** Source text after edit */
+static const char *str_new =
+    "int x;\n"
+    "\n"
+    "int f(void)\n"
+    "{\n"
+    "\treturn  0 ;\n"
+    "}\n"
+    "int  y;\n";
+
+/** Check that diagnostics match those of checking from scratch.
+ *
+ * @param cfg Checker configuration
+ * @param text Source text
+ * @param diags Diagnostics to verify
+ * @return EOK if the diagnostics match or error code
+ */
+static int test_mcache_compare(checker_cfg_t *cfg, const char *text,
+    diag_list_t *diags)
+{
+	mcache_t *mcache = NULL;
+	diag_list_t fdiags;
+	size_t i;
+	int rc;
+
+	diag_list_init(&fdiags);
+
+	rc = mcache_create(SIZE_MAX, &mcache);
+	if (rc != EOK)
+		goto error;
+
+	mcache_set_fps(mcache);
+
+	rc = mcache_check(mcache, "a.c", cmod_c, cfg, text, strlen(text),
+	    &fdiags, stderr);
+	if (rc != EOK)
+		goto error;
+
+	rc = EINVAL;
+	if (fdiags.ndiags != diags->ndiags)
+		goto error;
+
+	for (i = 0; i < diags->ndiags; i++) {
+		if (fdiags.diag[i].msg != diags->diag[i].msg ||
+		    fdiags.diag[i].bline != diags->diag[i].bline ||
+		    fdiags.diag[i].bcol != diags->diag[i].bcol ||
+		    fdiags.diag[i].fp != diags->diag[i].fp)
+			goto error;
+	}
+
+	rc = EOK;
+error:
+	diag_list_fini(&fdiags);
+	mcache_destroy(mcache);
+	return rc;
+}
+
+/** Run module cache tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_mcache(void)
+{
+	mcache_t *mcache = NULL;
+	mcache_entry_t *entry;
+	checker_cfg_t cfg;
+	diag_list_t diags;
+	FILE *nullf;
+	size_t mem;
+	int rc;
+
+	diag_list_init(&diags);
+	checker_cfg_init(&cfg);
+
+	rc = mcache_create(SIZE_MAX, &mcache);
+	if (rc != EOK)
+		goto error;
+
+	mcache_set_fps(mcache);
+
+	rc = mcache_check(mcache, "a.c", cmod_c, &cfg, str_old,
+	    strlen(str_old), &diags, stderr);
+	if (rc != EOK)
+		goto error;
+
+	if (diags.ndiags != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	/* Checked incrementally, same result as checking from scratch */
+	rc = mcache_check(mcache, "a.c", cmod_c, &cfg, str_new,
+	    strlen(str_new), &diags, stderr);
+	if (rc != EOK)
+		goto error;
+
+	if (diags.ndiags == 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = test_mcache_compare(&cfg, str_new, &diags);
+	if (rc != EOK)
+		goto error;
+
+	/* Unchanged, diagnostics are reported again */
+	diag_list_clear(&diags);
+	rc = mcache_check(mcache, "a.c", cmod_c, &cfg, str_new,
+	    strlen(str_new), &diags, stderr);
+	if (rc != EOK)
+		goto error;
+
+	rc = test_mcache_compare(&cfg, str_new, &diags);
+	if (rc != EOK)
+		goto error;
+
+	diag_list_clear(&diags);
+
+	/* Parse error, entry is dropped */
+	nullf = fopen("/dev/null", "w");
+	if (nullf == NULL) {
+		rc = EIO;
+		goto error;
+	}
+
+	rc = mcache_check(mcache, "a.c", cmod_c, &cfg, "int (", 5, &diags,
+	    nullf);
+	fclose(nullf);
+	if (rc == EOK || !list_empty(&mcache->entries) || mcache->mem != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	diag_list_clear(&diags);
+
+	rc = mcache_check(mcache, "a.c", cmod_c, &cfg, str_old,
+	    strlen(str_old), &diags, stderr);
+	if (rc != EOK)
+		goto error;
+
+	entry = list_get_instance(list_first(&mcache->entries),
+	    mcache_entry_t, lentries);
+	mem = entry->mem;
+	mcache_destroy(mcache);
+	mcache = NULL;
+
+	/* Cache that can hold just one entry */
+	rc = mcache_create(mem, &mcache);
+	if (rc != EOK)
+		goto error;
+
+	rc = mcache_check(mcache, "a.c", cmod_c, &cfg, str_old,
+	    strlen(str_old), &diags, stderr);
+	if (rc != EOK)
+		goto error;
+
+	rc = mcache_check(mcache, "b.c", cmod_c, &cfg, str_old,
+	    strlen(str_old), &diags, stderr);
+	if (rc != EOK)
+		goto error;
+
+	/* Least recently used entry has been evicted */
+	entry = list_get_instance(list_first(&mcache->entries),
+	    mcache_entry_t, lentries);
+	if (list_count(&mcache->entries) != 1 ||
+	    strcmp(entry->fname, "b.c") != 0 || mcache->mem != mem) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	mcache_remove(mcache, "b.c");
+	if (!list_empty(&mcache->entries) || mcache->mem != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	mcache_destroy(mcache);
+	diag_list_fini(&diags);
+	return EOK;
+error:
+	mcache_destroy(mcache);
+	diag_list_fini(&diags);
+	return rc;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test project configuration
+ */
+
+#include <checker.h>
+#include <merrno.h>
+#include <pconf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <test/pconf.h>
+#include <test/tmpdir.h>
+
+/** Test configuration file in the top-level directory */
+static const char *str_top =
+    "# Top-level configuration\n"
+    "root\n"
+    "disable fmt hdr\n"
+    "ignore gen *.tmp.c\n"
+    "type *.inc c\n";
+
+/** Test configuration file in a subdirectory */
+static const char *str_sub =
+    "enable fmt\n"
+    "\n"
+    "type special.h c\n";
+
+/** Invalid test configuration file */
+static const char *str_bad =
+    "disable nosuch\n";
+
+/** Create test file or directory.
+ *
+ * @param dir Test directory
+ * @param name File name relative to @a dir
+ * @param text File contents or @c NULL to create a directory
+ * @return EOK on success or error code
+ */
+static int test_pconf_create(const char *dir, const char *name,
+    const char *text)
+{
+	char *path;
+	FILE *f;
+	int rc;
+
+	if (asprintf(&path, "%s/%s", dir, name) < 0)
+		return ENOMEM;
+
+	if (text == NULL) {
+		rc = mkdir(path, 0700) == 0 ? EOK : EIO;
+		free(path);
+		return rc;
+	}
+
+	f = fopen(path, "wt");
+	free(path);
+	if (f == NULL)
+		return EIO;
+
+	rc = fputs(text, f) >= 0 ? EOK : EIO;
+	if (fclose(f) < 0)
+		rc = EIO;
+	return rc;
+}
+
+/** Run project configuration tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_pconf(void)
+{
+	char *dir = NULL;
+	pconf_t *pconf = NULL;
+	pconf_file_t pf;
+	pconf_file_t pf2;
+	checker_cfg_t cfg;
+	FILE *nullf = NULL;
+	int rc;
+
+	rc = test_tmpdir_create("pconf", &dir);
+	if (rc != EOK)
+		return rc;
+
+	rc = test_pconf_create(dir, ".ccheck", str_top);
+	if (rc == EOK)
+		rc = test_pconf_create(dir, "sub", NULL);
+	if (rc == EOK)
+		rc = test_pconf_create(dir, "sub/.ccheck", str_sub);
+	if (rc == EOK)
+		rc = test_pconf_create(dir, "bad", NULL);
+	if (rc == EOK)
+		rc = test_pconf_create(dir, "bad/.ccheck", str_bad);
+	if (rc != EOK)
+		goto error;
+
+	nullf = fopen("/dev/null", "w");
+	if (nullf == NULL) {
+		rc = EIO;
+		goto error;
+	}
+
+	/* Groups disabled on the command line stay disabled */
+	checker_cfg_init(&cfg);
+	cfg.loop = false;
+
+	rc = pconf_create(dir, &cfg, nullf, &pconf);
+	if (rc != EOK)
+		goto error;
+
+	rc = pconf_file(pconf, "a.c", &pf);
+	if (rc != EOK)
+		goto error;
+
+	rc = EINVAL;
+	if (pf.ignore || pf.mtype_set || pf.cfg->fmt || pf.cfg->hdr ||
+	    pf.cfg->loop || !pf.cfg->decl)
+		goto error;
+
+	/* Same directory, same configuration */
+	rc = pconf_file(pconf, "./x/../b.c", &pf2);
+	if (rc != EOK || pf2.cfg != pf.cfg) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = pconf_file(pconf, "sub/b.h", &pf);
+	if (rc != EOK)
+		goto error;
+
+	rc = EINVAL;
+	if (pf.ignore || pf.mtype_set || !pf.cfg->fmt || pf.cfg->hdr ||
+	    pf.cfg->loop)
+		goto error;
+
+	rc = pconf_file(pconf, "sub/special.h", &pf);
+	if (rc != EOK || !pf.mtype_set || pf.mtype != cmod_c) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = pconf_file(pconf, "sub/x.inc", &pf);
+	if (rc != EOK || !pf.mtype_set || pf.mtype != cmod_c) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = pconf_file(pconf, "sub/gen/y.c", &pf);
+	if (rc != EOK || !pf.ignore) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = pconf_file(pconf, "z.tmp.c", &pf);
+	if (rc != EOK || !pf.ignore) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	/* Invalid configuration file */
+	rc = pconf_file(pconf, "bad/c.c", &pf);
+	if (rc != EINVAL) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	pconf_destroy(pconf);
+	fclose(nullf);
+	test_tmpdir_destroy(dir);
+	return EOK;
+error:
+	pconf_destroy(pconf);
+	if (nullf != NULL)
+		fclose(nullf);
+	test_tmpdir_destroy(dir);
+	return rc;
+}
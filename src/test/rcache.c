@@ -0,0 +1,147 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <checker.h>
+#include <diag.h>
+#include <merrno.h>
+#include <rcache.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <test/rcache.h>
+#include <test/tmpdir.h>
+
+/** Run result cache tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_rcache(void)
+{
+	char *dir = NULL;
+	const char *data = "int x;\n";
+	rcache_t *rcache = NULL;
+	rcache_key_t key;
+	rcache_key_t okey;
+	checker_cfg_t cfg;
+	diag_list_t list;
+	diag_t diag;
+	int rc;
+
+	diag_list_init(&list);
+	checker_cfg_init(&cfg);
+
+	rc = test_tmpdir_create("rcache", &dir);
+	if (rc != EOK)
+		goto error;
+
+	/* Cache that can hold no entries at all */
+	rc = rcache_open(dir, 1, &rcache);
+	if (rc != EOK)
+		goto error;
+
+	rcache_key(rcache, data, strlen(data), &cfg, cmod_c, true, &key);
+
+	rc = rcache_lookup(rcache, &key, "a.c", &list);
+	if (rc != ENOENT) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	memset(&diag, 0, sizeof(diag_t));
+	diag.file = "a.c";
+	diag.bline = 1;
+	diag.bcol = 4;
+	diag.eline = 1;
+	diag.ecol = 4;
+	diag.ttype = ltt_ident;
+	diag.ttext = "x";
+	diag.msg = dm_nows_before;
+	diag.group = diag_msg_group(dm_nows_before);
+	diag.text = "Unexpected whitespace before 'x'.";
+	diag.fp = 0x123456789abcdef0ULL;
+	rc = diag_list_append(&list, &diag);
+	if (rc != EOK)
+		goto error;
+
+	rc = rcache_store(rcache, &key, &list);
+	if (rc != EOK)
+		goto error;
+
+	diag_list_clear(&list);
+
+	/* Hit, diagnostics are replayed with the new file name */
+	rc = rcache_lookup(rcache, &key, "b.c", &list);
+	if (rc != EOK)
+		goto error;
+
+	if (list.ndiags != 1 || strcmp(list.diag[0].file, "b.c") != 0 ||
+	    list.diag[0].msg != dm_nows_before ||
+	    list.diag[0].bcol != 4 || list.diag[0].fp != diag.fp ||
+	    strcmp(list.diag[0].ttext, "x") != 0 ||
+	    strcmp(list.diag[0].text, diag.text) != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	diag_list_clear(&list);
+
+	/* Entries with fingerprints are not used without them and vice versa */
+	rcache_key(rcache, data, strlen(data), &cfg, cmod_c, false, &okey);
+	rc = rcache_lookup(rcache, &okey, "a.c", &list);
+	if (rc != ENOENT) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	/* Different configuration is a miss */
+	cfg.fmt = false;
+	rcache_key(rcache, data, strlen(data), &cfg, cmod_c, true, &okey);
+	rc = rcache_lookup(rcache, &okey, "a.c", &list);
+	if (rc != ENOENT) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	/* Closing the cache evicts the entry as it exceeds the size limit */
+	rcache_close(rcache);
+	rcache = NULL;
+
+	rc = rcache_open(dir, 1, &rcache);
+	if (rc != EOK)
+		goto error;
+
+	rc = rcache_lookup(rcache, &key, "a.c", &list);
+	if (rc != ENOENT) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rcache_close(rcache);
+	diag_list_fini(&list);
+	test_tmpdir_destroy(dir);
+	return EOK;
+error:
+	rcache_close(rcache);
+	diag_list_fini(&list);
+	test_tmpdir_destroy(dir);
+	return rc;
+}
@@ -0,0 +1,257 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Concurrency stress test
+ *
+ * Checks every source file in a directory tree serially to obtain
+ * reference results, then checks all of them again several times over
+ * from many threads at once, each using its own checker instance. Any
+ * difference from the reference points to state shared between checker
+ * instances. Intended to be run under ThreadSanitizer.
+ */
+
+#include <fcntl.h>
+#include <flist.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sycek.h>
+#include <test/stress.h>
+#include <wpool.h>
+
+enum {
+	/** Number of worker threads */
+	test_stress_nthreads = 8,
+	/** Number of times each file is checked concurrently */
+	test_stress_rounds = 4
+};
+
+/** Result of checking one file */
+typedef struct {
+	/** Return code of the report run */
+	int rc;
+	/** Number of issues found */
+	size_t ndiags;
+	/** Sum of issue fingerprints */
+	uint64_t fpsum;
+	/** Return code of the fix run */
+	int frc;
+	/** Size of fixed text */
+	size_t fsize;
+	/** Hash of fixed text */
+	uint64_t fhash;
+} test_stress_res_t;
+
+/** Stress test */
+typedef struct {
+	/** Files to check */
+	flist_t *flist;
+	/** Results, one per job */
+	test_stress_res_t *res;
+} test_stress_t;
+
+/** Compute FNV-1a hash of a buffer.
+ *
+ * @param buf Buffer
+ * @param size Size of buffer in bytes
+ * @return Hash value
+ */
+static uint64_t test_stress_hash(const char *buf, size_t size)
+{
+	uint64_t h = 0xcbf29ce484222325ULL;
+	size_t i;
+
+	for (i = 0; i < size; i++) {
+		h ^= (uint8_t) buf[i];
+		h *= 0x100000001b3ULL;
+	}
+
+	return h;
+}
+
+/** Determine module type from file name.
+ *
+ * @param fname File name
+ * @return Module type
+ */
+static sycek_mtype_t test_stress_mtype(const char *fname)
+{
+	const char *ext;
+
+	ext = strrchr(fname, '.');
+	if (ext != NULL && strcmp(ext, ".h") == 0)
+		return sycek_mod_header;
+
+	return sycek_mod_c;
+}
+
+/** Check one file, recording the result.
+ *
+ * @param fname File name
+ * @param res Place to store result
+ */
+static void test_stress_check(const char *fname, test_stress_res_t *res)
+{
+	sycek_t *sycek;
+	sycek_diag_t diag;
+	char *text;
+	size_t i;
+	int rc;
+
+	memset(res, 0, sizeof(test_stress_res_t));
+
+	rc = sycek_create_file(fname, test_stress_mtype(fname), &sycek);
+	if (rc != EOK) {
+		res->rc = rc;
+		return;
+	}
+
+	res->rc = sycek_run(sycek, sycek_grp_all, false);
+	res->ndiags = sycek_diag_count(sycek);
+	for (i = 0; i < res->ndiags; i++) {
+		if (sycek_diag_get(sycek, i, &diag) == EOK)
+			res->fpsum += diag.fp;
+	}
+
+	res->frc = sycek_run(sycek, sycek_grp_all, true);
+	if (res->frc == EOK &&
+	    sycek_fixed_text(sycek, &text, &res->fsize) == EOK) {
+		res->fhash = test_stress_hash(text, res->fsize);
+		free(text);
+	}
+
+	sycek_destroy(sycek);
+}
+
+/** Compare two check results.
+ *
+ * @param a First result
+ * @param b Second result
+ * @return @c true iff results are equal
+ */
+static bool test_stress_res_equal(test_stress_res_t *a, test_stress_res_t *b)
+{
+	return a->rc == b->rc && a->ndiags == b->ndiags &&
+	    a->fpsum == b->fpsum && a->frc == b->frc &&
+	    a->fsize == b->fsize && a->fhash == b->fhash;
+}
+
+/** Run stress test job.
+ *
+ * @param arg Stress test (test_stress_t *)
+ * @param widx Worker index
+ * @param jidx Job index
+ */
+static void test_stress_job(void *arg, unsigned widx, size_t jidx)
+{
+	test_stress_t *stress = (test_stress_t *) arg;
+	size_t fidx;
+
+	(void) widx;
+
+	fidx = jidx % stress->flist->nentries;
+	test_stress_check(stress->flist->entry[fidx].path,
+	    &stress->res[jidx]);
+}
+
+/** Stress test work pool ops */
+static wpool_ops_t test_stress_wpool_ops = {
+	.run = test_stress_job
+};
+
+/** Run concurrency stress test.
+ *
+ * @param dir Directory containing source files to check
+ * @return EOK on success or non-zero error code
+ */
+int test_stress(const char *dir)
+{
+	test_stress_t stress;
+	test_stress_res_t *ref = NULL;
+	wpool_t *pool;
+	size_t nfiles;
+	size_t njobs;
+	size_t nbad;
+	size_t i;
+	int rc;
+
+	memset(&stress, 0, sizeof(stress));
+
+	rc = flist_create(AT_FDCWD, stderr, &stress.flist);
+	if (rc != EOK)
+		goto error;
+
+	rc = flist_add_path(stress.flist, dir);
+	if (rc != EOK)
+		goto error;
+
+	flist_uniq(stress.flist);
+	nfiles = stress.flist->nentries;
+	if (nfiles == 0) {
+		fprintf(stderr, "No source files found in '%s'.\n", dir);
+		rc = ENOENT;
+		goto error;
+	}
+
+	njobs = nfiles * test_stress_rounds;
+
+	ref = calloc(nfiles, sizeof(test_stress_res_t));
+	stress.res = calloc(njobs, sizeof(test_stress_res_t));
+	if (ref == NULL || stress.res == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	for (i = 0; i < nfiles; i++)
+		test_stress_check(stress.flist->entry[i].path, &ref[i]);
+
+	rc = wpool_create(test_stress_nthreads, njobs, &test_stress_wpool_ops,
+	    &stress, &pool);
+	if (rc != EOK)
+		goto error;
+
+	wpool_destroy(pool);
+
+	nbad = 0;
+	for (i = 0; i < njobs; i++) {
+		if (!test_stress_res_equal(&stress.res[i], &ref[i % nfiles])) {
+			fprintf(stderr, "Result mismatch for '%s'.\n",
+			    stress.flist->entry[i % nfiles].path);
+			++nbad;
+		}
+	}
+
+	printf("Checked %zu files %d times in %d threads, %zu mismatches.\n",
+	    nfiles, (int) test_stress_rounds, (int) test_stress_nthreads,
+	    nbad);
+
+	rc = nbad == 0 ? EOK : EINVAL;
+error:
+	free(stress.res);
+	free(ref);
+	flist_destroy(stress.flist);
+	return rc;
+}
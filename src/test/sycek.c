@@ -0,0 +1,170 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Sycek library test
+ */
+
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sycek.h>
+#include <test/sycek.h>
+
+/** Source with trailing whitespace, followed by bytes not part of it */
+static const char *str_ws = "int a; \nint b;\nXYZ";
+
+/** Source with trailing whitespace fixed */
+static const char *str_ws_fixed = "int a;\nint b;\n";
+
+/** Source that cannot be parsed */
+static const char *str_bad = "int a\n";
+
+/** Test checking and fixing a buffer.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_sycek_fix(void)
+{
+	sycek_t *sycek = NULL;
+	sycek_diag_t diag;
+	char *text = NULL;
+	size_t size;
+	int rc;
+
+	/* Leave out the bytes that are not part of the source */
+	rc = sycek_create_buf(str_ws, strlen(str_ws) - 3, "a.c", sycek_mod_c,
+	    &sycek);
+	if (rc != EOK)
+		return rc;
+
+	rc = sycek_run(sycek, sycek_grp_all, false);
+	if (rc != EOK)
+		goto error;
+
+	rc = EINVAL;
+	if (sycek_diag_count(sycek) != 1)
+		goto error;
+
+	if (sycek_diag_get(sycek, 0, &diag) != EOK)
+		goto error;
+
+	if (strcmp(diag.file, "a.c") != 0 || diag.bline != 1 ||
+	    strcmp(diag.group, "fmt") != 0 || diag.msg[0] == '\0')
+		goto error;
+
+	if (sycek_diag_get(sycek, 1, &diag) != ENOENT)
+		goto error;
+
+	rc = sycek_run(sycek, sycek_grp_all, true);
+	if (rc != EOK)
+		goto error;
+
+	rc = sycek_fixed_text(sycek, &text, &size);
+	if (rc != EOK)
+		goto error;
+
+	if (size != strlen(str_ws_fixed) || strcmp(text, str_ws_fixed) != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	/* Disabled checks report nothing */
+	rc = sycek_run(sycek, sycek_grp_all & ~sycek_grp_fmt, false);
+	if (rc != EOK)
+		goto error;
+
+	if (sycek_diag_count(sycek) != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	free(text);
+	sycek_destroy(sycek);
+	return EOK;
+error:
+	free(text);
+	sycek_destroy(sycek);
+	return rc;
+}
+
+/** Test parse errors.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_sycek_bad(void)
+{
+	sycek_t *sycek = NULL;
+	char *text;
+	size_t size;
+	int rc;
+
+	rc = sycek_create_buf(str_bad, strlen(str_bad), "bad.c", sycek_mod_c,
+	    &sycek);
+	if (rc != EOK)
+		return rc;
+
+	rc = EINVAL;
+	if (sycek_run(sycek, sycek_grp_all, false) == EOK)
+		goto error;
+
+	if (sycek_errors(sycek)[0] == '\0')
+		goto error;
+
+	if (sycek_fixed_text(sycek, &text, &size) != EINVAL)
+		goto error;
+
+	sycek_destroy(sycek);
+
+	rc = sycek_create_file("/nonexistent/a.c", sycek_mod_c, &sycek);
+	if (rc != ENOENT)
+		return EINVAL;
+
+	if (sycek_create_buf(str_bad, strlen(str_bad), "bad.c",
+	    (sycek_mtype_t)2, &sycek) != EINVAL)
+		return EINVAL;
+
+	return EOK;
+error:
+	sycek_destroy(sycek);
+	return rc;
+}
+
+/** Run sycek library tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_sycek(void)
+{
+	int rc;
+
+	rc = test_sycek_fix();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_sycek_bad();
+	if (rc != EOK)
+		return rc;
+
+	return EOK;
+}
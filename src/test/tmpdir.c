@@ -0,0 +1,107 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Temporary directories for tests
+ */
+
+#include <dirent.h>
+#include <merrno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <test/tmpdir.h>
+#include <unistd.h>
+
+/** Create temporary test directory.
+ *
+ * @param name Name of test (becomes part of directory name)
+ * @param rdir Place to store newly allocated directory path
+ * @return EOK on success, ENOMEM if out of memory, EIO if directory
+ *         cannot be created
+ */
+int test_tmpdir_create(const char *name, char **rdir)
+{
+	char *dir;
+
+	if (asprintf(&dir, "/tmp/ccheck-%s-XXXXXX", name) < 0)
+		return ENOMEM;
+
+	if (mkdtemp(dir) == NULL) {
+		free(dir);
+		return EIO;
+	}
+
+	*rdir = dir;
+	return EOK;
+}
+
+/** Remove directory with everything in it.
+ *
+ * Errors are ignored, whatever can be removed is removed.
+ *
+ * @param path Directory path
+ */
+static void test_tmpdir_remove(const char *path)
+{
+	DIR *d;
+	struct dirent *de;
+	struct stat st;
+	char *epath;
+
+	d = opendir(path);
+	if (d != NULL) {
+		while ((de = readdir(d)) != NULL) {
+			if (strcmp(de->d_name, ".") == 0 ||
+			    strcmp(de->d_name, "..") == 0)
+				continue;
+
+			if (asprintf(&epath, "%s/%s", path, de->d_name) < 0)
+				continue;
+
+			if (lstat(epath, &st) == 0 && S_ISDIR(st.st_mode))
+				test_tmpdir_remove(epath);
+			else
+				(void) remove(epath);
+
+			free(epath);
+		}
+
+		closedir(d);
+	}
+
+	(void) rmdir(path);
+}
+
+/** Remove temporary test directory with everything in it.
+ *
+ * @param dir Directory created by test_tmpdir_create() or @c NULL
+ */
+void test_tmpdir_destroy(char *dir)
+{
+	if (dir == NULL)
+		return;
+
+	test_tmpdir_remove(dir);
+	free(dir);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <merrno.h>
+#include <stdlib.h>
+#include <test/wpool.h>
+#include <wpool.h>
+
+enum {
+	/** Number of test jobs */
+	test_wpool_njobs = 1000,
+	/** Number of test workers */
+	test_wpool_nworkers = 4
+};
+
+/** Run test job.
+ *
+ * @param arg Array of job run counts (unsigned *)
+ * @param widx Worker index
+ * @param jidx Job index
+ */
+static void test_wpool_run(void *arg, unsigned widx, size_t jidx)
+{
+	unsigned *count = (unsigned *) arg;
+
+	(void) widx;
+	++count[jidx];
+}
+
+static wpool_ops_t test_wpool_ops = {
+	.run = test_wpool_run
+};
+
+/** Run work pool tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_wpool(void)
+{
+	wpool_t *pool;
+	unsigned *count;
+	size_t i;
+	int rc;
+
+	count = calloc(test_wpool_njobs, sizeof(unsigned));
+	if (count == NULL)
+		return ENOMEM;
+
+	rc = wpool_create(test_wpool_nworkers, test_wpool_njobs,
+	    &test_wpool_ops, count, &pool);
+	if (rc != EOK)
+		goto error;
+
+	wpool_destroy(pool);
+
+	/* Every job must have been run exactly once */
+	for (i = 0; i < test_wpool_njobs; i++) {
+		if (count[i] != 1) {
+			rc = EINVAL;
+			goto error;
+		}
+	}
+
+	/* More workers than jobs */
+	rc = wpool_create(test_wpool_nworkers, 1, &test_wpool_ops, count,
+	    &pool);
+	if (rc != EOK)
+		goto error;
+
+	wpool_destroy(pool);
+
+	if (count[0] != 2) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	free(count);
+	return EOK;
+error:
+	free(count);
+	return rc;
+}
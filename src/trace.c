@@ -0,0 +1,221 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Event trace
+ *
+ * Writes spans of time (checking a file, checker phases, checking
+ * a declaration) in the Chrome trace event format, which can be loaded
+ * into chrome://tracing, Perfetto and other trace viewers. Each thread
+ * writing to the trace is given a small thread number, in order of its
+ * first event, so that spans from parallel checks appear on separate
+ * tracks.
+ */
+
+#include <merrno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <trace.h>
+
+/** Create event trace.
+ *
+ * @param fname Output file name
+ * @param rtrace Place to store pointer to new trace
+ * @return EOK on success, ENOMEM if out of memory, EIO if the file
+ *         cannot be created
+ */
+int trace_create(const char *fname, trace_t **rtrace)
+{
+	trace_t *trace;
+
+	trace = calloc(1, sizeof(trace_t));
+	if (trace == NULL)
+		return ENOMEM;
+
+	if (pthread_key_create(&trace->tid_key, NULL) != 0) {
+		free(trace);
+		return ENOMEM;
+	}
+
+	trace->f = fopen(fname, "w");
+	if (trace->f == NULL) {
+		(void) pthread_key_delete(trace->tid_key);
+		free(trace);
+		return EIO;
+	}
+
+	pthread_mutex_init(&trace->lock, NULL);
+	trace->t0 = trace_now();
+	trace->first = true;
+
+	if (fputs("{\"traceEvents\":[", trace->f) == EOF)
+		trace->rc = EIO;
+
+	*rtrace = trace;
+	return EOK;
+}
+
+/** Finish and close event trace.
+ *
+ * @param trace Trace or @c NULL
+ * @return EOK on success, EIO if writing the trace failed
+ */
+int trace_close(trace_t *trace)
+{
+	int rc;
+
+	if (trace == NULL)
+		return EOK;
+
+	if (fputs("\n]}\n", trace->f) == EOF)
+		trace->rc = EIO;
+	if (fclose(trace->f) != 0)
+		trace->rc = EIO;
+
+	rc = trace->rc;
+	pthread_mutex_destroy(&trace->lock);
+	(void) pthread_key_delete(trace->tid_key);
+	free(trace);
+	return rc;
+}
+
+/** Get current time.
+ *
+ * @return Monotonic time in nanoseconds
+ */
+uint64_t trace_now(void)
+{
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+		return 0;
+
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/** Print string as a JSON string literal.
+ *
+ * @param str String
+ * @param f Output file
+ * @return EOK on success, EIO on I/O error
+ */
+static int trace_print_json_str(const char *str, FILE *f)
+{
+	const char *cp;
+	uint8_t b;
+
+	if (fputc('"', f) == EOF)
+		return EIO;
+
+	for (cp = str; *cp != '\0'; cp++) {
+		b = (uint8_t) *cp;
+		if (*cp == '"' || *cp == '\\') {
+			if (fputc('\\', f) == EOF || fputc(*cp, f) == EOF)
+				return EIO;
+		} else if (b < 32) {
+			if (fprintf(f, "\\u%04x", b) < 0)
+				return EIO;
+		} else {
+			if (fputc(*cp, f) == EOF)
+				return EIO;
+		}
+	}
+
+	if (fputc('"', f) == EOF)
+		return EIO;
+
+	return EOK;
+}
+
+/** Get number of calling thread.
+ *
+ * Must be called with the trace locked. A thread seen for the first
+ * time is given the next number and a name for it is written.
+ *
+ * @param trace Trace
+ * @return Thread number (starting from one)
+ */
+static unsigned trace_tid(trace_t *trace)
+{
+	unsigned tid;
+
+	tid = (unsigned) (uintptr_t) pthread_getspecific(trace->tid_key);
+	if (tid != 0)
+		return tid;
+
+	tid = ++trace->ntids;
+	(void) pthread_setspecific(trace->tid_key, (void *) (uintptr_t) tid);
+
+	if (fprintf(trace->f, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\","
+	    "\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+	    trace->first ? "" : ",", tid, tid) < 0)
+		trace->rc = EIO;
+
+	trace->first = false;
+	return tid;
+}
+
+/** Write span ending now.
+ *
+ * @param trace Trace
+ * @param cat Category
+ * @param name Name
+ * @param start Start time (from trace_now())
+ * @param line Source line to record with the span or zero
+ */
+void trace_span(trace_t *trace, const char *cat, const char *name,
+    uint64_t start, size_t line)
+{
+	uint64_t end;
+	unsigned tid;
+	FILE *f = trace->f;
+
+	end = trace_now();
+	if (start < trace->t0)
+		start = trace->t0;
+	if (end < start)
+		end = start;
+
+	pthread_mutex_lock(&trace->lock);
+
+	tid = trace_tid(trace);
+
+	if (fprintf(f, ",\n{\"name\":") < 0 ||
+	    trace_print_json_str(name, f) != EOK ||
+	    fprintf(f, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,"
+	    "\"dur\":%.3f,\"pid\":1,\"tid\":%u", cat,
+	    (double) (start - trace->t0) / 1000.0,
+	    (double) (end - start) / 1000.0, tid) < 0)
+		trace->rc = EIO;
+
+	if (line != 0 && fprintf(f, ",\"args\":{\"line\":%zu}", line) < 0)
+		trace->rc = EIO;
+
+	if (fputc('}', f) == EOF)
+		trace->rc = EIO;
+
+	pthread_mutex_unlock(&trace->lock);
+}
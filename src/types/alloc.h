@@ -0,0 +1,96 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Allocation tracker
+ */
+
+#ifndef TYPES_ALLOC_H
+#define TYPES_ALLOC_H
+
+#include <stddef.h>
+
+/** Subsystem to which an allocation is charged */
+typedef enum {
+	as_lexer,
+	as_parser,
+	as_ast,
+	as_checker,
+	as_limit
+} alloc_subsys_t;
+
+/** Allocation statistics of one subsystem */
+typedef struct {
+	/** Number of blocks allocated */
+	size_t nallocs;
+	/** Number of bytes allocated (including growth by reallocation) */
+	size_t nbytes;
+	/** Number of blocks currently allocated */
+	size_t nblocks;
+	/** Number of bytes currently allocated */
+	size_t cbytes;
+	/** Peak number of bytes allocated at the same time */
+	size_t peak;
+	/** Number of blocks found leaked when destroying a checker */
+	size_t nleaked;
+} alloc_stats_t;
+
+/** Allocation tracker */
+typedef struct alloc_track {
+	/** Statistics by subsystem */
+	alloc_stats_t ss[as_limit];
+	/** Number of bytes currently allocated by all subsystems */
+	size_t cbytes;
+	/** Peak number of bytes allocated by all subsystems */
+	size_t peak;
+	/**
+	 * Peak number of bytes allocated by all subsystems since
+	 * alloc_track_reset_peak()
+	 */
+	size_t rpeak;
+} alloc_track_t;
+
+/** Allocation mark (live blocks at some point in time) */
+typedef struct {
+	/** Tracker or @c NULL if allocations were not being tracked */
+	alloc_track_t *track;
+	/** Number of blocks allocated by each subsystem */
+	size_t nblocks[as_limit];
+} alloc_mark_t;
+
+/** Header of tracked block */
+typedef union {
+	struct {
+		/** Tracker charged with the block or @c NULL */
+		alloc_track_t *track;
+		/** Size of block (not including header) */
+		size_t size;
+		/** Subsystem charged with the block */
+		alloc_subsys_t ss;
+	} h;
+	/* Make sure the block that follows is suitably aligned */
+	long double ld;
+	long long ll;
+	void *p;
+} alloc_hdr_t;
+
+#endif
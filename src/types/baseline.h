@@ -0,0 +1,56 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TYPES_BASELINE_H
+#define TYPES_BASELINE_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Baseline (set of fingerprints of known issues, mapped from a file) */
+typedef struct {
+	/** Mapped file */
+	void *map;
+	/** Size of mapped file */
+	size_t map_size;
+	/** Hash table slots (little-endian 64-bit fingerprints) */
+	const uint8_t *slots;
+	/** Number of slots (power of two) */
+	uint64_t nslots;
+	/** Number of fingerprints */
+	uint64_t nentries;
+} baseline_t;
+
+/** Baseline writer (collects fingerprints of issues) */
+typedef struct {
+	/** Fingerprints */
+	uint64_t *fp;
+	/** Number of fingerprints */
+	size_t nfps;
+	/** Number of allocated entries */
+	size_t alloc;
+	/** Synchronizes adding fingerprints */
+	pthread_mutex_t lock;
+} baseline_wr_t;
+
+#endif
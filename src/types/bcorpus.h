@@ -0,0 +1,59 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Synthetic benchmark corpus
+ */
+
+#ifndef TYPES_BCORPUS_H
+#define TYPES_BCORPUS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/** Kind of synthetic source file */
+typedef enum {
+	/** Header consisting mostly of documentation comments */
+	bck_comments,
+	/** Deeply nested control flow */
+	bck_nested,
+	/** Giant initializer tables */
+	bck_tables,
+	/** Macro definitions and macro-heavy code */
+	bck_macros,
+	/** Long lines */
+	bck_longlines,
+	/** Number of corpus kinds */
+	bck_limit
+} bcorpus_kind_t;
+
+/** Synthetic corpus generator */
+typedef struct {
+	/** Output stream */
+	FILE *f;
+	/** Pseudo-random number generator state */
+	uint32_t seed;
+	/** Number of functions/declarations generated so far */
+	unsigned nitems;
+} bcorpus_t;
+
+#endif
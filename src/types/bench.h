@@ -0,0 +1,61 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Benchmarks
+ */
+
+#ifndef TYPES_BENCH_H
+#define TYPES_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Measured benchmark phase */
+typedef enum {
+	/** Lexing */
+	bph_lex,
+	/** Parsing */
+	bph_parse,
+	/** Rest of checker_run() */
+	bph_check,
+	/** Printing fixed source */
+	bph_fix_print,
+	/** Number of phases */
+	bph_limit
+} bench_phase_t;
+
+/** Benchmark result for one source file */
+typedef struct {
+	/** File name */
+	const char *fname;
+	/** Source size in bytes */
+	size_t nbytes;
+	/** Number of tokens */
+	size_t ntoks;
+	/** Median time spent in each phase in nanoseconds */
+	uint64_t time[bph_limit];
+	/** Median absolute deviation of time in each phase in nanoseconds */
+	uint64_t mad[bph_limit];
+} bench_res_t;
+
+#endif
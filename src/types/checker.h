@@ -29,8 +29,14 @@
 
 #include <adt/list.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <types/alloc.h>
 #include <types/ast.h>
+#include <types/diag.h>
 #include <types/lexer.h>
+#include <types/src_pos.h>
+#include <types/trace.h>
 
 /** Checker token */
 typedef struct {
@@ -62,6 +68,40 @@ typedef enum {
 	cmod_header
 } checker_mtype_t;
 
+/** Checker global declaration (incremental mode) */
+typedef struct {
+	/** Link in list of declarations */
+	link_t ldecls;
+	/** Declaration AST */
+	ast_node_t *decl;
+	/** @c true iff @c diags are up to date */
+	bool checked;
+	/** Diagnostics reported while checking the declaration */
+	diag_list_t diags;
+} checker_decl_t;
+
+/** Suppressed check groups starting at a line
+ *
+ * Entries are sorted by line. Each entry applies until the line
+ * of the next entry.
+ */
+typedef struct {
+	/** First line */
+	size_t bline;
+	/** Mask of suppressed check groups (bit number is diag_group_t) */
+	unsigned mask;
+} checker_supp_t;
+
+/** Change in suppression of a check group (used to build the table) */
+typedef struct {
+	/** Line where the change takes effect */
+	size_t line;
+	/** Check group */
+	diag_group_t group;
+	/** @c true if suppression begins, @c false if it ends */
+	bool begin;
+} checker_supp_ev_t;
+
 /** Checker module */
 typedef struct checker_module {
 	/** Containing checker */
@@ -70,8 +110,52 @@ typedef struct checker_module {
 	list_t toks; /* of checker_tok_t */
 	/** Module AST */
 	ast_module_t *ast;
+	/** Global declarations (incremental mode only) */
+	list_t decls; /* of checker_decl_t */
+	/** Lines changed by fixes, indexed by line number (fix mode only) */
+	bool *lfixed;
+	/** Number of entries in @c lfixed */
+	size_t nlines;
+	/** Number of tokens with a suppression directive */
+	size_t nsdirs;
+	/** @c true iff @c supp is up to date */
+	bool supp_valid;
+	/** Suppressed check groups by line */
+	checker_supp_t *supp;
+	/** Number of entries in @c supp */
+	size_t nsupp;
+	/** Number of times a token was visited walking the token list */
+	size_t nvisits;
 } checker_module_t;
 
+/** Extent of a global declaration (to find the enclosing declaration) */
+typedef struct {
+	/** Position of first token */
+	src_pos_t bpos;
+	/** Position of end of last token */
+	src_pos_t epos;
+	/** Declaration name token or @c NULL */
+	checker_tok_t *name;
+} checker_dextent_t;
+
+/** Range of source lines */
+typedef struct {
+	/** First line */
+	size_t bline;
+	/** Last line */
+	size_t eline;
+} checker_lrange_t;
+
+/** Source edit (replacement of a byte range) */
+typedef struct {
+	/** Offset of the replaced range in the old source */
+	size_t pos;
+	/** Size of the replaced range in the old source */
+	size_t old_size;
+	/** Size of the replacement text in the new source */
+	size_t new_size;
+} checker_edit_t;
+
 /** Checker configuration */
 typedef struct {
 	/** Declaration style */
@@ -92,6 +176,58 @@ typedef struct {
 	bool sclass;
 } checker_cfg_t;
 
+/** Checker phase (for statistics) */
+typedef enum {
+	/** Lexical analysis */
+	cph_lex,
+	/** Parsing */
+	cph_parse,
+	/** Checking the AST and tokens */
+	cph_check,
+	/** Checking comments */
+	cph_comments,
+	/** Checking lines */
+	cph_lines,
+	/** Checking vertical spacing */
+	cph_vspacing,
+	/** Number of phases */
+	cph_limit
+} checker_phase_t;
+
+/** Checker statistics */
+typedef struct {
+	/** Wall time spent in each phase in nanoseconds */
+	uint64_t wall[cph_limit];
+	/** CPU time spent in each phase in nanoseconds */
+	uint64_t cpu[cph_limit];
+	/** Number of source bytes read */
+	size_t nbytes;
+	/** Number of tokens produced by the lexer */
+	size_t ntoks;
+	/**
+	 * Number of AST nodes allocated by the parser (zero unless
+	 * allocations are tracked)
+	 */
+	size_t nnodes;
+	/** Number of tokens read by the parser (including re-reads) */
+	size_t nptoks;
+	/** Number of tokens visited by the checker (walking the token list) */
+	size_t nvisits;
+	/**
+	 * Peak number of bytes allocated by the checking thread during each
+	 * phase (zero unless allocations are tracked)
+	 */
+	size_t peak[cph_limit];
+} checker_stats_t;
+
+/** Start of a measured phase */
+typedef struct {
+	/** Wall clock time in nanoseconds */
+	uint64_t wall;
+	/** Thread CPU time in nanoseconds */
+	uint64_t cpu;
+} checker_stats_mark_t;
+
 /** Checker scope */
 typedef struct {
 	/** Scope indentation level, starting from zero */
@@ -114,8 +250,66 @@ typedef struct checker {
 	checker_mtype_t mtype;
 	/** Checker configuration */
 	checker_cfg_t *cfg;
+	/** Diagnostic sink ops */
+	diag_sink_ops_t *sink_ops;
+	/** Diagnostic sink argument */
+	void *sink_arg;
+	/** First error returned by diagnostic sink */
+	int sink_rc;
+	/** Diagnostics collected by the default sink */
+	diag_list_t diags;
+	/** Parse error output stream */
+	FILE *errf;
+	/** Incremental mode (keep diagnostics of each declaration) */
+	bool incr;
+	/** Compute fingerprints of reported diagnostics */
+	bool fps;
+	/** Only check lines in @c lrange */
+	bool lfilter;
+	/** Sorted, non-overlapping line ranges to check */
+	checker_lrange_t *lrange;
+	/** Number of entries in @c lrange */
+	size_t nlranges;
+	/** Global declaration extents in source order (built on demand) */
+	checker_dextent_t *dext;
+	/** Number of entries in @c dext */
+	size_t ndext;
+	/** @c true iff @c dext is up to date */
+	bool dext_valid;
+	/** Statistics to update or @c NULL */
+	checker_stats_t *stats;
+	/** Trace to write phase and declaration spans to or @c NULL */
+	trace_t *trace;
+	/** Stop checking after this many issues (zero for no limit) */
+	unsigned max_issues;
+	/** Number of issues reported by the current run */
+	unsigned nissues;
+	/** @c true if the issue limit was reached and checking should stop */
+	bool stop;
+	/** Allocations live before the checker was created */
+	alloc_mark_t amark;
 } checker_t;
 
+/** Unified diff of fixes */
+typedef struct {
+	/** Original source text */
+	const char *otext;
+	/** Size of @c otext */
+	size_t osize;
+	/** Number of lines in the original source */
+	size_t nlines;
+	/** Offset of each original line in @c otext (indexed by line number) */
+	size_t *ostart;
+	/** Fixed source text */
+	char *ntext;
+	/** Size of @c ntext */
+	size_t nsize;
+	/** Offset of each unchanged original line in @c ntext */
+	size_t *nstart;
+	/** @c true for each line changed by fixes (indexed by line number) */
+	bool *changed;
+} checker_diff_t;
+
 /** Checker parser input */
 typedef struct {
 	int dummy;
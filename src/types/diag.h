@@ -0,0 +1,217 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Diagnostics
+ */
+
+#ifndef TYPES_DIAG_H
+#define TYPES_DIAG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <types/lexer.h>
+
+/** Check group */
+typedef enum {
+	/** Declaration style */
+	dg_decl,
+	/** Empty statement */
+	dg_estmt,
+	/** Formatting */
+	dg_fmt,
+	/** Header style */
+	dg_hdr,
+	/** Invalid characters */
+	dg_invchar,
+	/** Loop style */
+	dg_loop,
+	/** Nested block */
+	dg_nblock,
+	/** Storage class issues */
+	dg_sclass,
+	/** Internal consistency checks (cannot be disabled) */
+	dg_internal
+} diag_group_t;
+
+/** Diagnostic message ID.
+ *
+ * Message IDs are stable and are used as part of machine-readable output.
+ * Only append new IDs at the end.
+ */
+typedef enum {
+	/** Token must begin on a new line */
+	dm_lbegin,
+	/** No whitespace before token */
+	dm_nows_before,
+	/** No whitespace after token */
+	dm_nows_after,
+	/** Non-spacing break before token */
+	dm_nsbrk_before,
+	/** Non-spacing break after token */
+	dm_nsbrk_after,
+	/** Breakable space before token */
+	dm_brkspace_before,
+	/** Breakable space after token */
+	dm_brkspace_after,
+	/** Non-breakable space before token */
+	dm_nbspace_before,
+	/** Binary operator at the beginning of a line */
+	dm_binop_lbegin,
+	/** Body of do loop without braces */
+	dm_do_braces,
+	/** For loop with empty next expression */
+	dm_for_empty_next,
+	/** Null statement */
+	dm_null_stmt,
+	/** Gratuitous nested block */
+	dm_nested_block,
+	/** Empty struct or union member declaration */
+	dm_empty_member,
+	/** Invalid character inside string literal */
+	dm_invchar_strlit,
+	/** Invalid character inside character literal */
+	dm_invchar_charlit,
+	/** Invalid character inside comment */
+	dm_invchar_comment,
+	/** Storage class extern with function definition */
+	dm_extern_fundef,
+	/** Non-static function defined in a header */
+	dm_hdr_fundef,
+	/** Multiple function declarators */
+	dm_multi_fundecl,
+	/** Mixing function and variable declarators */
+	dm_mixed_fun_var,
+	/** Non-static variable defined in a header */
+	dm_hdr_vardef,
+	/** Empty declaration */
+	dm_empty_decln,
+	/** Linked language is not C */
+	dm_externc_lang,
+	/** Mixing tabs and spaces in indentation */
+	dm_indent_mixed,
+	/** Spaces in indentation of non-continuation line */
+	dm_indent_noncont,
+	/** Wrong number of spaces in indentation */
+	dm_indent_spaces,
+	/** Wrong number of tabs in indentation */
+	dm_indent_tabs,
+	/** Mixing tabs and spaces */
+	dm_mixed_tabs_spaces,
+	/** Backslash outside of preprocessor directive */
+	dm_backslash,
+	/** Token not checked */
+	dm_tok_not_checked,
+	/** Indentation level mismatch between parser and checker */
+	dm_indlvl_mismatch,
+	/** Secondary indentation mismatch between parser and checker */
+	dm_seccont_mismatch,
+	/** Missing '*' at beginning of block comment line */
+	dm_cmt_asterisk,
+	/** Missing space after '*' in block comment line */
+	dm_cmt_space,
+	/** Unterminated comment */
+	dm_cmt_unterminated,
+	/** Block comment text not on a new line */
+	dm_cmt_text_nl,
+	/** Block comment closing not on a new line */
+	dm_cmt_close_nl,
+	/** Whitespace at end of line */
+	dm_trailing_ws,
+	/** Empty line at beginning of file */
+	dm_bof_empty_line,
+	/** Multiple consecutive empty lines */
+	dm_multi_empty_lines,
+	/** Missing newline at end of file */
+	dm_eof_newline,
+	/** Empty lines at end of file */
+	dm_eof_empty_lines,
+
+	/** Number of message IDs */
+	dm_limit
+} diag_msg_t;
+
+/** Diagnostic record */
+typedef struct {
+	/** File name */
+	const char *file;
+	/** Line of beginning of range */
+	size_t bline;
+	/** Column of beginning of range */
+	size_t bcol;
+	/** Line of end of range */
+	size_t eline;
+	/** Column of end of range */
+	size_t ecol;
+	/** Type of the offending token */
+	lexer_toktype_t ttype;
+	/** Text of the offending token (only if part of the tag) or @c NULL */
+	const char *ttext;
+	/** Check group */
+	diag_group_t group;
+	/** Message ID */
+	diag_msg_t msg;
+	/** Text argument (static string) or @c NULL */
+	const char *text;
+	/** Numeric arguments */
+	unsigned num[2];
+	/** Character argument */
+	char chr;
+	/** Sequence number (order in which the diagnostic was reported) */
+	size_t seq;
+	/**
+	 * Fingerprint (hash of message ID, surrounding tokens and name
+	 * of the enclosing declaration, does not depend on position)
+	 * or zero if not computed
+	 */
+	uint64_t fp;
+} diag_t;
+
+/** Diagnostic sink ops */
+typedef struct {
+	/** Report diagnostic */
+	int (*report)(void *, diag_t *);
+} diag_sink_ops_t;
+
+/** Diagnostic output format */
+typedef enum {
+	/** Human-readable text */
+	dfmt_text,
+	/** JSON lines */
+	dfmt_jsonl,
+	/** Compact binary records */
+	dfmt_bin
+} diag_fmt_t;
+
+/** Diagnostic list (per-file vector of diagnostics) */
+typedef struct {
+	/** File name (shared by all entries) */
+	char *fname;
+	/** Array of diagnostics */
+	diag_t *diag;
+	/** Number of diagnostics */
+	size_t ndiags;
+	/** Number of allocated entries */
+	size_t alloc;
+} diag_list_t;
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * List of source files to check
+ */
+
+#ifndef TYPES_FLIST_H
+#define TYPES_FLIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/** File list entry */
+typedef struct {
+	/** File path */
+	char *path;
+	/** File size in bytes */
+	size_t size;
+} flist_entry_t;
+
+/** File list */
+typedef struct {
+	/** Array of entries */
+	flist_entry_t *entry;
+	/** Number of entries */
+	size_t nentries;
+	/** Number of allocated entries */
+	size_t alloc;
+	/** @c true if any directory has been scanned */
+	bool dirs;
+	/** Directory relative paths are resolved against */
+	int dirfd;
+	/** Output stream for errors */
+	FILE *errf;
+} flist_t;
+
+#endif
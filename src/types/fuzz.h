@@ -0,0 +1,92 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Complexity fuzzer
+ */
+
+#ifndef TYPES_FUZZ_H
+#define TYPES_FUZZ_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/** Fragment category */
+typedef enum {
+	/** Expression */
+	fzc_expr,
+	/** Statement */
+	fzc_stmt,
+	/** Declarator */
+	fzc_dlr,
+	/** Initializer */
+	fzc_init,
+	/** Global declaration */
+	fzc_gdecl,
+	/** Number of categories */
+	fzc_limit
+} fuzz_cat_t;
+
+/** Fragment template with a hole.
+ *
+ * Nesting the template @c k times gives @c k copies of @c prefix,
+ * the innermost fragment and @c k copies of @c suffix.
+ */
+typedef struct {
+	/** Fragment category */
+	fuzz_cat_t cat;
+	/** Text before the hole */
+	char *prefix;
+	/** Size of @c prefix */
+	size_t prefix_size;
+	/** Text after the hole */
+	char *suffix;
+	/** Size of @c suffix */
+	size_t suffix_size;
+} fuzz_tmpl_t;
+
+/** Work done checking one input */
+typedef struct {
+	/** Number of tokens produced by the lexer */
+	size_t ntoks;
+	/** Number of tokens read by the parser */
+	size_t nptoks;
+	/** Number of tokens visited by the checker */
+	size_t nvisits;
+} fuzz_work_t;
+
+/** Complexity fuzzer */
+typedef struct {
+	/** Pseudo-random number generator state */
+	uint32_t seed;
+	/** Stream for text before the hole */
+	FILE *pf;
+	/** Stream for text after the hole */
+	FILE *sf;
+	/** Current output stream (@c pf until the hole is generated) */
+	FILE *f;
+	/** Output stream that discards output */
+	FILE *nullf;
+} fuzz_t;
+
+#endif
@@ -148,6 +148,18 @@ typedef enum {
 #define ltt_resword_first ltt_attribute
 #define ltt_resword_last ltt_while
 
+/** Suppression directive recognized in a comment token */
+typedef enum {
+	/** Not a suppression directive */
+	lsd_none,
+	/** ccheck-disable */
+	lsd_disable,
+	/** ccheck-enable */
+	lsd_enable,
+	/** ccheck-disable-next-line */
+	lsd_disable_next_line
+} lexer_sdir_t;
+
 /** Lexer token */
 typedef struct {
 	/** Position of beginning of token */
@@ -156,6 +168,8 @@ typedef struct {
 	src_pos_t epos;
 	/** Token type */
 	lexer_toktype_t ttype;
+	/** Suppression directive (ltt_ctext and ltt_dscomment only) */
+	lexer_sdir_t sdir;
 	/** Token full text */
 	char *text;
 	/** Text size not including null terminator */
@@ -166,7 +180,10 @@ typedef struct {
 
 /** Lexer input ops */
 typedef struct {
+	/** Read characters into lexer buffer */
 	int (*read)(void *, char *, size_t, size_t *, src_pos_t *);
+	/** Get entire input to scan in place (optional) */
+	int (*map)(void *, const char **, size_t *, src_pos_t *);
 } lexer_input_ops_t;
 
 typedef enum {
@@ -180,9 +197,11 @@ typedef enum {
 typedef struct {
 	/** Input buffer */
 	char buf[lexer_buf_size];
-	/** Buffer position */
+	/** Input scanned in place or @c NULL if reading into buf */
+	const char *ibuf;
+	/** Buffer position (in ibuf if not @c NULL, otherwise in buf) */
 	size_t buf_pos;
-	/** Number of used bytes in buf */
+	/** Number of used bytes in ibuf or buf */
 	size_t buf_used;
 	/** Position of start of input buffer */
 	src_pos_t buf_bpos;
@@ -190,6 +209,8 @@ typedef struct {
 	src_pos_t pos;
 	/** EOF hit in input */
 	bool in_eof;
+	/** Error returned by input or EOK */
+	int in_rc;
 	/** Input ops */
 	lexer_input_ops_t *input_ops;
 	/** Input argument */
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TYPES_LFILTER_H
+#define TYPES_LFILTER_H
+
+#include <stddef.h>
+#include <types/checker.h>
+
+/** Line ranges to check in one file */
+typedef struct {
+	/** File path */
+	char *fname;
+	/** Line ranges */
+	checker_lrange_t *range;
+	/** Number of line ranges */
+	size_t nranges;
+	/** Number of allocated line ranges */
+	size_t alloc;
+} lfilter_file_t;
+
+/** Line filter (line ranges to check in each file) */
+typedef struct {
+	/** Array of files */
+	lfilter_file_t *file;
+	/** Number of files */
+	size_t nfiles;
+	/** Number of allocated files */
+	size_t alloc;
+} lfilter_t;
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TYPES_MCACHE_H
+#define TYPES_MCACHE_H
+
+#include <adt/list.h>
+#include <types/buf_input.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <types/checker.h>
+
+struct mcache;
+
+/** Module cache entry (checked module kept in memory) */
+typedef struct {
+	/** Containing module cache */
+	struct mcache *mcache;
+	/** Link to @c mcache->entries */
+	link_t lentries;
+	/** File name */
+	char *fname;
+	/** Module type */
+	checker_mtype_t mtype;
+	/** Checker configuration */
+	checker_cfg_t *cfg;
+	/** Checker in incremental mode */
+	checker_t *checker;
+	/** Input the checker was created with */
+	buf_input_t binput;
+	/** Source text the checker state corresponds to */
+	char *text;
+	/** Size of @c text */
+	size_t size;
+	/** Estimated memory used by the entry in bytes */
+	size_t mem;
+} mcache_entry_t;
+
+/** Module cache.
+ *
+ * Keeps checkers of recently checked modules in memory so that a changed
+ * module can be re-checked incrementally.
+ */
+typedef struct mcache {
+	/** Entries, most recently used first */
+	list_t entries;
+	/** Estimated memory used by all entries in bytes */
+	size_t mem;
+	/** Maximum estimated memory used by all entries in bytes */
+	size_t max_mem;
+	/** Compute fingerprints of reported diagnostics */
+	bool fps;
+} mcache_t;
+
+#endif
@@ -27,6 +27,8 @@
 #ifndef TYPES_PARSER_H
 #define TYPES_PARSER_H
 
+#include <stddef.h>
+#include <stdio.h>
 #include <types/lexer.h>
 
 enum {
@@ -57,6 +59,10 @@ typedef struct {
 	unsigned indlvl;
 	/** Currently in secondary continuation? */
 	bool seccont;
+	/** Error output stream */
+	FILE *errf;
+	/** Counter of input tokens read (shared with sub-parsers) or @c NULL */
+	size_t *nread;
 } parser_t;
 
 #endif
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Project configuration (.ccheck files)
+ */
+
+#ifndef TYPES_PCONF_H
+#define TYPES_PCONF_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <types/checker.h>
+
+/** File type override */
+typedef struct {
+	/** File name pattern */
+	char *glob;
+	/** Module type of matching files */
+	checker_mtype_t mtype;
+} pconf_type_t;
+
+/** Configuration of a directory */
+typedef struct pconf_dir {
+	/** Absolute directory path */
+	char *path;
+	/** Configuration of parent directory or @c NULL */
+	struct pconf_dir *parent;
+	/** @c true iff the directory contains a configuration file */
+	bool has_file;
+	/** Patterns of files not to check */
+	char **ignore;
+	/** Number of entries in @c ignore */
+	size_t nignore;
+	/** File type overrides (later ones take precedence) */
+	pconf_type_t *type;
+	/** Number of entries in @c type */
+	size_t ntypes;
+	/** Enabled check groups (bit number is diag_group_t) */
+	unsigned groups;
+	/** Checker configuration for files in the directory */
+	checker_cfg_t cfg;
+} pconf_dir_t;
+
+/** Project configuration (configuration files found so far) */
+typedef struct {
+	/** Directory relative paths are resolved against */
+	char *cwd;
+	/** Check groups enabled on the command line */
+	unsigned base_groups;
+	/** Directories seen so far, sorted by path */
+	pconf_dir_t **dir;
+	/** Number of entries in @c dir */
+	size_t ndirs;
+	/** Number of allocated entries in @c dir */
+	size_t alloc;
+	/** Output stream for errors */
+	FILE *errf;
+	/** Protects @c dir, @c ndirs and @c alloc */
+	pthread_rwlock_t lock;
+} pconf_t;
+
+/** Configuration of a file */
+typedef struct {
+	/** Checker configuration */
+	checker_cfg_t *cfg;
+	/** @c true iff the file should not be checked */
+	bool ignore;
+	/** @c true iff @c mtype overrides the type by extension */
+	bool mtype_set;
+	/** Module type */
+	checker_mtype_t mtype;
+} pconf_file_t;
+
+#endif
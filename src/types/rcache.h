@@ -0,0 +1,55 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TYPES_RCACHE_H
+#define TYPES_RCACHE_H
+
+#include <pthread.h>
+#include <stdint.h>
+
+/** Result cache key */
+typedef struct {
+	/** Hash of file contents and everything affecting the result */
+	uint64_t hash;
+	/** File size */
+	uint64_t size;
+	/** Enabled check groups */
+	uint32_t cfgmask;
+	/** Module type */
+	uint8_t mtype;
+} rcache_key_t;
+
+/** Result cache */
+typedef struct {
+	/** Cache directory */
+	char *dir;
+	/** Maximum total size of cache entries in bytes */
+	uint64_t max_size;
+	/** Identity of the running ccheck binary */
+	uint64_t exe_id;
+	/** Protects @c nstored */
+	pthread_mutex_t lock;
+	/** Number of entries stored since the cache was opened */
+	unsigned nstored;
+} rcache_t;
+
+#endif
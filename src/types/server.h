@@ -0,0 +1,92 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TYPES_SERVER_H
+#define TYPES_SERVER_H
+
+#include <stdio.h>
+
+/** Server protocol message type */
+typedef enum {
+	/** Client working directory (request) */
+	smt_cwd = 'D',
+	/** Command-line argument (request) */
+	smt_arg = 'A',
+	/** Chunk of standard input (request) */
+	smt_input = 'I',
+	/** End of request */
+	smt_end = 'E',
+	/** Chunk of standard output (reply) */
+	smt_out = 'O',
+	/** Chunk of error output (reply) */
+	smt_err = 'R',
+	/** Exit status, ends the reply */
+	smt_exit = 'X'
+} server_msg_t;
+
+/** Check request
+ *
+ * Describes one invocation of ccheck, either from the command line
+ * or received by the server.
+ */
+typedef struct {
+	/** Number of arguments */
+	int argc;
+	/** Arguments (argv[0] is not used) */
+	char **argv;
+	/** Working directory path or @c NULL for the current directory */
+	const char *cwd;
+	/** Working directory (or @c AT_FDCWD) */
+	int dirfd;
+	/** Standard input */
+	FILE *inf;
+	/** Standard output */
+	FILE *outf;
+	/** Error output */
+	FILE *errf;
+} server_req_t;
+
+/** Server ops */
+typedef struct {
+	/** Run request, return EOK or error code (non-zero exit status) */
+	int (*run)(void *, server_req_t *);
+} server_ops_t;
+
+/** Check server */
+typedef struct {
+	/** Listening socket */
+	int lsock;
+	/** Ops */
+	server_ops_t *ops;
+	/** Argument to ops */
+	void *arg;
+} server_t;
+
+/** Server output stream (one per connection and message type) */
+typedef struct {
+	/** Connection socket */
+	int sock;
+	/** Message type to send data as */
+	server_msg_t mtype;
+} server_ostream_t;
+
+#endif
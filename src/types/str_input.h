@@ -34,6 +34,8 @@
 typedef struct {
 	/** String */
 	const char *str;
+	/** String length */
+	size_t len;
 	/** Current position in buffer */
 	size_t pos;
 	/** Current source position */
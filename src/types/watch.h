@@ -0,0 +1,55 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TYPES_WATCH_H
+#define TYPES_WATCH_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/** Watched directory */
+typedef struct {
+	/** Watch descriptor */
+	int wd;
+	/** Directory path */
+	char *path;
+} watch_dir_t;
+
+/** Watch for changes of source files in directory trees */
+typedef struct {
+	/** inotify file descriptor */
+	int fd;
+	/** Watched directories */
+	watch_dir_t *dir;
+	/** Number of watched directories */
+	size_t ndirs;
+	/** Number of entries allocated in @c dir */
+	size_t alloc;
+	/** Directories passed to watch_add_dir() */
+	char **root;
+	/** Number of entries in @c root */
+	size_t nroots;
+	/** Output stream for errors */
+	FILE *errf;
+} watch_t;
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TYPES_WPOOL_H
+#define TYPES_WPOOL_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** Work pool ops */
+typedef struct {
+	/** Run job (argument, worker index, job index) */
+	void (*run)(void *, unsigned, size_t);
+} wpool_ops_t;
+
+struct wpool;
+
+/** Work pool worker */
+typedef struct {
+	/** Containing work pool */
+	struct wpool *pool;
+	/** Worker index */
+	unsigned idx;
+	/** Worker thread */
+	pthread_t thread;
+	/** @c true if the thread has been started */
+	bool started;
+	/** Protects the job queue */
+	pthread_mutex_t lock;
+	/** Job queue (array of job indices) */
+	size_t *job;
+	/** Index of the first remaining job in the queue */
+	size_t head;
+	/** Index past the last remaining job in the queue */
+	size_t tail;
+} wpool_worker_t;
+
+/** Work pool */
+typedef struct wpool {
+	/** Ops */
+	wpool_ops_t *ops;
+	/** Argument to ops */
+	void *arg;
+	/** Array of workers */
+	wpool_worker_t *worker;
+	/** Number of workers */
+	unsigned nworkers;
+} wpool_t;
+
+#endif
@@ -0,0 +1,427 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Watch for changes of source files in directory trees
+ *
+ * Each directory in the watched trees has an inotify watch. Directories
+ * created in (or moved into) a watched tree are watched as they appear.
+ * Changes that arrive in quick succession (e.g. an editor saving several
+ * files) are collected into a single batch.
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <flist.h>
+#include <merrno.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <watch.h>
+
+enum {
+	/** Initial number of entries allocated in a directory array */
+	watch_init_alloc = 16,
+	/** Time to wait for further changes in milliseconds */
+	watch_settle_ms = 100,
+	/** Size of buffer for reading events */
+	watch_buf_size = 65536,
+	/** Events watched for in each directory */
+	watch_mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+	    IN_MOVED_TO | IN_ONLYDIR
+};
+
+/** Create watch.
+ *
+ * @param errf Output stream for errors
+ * @param rwatch Place to store pointer to new watch
+ * @return EOK on success, ENOMEM if out of memory, EIO if inotify
+ *         is not available
+ */
+int watch_create(FILE *errf, watch_t **rwatch)
+{
+	watch_t *watch;
+
+	watch = calloc(1, sizeof(watch_t));
+	if (watch == NULL)
+		return ENOMEM;
+
+	watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (watch->fd < 0) {
+		fprintf(errf, "Cannot initialize inotify.\n");
+		free(watch);
+		return EIO;
+	}
+
+	watch->errf = errf;
+	*rwatch = watch;
+	return EOK;
+}
+
+/** Destroy watch.
+ *
+ * @param watch Watch
+ */
+void watch_destroy(watch_t *watch)
+{
+	size_t i;
+
+	if (watch == NULL)
+		return;
+
+	for (i = 0; i < watch->ndirs; i++)
+		free(watch->dir[i].path);
+	for (i = 0; i < watch->nroots; i++)
+		free(watch->root[i]);
+
+	close(watch->fd);
+	free(watch->dir);
+	free(watch->root);
+	free(watch);
+}
+
+/** Find watched directory by watch descriptor.
+ *
+ * @param watch Watch
+ * @param wd Watch descriptor
+ * @return Watched directory or @c NULL if not found
+ */
+static watch_dir_t *watch_find(watch_t *watch, int wd)
+{
+	size_t i;
+
+	for (i = 0; i < watch->ndirs; i++) {
+		if (watch->dir[i].wd == wd)
+			return &watch->dir[i];
+	}
+
+	return NULL;
+}
+
+/** Forget watched directory.
+ *
+ * @param watch Watch
+ * @param dir Watched directory
+ */
+static void watch_dir_remove(watch_t *watch, watch_dir_t *dir)
+{
+	free(dir->path);
+	*dir = watch->dir[--watch->ndirs];
+}
+
+/** Start watching a single directory.
+ *
+ * @param watch Watch
+ * @param path Directory path
+ * @return EOK on success, ENOMEM if out of memory, EIO if the directory
+ *         cannot be watched
+ */
+static int watch_dir_add(watch_t *watch, const char *path)
+{
+	watch_dir_t *dir;
+	watch_dir_t *ndir;
+	size_t nalloc;
+	char *dpath;
+	int wd;
+
+	dpath = strdup(path);
+	if (dpath == NULL)
+		return ENOMEM;
+
+	wd = inotify_add_watch(watch->fd, path, watch_mask);
+	if (wd < 0) {
+		fprintf(watch->errf, "Cannot watch directory '%s'.\n", path);
+		free(dpath);
+		return EIO;
+	}
+
+	/* The same directory can be reached by a different path */
+	dir = watch_find(watch, wd);
+	if (dir != NULL) {
+		free(dir->path);
+		dir->path = dpath;
+		return EOK;
+	}
+
+	if (watch->ndirs >= watch->alloc) {
+		nalloc = watch->alloc != 0 ? 2 * watch->alloc :
+		    watch_init_alloc;
+		ndir = realloc(watch->dir, nalloc * sizeof(watch_dir_t));
+		if (ndir == NULL) {
+			(void) inotify_rm_watch(watch->fd, wd);
+			free(dpath);
+			return ENOMEM;
+		}
+
+		watch->dir = ndir;
+		watch->alloc = nalloc;
+	}
+
+	watch->dir[watch->ndirs].wd = wd;
+	watch->dir[watch->ndirs].path = dpath;
+	++watch->ndirs;
+	return EOK;
+}
+
+/** Start watching a directory tree.
+ *
+ * Symbolic links are not followed.
+ *
+ * @param watch Watch
+ * @param path Directory path
+ * @return EOK on success or error code
+ */
+static int watch_tree_add(watch_t *watch, const char *path)
+{
+	DIR *dir;
+	struct dirent *de;
+	struct stat st;
+	char *spath;
+	int rc;
+
+	rc = watch_dir_add(watch, path);
+	if (rc != EOK)
+		return rc;
+
+	dir = opendir(path);
+	if (dir == NULL) {
+		/* Vanished in the meantime */
+		return EOK;
+	}
+
+	while ((de = readdir(dir)) != NULL) {
+		if (strcmp(de->d_name, ".") == 0 ||
+		    strcmp(de->d_name, "..") == 0)
+			continue;
+
+		if (asprintf(&spath, "%s/%s", path, de->d_name) < 0) {
+			closedir(dir);
+			return ENOMEM;
+		}
+
+		if (lstat(spath, &st) == 0 && S_ISDIR(st.st_mode)) {
+			rc = watch_tree_add(watch, spath);
+			if (rc != EOK) {
+				free(spath);
+				closedir(dir);
+				return rc;
+			}
+		}
+
+		free(spath);
+	}
+
+	closedir(dir);
+	return EOK;
+}
+
+/** Stop watching a directory tree.
+ *
+ * @param watch Watch
+ * @param path Directory path
+ */
+static void watch_tree_remove(watch_t *watch, const char *path)
+{
+	size_t len;
+	size_t i;
+
+	len = strlen(path);
+
+	i = 0;
+	while (i < watch->ndirs) {
+		if (strncmp(watch->dir[i].path, path, len) == 0 &&
+		    (watch->dir[i].path[len] == '\0' ||
+		    watch->dir[i].path[len] == '/')) {
+			(void) inotify_rm_watch(watch->fd, watch->dir[i].wd);
+			watch_dir_remove(watch, &watch->dir[i]);
+		} else {
+			++i;
+		}
+	}
+}
+
+/** Watch directory tree for changes.
+ *
+ * @param watch Watch
+ * @param path Directory path
+ * @return EOK on success or error code
+ */
+int watch_add_dir(watch_t *watch, const char *path)
+{
+	char **nroot;
+	char *dpath;
+
+	dpath = strdup(path);
+	if (dpath == NULL)
+		return ENOMEM;
+
+	nroot = realloc(watch->root, (watch->nroots + 1) * sizeof(char *));
+	if (nroot == NULL) {
+		free(dpath);
+		return ENOMEM;
+	}
+
+	watch->root = nroot;
+	watch->root[watch->nroots++] = dpath;
+
+	return watch_tree_add(watch, path);
+}
+
+/** Process inotify event.
+ *
+ * @param watch Watch
+ * @param ev Event
+ * @param flist File list to add changed files to
+ * @return EOK on success or error code
+ */
+static int watch_event(watch_t *watch, struct inotify_event *ev,
+    flist_t *flist)
+{
+	watch_dir_t *dir;
+	char *path;
+	size_t i;
+	int rc;
+
+	if ((ev->mask & IN_Q_OVERFLOW) != 0) {
+		/* Some events were lost, assume everything changed */
+		for (i = 0; i < watch->nroots; i++) {
+			rc = flist_add_path(flist, watch->root[i]);
+			if (rc != EOK)
+				return rc;
+		}
+
+		return EOK;
+	}
+
+	dir = watch_find(watch, ev->wd);
+	if (dir == NULL)
+		return EOK;
+
+	if ((ev->mask & IN_IGNORED) != 0) {
+		/* Directory was deleted */
+		watch_dir_remove(watch, dir);
+		return EOK;
+	}
+
+	if (ev->len == 0)
+		return EOK;
+
+	if (asprintf(&path, "%s/%s", dir->path, ev->name) < 0)
+		return ENOMEM;
+
+	rc = EOK;
+	if ((ev->mask & IN_ISDIR) != 0) {
+		if ((ev->mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+			/* Files may have been created before we watch it */
+			rc = watch_tree_add(watch, path);
+			if (rc == EOK)
+				rc = flist_add_path(flist, path);
+		} else if ((ev->mask & IN_MOVED_FROM) != 0) {
+			watch_tree_remove(watch, path);
+		}
+	} else if ((ev->mask & IN_CREATE) == 0 &&
+	    flist_is_src_name(ev->name)) {
+		/* Written, replaced or removed */
+		rc = flist_add_path(flist, path);
+	}
+
+	free(path);
+	return rc;
+}
+
+/** Wait for changes of source files.
+ *
+ * Blocks until at least one source file in the watched trees has been
+ * written, created, replaced or removed and no further changes arrive
+ * for a short while.
+ *
+ * @param watch Watch
+ * @param flist Empty file list to add changed (or removed) files to,
+ *              sorted and without duplicates
+ * @return EOK on success or error code
+ */
+int watch_wait(watch_t *watch, flist_t *flist)
+{
+	union {
+		struct inotify_event ev;
+		char data[watch_buf_size];
+	} buf;
+	struct inotify_event *ev;
+	struct pollfd pfd;
+	ssize_t nread;
+	ssize_t offs;
+	int timeout;
+	int n;
+	int rc;
+
+	timeout = -1;
+	while (true) {
+		pfd.fd = watch->fd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+
+		n = poll(&pfd, 1, timeout);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			return EIO;
+		}
+
+		if (n == 0) {
+			if (flist->nentries > 0)
+				break;
+
+			/* Only irrelevant changes, keep waiting */
+			timeout = -1;
+			continue;
+		}
+
+		nread = read(watch->fd, buf.data, sizeof(buf.data));
+		if (nread < 0) {
+			if (errno == EINTR || errno == EAGAIN)
+				continue;
+			return EIO;
+		}
+
+		offs = 0;
+		while (offs < nread) {
+			ev = (struct inotify_event *) (buf.data + offs);
+			rc = watch_event(watch, ev, flist);
+			if (rc != EOK)
+				return rc;
+
+			offs += sizeof(struct inotify_event) + ev->len;
+		}
+
+		timeout = watch_settle_ms;
+	}
+
+	flist_uniq(flist);
+	return EOK;
+}
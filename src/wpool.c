@@ -0,0 +1,213 @@
+/*
+ * Copyright 2019 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Work-stealing pool of worker threads
+ *
+ * A fixed number of jobs, identified by their index, is distributed
+ * among the workers' queues up front. Job indices are taken to express
+ * priority (lower index is started earlier). Each worker runs jobs from
+ * its own queue and, once it is empty, steals jobs from the other
+ * workers' queues. The pool finishes once all queues are empty.
+ */
+
+#include <merrno.h>
+#include <stdlib.h>
+#include <wpool.h>
+
+static void *wpool_worker_main(void *);
+
+/** Take next job from a worker's queue.
+ *
+ * The job with the highest priority is taken both by the worker itself
+ * and by any thief so that large jobs are started first.
+ *
+ * @param worker Worker whose queue to take the job from
+ * @param rjob Place to store job index
+ * @return @c true if a job was taken, @c false if the queue is empty
+ */
+static bool wpool_worker_take(wpool_worker_t *worker, size_t *rjob)
+{
+	bool taken = false;
+
+	pthread_mutex_lock(&worker->lock);
+	if (worker->head < worker->tail) {
+		*rjob = worker->job[worker->head++];
+		taken = true;
+	}
+	pthread_mutex_unlock(&worker->lock);
+
+	return taken;
+}
+
+/** Get next job for a worker.
+ *
+ * @param worker Worker
+ * @param rjob Place to store job index
+ * @return @c true if a job was found, @c false if all queues are empty
+ */
+static bool wpool_next_job(wpool_worker_t *worker, size_t *rjob)
+{
+	wpool_t *pool = worker->pool;
+	unsigned i;
+
+	if (wpool_worker_take(worker, rjob))
+		return true;
+
+	/* Own queue is empty, try stealing from others */
+	for (i = 1; i < pool->nworkers; i++) {
+		if (wpool_worker_take(&pool->worker[(worker->idx + i) %
+		    pool->nworkers], rjob))
+			return true;
+	}
+
+	return false;
+}
+
+/** Worker thread main function.
+ *
+ * @param arg Worker (wpool_worker_t *)
+ * @return NULL
+ */
+static void *wpool_worker_main(void *arg)
+{
+	wpool_worker_t *worker = (wpool_worker_t *) arg;
+	wpool_t *pool = worker->pool;
+	size_t job;
+
+	while (wpool_next_job(worker, &job))
+		pool->ops->run(pool->arg, worker->idx, job);
+
+	return NULL;
+}
+
+/** Create work pool and start running jobs.
+ *
+ * Jobs are run asynchronously. The caller must synchronize with
+ * completion of individual jobs itself, or wait for all jobs to finish
+ * by calling wpool_destroy().
+ *
+ * @param nworkers Number of worker threads (at least one)
+ * @param njobs Number of jobs
+ * @param ops Ops
+ * @param arg Argument to @a ops
+ * @param rpool Place to store pointer to new work pool
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int wpool_create(unsigned nworkers, size_t njobs, wpool_ops_t *ops,
+    void *arg, wpool_t **rpool)
+{
+	wpool_t *pool;
+	wpool_worker_t *worker;
+	size_t qsize;
+	size_t i;
+	unsigned w;
+	int rc;
+
+	pool = calloc(1, sizeof(wpool_t));
+	if (pool == NULL)
+		return ENOMEM;
+
+	pool->ops = ops;
+	pool->arg = arg;
+	pool->nworkers = nworkers;
+
+	pool->worker = calloc(nworkers, sizeof(wpool_worker_t));
+	if (pool->worker == NULL) {
+		free(pool);
+		return ENOMEM;
+	}
+
+	qsize = (njobs + nworkers - 1) / nworkers;
+
+	for (w = 0; w < nworkers; w++) {
+		worker = &pool->worker[w];
+		worker->pool = pool;
+		worker->idx = w;
+		pthread_mutex_init(&worker->lock, NULL);
+	}
+
+	for (w = 0; w < nworkers; w++) {
+		worker = &pool->worker[w];
+		worker->job = calloc(qsize > 0 ? qsize : 1, sizeof(size_t));
+		if (worker->job == NULL) {
+			rc = ENOMEM;
+			goto error;
+		}
+	}
+
+	/* Deal jobs round-robin so that every queue starts with large jobs */
+	for (i = 0; i < njobs; i++) {
+		worker = &pool->worker[i % nworkers];
+		worker->job[worker->tail++] = i;
+	}
+
+	for (w = 0; w < nworkers; w++) {
+		worker = &pool->worker[w];
+		if (pthread_create(&worker->thread, NULL, wpool_worker_main,
+		    worker) != 0) {
+			rc = ENOMEM;
+			goto error;
+		}
+
+		worker->started = true;
+	}
+
+	*rpool = pool;
+	return EOK;
+error:
+	/* Drain all queues so that running workers finish quickly */
+	for (w = 0; w < nworkers; w++) {
+		worker = &pool->worker[w];
+		pthread_mutex_lock(&worker->lock);
+		worker->head = worker->tail;
+		pthread_mutex_unlock(&worker->lock);
+	}
+
+	wpool_destroy(pool);
+	return rc;
+}
+
+/** Wait for all jobs to finish and destroy work pool.
+ *
+ * @param pool Work pool
+ */
+void wpool_destroy(wpool_t *pool)
+{
+	unsigned w;
+
+	if (pool == NULL)
+		return;
+
+	for (w = 0; w < pool->nworkers; w++) {
+		if (pool->worker[w].started)
+			pthread_join(pool->worker[w].thread, NULL);
+	}
+
+	for (w = 0; w < pool->nworkers; w++) {
+		pthread_mutex_destroy(&pool->worker[w].lock);
+		free(pool->worker[w].job);
+	}
+
+	free(pool->worker);
+	free(pool);
+}
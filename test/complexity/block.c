@@ -0,0 +1,208 @@
+/*
+ * Deeply nested blocks
+ */
+
+int f(void)
+{
+	{
+		{
+			{
+				{
+					{
+						{
+							{
+								{
+									{
+										{
+											{
+												{
+													{
+														{
+															{
+																{
+																	{
+																		{
+																			{
+																				{
+																					{
+																						{
+																							{
+																								{
+																									{
+																										{
+																											{
+																												{
+																													{
+																														{
+																															{
+																																{
+																																	{
+																																		{
+																																			{
+																																				{
+																																					{
+																																						{
+																																							{
+																																								{
+																																									{
+																																										{
+																																											{
+																																												{
+																																													{
+																																														{
+																																															{
+																																																{
+																																																	{
+																																																		{
+																																																			{
+																																																				{
+																																																					{
+																																																						{
+																																																							{
+																																																								{
+																																																									{
+																																																										{
+																																																											{
+																																																												{
+																																																													{
+																																																														{
+																																																															{
+																																																																{
+																																																																	{
+																																																																		{
+																																																																			{
+																																																																				{
+																																																																					{
+																																																																						{
+																																																																							{
+																																																																								{
+																																																																									{
+																																																																										{
+																																																																											{
+																																																																												{
+																																																																													{
+																																																																														{
+																																																																															{
+																																																																																{
+																																																																																	{
+																																																																																		{
+																																																																																			{
+																																																																																				{
+																																																																																					{
+																																																																																						{
+																																																																																							{
+																																																																																								{
+																																																																																									{
+																																																																																										{
+																																																																																											{
+																																																																																												{
+																																																																																													{
+																																																																																														{
+																																																																																															{
+																																																																																																{
+																																																																																																	{
+																																																																																																		{
+																																																																																																			{
+																																																																																																				{
+																																																																																																					x = 1;
+																																																																																																				}
+																																																																																																			}
+																																																																																																		}
+																																																																																																	}
+																																																																																																}
+																																																																																															}
+																																																																																														}
+																																																																																													}
+																																																																																												}
+																																																																																											}
+																																																																																										}
+																																																																																									}
+																																																																																								}
+																																																																																							}
+																																																																																						}
+																																																																																					}
+																																																																																				}
+																																																																																			}
+																																																																																		}
+																																																																																	}
+																																																																																}
+																																																																															}
+																																																																														}
+																																																																													}
+																																																																												}
+																																																																											}
+																																																																										}
+																																																																									}
+																																																																								}
+																																																																							}
+																																																																						}
+																																																																					}
+																																																																				}
+																																																																			}
+																																																																		}
+																																																																	}
+																																																																}
+																																																															}
+																																																														}
+																																																													}
+																																																												}
+																																																											}
+																																																										}
+																																																									}
+																																																								}
+																																																							}
+																																																						}
+																																																					}
+																																																				}
+																																																			}
+																																																		}
+																																																	}
+																																																}
+																																															}
+																																														}
+																																													}
+																																												}
+																																											}
+																																										}
+																																									}
+																																								}
+																																							}
+																																						}
+																																					}
+																																				}
+																																			}
+																																		}
+																																	}
+																																}
+																															}
+																														}
+																													}
+																												}
+																											}
+																										}
+																									}
+																								}
+																							}
+																						}
+																					}
+																				}
+																			}
+																		}
+																	}
+																}
+															}
+														}
+													}
+												}
+											}
+										}
+									}
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,8 @@
+/*
+ * Deeply nested function calls
+ */
+
+int f(void)
+{
+	x = g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, g(a, b))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))));
+}
@@ -0,0 +1,8 @@
+/*
+ * Many declarations in one declaration statement
+ */
+
+int f(void)
+{
+	int *a0[2], *a1[2], *a2[2], *a3[2], *a4[2], *a5[2], *a6[2], *a7[2], *a8[2], *a9[2], *a10[2], *a11[2], *a12[2], *a13[2], *a14[2], *a15[2], *a16[2], *a17[2], *a18[2], *a19[2], *a20[2], *a21[2], *a22[2], *a23[2], *a24[2], *a25[2], *a26[2], *a27[2], *a28[2], *a29[2], *a30[2], *a31[2], *a32[2], *a33[2], *a34[2], *a35[2], *a36[2], *a37[2], *a38[2], *a39[2], *a40[2], *a41[2], *a42[2], *a43[2], *a44[2], *a45[2], *a46[2], *a47[2], *a48[2], *a49[2], *a50[2], *a51[2], *a52[2], *a53[2], *a54[2], *a55[2], *a56[2], *a57[2], *a58[2], *a59[2], *a60[2], *a61[2], *a62[2], *a63[2], *a64[2], *a65[2], *a66[2], *a67[2], *a68[2], *a69[2], *a70[2], *a71[2], *a72[2], *a73[2], *a74[2], *a75[2], *a76[2], *a77[2], *a78[2], *a79[2], *a80[2], *a81[2], *a82[2], *a83[2], *a84[2], *a85[2], *a86[2], *a87[2], *a88[2], *a89[2], *a90[2], *a91[2], *a92[2], *a93[2], *a94[2], *a95[2], *a96[2], *a97[2], *a98[2], *a99[2], *a100[2], *a101[2], *a102[2], *a103[2], *a104[2], *a105[2], *a106[2], *a107[2], *a108[2], *a109[2], *a110[2], *a111[2], *a112[2], *a113[2], *a114[2], *a115[2], *a116[2], *a117[2], *a118[2], *a119[2], *a120[2], *a121[2], *a122[2], *a123[2], *a124[2], *a125[2], *a126[2], *a127[2], *a128[2], *a129[2], *a130[2], *a131[2], *a132[2], *a133[2], *a134[2], *a135[2], *a136[2], *a137[2], *a138[2], *a139[2], *a140[2], *a141[2], *a142[2], *a143[2], *a144[2], *a145[2], *a146[2], *a147[2], *a148[2], *a149[2], *a150[2], *a151[2], *a152[2], *a153[2], *a154[2], *a155[2], *a156[2], *a157[2], *a158[2], *a159[2], *a160[2], *a161[2], *a162[2], *a163[2], *a164[2], *a165[2], *a166[2], *a167[2], *a168[2], *a169[2], *a170[2], *a171[2], *a172[2], *a173[2], *a174[2], *a175[2], *a176[2], *a177[2], *a178[2], *a179[2], *a180[2], *a181[2], *a182[2], *a183[2], *a184[2], *a185[2], *a186[2], *a187[2], *a188[2], *a189[2], *a190[2], *a191[2], *a192[2], *a193[2], *a194[2], *a195[2], *a196[2], *a197[2], *a198[2], *a199[2], *a200[2], *a201[2], *a202[2], *a203[2], *a204[2], *a205[2], *a206[2], *a207[2], *a208[2], *a209[2], *a210[2], *a211[2], *a212[2], *a213[2], *a214[2], *a215[2], *a216[2], *a217[2], *a218[2], *a219[2], *a220[2], *a221[2], *a222[2], *a223[2], *a224[2], *a225[2], *a226[2], *a227[2], *a228[2], *a229[2], *a230[2], *a231[2], *a232[2], *a233[2], *a234[2], *a235[2], *a236[2], *a237[2], *a238[2], *a239[2], *a240[2], *a241[2], *a242[2], *a243[2], *a244[2], *a245[2], *a246[2], *a247[2], *a248[2], *a249[2], *a250[2], *a251[2], *a252[2], *a253[2], *a254[2], *a255[2], *a256[2], *a257[2], *a258[2], *a259[2], *a260[2], *a261[2], *a262[2], *a263[2], *a264[2], *a265[2], *a266[2], *a267[2], *a268[2], *a269[2], *a270[2], *a271[2], *a272[2], *a273[2], *a274[2], *a275[2], *a276[2], *a277[2], *a278[2], *a279[2], *a280[2], *a281[2], *a282[2], *a283[2], *a284[2], *a285[2], *a286[2], *a287[2], *a288[2], *a289[2], *a290[2], *a291[2], *a292[2], *a293[2], *a294[2], *a295[2], *a296[2], *a297[2], *a298[2], *a299[2], *a300[2], *a301[2], *a302[2], *a303[2], *a304[2], *a305[2], *a306[2], *a307[2], *a308[2], *a309[2], *a310[2], *a311[2], *a312[2], *a313[2], *a314[2], *a315[2], *a316[2], *a317[2], *a318[2], *a319[2], *a320[2], *a321[2], *a322[2], *a323[2], *a324[2], *a325[2], *a326[2], *a327[2], *a328[2], *a329[2], *a330[2], *a331[2], *a332[2], *a333[2], *a334[2], *a335[2], *a336[2], *a337[2], *a338[2], *a339[2], *a340[2], *a341[2], *a342[2], *a343[2], *a344[2], *a345[2], *a346[2], *a347[2], *a348[2], *a349[2], *a350[2], *a351[2], *a352[2], *a353[2], *a354[2], *a355[2], *a356[2], *a357[2], *a358[2], *a359[2], *a360[2], *a361[2], *a362[2], *a363[2], *a364[2], *a365[2], *a366[2], *a367[2], *a368[2], *a369[2], *a370[2], *a371[2], *a372[2], *a373[2], *a374[2], *a375[2], *a376[2], *a377[2], *a378[2], *a379[2], *a380[2], *a381[2], *a382[2], *a383[2], *a384[2], *a385[2], *a386[2], *a387[2], *a388[2], *a389[2], *a390[2], *a391[2], *a392[2], *a393[2], *a394[2], *a395[2], *a396[2], *a397[2], *a398[2], *a399[2], *a400[2], *a401[2], *a402[2], *a403[2], *a404[2], *a405[2], *a406[2], *a407[2], *a408[2], *a409[2], *a410[2], *a411[2], *a412[2], *a413[2], *a414[2], *a415[2], *a416[2], *a417[2], *a418[2], *a419[2], *a420[2], *a421[2], *a422[2], *a423[2], *a424[2], *a425[2], *a426[2], *a427[2], *a428[2], *a429[2], *a430[2], *a431[2], *a432[2], *a433[2], *a434[2], *a435[2], *a436[2], *a437[2], *a438[2], *a439[2], *a440[2], *a441[2], *a442[2], *a443[2], *a444[2], *a445[2], *a446[2], *a447[2], *a448[2], *a449[2], *a450[2], *a451[2], *a452[2], *a453[2], *a454[2], *a455[2], *a456[2], *a457[2], *a458[2], *a459[2], *a460[2], *a461[2], *a462[2], *a463[2], *a464[2], *a465[2], *a466[2], *a467[2], *a468[2], *a469[2], *a470[2], *a471[2], *a472[2], *a473[2], *a474[2], *a475[2], *a476[2], *a477[2], *a478[2], *a479[2], *a480[2], *a481[2], *a482[2], *a483[2], *a484[2], *a485[2], *a486[2], *a487[2], *a488[2], *a489[2], *a490[2], *a491[2], *a492[2], *a493[2], *a494[2], *a495[2], *a496[2], *a497[2], *a498[2], *a499[2], *a500[2], *a501[2], *a502[2], *a503[2], *a504[2], *a505[2], *a506[2], *a507[2], *a508[2], *a509[2], *a510[2], *a511[2], *a512[2], *a513[2], *a514[2], *a515[2], *a516[2], *a517[2], *a518[2], *a519[2], *a520[2], *a521[2], *a522[2], *a523[2], *a524[2], *a525[2], *a526[2], *a527[2], *a528[2], *a529[2], *a530[2], *a531[2], *a532[2], *a533[2], *a534[2], *a535[2], *a536[2], *a537[2], *a538[2], *a539[2], *a540[2], *a541[2], *a542[2], *a543[2], *a544[2], *a545[2], *a546[2], *a547[2], *a548[2], *a549[2], *a550[2], *a551[2], *a552[2], *a553[2], *a554[2], *a555[2], *a556[2], *a557[2], *a558[2], *a559[2], *a560[2], *a561[2], *a562[2], *a563[2], *a564[2], *a565[2], *a566[2], *a567[2], *a568[2], *a569[2], *a570[2], *a571[2], *a572[2], *a573[2], *a574[2], *a575[2], *a576[2], *a577[2], *a578[2], *a579[2], *a580[2], *a581[2], *a582[2], *a583[2], *a584[2], *a585[2], *a586[2], *a587[2], *a588[2], *a589[2], *a590[2], *a591[2], *a592[2], *a593[2], *a594[2], *a595[2], *a596[2], *a597[2], *a598[2], *a599[2], *a600[2], *a601[2], *a602[2], *a603[2], *a604[2], *a605[2], *a606[2], *a607[2], *a608[2], *a609[2], *a610[2], *a611[2], *a612[2], *a613[2], *a614[2], *a615[2], *a616[2], *a617[2], *a618[2], *a619[2], *a620[2], *a621[2], *a622[2], *a623[2], *a624[2], *a625[2], *a626[2], *a627[2], *a628[2], *a629[2], *a630[2], *a631[2], *a632[2], *a633[2], *a634[2], *a635[2], *a636[2], *a637[2], *a638[2], *a639[2], *a640[2], *a641[2], *a642[2], *a643[2], *a644[2], *a645[2], *a646[2], *a647[2], *a648[2], *a649[2], *a650[2], *a651[2], *a652[2], *a653[2], *a654[2], *a655[2], *a656[2], *a657[2], *a658[2], *a659[2], *a660[2], *a661[2], *a662[2], *a663[2], *a664[2], *a665[2], *a666[2], *a667[2], *a668[2], *a669[2], *a670[2], *a671[2], *a672[2], *a673[2], *a674[2], *a675[2], *a676[2], *a677[2], *a678[2], *a679[2], *a680[2], *a681[2], *a682[2], *a683[2], *a684[2], *a685[2], *a686[2], *a687[2], *a688[2], *a689[2], *a690[2], *a691[2], *a692[2], *a693[2], *a694[2], *a695[2], *a696[2], *a697[2], *a698[2], *a699[2], *a700[2], *a701[2], *a702[2], *a703[2], *a704[2], *a705[2], *a706[2], *a707[2], *a708[2], *a709[2], *a710[2], *a711[2], *a712[2], *a713[2], *a714[2], *a715[2], *a716[2], *a717[2], *a718[2], *a719[2], *a720[2], *a721[2], *a722[2], *a723[2], *a724[2], *a725[2], *a726[2], *a727[2], *a728[2], *a729[2], *a730[2], *a731[2], *a732[2], *a733[2], *a734[2], *a735[2], *a736[2], *a737[2], *a738[2], *a739[2], *a740[2], *a741[2], *a742[2], *a743[2], *a744[2], *a745[2], *a746[2], *a747[2], *a748[2], *a749[2], *a750[2], *a751[2], *a752[2], *a753[2], *a754[2], *a755[2], *a756[2], *a757[2], *a758[2], *a759[2], *a760[2], *a761[2], *a762[2], *a763[2], *a764[2], *a765[2], *a766[2], *a767[2], *a768[2], *a769[2], *a770[2], *a771[2], *a772[2], *a773[2], *a774[2], *a775[2], *a776[2], *a777[2], *a778[2], *a779[2], *a780[2], *a781[2], *a782[2], *a783[2], *a784[2], *a785[2], *a786[2], *a787[2], *a788[2], *a789[2], *a790[2], *a791[2], *a792[2], *a793[2], *a794[2], *a795[2], *a796[2], *a797[2], *a798[2], *a799[2], *a800[2], *a801[2], *a802[2], *a803[2], *a804[2], *a805[2], *a806[2], *a807[2], *a808[2], *a809[2], *a810[2], *a811[2], *a812[2], *a813[2], *a814[2], *a815[2], *a816[2], *a817[2], *a818[2], *a819[2], *a820[2], *a821[2], *a822[2], *a823[2], *a824[2], *a825[2], *a826[2], *a827[2], *a828[2], *a829[2], *a830[2], *a831[2], *a832[2], *a833[2], *a834[2], *a835[2], *a836[2], *a837[2], *a838[2], *a839[2], *a840[2], *a841[2], *a842[2], *a843[2], *a844[2], *a845[2], *a846[2], *a847[2], *a848[2], *a849[2], *a850[2], *a851[2], *a852[2], *a853[2], *a854[2], *a855[2], *a856[2], *a857[2], *a858[2], *a859[2], *a860[2], *a861[2], *a862[2], *a863[2], *a864[2], *a865[2], *a866[2], *a867[2], *a868[2], *a869[2], *a870[2], *a871[2], *a872[2], *a873[2], *a874[2], *a875[2], *a876[2], *a877[2], *a878[2], *a879[2], *a880[2], *a881[2], *a882[2], *a883[2], *a884[2], *a885[2], *a886[2], *a887[2], *a888[2], *a889[2], *a890[2], *a891[2], *a892[2], *a893[2], *a894[2], *a895[2], *a896[2], *a897[2], *a898[2], *a899[2], *a900[2], *a901[2], *a902[2], *a903[2], *a904[2], *a905[2], *a906[2], *a907[2], *a908[2], *a909[2], *a910[2], *a911[2], *a912[2], *a913[2], *a914[2], *a915[2], *a916[2], *a917[2], *a918[2], *a919[2], *a920[2], *a921[2], *a922[2], *a923[2], *a924[2], *a925[2], *a926[2], *a927[2], *a928[2], *a929[2], *a930[2], *a931[2], *a932[2], *a933[2], *a934[2], *a935[2], *a936[2], *a937[2], *a938[2], *a939[2], *a940[2], *a941[2], *a942[2], *a943[2], *a944[2], *a945[2], *a946[2], *a947[2], *a948[2], *a949[2], *a950[2], *a951[2], *a952[2], *a953[2], *a954[2], *a955[2], *a956[2], *a957[2], *a958[2], *a959[2], *a960[2], *a961[2], *a962[2], *a963[2], *a964[2], *a965[2], *a966[2], *a967[2], *a968[2], *a969[2], *a970[2], *a971[2], *a972[2], *a973[2], *a974[2], *a975[2], *a976[2], *a977[2], *a978[2], *a979[2], *a980[2], *a981[2], *a982[2], *a983[2], *a984[2], *a985[2], *a986[2], *a987[2], *a988[2], *a989[2], *a990[2], *a991[2], *a992[2], *a993[2], *a994[2], *a995[2], *a996[2], *a997[2], *a998[2], *a999[2];
+}
@@ -0,0 +1,8 @@
+/*
+ * Very long expression on a single line
+ */
+
+int f(void)
+{
+	x = a + b0 + b1 + b2 + b3 + b4 + b5 + b6 + b7 + b8 + b9 + b10 + b11 + b12 + b13 + b14 + b15 + b16 + b17 + b18 + b19 + b20 + b21 + b22 + b23 + b24 + b25 + b26 + b27 + b28 + b29 + b30 + b31 + b32 + b33 + b34 + b35 + b36 + b37 + b38 + b39 + b40 + b41 + b42 + b43 + b44 + b45 + b46 + b47 + b48 + b49 + b50 + b51 + b52 + b53 + b54 + b55 + b56 + b57 + b58 + b59 + b60 + b61 + b62 + b63 + b64 + b65 + b66 + b67 + b68 + b69 + b70 + b71 + b72 + b73 + b74 + b75 + b76 + b77 + b78 + b79 + b80 + b81 + b82 + b83 + b84 + b85 + b86 + b87 + b88 + b89 + b90 + b91 + b92 + b93 + b94 + b95 + b96 + b97 + b98 + b99 + b100 + b101 + b102 + b103 + b104 + b105 + b106 + b107 + b108 + b109 + b110 + b111 + b112 + b113 + b114 + b115 + b116 + b117 + b118 + b119 + b120 + b121 + b122 + b123 + b124 + b125 + b126 + b127 + b128 + b129 + b130 + b131 + b132 + b133 + b134 + b135 + b136 + b137 + b138 + b139 + b140 + b141 + b142 + b143 + b144 + b145 + b146 + b147 + b148 + b149 + b150 + b151 + b152 + b153 + b154 + b155 + b156 + b157 + b158 + b159 + b160 + b161 + b162 + b163 + b164 + b165 + b166 + b167 + b168 + b169 + b170 + b171 + b172 + b173 + b174 + b175 + b176 + b177 + b178 + b179 + b180 + b181 + b182 + b183 + b184 + b185 + b186 + b187 + b188 + b189 + b190 + b191 + b192 + b193 + b194 + b195 + b196 + b197 + b198 + b199 + b200 + b201 + b202 + b203 + b204 + b205 + b206 + b207 + b208 + b209 + b210 + b211 + b212 + b213 + b214 + b215 + b216 + b217 + b218 + b219 + b220 + b221 + b222 + b223 + b224 + b225 + b226 + b227 + b228 + b229 + b230 + b231 + b232 + b233 + b234 + b235 + b236 + b237 + b238 + b239 + b240 + b241 + b242 + b243 + b244 + b245 + b246 + b247 + b248 + b249 + b250 + b251 + b252 + b253 + b254 + b255 + b256 + b257 + b258 + b259 + b260 + b261 + b262 + b263 + b264 + b265 + b266 + b267 + b268 + b269 + b270 + b271 + b272 + b273 + b274 + b275 + b276 + b277 + b278 + b279 + b280 + b281 + b282 + b283 + b284 + b285 + b286 + b287 + b288 + b289 + b290 + b291 + b292 + b293 + b294 + b295 + b296 + b297 + b298 + b299 + b300 + b301 + b302 + b303 + b304 + b305 + b306 + b307 + b308 + b309 + b310 + b311 + b312 + b313 + b314 + b315 + b316 + b317 + b318 + b319 + b320 + b321 + b322 + b323 + b324 + b325 + b326 + b327 + b328 + b329 + b330 + b331 + b332 + b333 + b334 + b335 + b336 + b337 + b338 + b339 + b340 + b341 + b342 + b343 + b344 + b345 + b346 + b347 + b348 + b349 + b350 + b351 + b352 + b353 + b354 + b355 + b356 + b357 + b358 + b359 + b360 + b361 + b362 + b363 + b364 + b365 + b366 + b367 + b368 + b369 + b370 + b371 + b372 + b373 + b374 + b375 + b376 + b377 + b378 + b379 + b380 + b381 + b382 + b383 + b384 + b385 + b386 + b387 + b388 + b389 + b390 + b391 + b392 + b393 + b394 + b395 + b396 + b397 + b398 + b399 + b400 + b401 + b402 + b403 + b404 + b405 + b406 + b407 + b408 + b409 + b410 + b411 + b412 + b413 + b414 + b415 + b416 + b417 + b418 + b419 + b420 + b421 + b422 + b423 + b424 + b425 + b426 + b427 + b428 + b429 + b430 + b431 + b432 + b433 + b434 + b435 + b436 + b437 + b438 + b439 + b440 + b441 + b442 + b443 + b444 + b445 + b446 + b447 + b448 + b449 + b450 + b451 + b452 + b453 + b454 + b455 + b456 + b457 + b458 + b459 + b460 + b461 + b462 + b463 + b464 + b465 + b466 + b467 + b468 + b469 + b470 + b471 + b472 + b473 + b474 + b475 + b476 + b477 + b478 + b479 + b480 + b481 + b482 + b483 + b484 + b485 + b486 + b487 + b488 + b489 + b490 + b491 + b492 + b493 + b494 + b495 + b496 + b497 + b498 + b499 + b500 + b501 + b502 + b503 + b504 + b505 + b506 + b507 + b508 + b509 + b510 + b511 + b512 + b513 + b514 + b515 + b516 + b517 + b518 + b519 + b520 + b521 + b522 + b523 + b524 + b525 + b526 + b527 + b528 + b529 + b530 + b531 + b532 + b533 + b534 + b535 + b536 + b537 + b538 + b539 + b540 + b541 + b542 + b543 + b544 + b545 + b546 + b547 + b548 + b549 + b550 + b551 + b552 + b553 + b554 + b555 + b556 + b557 + b558 + b559 + b560 + b561 + b562 + b563 + b564 + b565 + b566 + b567 + b568 + b569 + b570 + b571 + b572 + b573 + b574 + b575 + b576 + b577 + b578 + b579 + b580 + b581 + b582 + b583 + b584 + b585 + b586 + b587 + b588 + b589 + b590 + b591 + b592 + b593 + b594 + b595 + b596 + b597 + b598 + b599 + b600 + b601 + b602 + b603 + b604 + b605 + b606 + b607 + b608 + b609 + b610 + b611 + b612 + b613 + b614 + b615 + b616 + b617 + b618 + b619 + b620 + b621 + b622 + b623 + b624 + b625 + b626 + b627 + b628 + b629 + b630 + b631 + b632 + b633 + b634 + b635 + b636 + b637 + b638 + b639 + b640 + b641 + b642 + b643 + b644 + b645 + b646 + b647 + b648 + b649 + b650 + b651 + b652 + b653 + b654 + b655 + b656 + b657 + b658 + b659 + b660 + b661 + b662 + b663 + b664 + b665 + b666 + b667 + b668 + b669 + b670 + b671 + b672 + b673 + b674 + b675 + b676 + b677 + b678 + b679 + b680 + b681 + b682 + b683 + b684 + b685 + b686 + b687 + b688 + b689 + b690 + b691 + b692 + b693 + b694 + b695 + b696 + b697 + b698 + b699 + b700 + b701 + b702 + b703 + b704 + b705 + b706 + b707 + b708 + b709 + b710 + b711 + b712 + b713 + b714 + b715 + b716 + b717 + b718 + b719 + b720 + b721 + b722 + b723 + b724 + b725 + b726 + b727 + b728 + b729 + b730 + b731 + b732 + b733 + b734 + b735 + b736 + b737 + b738 + b739 + b740 + b741 + b742 + b743 + b744 + b745 + b746 + b747 + b748 + b749 + b750 + b751 + b752 + b753 + b754 + b755 + b756 + b757 + b758 + b759 + b760 + b761 + b762 + b763 + b764 + b765 + b766 + b767 + b768 + b769 + b770 + b771 + b772 + b773 + b774 + b775 + b776 + b777 + b778 + b779 + b780 + b781 + b782 + b783 + b784 + b785 + b786 + b787 + b788 + b789 + b790 + b791 + b792 + b793 + b794 + b795 + b796 + b797 + b798 + b799 + b800 + b801 + b802 + b803 + b804 + b805 + b806 + b807 + b808 + b809 + b810 + b811 + b812 + b813 + b814 + b815 + b816 + b817 + b818 + b819 + b820 + b821 + b822 + b823 + b824 + b825 + b826 + b827 + b828 + b829 + b830 + b831 + b832 + b833 + b834 + b835 + b836 + b837 + b838 + b839 + b840 + b841 + b842 + b843 + b844 + b845 + b846 + b847 + b848 + b849 + b850 + b851 + b852 + b853 + b854 + b855 + b856 + b857 + b858 + b859 + b860 + b861 + b862 + b863 + b864 + b865 + b866 + b867 + b868 + b869 + b870 + b871 + b872 + b873 + b874 + b875 + b876 + b877 + b878 + b879 + b880 + b881 + b882 + b883 + b884 + b885 + b886 + b887 + b888 + b889 + b890 + b891 + b892 + b893 + b894 + b895 + b896 + b897 + b898 + b899 + b900 + b901 + b902 + b903 + b904 + b905 + b906 + b907 + b908 + b909 + b910 + b911 + b912 + b913 + b914 + b915 + b916 + b917 + b918 + b919 + b920 + b921 + b922 + b923 + b924 + b925 + b926 + b927 + b928 + b929 + b930 + b931 + b932 + b933 + b934 + b935 + b936 + b937 + b938 + b939 + b940 + b941 + b942 + b943 + b944 + b945 + b946 + b947 + b948 + b949 + b950 + b951 + b952 + b953 + b954 + b955 + b956 + b957 + b958 + b959 + b960 + b961 + b962 + b963 + b964 + b965 + b966 + b967 + b968 + b969 + b970 + b971 + b972 + b973 + b974 + b975 + b976 + b977 + b978 + b979 + b980 + b981 + b982 + b983 + b984 + b985 + b986 + b987 + b988 + b989 + b990 + b991 + b992 + b993 + b994 + b995 + b996 + b997 + b998 + b999 + b1000 + b1001 + b1002 + b1003 + b1004 + b1005 + b1006 + b1007 + b1008 + b1009 + b1010 + b1011 + b1012 + b1013 + b1014 + b1015 + b1016 + b1017 + b1018 + b1019 + b1020 + b1021 + b1022 + b1023 + b1024 + b1025 + b1026 + b1027 + b1028 + b1029 + b1030 + b1031 + b1032 + b1033 + b1034 + b1035 + b1036 + b1037 + b1038 + b1039 + b1040 + b1041 + b1042 + b1043 + b1044 + b1045 + b1046 + b1047 + b1048 + b1049 + b1050 + b1051 + b1052 + b1053 + b1054 + b1055 + b1056 + b1057 + b1058 + b1059 + b1060 + b1061 + b1062 + b1063 + b1064 + b1065 + b1066 + b1067 + b1068 + b1069 + b1070 + b1071 + b1072 + b1073 + b1074 + b1075 + b1076 + b1077 + b1078 + b1079 + b1080 + b1081 + b1082 + b1083 + b1084 + b1085 + b1086 + b1087 + b1088 + b1089 + b1090 + b1091 + b1092 + b1093 + b1094 + b1095 + b1096 + b1097 + b1098 + b1099 + b1100 + b1101 + b1102 + b1103 + b1104 + b1105 + b1106 + b1107 + b1108 + b1109 + b1110 + b1111 + b1112 + b1113 + b1114 + b1115 + b1116 + b1117 + b1118 + b1119 + b1120 + b1121 + b1122 + b1123 + b1124 + b1125 + b1126 + b1127 + b1128 + b1129 + b1130 + b1131 + b1132 + b1133 + b1134 + b1135 + b1136 + b1137 + b1138 + b1139 + b1140 + b1141 + b1142 + b1143 + b1144 + b1145 + b1146 + b1147 + b1148 + b1149 + b1150 + b1151 + b1152 + b1153 + b1154 + b1155 + b1156 + b1157 + b1158 + b1159 + b1160 + b1161 + b1162 + b1163 + b1164 + b1165 + b1166 + b1167 + b1168 + b1169 + b1170 + b1171 + b1172 + b1173 + b1174 + b1175 + b1176 + b1177 + b1178 + b1179 + b1180 + b1181 + b1182 + b1183 + b1184 + b1185 + b1186 + b1187 + b1188 + b1189 + b1190 + b1191 + b1192 + b1193 + b1194 + b1195 + b1196 + b1197 + b1198 + b1199 + b1200 + b1201 + b1202 + b1203 + b1204 + b1205 + b1206 + b1207 + b1208 + b1209 + b1210 + b1211 + b1212 + b1213 + b1214 + b1215 + b1216 + b1217 + b1218 + b1219 + b1220 + b1221 + b1222 + b1223 + b1224 + b1225 + b1226 + b1227 + b1228 + b1229 + b1230 + b1231 + b1232 + b1233 + b1234 + b1235 + b1236 + b1237 + b1238 + b1239 + b1240 + b1241 + b1242 + b1243 + b1244 + b1245 + b1246 + b1247 + b1248 + b1249 + b1250 + b1251 + b1252 + b1253 + b1254 + b1255 + b1256 + b1257 + b1258 + b1259 + b1260 + b1261 + b1262 + b1263 + b1264 + b1265 + b1266 + b1267 + b1268 + b1269 + b1270 + b1271 + b1272 + b1273 + b1274 + b1275 + b1276 + b1277 + b1278 + b1279 + b1280 + b1281 + b1282 + b1283 + b1284 + b1285 + b1286 + b1287 + b1288 + b1289 + b1290 + b1291 + b1292 + b1293 + b1294 + b1295 + b1296 + b1297 + b1298 + b1299 + b1300 + b1301 + b1302 + b1303 + b1304 + b1305 + b1306 + b1307 + b1308 + b1309 + b1310 + b1311 + b1312 + b1313 + b1314 + b1315 + b1316 + b1317 + b1318 + b1319 + b1320 + b1321 + b1322 + b1323 + b1324 + b1325 + b1326 + b1327 + b1328 + b1329 + b1330 + b1331 + b1332 + b1333 + b1334 + b1335 + b1336 + b1337 + b1338 + b1339 + b1340 + b1341 + b1342 + b1343 + b1344 + b1345 + b1346 + b1347 + b1348 + b1349 + b1350 + b1351 + b1352 + b1353 + b1354 + b1355 + b1356 + b1357 + b1358 + b1359 + b1360 + b1361 + b1362 + b1363 + b1364 + b1365 + b1366 + b1367 + b1368 + b1369 + b1370 + b1371 + b1372 + b1373 + b1374 + b1375 + b1376 + b1377 + b1378 + b1379 + b1380 + b1381 + b1382 + b1383 + b1384 + b1385 + b1386 + b1387 + b1388 + b1389 + b1390 + b1391 + b1392 + b1393 + b1394 + b1395 + b1396 + b1397 + b1398 + b1399 + b1400 + b1401 + b1402 + b1403 + b1404 + b1405 + b1406 + b1407 + b1408 + b1409 + b1410 + b1411 + b1412 + b1413 + b1414 + b1415 + b1416 + b1417 + b1418 + b1419 + b1420 + b1421 + b1422 + b1423 + b1424 + b1425 + b1426 + b1427 + b1428 + b1429 + b1430 + b1431 + b1432 + b1433 + b1434 + b1435 + b1436 + b1437 + b1438 + b1439 + b1440 + b1441 + b1442 + b1443 + b1444 + b1445 + b1446 + b1447 + b1448 + b1449 + b1450 + b1451 + b1452 + b1453 + b1454 + b1455 + b1456 + b1457 + b1458 + b1459 + b1460 + b1461 + b1462 + b1463 + b1464 + b1465 + b1466 + b1467 + b1468 + b1469 + b1470 + b1471 + b1472 + b1473 + b1474 + b1475 + b1476 + b1477 + b1478 + b1479 + b1480 + b1481 + b1482 + b1483 + b1484 + b1485 + b1486 + b1487 + b1488 + b1489 + b1490 + b1491 + b1492 + b1493 + b1494 + b1495 + b1496 + b1497 + b1498 + b1499 + b1500 + b1501 + b1502 + b1503 + b1504 + b1505 + b1506 + b1507 + b1508 + b1509 + b1510 + b1511 + b1512 + b1513 + b1514 + b1515 + b1516 + b1517 + b1518 + b1519 + b1520 + b1521 + b1522 + b1523 + b1524 + b1525 + b1526 + b1527 + b1528 + b1529 + b1530 + b1531 + b1532 + b1533 + b1534 + b1535 + b1536 + b1537 + b1538 + b1539 + b1540 + b1541 + b1542 + b1543 + b1544 + b1545 + b1546 + b1547 + b1548 + b1549 + b1550 + b1551 + b1552 + b1553 + b1554 + b1555 + b1556 + b1557 + b1558 + b1559 + b1560 + b1561 + b1562 + b1563 + b1564 + b1565 + b1566 + b1567 + b1568 + b1569 + b1570 + b1571 + b1572 + b1573 + b1574 + b1575 + b1576 + b1577 + b1578 + b1579 + b1580 + b1581 + b1582 + b1583 + b1584 + b1585 + b1586 + b1587 + b1588 + b1589 + b1590 + b1591 + b1592 + b1593 + b1594 + b1595 + b1596 + b1597 + b1598 + b1599 + b1600 + b1601 + b1602 + b1603 + b1604 + b1605 + b1606 + b1607 + b1608 + b1609 + b1610 + b1611 + b1612 + b1613 + b1614 + b1615 + b1616 + b1617 + b1618 + b1619 + b1620 + b1621 + b1622 + b1623 + b1624 + b1625 + b1626 + b1627 + b1628 + b1629 + b1630 + b1631 + b1632 + b1633 + b1634 + b1635 + b1636 + b1637 + b1638 + b1639 + b1640 + b1641 + b1642 + b1643 + b1644 + b1645 + b1646 + b1647 + b1648 + b1649 + b1650 + b1651 + b1652 + b1653 + b1654 + b1655 + b1656 + b1657 + b1658 + b1659 + b1660 + b1661 + b1662 + b1663 + b1664 + b1665 + b1666 + b1667 + b1668 + b1669 + b1670 + b1671 + b1672 + b1673 + b1674 + b1675 + b1676 + b1677 + b1678 + b1679 + b1680 + b1681 + b1682 + b1683 + b1684 + b1685 + b1686 + b1687 + b1688 + b1689 + b1690 + b1691 + b1692 + b1693 + b1694 + b1695 + b1696 + b1697 + b1698 + b1699 + b1700 + b1701 + b1702 + b1703 + b1704 + b1705 + b1706 + b1707 + b1708 + b1709 + b1710 + b1711 + b1712 + b1713 + b1714 + b1715 + b1716 + b1717 + b1718 + b1719 + b1720 + b1721 + b1722 + b1723 + b1724 + b1725 + b1726 + b1727 + b1728 + b1729 + b1730 + b1731 + b1732 + b1733 + b1734 + b1735 + b1736 + b1737 + b1738 + b1739 + b1740 + b1741 + b1742 + b1743 + b1744 + b1745 + b1746 + b1747 + b1748 + b1749 + b1750 + b1751 + b1752 + b1753 + b1754 + b1755 + b1756 + b1757 + b1758 + b1759 + b1760 + b1761 + b1762 + b1763 + b1764 + b1765 + b1766 + b1767 + b1768 + b1769 + b1770 + b1771 + b1772 + b1773 + b1774 + b1775 + b1776 + b1777 + b1778 + b1779 + b1780 + b1781 + b1782 + b1783 + b1784 + b1785 + b1786 + b1787 + b1788 + b1789 + b1790 + b1791 + b1792 + b1793 + b1794 + b1795 + b1796 + b1797 + b1798 + b1799 + b1800 + b1801 + b1802 + b1803 + b1804 + b1805 + b1806 + b1807 + b1808 + b1809 + b1810 + b1811 + b1812 + b1813 + b1814 + b1815 + b1816 + b1817 + b1818 + b1819 + b1820 + b1821 + b1822 + b1823 + b1824 + b1825 + b1826 + b1827 + b1828 + b1829 + b1830 + b1831 + b1832 + b1833 + b1834 + b1835 + b1836 + b1837 + b1838 + b1839 + b1840 + b1841 + b1842 + b1843 + b1844 + b1845 + b1846 + b1847 + b1848 + b1849 + b1850 + b1851 + b1852 + b1853 + b1854 + b1855 + b1856 + b1857 + b1858 + b1859 + b1860 + b1861 + b1862 + b1863 + b1864 + b1865 + b1866 + b1867 + b1868 + b1869 + b1870 + b1871 + b1872 + b1873 + b1874 + b1875 + b1876 + b1877 + b1878 + b1879 + b1880 + b1881 + b1882 + b1883 + b1884 + b1885 + b1886 + b1887 + b1888 + b1889 + b1890 + b1891 + b1892 + b1893 + b1894 + b1895 + b1896 + b1897 + b1898 + b1899 + b1900 + b1901 + b1902 + b1903 + b1904 + b1905 + b1906 + b1907 + b1908 + b1909 + b1910 + b1911 + b1912 + b1913 + b1914 + b1915 + b1916 + b1917 + b1918 + b1919 + b1920 + b1921 + b1922 + b1923 + b1924 + b1925 + b1926 + b1927 + b1928 + b1929 + b1930 + b1931 + b1932 + b1933 + b1934 + b1935 + b1936 + b1937 + b1938 + b1939 + b1940 + b1941 + b1942 + b1943 + b1944 + b1945 + b1946 + b1947 + b1948 + b1949 + b1950 + b1951 + b1952 + b1953 + b1954 + b1955 + b1956 + b1957 + b1958 + b1959 + b1960 + b1961 + b1962 + b1963 + b1964 + b1965 + b1966 + b1967 + b1968 + b1969 + b1970 + b1971 + b1972 + b1973 + b1974 + b1975 + b1976 + b1977 + b1978 + b1979 + b1980 + b1981 + b1982 + b1983 + b1984 + b1985 + b1986 + b1987 + b1988 + b1989 + b1990 + b1991 + b1992 + b1993 + b1994 + b1995 + b1996 + b1997 + b1998 + b1999;
+}
@@ -0,0 +1,409 @@
+/*
+ * Long if-else chain
+ */
+
+int f(void)
+{
+	if (a == 0)
+		b();
+	else 	if (a == 1)
+		b();
+	else 	if (a == 2)
+		b();
+	else 	if (a == 3)
+		b();
+	else 	if (a == 4)
+		b();
+	else 	if (a == 5)
+		b();
+	else 	if (a == 6)
+		b();
+	else 	if (a == 7)
+		b();
+	else 	if (a == 8)
+		b();
+	else 	if (a == 9)
+		b();
+	else 	if (a == 10)
+		b();
+	else 	if (a == 11)
+		b();
+	else 	if (a == 12)
+		b();
+	else 	if (a == 13)
+		b();
+	else 	if (a == 14)
+		b();
+	else 	if (a == 15)
+		b();
+	else 	if (a == 16)
+		b();
+	else 	if (a == 17)
+		b();
+	else 	if (a == 18)
+		b();
+	else 	if (a == 19)
+		b();
+	else 	if (a == 20)
+		b();
+	else 	if (a == 21)
+		b();
+	else 	if (a == 22)
+		b();
+	else 	if (a == 23)
+		b();
+	else 	if (a == 24)
+		b();
+	else 	if (a == 25)
+		b();
+	else 	if (a == 26)
+		b();
+	else 	if (a == 27)
+		b();
+	else 	if (a == 28)
+		b();
+	else 	if (a == 29)
+		b();
+	else 	if (a == 30)
+		b();
+	else 	if (a == 31)
+		b();
+	else 	if (a == 32)
+		b();
+	else 	if (a == 33)
+		b();
+	else 	if (a == 34)
+		b();
+	else 	if (a == 35)
+		b();
+	else 	if (a == 36)
+		b();
+	else 	if (a == 37)
+		b();
+	else 	if (a == 38)
+		b();
+	else 	if (a == 39)
+		b();
+	else 	if (a == 40)
+		b();
+	else 	if (a == 41)
+		b();
+	else 	if (a == 42)
+		b();
+	else 	if (a == 43)
+		b();
+	else 	if (a == 44)
+		b();
+	else 	if (a == 45)
+		b();
+	else 	if (a == 46)
+		b();
+	else 	if (a == 47)
+		b();
+	else 	if (a == 48)
+		b();
+	else 	if (a == 49)
+		b();
+	else 	if (a == 50)
+		b();
+	else 	if (a == 51)
+		b();
+	else 	if (a == 52)
+		b();
+	else 	if (a == 53)
+		b();
+	else 	if (a == 54)
+		b();
+	else 	if (a == 55)
+		b();
+	else 	if (a == 56)
+		b();
+	else 	if (a == 57)
+		b();
+	else 	if (a == 58)
+		b();
+	else 	if (a == 59)
+		b();
+	else 	if (a == 60)
+		b();
+	else 	if (a == 61)
+		b();
+	else 	if (a == 62)
+		b();
+	else 	if (a == 63)
+		b();
+	else 	if (a == 64)
+		b();
+	else 	if (a == 65)
+		b();
+	else 	if (a == 66)
+		b();
+	else 	if (a == 67)
+		b();
+	else 	if (a == 68)
+		b();
+	else 	if (a == 69)
+		b();
+	else 	if (a == 70)
+		b();
+	else 	if (a == 71)
+		b();
+	else 	if (a == 72)
+		b();
+	else 	if (a == 73)
+		b();
+	else 	if (a == 74)
+		b();
+	else 	if (a == 75)
+		b();
+	else 	if (a == 76)
+		b();
+	else 	if (a == 77)
+		b();
+	else 	if (a == 78)
+		b();
+	else 	if (a == 79)
+		b();
+	else 	if (a == 80)
+		b();
+	else 	if (a == 81)
+		b();
+	else 	if (a == 82)
+		b();
+	else 	if (a == 83)
+		b();
+	else 	if (a == 84)
+		b();
+	else 	if (a == 85)
+		b();
+	else 	if (a == 86)
+		b();
+	else 	if (a == 87)
+		b();
+	else 	if (a == 88)
+		b();
+	else 	if (a == 89)
+		b();
+	else 	if (a == 90)
+		b();
+	else 	if (a == 91)
+		b();
+	else 	if (a == 92)
+		b();
+	else 	if (a == 93)
+		b();
+	else 	if (a == 94)
+		b();
+	else 	if (a == 95)
+		b();
+	else 	if (a == 96)
+		b();
+	else 	if (a == 97)
+		b();
+	else 	if (a == 98)
+		b();
+	else 	if (a == 99)
+		b();
+	else 	if (a == 100)
+		b();
+	else 	if (a == 101)
+		b();
+	else 	if (a == 102)
+		b();
+	else 	if (a == 103)
+		b();
+	else 	if (a == 104)
+		b();
+	else 	if (a == 105)
+		b();
+	else 	if (a == 106)
+		b();
+	else 	if (a == 107)
+		b();
+	else 	if (a == 108)
+		b();
+	else 	if (a == 109)
+		b();
+	else 	if (a == 110)
+		b();
+	else 	if (a == 111)
+		b();
+	else 	if (a == 112)
+		b();
+	else 	if (a == 113)
+		b();
+	else 	if (a == 114)
+		b();
+	else 	if (a == 115)
+		b();
+	else 	if (a == 116)
+		b();
+	else 	if (a == 117)
+		b();
+	else 	if (a == 118)
+		b();
+	else 	if (a == 119)
+		b();
+	else 	if (a == 120)
+		b();
+	else 	if (a == 121)
+		b();
+	else 	if (a == 122)
+		b();
+	else 	if (a == 123)
+		b();
+	else 	if (a == 124)
+		b();
+	else 	if (a == 125)
+		b();
+	else 	if (a == 126)
+		b();
+	else 	if (a == 127)
+		b();
+	else 	if (a == 128)
+		b();
+	else 	if (a == 129)
+		b();
+	else 	if (a == 130)
+		b();
+	else 	if (a == 131)
+		b();
+	else 	if (a == 132)
+		b();
+	else 	if (a == 133)
+		b();
+	else 	if (a == 134)
+		b();
+	else 	if (a == 135)
+		b();
+	else 	if (a == 136)
+		b();
+	else 	if (a == 137)
+		b();
+	else 	if (a == 138)
+		b();
+	else 	if (a == 139)
+		b();
+	else 	if (a == 140)
+		b();
+	else 	if (a == 141)
+		b();
+	else 	if (a == 142)
+		b();
+	else 	if (a == 143)
+		b();
+	else 	if (a == 144)
+		b();
+	else 	if (a == 145)
+		b();
+	else 	if (a == 146)
+		b();
+	else 	if (a == 147)
+		b();
+	else 	if (a == 148)
+		b();
+	else 	if (a == 149)
+		b();
+	else 	if (a == 150)
+		b();
+	else 	if (a == 151)
+		b();
+	else 	if (a == 152)
+		b();
+	else 	if (a == 153)
+		b();
+	else 	if (a == 154)
+		b();
+	else 	if (a == 155)
+		b();
+	else 	if (a == 156)
+		b();
+	else 	if (a == 157)
+		b();
+	else 	if (a == 158)
+		b();
+	else 	if (a == 159)
+		b();
+	else 	if (a == 160)
+		b();
+	else 	if (a == 161)
+		b();
+	else 	if (a == 162)
+		b();
+	else 	if (a == 163)
+		b();
+	else 	if (a == 164)
+		b();
+	else 	if (a == 165)
+		b();
+	else 	if (a == 166)
+		b();
+	else 	if (a == 167)
+		b();
+	else 	if (a == 168)
+		b();
+	else 	if (a == 169)
+		b();
+	else 	if (a == 170)
+		b();
+	else 	if (a == 171)
+		b();
+	else 	if (a == 172)
+		b();
+	else 	if (a == 173)
+		b();
+	else 	if (a == 174)
+		b();
+	else 	if (a == 175)
+		b();
+	else 	if (a == 176)
+		b();
+	else 	if (a == 177)
+		b();
+	else 	if (a == 178)
+		b();
+	else 	if (a == 179)
+		b();
+	else 	if (a == 180)
+		b();
+	else 	if (a == 181)
+		b();
+	else 	if (a == 182)
+		b();
+	else 	if (a == 183)
+		b();
+	else 	if (a == 184)
+		b();
+	else 	if (a == 185)
+		b();
+	else 	if (a == 186)
+		b();
+	else 	if (a == 187)
+		b();
+	else 	if (a == 188)
+		b();
+	else 	if (a == 189)
+		b();
+	else 	if (a == 190)
+		b();
+	else 	if (a == 191)
+		b();
+	else 	if (a == 192)
+		b();
+	else 	if (a == 193)
+		b();
+	else 	if (a == 194)
+		b();
+	else 	if (a == 195)
+		b();
+	else 	if (a == 196)
+		b();
+	else 	if (a == 197)
+		b();
+	else 	if (a == 198)
+		b();
+	else 	if (a == 199)
+		b();
+	else 
+		c();
+}
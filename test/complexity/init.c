@@ -0,0 +1,5 @@
+/*
+ * Deeply nested initializers
+ */
+
+struct s a = { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, { 1, 1 } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } } };
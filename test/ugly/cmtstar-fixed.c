@@ -0,0 +1,11 @@
+/*
+ * Block comment lines should have a space after the leading asterisk
+ * and fixing them must not change the rest of the line.
+ */
+int main(void)
+{
+	/*
+	 * foo bar
+	 */
+	return 0;
+}